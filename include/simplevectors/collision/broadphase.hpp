@@ -0,0 +1,454 @@
+/**
+ * @file broadphase.hpp
+ *
+ * @brief Overlapping pairs among many axis-aligned boxes.
+ *
+ * svector::SweepAndPrune keeps the end points of moving boxes sorted along
+ * every axis between frames. Boxes usually move only a little each frame, so
+ * the lists are almost sorted and insertion sort fixes them in close to
+ * linear time; every swap of a lower and an upper end point is where a pair
+ * of boxes starts or stops overlapping, so the set of pairs is updated along
+ * the way.
+ *
+ * svector::BoxSweep finds the pairs of one set of boxes from scratch. It
+ * sweeps along the axis where the boxes are spread out the most and checks
+ * the other axes for the boxes that overlap on that one. The sweep can be
+ * split into ranges that are processed independently.
+ *
+ * Both work for boxes of any dimension. Boxes that only touch count as
+ * overlapping.
+ *
+ * This file is not included in vectors.hpp, so it has to be included
+ * separately.
+ *
+ * @copyright Copyright (c) 2023 Jonathan Liu. This project is released under
+ * the MIT License. All rights reserved.
+ */
+
+#ifndef INCLUDE_SVECTOR_BROADPHASE_HPP_
+#define INCLUDE_SVECTOR_BROADPHASE_HPP_
+
+#include <algorithm> // std::sort
+#include <cstddef>   // std::size_t
+#include <set>       // std::set
+#include <utility>   // std::pair
+#include <vector>    // std::vector
+
+#include "simplevectors/core/traits.hpp" // svector::VectorTraits
+
+namespace svector {
+namespace detail {
+/**
+ * An end point of a box along one axis.
+ */
+struct SweepEndpoint {
+  double value;
+  std::size_t box;
+  bool upper;
+};
+
+/**
+ * Whether an end point comes before another. Lower end points come first
+ * when the values are equal, so touching boxes overlap.
+ */
+inline bool endpointBefore(const SweepEndpoint &lhs,
+                           const SweepEndpoint &rhs) {
+  return lhs.value < rhs.value ||
+         (lhs.value == rhs.value && !lhs.upper && rhs.upper);
+}
+} // namespace detail
+
+/**
+ * @brief Incremental sweep and prune over moving boxes.
+ *
+ * Add boxes, move them every frame, then call update() to get the pairs of
+ * overlapping boxes.
+ *
+ * @tparam V Point type of the box corners.
+ */
+template <typename V> class SweepAndPrune {
+public:
+  /**
+   * @brief Number of axes of the boxes.
+   */
+  static constexpr std::size_t dimensions = VectorTraits<V>::dimensions;
+
+  /**
+   * @brief Creates an empty sweep.
+   */
+  SweepAndPrune() : m_inserted(0) {}
+
+  /**
+   * @brief Adds a box.
+   *
+   * The box takes part in the pairs from the next call to update().
+   *
+   * @param lower The corner of the box with the smallest coordinates.
+   * @param upper The corner of the box with the largest coordinates.
+   *
+   * @returns The id of the box. Ids of removed boxes are reused.
+   */
+  std::size_t insert(const V &lower, const V &upper) {
+    std::size_t id;
+    if (this->m_free.empty()) {
+      id = this->m_lower.size() / dimensions;
+      this->m_lower.resize(this->m_lower.size() + dimensions);
+      this->m_upper.resize(this->m_upper.size() + dimensions);
+    } else {
+      id = this->m_free.back();
+      this->m_free.pop_back();
+    }
+
+    this->move(id, lower, upper);
+    for (std::size_t axis = 0; axis < dimensions; axis++) {
+      this->m_axes[axis].push_back(detail::SweepEndpoint{
+          this->m_lower[id * dimensions + axis], id, false});
+      this->m_axes[axis].push_back(detail::SweepEndpoint{
+          this->m_upper[id * dimensions + axis], id, true});
+    }
+    this->m_inserted++;
+
+    return id;
+  }
+
+  /**
+   * @brief Removes a box.
+   *
+   * @param id The id of the box.
+   *
+   * @note This method will result in undefined behavior if the box was
+   * already removed.
+   */
+  void erase(const std::size_t id) {
+    for (std::size_t axis = 0; axis < dimensions; axis++) {
+      std::vector<detail::SweepEndpoint> &list = this->m_axes[axis];
+      std::size_t kept = 0;
+      for (std::size_t i = 0; i < list.size(); i++) {
+        if (list[i].box != id) {
+          list[kept++] = list[i];
+        }
+      }
+      list.resize(kept);
+    }
+
+    for (auto it = this->m_pairs.begin(); it != this->m_pairs.end();) {
+      if (it->first == id || it->second == id) {
+        it = this->m_pairs.erase(it);
+      } else {
+        ++it;
+      }
+    }
+
+    this->m_free.push_back(id);
+  }
+
+  /**
+   * @brief Moves a box.
+   *
+   * The pairs change on the next call to update().
+   *
+   * @param id The id of the box.
+   * @param lower The new corner with the smallest coordinates.
+   * @param upper The new corner with the largest coordinates.
+   */
+  void move(const std::size_t id, const V &lower, const V &upper) {
+    for (std::size_t axis = 0; axis < dimensions; axis++) {
+      this->m_lower[id * dimensions + axis] = static_cast<double>(lower[axis]);
+      this->m_upper[id * dimensions + axis] = static_cast<double>(upper[axis]);
+    }
+  }
+
+  /**
+   * @brief Brings the pairs up to date with the boxes.
+   *
+   * Runs in about O(n + s) for n boxes and s end points that changed order
+   * since the last update. After many insertions, the lists are sorted from
+   * scratch instead.
+   *
+   * @returns The pairs of ids of overlapping boxes, with the smaller id
+   * first, in sorted order.
+   */
+  const std::set<std::pair<std::size_t, std::size_t>> &update() {
+    for (std::size_t axis = 0; axis < dimensions; axis++) {
+      for (detail::SweepEndpoint &endpoint : this->m_axes[axis]) {
+        const std::size_t index = endpoint.box * dimensions + axis;
+        endpoint.value =
+            endpoint.upper ? this->m_upper[index] : this->m_lower[index];
+      }
+    }
+
+    const std::size_t count = this->m_axes[0].size() / 2;
+    if (this->m_inserted * 4 > count) {
+      this->rebuild();
+    } else {
+      for (std::size_t axis = 0; axis < dimensions; axis++) {
+        this->sortAxis(axis);
+      }
+    }
+    this->m_inserted = 0;
+
+    return this->m_pairs;
+  }
+
+  /**
+   * @brief The pairs found by the last update.
+   *
+   * @returns The pairs of ids of overlapping boxes, with the smaller id
+   * first, in sorted order.
+   */
+  const std::set<std::pair<std::size_t, std::size_t>> &pairs() const {
+    return this->m_pairs;
+  }
+
+private:
+  std::vector<detail::SweepEndpoint> m_axes[dimensions]; //!< End points.
+  std::vector<double> m_lower;     //!< Lower corners, one row per box.
+  std::vector<double> m_upper;     //!< Upper corners, one row per box.
+  std::vector<std::size_t> m_free; //!< Ids of removed boxes.
+  std::size_t m_inserted;          //!< Boxes added since the last update.
+  std::set<std::pair<std::size_t, std::size_t>> m_pairs; //!< Pairs.
+
+  /**
+   * @brief Whether two boxes overlap on every axis.
+   */
+  bool overlap(const std::size_t a, const std::size_t b) const {
+    for (std::size_t axis = 0; axis < dimensions; axis++) {
+      if (this->m_lower[a * dimensions + axis] >
+              this->m_upper[b * dimensions + axis] ||
+          this->m_lower[b * dimensions + axis] >
+              this->m_upper[a * dimensions + axis]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Insertion sort of one axis, updating the pairs at every swap of a
+   * lower and an upper end point.
+   */
+  void sortAxis(const std::size_t axis) {
+    std::vector<detail::SweepEndpoint> &list = this->m_axes[axis];
+    for (std::size_t i = 1; i < list.size(); i++) {
+      const detail::SweepEndpoint moving = list[i];
+      std::size_t j = i;
+      while (j > 0 && detail::endpointBefore(moving, list[j - 1])) {
+        const detail::SweepEndpoint &passed = list[j - 1];
+        const std::pair<std::size_t, std::size_t> pair =
+            moving.box < passed.box ? std::make_pair(moving.box, passed.box)
+                                    : std::make_pair(passed.box, moving.box);
+        if (!moving.upper && passed.upper) {
+          // a lower end moved below an upper end, so they may now overlap
+          if (this->overlap(moving.box, passed.box)) {
+            this->m_pairs.insert(pair);
+          }
+        } else if (moving.upper && !passed.upper) {
+          // an upper end moved below a lower end, so they are now apart
+          this->m_pairs.erase(pair);
+        }
+
+        list[j] = passed;
+        j--;
+      }
+      list[j] = moving;
+    }
+  }
+
+  /**
+   * @brief Sorts every axis from scratch and finds all pairs with one sweep.
+   */
+  void rebuild() {
+    for (std::size_t axis = 0; axis < dimensions; axis++) {
+      std::sort(this->m_axes[axis].begin(), this->m_axes[axis].end(),
+                detail::endpointBefore);
+    }
+
+    this->m_pairs.clear();
+    std::vector<std::size_t> active;
+    for (const detail::SweepEndpoint &endpoint : this->m_axes[0]) {
+      if (endpoint.upper) {
+        for (std::size_t i = 0; i < active.size(); i++) {
+          if (active[i] == endpoint.box) {
+            active[i] = active.back();
+            active.pop_back();
+            break;
+          }
+        }
+        continue;
+      }
+
+      for (const std::size_t other : active) {
+        if (this->overlap(endpoint.box, other)) {
+          this->m_pairs.insert(endpoint.box < other
+                                   ? std::make_pair(endpoint.box, other)
+                                   : std::make_pair(other, endpoint.box));
+        }
+      }
+      active.push_back(endpoint.box);
+    }
+  }
+};
+
+template <typename V> constexpr std::size_t SweepAndPrune<V>::dimensions;
+
+/**
+ * @brief Sweep and prune of one set of boxes.
+ *
+ * Sorts the boxes along the axis where their centers vary the most, then
+ * checks each box against the boxes after it that start before it ends.
+ *
+ * @tparam V Point type of the box corners.
+ */
+template <typename V> class BoxSweep {
+public:
+  /**
+   * @brief Number of axes of the boxes.
+   */
+  static constexpr std::size_t dimensions = VectorTraits<V>::dimensions;
+
+  /**
+   * @brief Sorts the boxes.
+   *
+   * @param lowers The corners of the boxes with the smallest coordinates.
+   * @param uppers The corners of the boxes with the largest coordinates.
+   *
+   * @note This method will result in undefined behavior if lowers and
+   * uppers have different sizes.
+   */
+  BoxSweep(const std::vector<V> &lowers, const std::vector<V> &uppers)
+      : m_axis(0) {
+    const std::size_t n = lowers.size();
+
+    // sweep along the axis with the largest variance of the centers
+    double best = -1;
+    for (std::size_t axis = 0; axis < dimensions; axis++) {
+      double sum = 0;
+      double sumSquares = 0;
+      for (std::size_t i = 0; i < n; i++) {
+        const double center = static_cast<double>(lowers[i][axis]) +
+                              static_cast<double>(uppers[i][axis]);
+        sum += center;
+        sumSquares += center * center;
+      }
+      const double variance =
+          n > 0 ? sumSquares / static_cast<double>(n) -
+                      (sum / static_cast<double>(n)) *
+                          (sum / static_cast<double>(n))
+                : 0;
+      if (variance > best) {
+        best = variance;
+        this->m_axis = axis;
+      }
+    }
+
+    this->m_order.resize(n);
+    for (std::size_t i = 0; i < n; i++) {
+      this->m_order[i] = i;
+    }
+    const std::size_t axis = this->m_axis;
+    std::sort(this->m_order.begin(), this->m_order.end(),
+              [&lowers, axis](const std::size_t lhs, const std::size_t rhs) {
+                return lowers[lhs][axis] < lowers[rhs][axis];
+              });
+
+    // bounds in sorted order, one array per axis and side
+    this->m_lower.resize(dimensions * n);
+    this->m_upper.resize(dimensions * n);
+    for (std::size_t k = 0; k < dimensions; k++) {
+      for (std::size_t i = 0; i < n; i++) {
+        const std::size_t box = this->m_order[i];
+        this->m_lower[k * n + i] = static_cast<double>(lowers[box][k]);
+        this->m_upper[k * n + i] = static_cast<double>(uppers[box][k]);
+      }
+    }
+  }
+
+  /**
+   * @brief Number of boxes.
+   *
+   * @returns The number of boxes.
+   */
+  std::size_t size() const { return this->m_order.size(); }
+
+  /**
+   * @brief The axis the boxes are sorted along.
+   *
+   * @returns The index of the axis.
+   */
+  std::size_t axis() const { return this->m_axis; }
+
+  /**
+   * @brief Finds the pairs whose first box in sorted order is in a range.
+   *
+   * Ranges do not share pairs, so the pairs of all boxes are the union of
+   * the pairs of ranges that cover 0 to size(), which can be found at the
+   * same time.
+   *
+   * @param begin The first sorted position of the range.
+   * @param end One past the last sorted position of the range.
+   * @param out The vector to append the pairs of box indices to, with the
+   * smaller index first.
+   */
+  void pairs(const std::size_t begin, const std::size_t end,
+             std::vector<std::pair<std::size_t, std::size_t>> &out) const {
+    const std::size_t n = this->m_order.size();
+    const double *sweepLower = &this->m_lower[this->m_axis * n];
+    for (std::size_t i = begin; i < end; i++) {
+      const double limit = this->m_upper[this->m_axis * n + i];
+      for (std::size_t j = i + 1; j < n && sweepLower[j] <= limit; j++) {
+        bool overlap = true;
+        for (std::size_t k = 0; k < dimensions; k++) {
+          overlap = overlap && this->m_lower[k * n + j] <=
+                                   this->m_upper[k * n + i] &&
+                    this->m_lower[k * n + i] <= this->m_upper[k * n + j];
+        }
+        if (overlap) {
+          const std::size_t a = this->m_order[i];
+          const std::size_t b = this->m_order[j];
+          out.push_back(a < b ? std::make_pair(a, b) : std::make_pair(b, a));
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Finds all pairs of overlapping boxes.
+   *
+   * @returns The pairs of box indices, with the smaller index first, in
+   * sorted order.
+   */
+  std::vector<std::pair<std::size_t, std::size_t>> pairs() const {
+    std::vector<std::pair<std::size_t, std::size_t>> result;
+    this->pairs(0, this->m_order.size(), result);
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+private:
+  std::size_t m_axis;               //!< Axis the boxes are sorted along.
+  std::vector<std::size_t> m_order; //!< Box indices in sorted order.
+  std::vector<double> m_lower;      //!< Sorted lower bounds per axis.
+  std::vector<double> m_upper;      //!< Sorted upper bounds per axis.
+};
+
+template <typename V> constexpr std::size_t BoxSweep<V>::dimensions;
+
+/**
+ * @brief Finds all pairs of overlapping boxes.
+ *
+ * @tparam V Point type of the box corners.
+ *
+ * @param lowers The corners of the boxes with the smallest coordinates.
+ * @param uppers The corners of the boxes with the largest coordinates.
+ *
+ * @returns The pairs of box indices, with the smaller index first, in sorted
+ * order.
+ */
+template <typename V>
+std::vector<std::pair<std::size_t, std::size_t>>
+overlappingBoxes(const std::vector<V> &lowers, const std::vector<V> &uppers) {
+  return BoxSweep<V>(lowers, uppers).pairs();
+}
+} // namespace svector
+
+#endif
@@ -0,0 +1,861 @@
+/**
+ * @file gjk.hpp
+ *
+ * @brief Distance, overlap and penetration depth of convex shapes.
+ *
+ * A convex shape is given by its support function: a callable that takes a
+ * svector::Vector3D direction and returns the point of the shape farthest in
+ * that direction, as any 3D vector type. svector::ConvexPointsShape and
+ * svector::SphereShape are provided; other shapes, such as moved or rotated
+ * ones, can be written as lambdas.
+ *
+ * The GJK algorithm finds the distance between two shapes, and the EPA
+ * algorithm finds how deep they overlap. Both keep a simplex of the
+ * Minkowski difference of the shapes, which can be passed back in on the
+ * next frame: when the shapes only moved a little, the old simplex is close
+ * to the answer and far fewer iterations are needed.
+ *
+ * This file is not included in vectors.hpp, so it has to be included
+ * separately.
+ *
+ * @copyright Copyright (c) 2023 Jonathan Liu. This project is released under
+ * the MIT License. All rights reserved.
+ */
+
+#ifndef INCLUDE_SVECTOR_GJK_HPP_
+#define INCLUDE_SVECTOR_GJK_HPP_
+
+#include <array>   // std::array
+#include <cmath>   // std::sqrt, std::abs
+#include <cstddef> // std::size_t
+#include <limits>  // std::numeric_limits
+#include <utility> // std::pair
+#include <vector>  // std::vector
+
+#include "simplevectors/core/traits.hpp"   // svector::VectorTraits
+#include "simplevectors/core/vector3d.hpp" // svector::Vector3D
+#include "simplevectors/functions.hpp"     // vector operators
+
+namespace svector {
+namespace detail {
+/** Maximum number of GJK iterations. */
+constexpr std::size_t GJK_MAX_ITERATIONS = 64;
+
+/** Maximum number of EPA iterations. */
+constexpr std::size_t EPA_MAX_ITERATIONS = 256;
+
+/** Relative tolerance of GJK and EPA. */
+constexpr double GJK_TOLERANCE = 1e-10;
+
+/**
+ * Converts a support point to a Vector3D.
+ */
+template <typename V> Vector3D gjkPoint(const V &point) {
+  static_assert(VectorTraits<V>::dimensions == 3,
+                "Support functions must return 3D vectors");
+
+  return Vector3D(static_cast<double>(point[0]),
+                  static_cast<double>(point[1]),
+                  static_cast<double>(point[2]));
+}
+} // namespace detail
+
+/**
+ * @brief Support function of the convex hull of a set of points.
+ *
+ * The points are not copied and must outlive the shape.
+ *
+ * @tparam V 3D point type.
+ */
+template <typename V> class ConvexPointsShape {
+public:
+  /**
+   * @brief Creates the shape.
+   *
+   * @param points The points, which must not be empty.
+   */
+  explicit ConvexPointsShape(const std::vector<V> &points)
+      : m_points(&points) {
+    static_assert(VectorTraits<V>::dimensions == 3,
+                  "ConvexPointsShape requires 3D vectors");
+  }
+
+  /**
+   * @brief The point farthest in a direction.
+   *
+   * @param direction The direction.
+   *
+   * @returns The point with the largest dot product with the direction.
+   */
+  Vector3D operator()(const Vector3D &direction) const {
+    const std::vector<V> &points = *this->m_points;
+    std::size_t best = 0;
+    double bestDot = direction.dot(detail::gjkPoint(points[0]));
+    for (std::size_t i = 1; i < points.size(); i++) {
+      const double d = direction.dot(detail::gjkPoint(points[i]));
+      if (d > bestDot) {
+        best = i;
+        bestDot = d;
+      }
+    }
+
+    return detail::gjkPoint(points[best]);
+  }
+
+private:
+  const std::vector<V> *m_points; //!< The points.
+};
+
+/**
+ * @brief Support function of a sphere.
+ */
+class SphereShape {
+public:
+  /**
+   * @brief Creates the shape.
+   *
+   * @param center The center of the sphere.
+   * @param radius The radius of the sphere.
+   */
+  SphereShape(const Vector3D &center, const double radius)
+      : m_center(center), m_radius(radius) {}
+
+  /**
+   * @brief The point farthest in a direction.
+   *
+   * @param direction The direction.
+   *
+   * @returns The point on the sphere in the direction from its center.
+   */
+  Vector3D operator()(const Vector3D &direction) const {
+    const double length = direction.magn();
+    if (length == 0) {
+      return this->m_center + Vector3D(this->m_radius, 0, 0);
+    }
+
+    return this->m_center + direction * (this->m_radius / length);
+  }
+
+private:
+  Vector3D m_center; //!< The center.
+  double m_radius;   //!< The radius.
+};
+
+/**
+ * @brief A simplex of the Minkowski difference A - B of two shapes.
+ *
+ * Start with an empty simplex and pass the same object to every query of the
+ * same pair of shapes to warm start the queries.
+ */
+struct GJKSimplex {
+  std::array<Vector3D, 4> w;   //!< Vertices, each a[i] - b[i].
+  std::array<Vector3D, 4> a;   //!< Support points of shape A.
+  std::array<Vector3D, 4> b;   //!< Support points of shape B.
+  std::array<Vector3D, 4> dir; //!< Directions the vertices were found in.
+  std::size_t size;            //!< Number of vertices in use.
+
+  /**
+   * @brief Creates an empty simplex.
+   */
+  GJKSimplex() : size(0) {}
+};
+
+/**
+ * @brief Result of a distance query.
+ */
+struct GJKResult {
+  bool overlap;           //!< Whether the shapes overlap or touch.
+  double distance;        //!< Distance between the shapes, 0 if overlapping.
+  Vector3D pointA;        //!< Closest point on shape A.
+  Vector3D pointB;        //!< Closest point on shape B.
+  std::size_t iterations; //!< Number of support evaluations used.
+};
+
+/**
+ * @brief Result of a penetration query.
+ */
+struct Penetration {
+  bool overlap;    //!< Whether the shapes overlap.
+  double depth;    //!< How far B has to move along the normal to separate.
+  Vector3D normal; //!< Unit direction from shape A towards shape B.
+  Vector3D pointA; //!< Deepest point of shape A inside B.
+  Vector3D pointB; //!< Deepest point of shape B inside A.
+};
+
+namespace detail {
+/**
+ * Closest point of a sub-simplex to the origin, with the vertices it uses
+ * and their barycentric weights.
+ */
+struct GJKClosest {
+  Vector3D point;
+  std::size_t count;
+  std::array<std::size_t, 4> index;
+  std::array<double, 4> weight;
+};
+
+/**
+ * Closest point on one vertex.
+ */
+inline GJKClosest gjkVertex(const GJKSimplex &simplex, const std::size_t i) {
+  GJKClosest result;
+  result.point = simplex.w[i];
+  result.count = 1;
+  result.index[0] = i;
+  result.weight[0] = 1;
+  return result;
+}
+
+/**
+ * Closest point on an edge, given t from vertex i to j.
+ */
+inline GJKClosest gjkEdge(const GJKSimplex &simplex, const std::size_t i,
+                          const std::size_t j, const double t) {
+  GJKClosest result;
+  result.point = simplex.w[i] + (simplex.w[j] - simplex.w[i]) * t;
+  result.count = 2;
+  result.index[0] = i;
+  result.index[1] = j;
+  result.weight[0] = 1 - t;
+  result.weight[1] = t;
+  return result;
+}
+
+/**
+ * Closest point on the segment between vertices i and j.
+ */
+inline GJKClosest gjkSegment(const GJKSimplex &simplex, const std::size_t i,
+                             const std::size_t j) {
+  const Vector3D ab = simplex.w[j] - simplex.w[i];
+  const double length = ab.dot(ab);
+  const double t = length > 0 ? -simplex.w[i].dot(ab) / length : 0;
+  if (t <= 0) {
+    return gjkVertex(simplex, i);
+  }
+  if (t >= 1) {
+    return gjkVertex(simplex, j);
+  }
+
+  return gjkEdge(simplex, i, j, t);
+}
+
+/**
+ * Closest point on the triangle of vertices i, j and k, using the Voronoi
+ * regions of its vertices and edges.
+ */
+inline GJKClosest gjkTriangle(const GJKSimplex &simplex, const std::size_t i,
+                              const std::size_t j, const std::size_t k) {
+  const Vector3D &a = simplex.w[i];
+  const Vector3D &b = simplex.w[j];
+  const Vector3D &c = simplex.w[k];
+  const Vector3D ab = b - a;
+  const Vector3D ac = c - a;
+
+  const double d1 = -ab.dot(a);
+  const double d2 = -ac.dot(a);
+  if (d1 <= 0 && d2 <= 0) {
+    return gjkVertex(simplex, i);
+  }
+
+  const double d3 = -ab.dot(b);
+  const double d4 = -ac.dot(b);
+  if (d3 >= 0 && d4 <= d3) {
+    return gjkVertex(simplex, j);
+  }
+
+  const double vc = d1 * d4 - d3 * d2;
+  if (vc <= 0 && d1 >= 0 && d3 <= 0) {
+    return gjkEdge(simplex, i, j, d1 / (d1 - d3));
+  }
+
+  const double d5 = -ab.dot(c);
+  const double d6 = -ac.dot(c);
+  if (d6 >= 0 && d5 <= d6) {
+    return gjkVertex(simplex, k);
+  }
+
+  const double vb = d5 * d2 - d1 * d6;
+  if (vb <= 0 && d2 >= 0 && d6 <= 0) {
+    return gjkEdge(simplex, i, k, d2 / (d2 - d6));
+  }
+
+  const double va = d3 * d6 - d5 * d4;
+  if (va <= 0 && d4 - d3 >= 0 && d5 - d6 >= 0) {
+    return gjkEdge(simplex, j, k, (d4 - d3) / ((d4 - d3) + (d5 - d6)));
+  }
+
+  const double sum = va + vb + vc;
+  if (!(sum > 0)) {
+    // degenerate triangle, so the closest point is on one of its edges
+    GJKClosest best = gjkSegment(simplex, i, j);
+    const GJKClosest other[] = {gjkSegment(simplex, i, k),
+                                gjkSegment(simplex, j, k)};
+    for (const GJKClosest &candidate : other) {
+      if (candidate.point.dot(candidate.point) < best.point.dot(best.point)) {
+        best = candidate;
+      }
+    }
+    return best;
+  }
+
+  GJKClosest result;
+  result.count = 3;
+  result.index[0] = i;
+  result.index[1] = j;
+  result.index[2] = k;
+  result.weight[0] = va / sum;
+  result.weight[1] = vb / sum;
+  result.weight[2] = vc / sum;
+  result.point = a * result.weight[0] + b * result.weight[1] +
+                 c * result.weight[2];
+  return result;
+}
+
+/**
+ * Closest point on the tetrahedron of all four vertices. A count of four
+ * means the origin is inside.
+ */
+inline GJKClosest gjkTetrahedron(const GJKSimplex &simplex) {
+  static const std::size_t faces[4][4] = {
+      {0, 1, 2, 3}, {0, 1, 3, 2}, {0, 2, 3, 1}, {1, 2, 3, 0}};
+
+  const Vector3D &a = simplex.w[0];
+  const double volume =
+      (simplex.w[1] - a).dot(cross(simplex.w[2] - a, simplex.w[3] - a));
+  const bool flat = std::abs(volume) <= 0;
+
+  GJKClosest best;
+  bool found = false;
+  for (const auto &face : faces) {
+    const Vector3D &p = simplex.w[face[0]];
+    const Vector3D normal =
+        cross(simplex.w[face[1]] - p, simplex.w[face[2]] - p);
+    const double origin = -normal.dot(p);
+    const double opposite = normal.dot(simplex.w[face[3]] - p);
+    if (!flat && origin * opposite >= 0) {
+      // the origin is on the same side of this face as the tetrahedron
+      continue;
+    }
+
+    const GJKClosest candidate =
+        gjkTriangle(simplex, face[0], face[1], face[2]);
+    if (!found ||
+        candidate.point.dot(candidate.point) < best.point.dot(best.point)) {
+      best = candidate;
+      found = true;
+    }
+  }
+
+  if (!found) {
+    best.point = Vector3D(0, 0, 0);
+    best.count = 4;
+    for (std::size_t i = 0; i < 4; i++) {
+      best.index[i] = i;
+      best.weight[i] = 0;
+    }
+  }
+
+  return best;
+}
+
+/**
+ * Shrinks the simplex to the vertices used by the closest point.
+ */
+inline void gjkKeep(GJKSimplex &simplex, const GJKClosest &closest) {
+  GJKSimplex kept;
+  for (std::size_t i = 0; i < closest.count; i++) {
+    const std::size_t from = closest.index[i];
+    kept.w[i] = simplex.w[from];
+    kept.a[i] = simplex.a[from];
+    kept.b[i] = simplex.b[from];
+    kept.dir[i] = simplex.dir[from];
+  }
+  kept.size = closest.count;
+  simplex = kept;
+}
+
+/**
+ * Closest point of the whole simplex to the origin.
+ */
+inline GJKClosest gjkClosest(const GJKSimplex &simplex) {
+  switch (simplex.size) {
+  case 1:
+    return gjkVertex(simplex, 0);
+  case 2:
+    return gjkSegment(simplex, 0, 1);
+  case 3:
+    return gjkTriangle(simplex, 0, 1, 2);
+  default:
+    return gjkTetrahedron(simplex);
+  }
+}
+
+/**
+ * Sets vertex i of the simplex to the support point in a direction.
+ */
+template <typename SA, typename SB>
+void gjkSupport(const SA &shapeA, const SB &shapeB, const Vector3D &direction,
+                GJKSimplex &simplex, const std::size_t i) {
+  simplex.a[i] = gjkPoint(shapeA(direction));
+  simplex.b[i] = gjkPoint(shapeB(-direction));
+  simplex.w[i] = simplex.a[i] - simplex.b[i];
+  simplex.dir[i] = direction;
+}
+} // namespace detail
+
+/**
+ * @brief Distance between two convex shapes, warm started from a simplex.
+ *
+ * The simplex of a previous query of the same shapes is refreshed by
+ * evaluating the support functions again in the directions it was found in.
+ * An empty simplex starts from scratch.
+ *
+ * @tparam SA Support function type of shape A.
+ * @tparam SB Support function type of shape B.
+ *
+ * @param shapeA The support function of shape A.
+ * @param shapeB The support function of shape B.
+ * @param simplex The simplex to start from, replaced by the final simplex.
+ *
+ * @returns The distance and closest points of the shapes.
+ */
+template <typename SA, typename SB>
+GJKResult gjkDistance(const SA &shapeA, const SB &shapeB,
+                      GJKSimplex &simplex) {
+  GJKResult result;
+  result.iterations = 0;
+
+  // refresh the old vertices, dropping any that became duplicates
+  std::size_t size = 0;
+  for (std::size_t i = 0; i < simplex.size; i++) {
+    detail::gjkSupport(shapeA, shapeB, simplex.dir[i], simplex, size);
+    result.iterations++;
+    bool duplicate = false;
+    for (std::size_t j = 0; j < size; j++) {
+      duplicate = duplicate || simplex.w[j] == simplex.w[size];
+    }
+    size += duplicate ? 0 : 1;
+  }
+  simplex.size = size;
+
+  if (simplex.size == 0) {
+    detail::gjkSupport(shapeA, shapeB, Vector3D(1, 0, 0), simplex, 0);
+    simplex.size = 1;
+    result.iterations++;
+  }
+
+  detail::GJKClosest closest;
+  while (true) {
+    closest = detail::gjkClosest(simplex);
+    detail::gjkKeep(simplex, closest);
+
+    const Vector3D &v = closest.point;
+    const double vv = v.dot(v);
+    double scale = 0;
+    for (std::size_t i = 0; i < simplex.size; i++) {
+      const double ww = simplex.w[i].dot(simplex.w[i]);
+      scale = ww > scale ? ww : scale;
+    }
+
+    if (simplex.size == 4 || vv <= detail::GJK_TOLERANCE * scale) {
+      result.overlap = true;
+      break;
+    }
+    if (result.iterations >= detail::GJK_MAX_ITERATIONS) {
+      result.overlap = false;
+      break;
+    }
+
+    const std::size_t next = simplex.size;
+    detail::gjkSupport(shapeA, shapeB, -v, simplex, next);
+    result.iterations++;
+
+    // stop when the new vertex brings v no closer to the origin
+    const Vector3D &w = simplex.w[next];
+    bool duplicate = false;
+    for (std::size_t i = 0; i < next; i++) {
+      duplicate = duplicate || simplex.w[i] == w;
+    }
+    if (duplicate || vv - v.dot(w) <= detail::GJK_TOLERANCE * vv) {
+      result.overlap = false;
+      break;
+    }
+
+    simplex.size++;
+  }
+
+  result.pointA = Vector3D(0, 0, 0);
+  result.pointB = Vector3D(0, 0, 0);
+  if (result.overlap) {
+    result.distance = 0;
+    if (simplex.size < 4) {
+      for (std::size_t i = 0; i < simplex.size; i++) {
+        result.pointA += simplex.a[i] * closest.weight[i];
+        result.pointB += simplex.b[i] * closest.weight[i];
+      }
+    }
+  } else {
+    result.distance = closest.point.magn();
+    for (std::size_t i = 0; i < simplex.size; i++) {
+      result.pointA += simplex.a[i] * closest.weight[i];
+      result.pointB += simplex.b[i] * closest.weight[i];
+    }
+  }
+
+  return result;
+}
+
+/**
+ * @brief Distance between two convex shapes.
+ *
+ * @tparam SA Support function type of shape A.
+ * @tparam SB Support function type of shape B.
+ *
+ * @param shapeA The support function of shape A.
+ * @param shapeB The support function of shape B.
+ *
+ * @returns The distance and closest points of the shapes.
+ */
+template <typename SA, typename SB>
+GJKResult gjkDistance(const SA &shapeA, const SB &shapeB) {
+  GJKSimplex simplex;
+  return gjkDistance(shapeA, shapeB, simplex);
+}
+
+/**
+ * @brief Whether two convex shapes overlap or touch, warm started from a
+ * simplex.
+ *
+ * @tparam SA Support function type of shape A.
+ * @tparam SB Support function type of shape B.
+ *
+ * @param shapeA The support function of shape A.
+ * @param shapeB The support function of shape B.
+ * @param simplex The simplex to start from, replaced by the final simplex.
+ *
+ * @returns Whether the shapes overlap.
+ */
+template <typename SA, typename SB>
+bool gjkOverlap(const SA &shapeA, const SB &shapeB, GJKSimplex &simplex) {
+  return gjkDistance(shapeA, shapeB, simplex).overlap;
+}
+
+/**
+ * @brief Whether two convex shapes overlap or touch.
+ *
+ * @tparam SA Support function type of shape A.
+ * @tparam SB Support function type of shape B.
+ *
+ * @param shapeA The support function of shape A.
+ * @param shapeB The support function of shape B.
+ *
+ * @returns Whether the shapes overlap.
+ */
+template <typename SA, typename SB>
+bool gjkOverlap(const SA &shapeA, const SB &shapeB) {
+  GJKSimplex simplex;
+  return gjkOverlap(shapeA, shapeB, simplex);
+}
+
+namespace detail {
+/** A face of the EPA polytope. */
+struct EPAFace {
+  std::size_t v[3];
+  Vector3D normal;
+  double distance;
+};
+
+/**
+ * Grows a simplex that contains the origin into a tetrahedron, returning
+ * false if the Minkowski difference is flat.
+ */
+template <typename SA, typename SB>
+bool epaTetrahedron(const SA &shapeA, const SB &shapeB, GJKSimplex &simplex) {
+  static const Vector3D axes[] = {Vector3D(1, 0, 0), Vector3D(-1, 0, 0),
+                                  Vector3D(0, 1, 0), Vector3D(0, -1, 0),
+                                  Vector3D(0, 0, 1), Vector3D(0, 0, -1)};
+
+  double scale = 0;
+  for (std::size_t i = 0; i < simplex.size; i++) {
+    const double ww = simplex.w[i].dot(simplex.w[i]);
+    scale = ww > scale ? ww : scale;
+  }
+  const double tiny = GJK_TOLERANCE * (scale > 0 ? scale : 1);
+
+  if (simplex.size == 1) {
+    for (const Vector3D &axis : axes) {
+      gjkSupport(shapeA, shapeB, axis, simplex, 1);
+      const Vector3D diff = simplex.w[1] - simplex.w[0];
+      if (diff.dot(diff) > tiny) {
+        simplex.size = 2;
+        break;
+      }
+    }
+  }
+
+  if (simplex.size == 2) {
+    const Vector3D u = simplex.w[1] - simplex.w[0];
+    std::size_t least = 0;
+    for (std::size_t i = 1; i < 3; i++) {
+      if (std::abs(u[i]) < std::abs(u[least])) {
+        least = i;
+      }
+    }
+    const Vector3D n1 = u.cross(axes[2 * least]);
+    const Vector3D n2 = u.cross(n1);
+    const Vector3D directions[] = {n1, -n1, n2, -n2};
+    for (const Vector3D &direction : directions) {
+      gjkSupport(shapeA, shapeB, direction, simplex, 2);
+      const Vector3D off = cross(simplex.w[2] - simplex.w[0], u);
+      if (off.dot(off) > tiny * u.dot(u)) {
+        simplex.size = 3;
+        break;
+      }
+    }
+  }
+
+  if (simplex.size == 3) {
+    const Vector3D n =
+        cross(simplex.w[1] - simplex.w[0], simplex.w[2] - simplex.w[0]);
+    const Vector3D directions[] = {n, -n};
+    for (const Vector3D &direction : directions) {
+      gjkSupport(shapeA, shapeB, direction, simplex, 3);
+      const double off = (simplex.w[3] - simplex.w[0]).dot(n);
+      if (off * off > tiny * n.dot(n)) {
+        simplex.size = 4;
+        break;
+      }
+    }
+  }
+
+  return simplex.size == 4;
+}
+
+/**
+ * Whether two faces of the polytope share an edge.
+ */
+inline bool epaAdjacent(const EPAFace &lhs, const EPAFace &rhs) {
+  std::size_t shared = 0;
+  for (std::size_t i = 0; i < 3; i++) {
+    for (std::size_t j = 0; j < 3; j++) {
+      shared += lhs.v[i] == rhs.v[j] ? 1 : 0;
+    }
+  }
+  return shared >= 2;
+}
+
+/**
+ * Makes a face of the polytope with its normal pointing away from an
+ * interior point.
+ */
+inline EPAFace epaFace(const std::vector<Vector3D> &w, std::size_t i,
+                       std::size_t j, std::size_t k, const Vector3D &inside) {
+  Vector3D normal = cross(w[j] - w[i], w[k] - w[i]);
+  if (normal.dot(w[i] - inside) < 0) {
+    normal = -normal;
+    const std::size_t temp = j;
+    j = k;
+    k = temp;
+  }
+
+  const double length = normal.magn();
+  EPAFace face;
+  face.v[0] = i;
+  face.v[1] = j;
+  face.v[2] = k;
+  face.normal = length > 0 ? normal / length : Vector3D(0, 0, 0);
+
+  // a face without area is never the closest one
+  face.distance = length > 0 ? face.normal.dot(w[i])
+                             : std::numeric_limits<double>::infinity();
+  return face;
+}
+
+/**
+ * Index of the face of the polytope closest to the origin.
+ */
+inline std::size_t epaClosest(const std::vector<EPAFace> &faces) {
+  std::size_t closest = 0;
+  for (std::size_t i = 1; i < faces.size(); i++) {
+    if (faces[i].distance < faces[closest].distance) {
+      closest = i;
+    }
+  }
+  return closest;
+}
+} // namespace detail
+
+/**
+ * @brief Penetration depth of two convex shapes, warm started from a
+ * simplex.
+ *
+ * Runs GJK first, then, if the shapes overlap, EPA expands the GJK simplex
+ * towards the boundary of the Minkowski difference closest to the origin.
+ *
+ * @tparam SA Support function type of shape A.
+ * @tparam SB Support function type of shape B.
+ *
+ * @param shapeA The support function of shape A.
+ * @param shapeB The support function of shape B.
+ * @param simplex The simplex to start from, replaced by the final GJK
+ * simplex.
+ *
+ * @returns The penetration depth and normal. If the shapes do not overlap,
+ * the depth is 0, the points are the closest points and the normal points
+ * from the closest point of A to that of B.
+ */
+template <typename SA, typename SB>
+Penetration epaPenetration(const SA &shapeA, const SB &shapeB,
+                           GJKSimplex &simplex) {
+  const GJKResult gjk = gjkDistance(shapeA, shapeB, simplex);
+
+  Penetration result;
+  result.overlap = gjk.overlap;
+  result.depth = 0;
+  result.pointA = gjk.pointA;
+  result.pointB = gjk.pointB;
+  result.normal = Vector3D(0, 0, 0);
+  if (!gjk.overlap) {
+    result.normal = (gjk.pointB - gjk.pointA) / gjk.distance;
+    return result;
+  }
+
+  GJKSimplex start = simplex;
+  if (!detail::epaTetrahedron(shapeA, shapeB, start)) {
+    // the shapes are flat and only touch
+    return result;
+  }
+
+  std::vector<Vector3D> w(start.w.begin(), start.w.end());
+  std::vector<Vector3D> a(start.a.begin(), start.a.end());
+  std::vector<Vector3D> b(start.b.begin(), start.b.end());
+  const Vector3D inside = (w[0] + w[1] + w[2] + w[3]) / 4.0;
+
+  std::vector<detail::EPAFace> faces{detail::epaFace(w, 0, 1, 2, inside),
+                                     detail::epaFace(w, 0, 1, 3, inside),
+                                     detail::epaFace(w, 0, 2, 3, inside),
+                                     detail::epaFace(w, 1, 2, 3, inside)};
+  std::vector<std::pair<std::size_t, std::size_t>> horizon;
+  std::vector<bool> visible;
+  std::vector<std::size_t> stack;
+
+  for (std::size_t iteration = 0; iteration < detail::EPA_MAX_ITERATIONS;
+       iteration++) {
+    const std::size_t closest = detail::epaClosest(faces);
+    const Vector3D normal = faces[closest].normal;
+    const Vector3D newA = detail::gjkPoint(shapeA(normal));
+    const Vector3D newB = detail::gjkPoint(shapeB(-normal));
+    const Vector3D newW = newA - newB;
+    const double distance = normal.dot(newW);
+    const double tolerance = detail::GJK_TOLERANCE * (1 + distance);
+    bool duplicate = false;
+    for (const Vector3D &vertex : w) {
+      duplicate = duplicate || vertex == newW;
+    }
+    if (duplicate || distance - faces[closest].distance <= tolerance) {
+      break;
+    }
+
+    // remove the faces that see the new vertex, grown from the closest face
+    // so that the removed region stays connected, and collect its outline
+    visible.assign(faces.size(), false);
+    visible[closest] = true;
+    stack.assign(1, closest);
+    while (!stack.empty()) {
+      const std::size_t current = stack.back();
+      stack.pop_back();
+      for (std::size_t i = 0; i < faces.size(); i++) {
+        if (!visible[i] && detail::epaAdjacent(faces[current], faces[i]) &&
+            faces[i].normal.dot(newW - w[faces[i].v[0]]) > 0) {
+          visible[i] = true;
+          stack.push_back(i);
+        }
+      }
+    }
+
+    horizon.clear();
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < faces.size(); i++) {
+      const detail::EPAFace face = faces[i];
+      if (!visible[i]) {
+        faces[kept++] = face;
+        continue;
+      }
+
+      for (std::size_t e = 0; e < 3; e++) {
+        const std::size_t from = face.v[e];
+        const std::size_t to = face.v[(e + 1) % 3];
+        bool shared = false;
+        for (std::size_t h = 0; h < horizon.size(); h++) {
+          if (horizon[h].first == to && horizon[h].second == from) {
+            horizon[h] = horizon.back();
+            horizon.pop_back();
+            shared = true;
+            break;
+          }
+        }
+        if (!shared) {
+          horizon.push_back(std::make_pair(from, to));
+        }
+      }
+    }
+    faces.resize(kept);
+
+    const std::size_t index = w.size();
+    w.push_back(newW);
+    a.push_back(newA);
+    b.push_back(newB);
+    for (const auto &edge : horizon) {
+      faces.push_back(
+          detail::epaFace(w, edge.first, edge.second, index, inside));
+    }
+  }
+
+  // the faces change after the closest one is picked, so when the iteration
+  // limit is reached it has to be picked again
+  const detail::EPAFace &face = faces[detail::epaClosest(faces)];
+
+  // barycentric coordinates of the origin's projection on the closest face
+  const Vector3D point = face.normal * face.distance;
+  const Vector3D v0 = w[face.v[1]] - w[face.v[0]];
+  const Vector3D v1 = w[face.v[2]] - w[face.v[0]];
+  const Vector3D v2 = point - w[face.v[0]];
+  const double d00 = v0.dot(v0);
+  const double d01 = v0.dot(v1);
+  const double d11 = v1.dot(v1);
+  const double d20 = v2.dot(v0);
+  const double d21 = v2.dot(v1);
+  const double denom = d00 * d11 - d01 * d01;
+  const double u = denom > 0 ? (d11 * d20 - d01 * d21) / denom : 0;
+  const double v = denom > 0 ? (d00 * d21 - d01 * d20) / denom : 0;
+
+  result.depth = face.distance;
+  result.normal = face.normal;
+  result.pointA = a[face.v[0]] * (1 - u - v) + a[face.v[1]] * u +
+                  a[face.v[2]] * v;
+  result.pointB = b[face.v[0]] * (1 - u - v) + b[face.v[1]] * u +
+                  b[face.v[2]] * v;
+  return result;
+}
+
+/**
+ * @brief Penetration depth of two convex shapes.
+ *
+ * @tparam SA Support function type of shape A.
+ * @tparam SB Support function type of shape B.
+ *
+ * @param shapeA The support function of shape A.
+ * @param shapeB The support function of shape B.
+ *
+ * @returns The penetration depth and normal. If the shapes do not overlap,
+ * the depth is 0, the points are the closest points and the normal points
+ * from the closest point of A to that of B.
+ */
+template <typename SA, typename SB>
+Penetration epaPenetration(const SA &shapeA, const SB &shapeB) {
+  GJKSimplex simplex;
+  return epaPenetration(shapeA, shapeB, simplex);
+}
+} // namespace svector
+
+#endif
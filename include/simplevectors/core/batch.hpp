@@ -0,0 +1,44 @@
+/**
+ * @file batch.hpp
+ *
+ * @brief Helpers shared by the batch kernels.
+ *
+ * The batch kernels process their input in chunks: a loop without branches
+ * computes a flag for every element of the chunk, which the compiler can
+ * vectorize, and a second loop then packs the indices of the flagged
+ * elements into the output. The chunk size and the packing loop are defined
+ * here so that every module uses the same ones.
+ *
+ * @copyright Copyright (c) 2023 Jonathan Liu. This project is released under
+ * the MIT License. All rights reserved.
+ */
+
+#ifndef INCLUDE_SVECTOR_BATCH_HPP_
+#define INCLUDE_SVECTOR_BATCH_HPP_
+
+#include <cstddef> // std::size_t
+
+namespace svector {
+namespace detail {
+/**
+ * Number of elements processed together by the batch kernels. The flags of
+ * a chunk of doubles fit in the L1 cache with room to spare.
+ */
+constexpr std::size_t BATCH_CHUNK = 256;
+
+/**
+ * Appends start + i for every set flag, without branches.
+ */
+inline std::size_t batchCompact(const double *flags, const std::size_t m,
+                                const std::size_t start, std::size_t *out,
+                                std::size_t count) {
+  for (std::size_t i = 0; i < m; i++) {
+    out[count] = start + i;
+    count += flags[i] != 0 ? 1 : 0;
+  }
+  return count;
+}
+} // namespace detail
+} // namespace svector
+
+#endif
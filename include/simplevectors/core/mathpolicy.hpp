@@ -0,0 +1,584 @@
+/**
+ * @file mathpolicy.hpp
+ *
+ * @brief Math policies for the magnitudes, unit vectors and angles of
+ * vectors.
+ *
+ * A math policy is a class with static functions for square roots,
+ * reciprocal square roots and trigonometry. The methods and functions that
+ * compute magnitudes, normalize vectors, rotate vectors and compute angles
+ * take a policy in their last template argument, which defaults to
+ * SVECTOR_MATH_POLICY. svector::ExactMath gives the results of the standard
+ * library, svector::FastMath trades a few units in the last place for no
+ * divisions or square roots in normalization and svector::ApproxMath trades
+ * about 1e-5 relative error for cheap approximations.
+ *
+ * To change the policy of every call, define SVECTOR_MATH_POLICY before
+ * including the library, for example as svector::FastMath. It has to be the
+ * same in every translation unit.
+ *
+ * @copyright Copyright (c) 2023 Jonathan Liu. This project is released under
+ * the MIT License. All rights reserved.
+ */
+
+#ifndef INCLUDE_SVECTOR_MATHPOLICY_HPP_
+#define INCLUDE_SVECTOR_MATHPOLICY_HPP_
+
+#include <cmath>   // std::sqrt, std::sin, std::cos, std::atan2, std::acos
+#include <cstdint> // std::uint32_t, std::uint64_t
+#include <cstring> // std::memcpy
+
+namespace svector {
+// COMBINER_PY_START
+/**
+ * @brief The accuracy of an angle kernel.
+ */
+enum AngleAccuracy {
+  ANGLE_EXACT,   //!< The functions of the standard library.
+  ANGLE_PRECISE, //!< Polynomials within about 1e-15 radians.
+  ANGLE_FAST     //!< Polynomials within about 1e-4 radians.
+};
+
+namespace detail {
+constexpr double ANGLE_PI = 3.14159265358979323846;
+constexpr double ANGLE_PI_2 = 1.57079632679489661923;
+constexpr double ANGLE_PI_4 = 0.78539816339744830962;
+constexpr double ANGLE_2PI = 6.28318530717958647693;
+constexpr double ANGLE_INV_2PI = 0.15915494309189533577;
+constexpr double ANGLE_2_PI = 0.63661977236758134308;
+//! Angles beyond this are reduced by the standard library.
+constexpr double PRECISE_REDUCTION_LIMIT = 1e6;
+
+/**
+ * The arctangent of a in [0, 1], with the rational approximation of Cephes.
+ */
+inline double preciseAtan(const double a) {
+  // atan(a) = atan(1/2) + atan(t) with t in [-1/2, 1/3], which avoids
+  // choosing between ranges
+  const double t = (a - 0.5) / (1 + 0.5 * a);
+  const double z = t * t;
+  const double p =
+      (((-8.750608600031904122785e-1 * z - 1.615753718733365076637e1) * z -
+        7.500855792314704667340e1) *
+           z -
+       1.228866684490136173410e2) *
+          z -
+      6.485021904942025371773e1;
+  const double q =
+      ((((z + 2.485846490142306297962e1) * z + 1.650270098316988542046e2) *
+            z +
+        4.328810604912902668951e2) *
+           z +
+       4.853903996359136964868e2) *
+          z +
+      1.945506571482613964425e2;
+  return 0.4636476090008061 + (t * z * p / q + t + 2.2698777452961687e-17);
+}
+
+/**
+ * The arctangent of a in [0, 1], with a polynomial of degree 9.
+ */
+inline double fastAtan(const double a) {
+  const double z = a * a;
+  return a * (0.99986660 +
+              z * (-0.33029950 +
+                   z * (0.18014100 + z * (-0.08513300 + z * 0.02083510))));
+}
+
+/**
+ * The reciprocal square root of a positive double, from an estimate made
+ * from its bits and two Newton steps, within about 5e-6 relative error.
+ */
+inline double approxRsqrt(const double x) {
+  std::uint64_t bits;
+  std::memcpy(&bits, &x, sizeof(bits));
+  bits = 0x5FE6EB50C7B537A9ULL - (bits >> 1);
+  double y;
+  std::memcpy(&y, &bits, sizeof(y));
+  y = y * (1.5 - 0.5 * x * y * y);
+  return y * (1.5 - 0.5 * x * y * y);
+}
+
+/**
+ * The reciprocal square root of a positive float, from an estimate made
+ * from its bits and two Newton steps, within about 5e-6 relative error.
+ */
+inline float approxRsqrt(const float x) {
+  std::uint32_t bits;
+  std::memcpy(&bits, &x, sizeof(bits));
+  bits = 0x5F375A86U - (bits >> 1);
+  float y;
+  std::memcpy(&y, &bits, sizeof(y));
+  y = y * (1.5F - 0.5F * x * y * y);
+  return y * (1.5F - 0.5F * x * y * y);
+}
+
+/**
+ * The reciprocal square root of a positive normal double, from
+ * approxRsqrt() and two more Newton steps, the last of which corrects with
+ * the residual so that the result is within one unit in the last place.
+ */
+inline double refinedRsqrt(const double x) {
+  double y = approxRsqrt(x);
+  y = y * (1.5 - 0.5 * x * y * y);
+  return y + 0.5 * y * (1 - x * y * y);
+}
+
+/**
+ * The reciprocal square root of a positive normal float, from approxRsqrt()
+ * and a Newton step that corrects with the residual, within one unit in the
+ * last place.
+ */
+inline float refinedRsqrt(const float x) {
+  const float y = approxRsqrt(x);
+  return y + 0.5F * y * (1 - x * y * y);
+}
+
+/**
+ * Reduces an angle to [-π, π]. Precision is lost for very large angles.
+ */
+inline double reduceAngle(const double ang) {
+  return ang - ANGLE_2PI * std::floor(ang * ANGLE_INV_2PI + 0.5);
+}
+
+/**
+ * The sine of r in [-π/2, π/2] with a Taylor polynomial of degree 11.
+ */
+inline double sinPolynomial(const double r) {
+  const double z = r * r;
+  return r *
+         (1 + z * (-1.0 / 6 +
+                   z * (1.0 / 120 +
+                        z * (-1.0 / 5040 +
+                             z * (1.0 / 362880 + z * (-1.0 / 39916800))))));
+}
+
+/**
+ * The cosine of r in [-π/2, π/2] with a Taylor polynomial of degree 12.
+ */
+inline double cosPolynomial(const double r) {
+  const double z = r * r;
+  return 1 +
+         z * (-1.0 / 2 +
+              z * (1.0 / 24 +
+                   z * (-1.0 / 720 +
+                        z * (1.0 / 40320 +
+                             z * (-1.0 / 3628800 + z * (1.0 / 479001600))))));
+}
+
+/**
+ * The sine, within about 1e-7.
+ */
+inline double approxSin(const double ang) {
+  // sin(r) = ±cos(π/2 - |r|), which keeps the polynomial in [-π/2, π/2]
+  const double r = reduceAngle(ang);
+  return std::copysign(cosPolynomial(ANGLE_PI_2 - std::abs(r)), r);
+}
+
+/**
+ * The cosine, within about 1e-7.
+ */
+inline double approxCos(const double ang) {
+  // cos(r) = sin(π/2 - |r|)
+  return sinPolynomial(ANGLE_PI_2 - std::abs(reduceAngle(ang)));
+}
+
+/**
+ * The sine and cosine with the polynomials of Cephes. The angle is reduced
+ * by the nearest multiple of π/2 in three parts, and the quadrant selects
+ * and negates the results with arithmetic, so loops have no branches other
+ * than the one for angles beyond PRECISE_REDUCTION_LIMIT.
+ */
+inline void preciseSinCos(const double ang, double &sine, double &cosine) {
+  // the reduction loses accuracy for larger angles (and NaNs end up here)
+  if (!(std::abs(ang) <= PRECISE_REDUCTION_LIMIT)) {
+    sine = std::sin(ang);
+    cosine = std::cos(ang);
+    return;
+  }
+
+  const double kd = std::floor(ang * ANGLE_2_PI + 0.5);
+  const double r = ((ang - kd * 1.57079625129699707031) -
+                    kd * 7.54978941586159635336e-8) -
+                   kd * 5.39030285815811905290e-15;
+  const double z = r * r;
+  const double s =
+      r + r * z *
+              (((((1.58962301576546568060e-10 * z -
+                   2.50507477628578072866e-8) *
+                      z +
+                  2.75573136213857245213e-6) *
+                     z -
+                 1.98412698295895385996e-4) *
+                    z +
+                8.33333333332211858878e-3) *
+                   z -
+               1.66666666666666307295e-1);
+  const double c =
+      1 - 0.5 * z +
+      z * z *
+          (((((-1.13585365213876817300e-11 * z + 2.08757008419747316778e-9) *
+                  z -
+              2.75573141792967388112e-7) *
+                 z +
+             2.48015872888517045348e-5) *
+                z -
+            1.38888888888730564116e-3) *
+               z +
+           4.16666666666665929218e-2);
+
+  // odd quadrants swap sine and cosine, and the quadrant sets the signs
+  const double quadrant = kd - 4 * std::floor(kd * 0.25);
+  const double odd = std::fmod(quadrant, 2);
+  const double sineSign = 1 - 2 * std::floor(quadrant * 0.5);
+  const double cosineSign =
+      1 - 2 * std::floor(std::fmod(quadrant + 1, 4) * 0.5);
+  sine = sineSign * (odd * c + (1 - odd) * s);
+  cosine = cosineSign * (odd * s + (1 - odd) * c);
+}
+} // namespace detail
+
+/**
+ * @brief Computes the arctangent of y / x in the right quadrant.
+ *
+ * The angle will be in the range [-π, π] like std::atan2(), and is 0 when
+ * both arguments are 0.
+ *
+ * @tparam A The accuracy.
+ *
+ * @param y The y-coordinate.
+ * @param x The x-coordinate.
+ *
+ * @returns The angle of (x, y) in radians.
+ */
+template <AngleAccuracy A = ANGLE_EXACT>
+inline double arctan2(const double y, const double x) {
+  if (A == ANGLE_EXACT) {
+    return std::atan2(y, x);
+  }
+
+  const double ax = std::abs(x);
+  const double ay = std::abs(y);
+  // the selections are arithmetic, so that loops have no branches
+  const double swapped = static_cast<double>(ay > ax);
+  const double larger = swapped * ay + (1 - swapped) * ax;
+  const double smaller = swapped * ax + (1 - swapped) * ay;
+  const double a = smaller / (larger + static_cast<double>(larger == 0));
+  double result = A == ANGLE_PRECISE ? detail::preciseAtan(a)
+                                     : detail::fastAtan(a);
+
+  // π/2 - result when |y| > |x|, and π - result when x < 0
+  result = detail::ANGLE_PI_4 - std::copysign(detail::ANGLE_PI_4 - result,
+                                              ax - ay);
+  result = detail::ANGLE_PI_2 - std::copysign(detail::ANGLE_PI_2 - result, x);
+  return std::copysign(result, y);
+}
+
+/**
+ * @brief Computes the arccosine.
+ *
+ * @tparam A The accuracy.
+ *
+ * @param x The cosine, in [-1, 1].
+ *
+ * @returns The angle in radians, in the range [0, π].
+ */
+template <AngleAccuracy A = ANGLE_EXACT> inline double arccos(const double x) {
+  if (A == ANGLE_EXACT) {
+    return std::acos(x);
+  }
+  if (A == ANGLE_PRECISE) {
+    // the sine is computed without cancellation near ±1, and cosines that
+    // are rounded past ±1 give 0 or π
+    const double sine2 = (1 - x) * (1 + x);
+    return arctan2<ANGLE_PRECISE>(std::sqrt(0.5 * (sine2 + std::abs(sine2))),
+                                  x);
+  }
+
+  // Abramowitz and Stegun 4.4.45
+  const double ax = std::abs(x);
+  const double rest = 1 - ax;
+  const double result =
+      std::sqrt(0.5 * (rest + std::abs(rest))) *
+      (1.5707288 + ax * (-0.2121144 + ax * (0.0742610 - 0.0187293 * ax)));
+  // π - result for negative cosines
+  return detail::ANGLE_PI_2 - std::copysign(detail::ANGLE_PI_2 - result, x);
+}
+
+/**
+ * @brief Computes the sine and cosine of an angle.
+ *
+ * The precise kernel is within about 1e-15 of the standard library, which
+ * it calls for angles beyond 1e6 radians in magnitude. The fast kernel is
+ * within about 1e-7.
+ *
+ * @tparam A The accuracy.
+ *
+ * @param ang The angle in radians.
+ * @param sine The sine of the angle.
+ * @param cosine The cosine of the angle.
+ */
+template <AngleAccuracy A = ANGLE_EXACT>
+inline void sinCos(const double ang, double &sine, double &cosine) {
+  if (A == ANGLE_EXACT) {
+    sine = std::sin(ang);
+    cosine = std::cos(ang);
+  } else if (A == ANGLE_PRECISE) {
+    detail::preciseSinCos(ang, sine, cosine);
+  } else {
+    sine = detail::approxSin(ang);
+    cosine = detail::approxCos(ang);
+  }
+}
+
+/**
+ * @brief The functions of the standard library.
+ *
+ * Vectors are normalized by dividing by their magnitude, so the results are
+ * the same as without a policy.
+ */
+struct ExactMath {
+  /**
+   * @brief Computes a square root.
+   *
+   * @param x A non-negative number.
+   *
+   * @returns The square root of x.
+   */
+  template <typename T> static T sqrt(const T x) { return std::sqrt(x); }
+
+  /**
+   * @brief Computes a reciprocal square root.
+   *
+   * @param x A positive number.
+   *
+   * @returns 1 divided by the square root of x.
+   */
+  template <typename T> static T rsqrt(const T x) { return 1 / std::sqrt(x); }
+
+  /**
+   * @brief Computes a sine.
+   *
+   * @param ang An angle in radians.
+   *
+   * @returns The sine of the angle.
+   */
+  static double sin(const double ang) { return std::sin(ang); }
+
+  /**
+   * @brief Computes a cosine.
+   *
+   * @param ang An angle in radians.
+   *
+   * @returns The cosine of the angle.
+   */
+  static double cos(const double ang) { return std::cos(ang); }
+
+  /**
+   * @brief Computes the arctangent of y / x in the right quadrant.
+   *
+   * @param y The y-coordinate.
+   * @param x The x-coordinate.
+   *
+   * @returns The angle of (x, y) in radians.
+   */
+  static double atan2(const double y, const double x) {
+    return arctan2<ANGLE_EXACT>(y, x);
+  }
+
+  /**
+   * @brief Computes an arccosine.
+   *
+   * @param x A cosine, in [-1, 1].
+   *
+   * @returns The angle in radians, in the range [0, π].
+   */
+  static double acos(const double x) { return arccos<ANGLE_EXACT>(x); }
+};
+
+/**
+ * @brief Reciprocal square roots and polynomial angles.
+ *
+ * Vectors are normalized by multiplying by the reciprocal of their
+ * magnitude. Reciprocal square roots of floating point numbers are estimated
+ * from their bits and refined with Newton steps to within one unit in the
+ * last place, without a division or a square root, so that loops vectorize
+ * to cheap multiplications. Angles are computed with the
+ * svector::ANGLE_PRECISE kernels. Results are within a few units in the last
+ * place of svector::ExactMath when the squared magnitudes are normal numbers;
+ * zero vectors normalize to zero vectors instead of NaN, and vectors shorter
+ * than about 1e-154 are not normalized accurately.
+ */
+struct FastMath {
+  /**
+   * @brief Computes a square root.
+   *
+   * @param x A non-negative number.
+   *
+   * @returns The square root of x.
+   */
+  template <typename T> static T sqrt(const T x) { return std::sqrt(x); }
+
+  /**
+   * @brief Computes a reciprocal square root.
+   *
+   * @param x A positive number.
+   *
+   * @returns 1 divided by the square root of x.
+   */
+  template <typename T> static T rsqrt(const T x) { return 1 / std::sqrt(x); }
+
+  /**
+   * @brief Computes a reciprocal square root.
+   *
+   * @param x A positive normal number.
+   *
+   * @returns 1 divided by the square root of x.
+   */
+  static double rsqrt(const double x) { return detail::refinedRsqrt(x); }
+
+  /**
+   * @brief Computes a reciprocal square root.
+   *
+   * @param x A positive normal number.
+   *
+   * @returns 1 divided by the square root of x.
+   */
+  static float rsqrt(const float x) { return detail::refinedRsqrt(x); }
+
+  /**
+   * @brief Computes a sine.
+   *
+   * @param ang An angle in radians.
+   *
+   * @returns The sine of the angle.
+   */
+  static double sin(const double ang) { return std::sin(ang); }
+
+  /**
+   * @brief Computes a cosine.
+   *
+   * @param ang An angle in radians.
+   *
+   * @returns The cosine of the angle.
+   */
+  static double cos(const double ang) { return std::cos(ang); }
+
+  /**
+   * @brief Computes the arctangent of y / x in the right quadrant.
+   *
+   * @param y The y-coordinate.
+   * @param x The x-coordinate.
+   *
+   * @returns The angle of (x, y) in radians.
+   */
+  static double atan2(const double y, const double x) {
+    return arctan2<ANGLE_PRECISE>(y, x);
+  }
+
+  /**
+   * @brief Computes an arccosine.
+   *
+   * @param x A cosine, in [-1, 1].
+   *
+   * @returns The angle in radians, in the range [0, π].
+   */
+  static double acos(const double x) { return arccos<ANGLE_PRECISE>(x); }
+};
+
+/**
+ * @brief Approximations for games and graphics.
+ *
+ * Reciprocal square roots of floating point numbers are estimated from their
+ * bits and refined with two Newton steps, within about 5e-6 relative error.
+ * Sines and cosines are polynomials within about 1e-7, and angles are
+ * computed with the svector::ANGLE_FAST kernels. The arguments must be
+ * finite.
+ */
+struct ApproxMath {
+  /**
+   * @brief Computes a square root.
+   *
+   * @param x A non-negative number.
+   *
+   * @returns The square root of x.
+   */
+  template <typename T> static T sqrt(const T x) { return x * rsqrt(x); }
+
+  /**
+   * @brief Computes a reciprocal square root.
+   *
+   * @param x A positive number.
+   *
+   * @returns 1 divided by the square root of x.
+   */
+  template <typename T> static T rsqrt(const T x) { return 1 / std::sqrt(x); }
+
+  /**
+   * @brief Computes a reciprocal square root.
+   *
+   * @param x A positive number.
+   *
+   * @returns 1 divided by the square root of x.
+   */
+  static double rsqrt(const double x) { return detail::approxRsqrt(x); }
+
+  /**
+   * @brief Computes a reciprocal square root.
+   *
+   * @param x A positive number.
+   *
+   * @returns 1 divided by the square root of x.
+   */
+  static float rsqrt(const float x) { return detail::approxRsqrt(x); }
+
+  /**
+   * @brief Computes a sine.
+   *
+   * @param ang An angle in radians.
+   *
+   * @returns The sine of the angle.
+   */
+  static double sin(const double ang) { return detail::approxSin(ang); }
+
+  /**
+   * @brief Computes a cosine.
+   *
+   * @param ang An angle in radians.
+   *
+   * @returns The cosine of the angle.
+   */
+  static double cos(const double ang) { return detail::approxCos(ang); }
+
+  /**
+   * @brief Computes the arctangent of y / x in the right quadrant.
+   *
+   * @param y The y-coordinate.
+   * @param x The x-coordinate.
+   *
+   * @returns The angle of (x, y) in radians.
+   */
+  static double atan2(const double y, const double x) {
+    return arctan2<ANGLE_FAST>(y, x);
+  }
+
+  /**
+   * @brief Computes an arccosine.
+   *
+   * @param x A cosine, in [-1, 1].
+   *
+   * @returns The angle in radians, in the range [0, π].
+   */
+  static double acos(const double x) { return arccos<ANGLE_FAST>(x); }
+};
+
+#ifndef SVECTOR_MATH_POLICY
+/**
+ * @brief The default math policy.
+ */
+#define SVECTOR_MATH_POLICY svector::ExactMath
+#endif
+// COMBINER_PY_END
+} // namespace svector
+
+#endif
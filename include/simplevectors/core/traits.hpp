@@ -0,0 +1,57 @@
+/**
+ * @file traits.hpp
+ *
+ * @brief Type traits for vector classes.
+ *
+ * These are used by the modules outside of the core library so that their
+ * functions accept svector::Vector and any class derived from it (such as
+ * svector::Vector2D and svector::Vector3D).
+ *
+ * @copyright Copyright (c) 2023 Jonathan Liu. This project is released under
+ * the MIT License. All rights reserved.
+ */
+
+#ifndef INCLUDE_SVECTOR_TRAITS_HPP_
+#define INCLUDE_SVECTOR_TRAITS_HPP_
+
+#include <cstddef>     // std::size_t
+#include <type_traits> // std::integral_constant
+
+#include "simplevectors/core/vector.hpp" // svector::Vector
+
+namespace svector {
+namespace detail {
+/**
+ * Deduces the number of dimensions from a pointer to svector::Vector or to a
+ * class derived from it. Only used in unevaluated contexts.
+ */
+template <std::size_t D, typename T>
+std::integral_constant<std::size_t, D> vectorDimensions(const Vector<D, T> *);
+
+/**
+ * Deduces the component type from a pointer to svector::Vector or to a class
+ * derived from it. Only used in unevaluated contexts.
+ */
+template <std::size_t D, typename T> T vectorValue(const Vector<D, T> *);
+} // namespace detail
+
+/**
+ * @brief Dimensions and component type of a vector class.
+ *
+ * @tparam V svector::Vector or a class derived from it.
+ */
+template <typename V> struct VectorTraits {
+  /**
+   * @brief The number of dimensions of V.
+   */
+  static constexpr std::size_t dimensions = decltype(
+      detail::vectorDimensions(static_cast<const V *>(nullptr)))::value;
+
+  typedef decltype(detail::vectorValue(static_cast<const V *>(nullptr)))
+      value_type; //!< The component type of V.
+};
+
+template <typename V> constexpr std::size_t VectorTraits<V>::dimensions;
+} // namespace svector
+
+#endif
@@ -17,7 +17,9 @@
 #include <cstdint>          // std::int8_t
 #include <initializer_list> // std::initializer_list
 #include <string>           // std::string, std::to_string
-#include <type_traits>      // std::is_arithmetic
+#include <type_traits>      // std::is_arithmetic, std::is_same
+
+#include "simplevectors/core/mathpolicy.hpp" // SVECTOR_MATH_POLICY
 
 namespace svector {
 // COMBINER_PY_START
@@ -421,17 +423,75 @@ public:
    *
    * Gets the magnitude of the vector.
    *
+   * @tparam P The math policy, see svector::ExactMath.
+   *
    * @returns The magnitude of the vector.
    */
-  T magn() const {
+  template <typename P = SVECTOR_MATH_POLICY> T magn() const {
+    T sum_of_squares = 0;
+
+    for (const auto &i : this->m_components) {
+      sum_of_squares += i * i;
+    }
+
+    return P::sqrt(sum_of_squares);
+  }
+
+  /**
+   * @brief Squared magnitude
+   *
+   * Gets the square of the magnitude of the vector, without a square root.
+   * Use this to compare lengths, for example against the square of a
+   * threshold.
+   *
+   * @returns The squared magnitude of the vector.
+   */
+  T magnSquared() const {
     T sum_of_squares = 0;
 
     for (const auto &i : this->m_components) {
       sum_of_squares += i * i;
     }
 
-    return std::sqrt(sum_of_squares);
-  };
+    return sum_of_squares;
+  }
+
+  /**
+   * @brief Distance to another vector
+   *
+   * Gets the distance between the points that the two vectors point to.
+   *
+   * @tparam P The math policy, see svector::ExactMath.
+   *
+   * @param other The other vector.
+   *
+   * @returns The magnitude of the difference of the vectors.
+   */
+  template <typename P = SVECTOR_MATH_POLICY>
+  T distance(const Vector<D, T> &other) const {
+    return P::sqrt(this->distanceSquared(other));
+  }
+
+  /**
+   * @brief Squared distance to another vector
+   *
+   * Gets the square of the distance between the points that the two vectors
+   * point to, without a square root.
+   *
+   * @param other The other vector.
+   *
+   * @returns The squared magnitude of the difference of the vectors.
+   */
+  T distanceSquared(const Vector<D, T> &other) const {
+    T sum_of_squares = 0;
+
+    for (std::size_t i = 0; i < D; i++) {
+      const T difference = this->m_components[i] - other[i];
+      sum_of_squares += difference * difference;
+    }
+
+    return sum_of_squares;
+  }
 
   /**
    * @brief Normalizes a vector.
@@ -441,9 +501,24 @@ public:
    * @note This method will result in undefined behavior if the vector is a zero
    * vector (if the magnitude equals zero).
    *
+   * @tparam P The math policy. Except with svector::ExactMath, the
+   * components are multiplied by the reciprocal of the magnitude.
+   *
    * @returns A new vector representing the normalized vector.
    */
-  Vector<D, T> normalize() const { return (*this) / this->magn(); }
+  template <typename P = SVECTOR_MATH_POLICY> Vector<D, T> normalize() const {
+    if (std::is_same<P, ExactMath>::value) {
+      return (*this) / this->template magn<P>();
+    }
+
+    T sum_of_squares = 0;
+
+    for (const auto &i : this->m_components) {
+      sum_of_squares += i * i;
+    }
+
+    return (*this) * P::rsqrt(sum_of_squares);
+  }
 
   /**
    * @brief Gets the number of dimensions.
@@ -457,7 +532,7 @@ public:
    *
    * @returns Whether the current vector is a zero vector.
    */
-  bool isZero() const { return this->magn() == 0; }
+  bool isZero() const { return this->magnSquared() == 0; }
 
   /**
    * @brief Value of a certain component of a vector
@@ -10,9 +10,8 @@
 #ifndef INCLUDE_SVECTOR_VECTOR2D_HPP_
 #define INCLUDE_SVECTOR_VECTOR2D_HPP_
 
-#include <cmath> // std::atan2, std::cos, std::sin
-
-#include "simplevectors/core/vector.hpp" // svector::Vector
+#include "simplevectors/core/mathpolicy.hpp" // SVECTOR_MATH_POLICY
+#include "simplevectors/core/vector.hpp"     // svector::Vector
 
 namespace svector {
 // COMBINER_PY_START
@@ -88,9 +87,13 @@ public:
    *
    * The angle will be in the range (-π, π].
    *
+   * @tparam P The math policy, see svector::ExactMath.
+   *
    * @returns The angle of the vector.
    */
-  double angle() const { return std::atan2(this->y(), this->x()); }
+  template <typename P = SVECTOR_MATH_POLICY> double angle() const {
+    return P::atan2(this->y(), this->x());
+  }
 
   /**
    * @brief Rotates vector by a certain angle.
@@ -99,10 +102,13 @@ public:
    * counterclockwise when the angle is positive and clockwise
    * when the angle is negative.
    *
+   * @tparam P The math policy, see svector::ExactMath.
+   *
    * @param ang the angle to rotate the vector, in radians.
    *
    * @returns A new, rotated vector.
    */
+  template <typename P = SVECTOR_MATH_POLICY>
   Vector2D rotate(const double ang) const {
     //
     // Rotation matrix:
@@ -111,8 +117,10 @@ public:
     // | sin(ang)    cos(ang) | |y|
     //
 
-    const double xPrime = this->x() * std::cos(ang) - this->y() * std::sin(ang);
-    const double yPrime = this->x() * std::sin(ang) + this->y() * std::cos(ang);
+    const double cosine = P::cos(ang);
+    const double sine = P::sin(ang);
+    const double xPrime = this->x() * cosine - this->y() * sine;
+    const double yPrime = this->x() * sine + this->y() * cosine;
 
     return Vector2D{xPrime, yPrime};
   }
@@ -10,10 +10,11 @@
 #ifndef INCLUDE_SVECTOR_VECTOR3D_HPP_
 #define INCLUDE_SVECTOR_VECTOR3D_HPP_
 
-#include <cmath> // std::acos, std::cos, std::sin
+#include <type_traits> // std::is_same
 
-#include "simplevectors/core/units.hpp"  // svector::AngleDir
-#include "simplevectors/core/vector.hpp" // svector::Vector
+#include "simplevectors/core/mathpolicy.hpp" // SVECTOR_MATH_POLICY
+#include "simplevectors/core/units.hpp"      // svector::AngleDir
+#include "simplevectors/core/vector.hpp"     // svector::Vector
 
 namespace svector {
 // COMBINER_PY_START
@@ -144,10 +145,42 @@ public:
    * of a 3D vector into a struct with three variables and a
    * constructor for those three variables.
    *
+   * @tparam P The math policy, see svector::ExactMath.
+   *
    * @returns Converted value.
    */
-  template <typename T> T anglesAs() const {
-    return T{this->getAlpha(), this->getBeta(), this->getGamma()};
+  template <typename T, typename P = SVECTOR_MATH_POLICY> T anglesAs() const {
+    const Vector3D cosines = this->directionCosines<P>();
+    return T{P::acos(cosines.x()), P::acos(cosines.y()),
+             P::acos(cosines.z())};
+  }
+
+  /**
+   * @brief Gets the direction cosines of the vector.
+   *
+   * The direction cosines are the cosines of α, β and γ, which are the
+   * components of the vector divided by its magnitude. The magnitude is only
+   * computed once.
+   *
+   * @note This method will result in undefined behavior if the vector is a zero
+   * vector (if the magnitude equals zero).
+   *
+   * @tparam P The math policy. Except with svector::ExactMath, the
+   * components are multiplied by the reciprocal of the magnitude.
+   *
+   * @returns A vector with the cosines of α, β and γ.
+   */
+  template <typename P = SVECTOR_MATH_POLICY>
+  Vector3D directionCosines() const {
+    if (std::is_same<P, ExactMath>::value) {
+      const double magnitude = this->magn<P>();
+      return Vector3D(this->x() / magnitude, this->y() / magnitude,
+                      this->z() / magnitude);
+    }
+
+    const double inverse = P::rsqrt(this->dot(*this));
+    return Vector3D(this->x() * inverse, this->y() * inverse,
+                    this->z() * inverse);
   }
 
   /**
@@ -163,16 +196,21 @@ public:
    * @note This method will result in undefined behavior if the vector is a zero
    * vector (if the magnitude equals zero).
    *
+   * @tparam D The angle.
+   * @tparam P The math policy, see svector::ExactMath.
+   *
    * @returns An angle representing the angle you specified.
    */
-  template <AngleDir D> double angle() const {
+  template <AngleDir D, typename P = SVECTOR_MATH_POLICY>
+  double angle() const {
+    const Vector3D cosines = this->directionCosines<P>();
     switch (D) {
     case ALPHA:
-      return this->getAlpha();
+      return P::acos(cosines.x());
     case BETA:
-      return this->getBeta();
+      return P::acos(cosines.y());
     default:
-      return this->getGamma();
+      return P::acos(cosines.z());
     }
   }
 
@@ -189,53 +227,32 @@ public:
    *
    * @see svector::AngleDir
    *
+   * @tparam D The axis.
+   * @tparam P The math policy, see svector::ExactMath.
+   *
    * @param ang the angle to rotate the vector, in radians.
    *
    * @returns A new, rotated vector.
    */
-  template <AngleDir D> Vector3D rotate(const double &ang) const {
+  template <AngleDir D, typename P = SVECTOR_MATH_POLICY>
+  Vector3D rotate(const double &ang) const {
+    const double cosine = P::cos(ang);
+    const double sine = P::sin(ang);
     switch (D) {
     case ALPHA:
-      return this->rotateAlpha(ang);
+      return this->rotateAlpha(cosine, sine);
     case BETA:
-      return this->rotateBeta(ang);
+      return this->rotateBeta(cosine, sine);
     default:
-      return this->rotateGamma(ang);
+      return this->rotateGamma(cosine, sine);
     }
   }
 
 private:
   /**
-   * Gets α angle.
-   *
-   * α is the angle between the vector and the x-axis.
-   *
-   * @returns α
-   */
-  double getAlpha() const { return std::acos(this->x() / this->magn()); }
-
-  /**
-   * Gets β angle.
-   *
-   * β is the angle between the vector and the y-axis.
-   *
-   * @returns β
-   */
-  double getBeta() const { return std::acos(this->y() / this->magn()); }
-
-  /**
-   * Gets γ angle.
-   *
-   * γ is the angle between the vector and the z-axis.
-   *
-   * @returns γ
-   */
-  double getGamma() const { return std::acos(this->z() / this->magn()); }
-
-  /**
-   * Rotates around x-axis.
+   * Rotates around x-axis, given the cosine and sine of the angle.
    */
-  Vector3D rotateAlpha(const double &ang) const {
+  Vector3D rotateAlpha(const double cosine, const double sine) const {
     /**
      * Rotation matrix:
      *
@@ -245,16 +262,16 @@ private:
      */
 
     const double xPrime = this->x();
-    const double yPrime = this->y() * std::cos(ang) - this->z() * std::sin(ang);
-    const double zPrime = this->y() * std::sin(ang) + this->z() * std::cos(ang);
+    const double yPrime = this->y() * cosine - this->z() * sine;
+    const double zPrime = this->y() * sine + this->z() * cosine;
 
     return Vector3D{xPrime, yPrime, zPrime};
   }
 
   /**
-   * Rotates around y-axis.
+   * Rotates around y-axis, given the cosine and sine of the angle.
    */
-  Vector3D rotateBeta(const double &ang) const {
+  Vector3D rotateBeta(const double cosine, const double sine) const {
     /**
      * Rotation matrix:
      *
@@ -263,18 +280,17 @@ private:
      * |−sin(ang)  0  cos(ang)| |z|
      */
 
-    const double xPrime = this->x() * std::cos(ang) + this->z() * std::sin(ang);
+    const double xPrime = this->x() * cosine + this->z() * sine;
     const double yPrime = this->y();
-    const double zPrime =
-        -this->x() * std::sin(ang) + this->z() * std::cos(ang);
+    const double zPrime = -this->x() * sine + this->z() * cosine;
 
     return Vector3D{xPrime, yPrime, zPrime};
   }
 
   /**
-   * Rotates around z-axis.
+   * Rotates around z-axis, given the cosine and sine of the angle.
    */
-  Vector3D rotateGamma(const double &ang) const {
+  Vector3D rotateGamma(const double cosine, const double sine) const {
     /**
      * Rotation matrix:
      *
@@ -283,8 +299,8 @@ private:
      * |  0         0        1| |z|
      */
 
-    const double xPrime = this->x() * std::cos(ang) - this->y() * std::sin(ang);
-    const double yPrime = this->x() * std::sin(ang) + this->y() * std::cos(ang);
+    const double xPrime = this->x() * cosine - this->y() * sine;
+    const double yPrime = this->x() * sine + this->y() * cosine;
     const double zPrime = this->z();
 
     return Vector3D{xPrime, yPrime, zPrime};
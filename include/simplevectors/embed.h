@@ -506,6 +506,49 @@ inline float magn(const EmbVec2D &vec) {
   return sqrtf(vec.x * vec.x + vec.y * vec.y);
 }
 
+/**
+ * @brief Gets the squared magnitude of the vector.
+ *
+ * The square root is not taken, so this is cheaper than magn() for
+ * comparing lengths.
+ *
+ * @param vec A 2D vector.
+ *
+ * @returns squared magnitude of vector.
+ */
+inline float magnSquared(const EmbVec2D &vec) {
+  return vec.x * vec.x + vec.y * vec.y;
+}
+
+/**
+ * @brief Gets the squared distance between two vectors.
+ *
+ * The square root is not taken, so this is cheaper than distance() for
+ * comparing distances.
+ *
+ * @param lhs First vector.
+ * @param rhs Second vector.
+ *
+ * @returns squared magnitude of the difference of the vectors.
+ */
+inline float distanceSquared(const EmbVec2D &lhs, const EmbVec2D &rhs) {
+  const float dx = lhs.x - rhs.x;
+  const float dy = lhs.y - rhs.y;
+  return dx * dx + dy * dy;
+}
+
+/**
+ * @brief Gets the distance between two vectors.
+ *
+ * @param lhs First vector.
+ * @param rhs Second vector.
+ *
+ * @returns magnitude of the difference of the vectors.
+ */
+inline float distance(const EmbVec2D &lhs, const EmbVec2D &rhs) {
+  return sqrtf(distanceSquared(lhs, rhs));
+}
+
 /**
  * @brief Gets the angle of a 2D vector in radians.
  *
@@ -536,7 +579,7 @@ inline EmbVec2D normalize(const EmbVec2D &vec) { return vec / magn(vec); }
  *
  * @returns Whether the given vector is a zero vector.
  */
-inline bool isZero(const EmbVec2D &vec) { return magn(vec) == 0; }
+inline bool isZero(const EmbVec2D &vec) { return magnSquared(vec) == 0; }
 
 /**
  * @brief Rotates vector by a certain angle.
@@ -716,6 +759,50 @@ inline float magn(const EmbVec3D &vec) {
   return sqrtf(vec.x * vec.x + vec.y * vec.y + vec.z * vec.z);
 }
 
+/**
+ * @brief Gets the squared magnitude of the vector.
+ *
+ * The square root is not taken, so this is cheaper than magn() for
+ * comparing lengths.
+ *
+ * @param vec A 3D vector.
+ *
+ * @returns squared magnitude of vector.
+ */
+inline float magnSquared(const EmbVec3D &vec) {
+  return vec.x * vec.x + vec.y * vec.y + vec.z * vec.z;
+}
+
+/**
+ * @brief Gets the squared distance between two vectors.
+ *
+ * The square root is not taken, so this is cheaper than distance() for
+ * comparing distances.
+ *
+ * @param lhs First vector.
+ * @param rhs Second vector.
+ *
+ * @returns squared magnitude of the difference of the vectors.
+ */
+inline float distanceSquared(const EmbVec3D &lhs, const EmbVec3D &rhs) {
+  const float dx = lhs.x - rhs.x;
+  const float dy = lhs.y - rhs.y;
+  const float dz = lhs.z - rhs.z;
+  return dx * dx + dy * dy + dz * dz;
+}
+
+/**
+ * @brief Gets the distance between two vectors.
+ *
+ * @param lhs First vector.
+ * @param rhs Second vector.
+ *
+ * @returns magnitude of the difference of the vectors.
+ */
+inline float distance(const EmbVec3D &lhs, const EmbVec3D &rhs) {
+  return sqrtf(distanceSquared(lhs, rhs));
+}
+
 /**
  * @brief Normalizes a vector.
  *
@@ -735,7 +822,7 @@ inline EmbVec3D normalize(const EmbVec3D &vec) { return vec / magn(vec); }
  *
  * @returns Whether the given vector is a zero vector.
  */
-inline bool isZero(const EmbVec3D &vec) { return magn(vec) == 0; }
+inline bool isZero(const EmbVec3D &vec) { return magnSquared(vec) == 0; }
 
 /**
  * @brief Gets α angle.
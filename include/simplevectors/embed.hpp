@@ -512,6 +512,49 @@ inline double magn(const Vec2D &vec) {
   return std::sqrt(vec.x * vec.x + vec.y * vec.y);
 }
 
+/**
+ * @brief Gets the squared magnitude of the vector.
+ *
+ * The square root is not taken, so this is cheaper than magn() for
+ * comparing lengths.
+ *
+ * @param vec A 2D vector.
+ *
+ * @returns squared magnitude of vector.
+ */
+inline double magnSquared(const Vec2D &vec) {
+  return vec.x * vec.x + vec.y * vec.y;
+}
+
+/**
+ * @brief Gets the squared distance between two vectors.
+ *
+ * The square root is not taken, so this is cheaper than distance() for
+ * comparing distances.
+ *
+ * @param lhs First vector.
+ * @param rhs Second vector.
+ *
+ * @returns squared magnitude of the difference of the vectors.
+ */
+inline double distanceSquared(const Vec2D &lhs, const Vec2D &rhs) {
+  const double dx = lhs.x - rhs.x;
+  const double dy = lhs.y - rhs.y;
+  return dx * dx + dy * dy;
+}
+
+/**
+ * @brief Gets the distance between two vectors.
+ *
+ * @param lhs First vector.
+ * @param rhs Second vector.
+ *
+ * @returns magnitude of the difference of the vectors.
+ */
+inline double distance(const Vec2D &lhs, const Vec2D &rhs) {
+  return std::sqrt(distanceSquared(lhs, rhs));
+}
+
 /**
  * @brief Gets the angle of a 2D vector in radians.
  *
@@ -542,7 +585,7 @@ inline Vec2D normalize(const Vec2D &vec) { return vec / magn(vec); }
  *
  * @returns Whether the given vector is a zero vector.
  */
-inline bool isZero(const Vec2D &vec) { return magn(vec) == 0; }
+inline bool isZero(const Vec2D &vec) { return magnSquared(vec) == 0; }
 
 /**
  * @brief Rotates vector by a certain angle.
@@ -738,6 +781,50 @@ inline double magn(const Vec3D &vec) {
   return std::sqrt(vec.x * vec.x + vec.y * vec.y + vec.z * vec.z);
 }
 
+/**
+ * @brief Gets the squared magnitude of the vector.
+ *
+ * The square root is not taken, so this is cheaper than magn() for
+ * comparing lengths.
+ *
+ * @param vec A 3D vector.
+ *
+ * @returns squared magnitude of vector.
+ */
+inline double magnSquared(const Vec3D &vec) {
+  return vec.x * vec.x + vec.y * vec.y + vec.z * vec.z;
+}
+
+/**
+ * @brief Gets the squared distance between two vectors.
+ *
+ * The square root is not taken, so this is cheaper than distance() for
+ * comparing distances.
+ *
+ * @param lhs First vector.
+ * @param rhs Second vector.
+ *
+ * @returns squared magnitude of the difference of the vectors.
+ */
+inline double distanceSquared(const Vec3D &lhs, const Vec3D &rhs) {
+  const double dx = lhs.x - rhs.x;
+  const double dy = lhs.y - rhs.y;
+  const double dz = lhs.z - rhs.z;
+  return dx * dx + dy * dy + dz * dz;
+}
+
+/**
+ * @brief Gets the distance between two vectors.
+ *
+ * @param lhs First vector.
+ * @param rhs Second vector.
+ *
+ * @returns magnitude of the difference of the vectors.
+ */
+inline double distance(const Vec3D &lhs, const Vec3D &rhs) {
+  return std::sqrt(distanceSquared(lhs, rhs));
+}
+
 /**
  * @brief Normalizes a vector.
  *
@@ -757,7 +844,7 @@ inline Vec3D normalize(const Vec3D &vec) { return vec / magn(vec); }
  *
  * @returns Whether the given vector is a zero vector.
  */
-inline bool isZero(const Vec3D &vec) { return magn(vec) == 0; }
+inline bool isZero(const Vec3D &vec) { return magnSquared(vec) == 0; }
 
 /**
  * @brief Gets α angle.
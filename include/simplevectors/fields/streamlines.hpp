@@ -0,0 +1,351 @@
+/**
+ * @file streamlines.hpp
+ *
+ * @brief Streamlines and particle paths through 3D vector fields.
+ *
+ * A streamline is traced from a seed point by integrating the field with
+ * either the classical fourth-order Runge-Kutta method with a fixed step, or
+ * the Dormand-Prince 5(4) method, which estimates the error of every step
+ * and adapts the step size to keep it below a tolerance. Streamlines follow
+ * the direction of the field and their step is a distance; particle paths
+ * follow the field as a velocity and their step is a time.
+ *
+ * The field is any function object that takes a svector::Vector3D and
+ * returns a 3D vector, such as a lambda that samples a svector::VectorField.
+ *
+ * The points of a streamline are written into a buffer given by the caller,
+ * so tracing does not allocate. Seeds traced with traceStreamlines() each
+ * have their own part of the buffer, so ranges of seeds can be traced
+ * independently.
+ *
+ * This file is not included in vectors.hpp, so it has to be included
+ * separately.
+ *
+ * @copyright Copyright (c) 2023 Jonathan Liu. This project is released under
+ * the MIT License. All rights reserved.
+ */
+
+#ifndef INCLUDE_SVECTOR_STREAMLINES_HPP_
+#define INCLUDE_SVECTOR_STREAMLINES_HPP_
+
+#include <cmath>   // std::sqrt, std::pow
+#include <cstddef> // std::size_t
+#include <limits>  // std::numeric_limits
+
+#include "simplevectors/core/vector3d.hpp" // svector::Vector3D
+
+namespace svector {
+/**
+ * @brief The integration method of a streamline.
+ */
+enum StreamlineMethod {
+  STREAMLINE_RK4, //!< Classical Runge-Kutta with a fixed step.
+  STREAMLINE_RK45 //!< Dormand-Prince with an adaptive step.
+};
+
+/**
+ * @brief Why tracing a streamline stopped.
+ */
+enum StreamlineStop {
+  STREAMLINE_CAPACITY,   //!< The buffer is full.
+  STREAMLINE_LENGTH,     //!< The streamline reached its maximum length.
+  STREAMLINE_STAGNATION, //!< The field became too weak.
+  STREAMLINE_BOUNDS,     //!< The next point was outside of the bounds.
+  STREAMLINE_STEP        //!< The step size fell below the minimum.
+};
+
+/**
+ * @brief Parameters of streamline tracing.
+ */
+struct StreamlineSettings {
+  StreamlineMethod method; //!< The integration method.
+  double step;      //!< The step, or the first step of adaptive methods.
+  double minStep;   //!< The smallest step of adaptive methods.
+  double maxStep;   //!< The largest step of adaptive methods.
+  double tolerance; //!< The largest error per step of adaptive methods.
+  double maxLength; //!< The largest length of the streamline.
+  double minSpeed;  //!< Tracing stops where the field is weaker than this.
+  bool normalize;   //!< Whether to follow the direction instead of the
+                    //!< field, so that steps are distances.
+  bool backward;    //!< Whether to trace against the field.
+  Vector3D lower;   //!< The lower corner of the bounds.
+  Vector3D upper;   //!< The upper corner of the bounds.
+
+  /**
+   * @brief Creates settings for RK4 streamlines with steps of 0.01 and no
+   * bounds.
+   */
+  StreamlineSettings()
+      : method(STREAMLINE_RK4), step(0.01), minStep(1e-6), maxStep(1),
+        tolerance(1e-6), maxLength(std::numeric_limits<double>::infinity()),
+        minSpeed(1e-12), normalize(true), backward(false),
+        lower(-std::numeric_limits<double>::infinity(),
+              -std::numeric_limits<double>::infinity(),
+              -std::numeric_limits<double>::infinity()),
+        upper(std::numeric_limits<double>::infinity(),
+              std::numeric_limits<double>::infinity(),
+              std::numeric_limits<double>::infinity()) {}
+};
+
+/**
+ * @brief The result of tracing a streamline.
+ */
+struct StreamlineResult {
+  std::size_t count;   //!< The number of points written, with the seed.
+  double length;       //!< The length of the streamline.
+  StreamlineStop stop; //!< Why tracing stopped.
+};
+
+namespace detail {
+/**
+ * Evaluates the field as followed by a streamline. Returns false if the
+ * field is too weak.
+ */
+template <typename F>
+bool streamlineSlope(const F &field, const StreamlineSettings &settings,
+                     const double *point, double *out) {
+  const auto value = field(Vector3D(point[0], point[1], point[2]));
+  out[0] = value[0];
+  out[1] = value[1];
+  out[2] = value[2];
+  const double speed =
+      std::sqrt(out[0] * out[0] + out[1] * out[1] + out[2] * out[2]);
+  if (!(speed >= settings.minSpeed)) {
+    return false;
+  }
+
+  const double scale =
+      (settings.normalize ? 1 / speed : 1) * (settings.backward ? -1 : 1);
+  out[0] *= scale;
+  out[1] *= scale;
+  out[2] *= scale;
+  return true;
+}
+
+/**
+ * Whether a point is within the bounds.
+ */
+inline bool streamlineInside(const StreamlineSettings &settings,
+                             const double *point) {
+  return point[0] >= settings.lower.x() && point[0] <= settings.upper.x() &&
+         point[1] >= settings.lower.y() && point[1] <= settings.upper.y() &&
+         point[2] >= settings.lower.z() && point[2] <= settings.upper.z();
+}
+} // namespace detail
+
+/**
+ * @brief Traces one streamline.
+ *
+ * @tparam F The type of the field.
+ *
+ * @param field The field, called with a point and returning a 3D vector.
+ * @param seed The first point.
+ * @param settings The parameters of the tracing.
+ * @param out The buffer for the points.
+ * @param capacity The number of points that fit into the buffer.
+ *
+ * @returns The number of points written, the length of the streamline and
+ * why tracing stopped.
+ */
+template <typename F>
+StreamlineResult traceStreamline(const F &field, const Vector3D &seed,
+                                 const StreamlineSettings &settings,
+                                 Vector3D *out, const std::size_t capacity) {
+  // Dormand-Prince coefficients
+  static const double a[7][6] = {
+      {0, 0, 0, 0, 0, 0},
+      {1.0 / 5, 0, 0, 0, 0, 0},
+      {3.0 / 40, 9.0 / 40, 0, 0, 0, 0},
+      {44.0 / 45, -56.0 / 15, 32.0 / 9, 0, 0, 0},
+      {19372.0 / 6561, -25360.0 / 2187, 64448.0 / 6561, -212.0 / 729, 0, 0},
+      {9017.0 / 3168, -355.0 / 33, 46732.0 / 5247, 49.0 / 176,
+       -5103.0 / 18656, 0},
+      {35.0 / 384, 0, 500.0 / 1113, 125.0 / 192, -2187.0 / 6784,
+       11.0 / 84}};
+  // difference between the fifth and fourth order weights
+  static const double e[7] = {35.0 / 384 - 5179.0 / 57600,
+                              0,
+                              500.0 / 1113 - 7571.0 / 16695,
+                              125.0 / 192 - 393.0 / 640,
+                              -2187.0 / 6784 + 92097.0 / 339200,
+                              11.0 / 84 - 187.0 / 2100,
+                              -1.0 / 40};
+
+  StreamlineResult result;
+  result.count = 0;
+  result.length = 0;
+  result.stop = STREAMLINE_CAPACITY;
+
+  double p[3] = {seed.x(), seed.y(), seed.z()};
+  if (capacity == 0) {
+    return result;
+  }
+  if (!detail::streamlineInside(settings, p)) {
+    result.stop = STREAMLINE_BOUNDS;
+    return result;
+  }
+  out[result.count++] = seed;
+
+  const bool adaptive = settings.method == STREAMLINE_RK45;
+  double h = settings.step;
+  double k[7][3];
+  bool haveSlope = false;
+  while (result.count < capacity) {
+    const double remaining = settings.maxLength - result.length;
+    if (remaining <= 0) {
+      result.stop = STREAMLINE_LENGTH;
+      return result;
+    }
+    if (!haveSlope && !detail::streamlineSlope(field, settings, p, k[0])) {
+      result.stop = STREAMLINE_STAGNATION;
+      return result;
+    }
+    haveSlope = false;
+
+    double next[3];
+    double error = 0;
+    const double speed =
+        std::sqrt(k[0][0] * k[0][0] + k[0][1] * k[0][1] + k[0][2] * k[0][2]);
+    double taken = h;
+    const bool last = speed * taken >= remaining;
+    if (last) {
+      taken = remaining / speed;
+    }
+
+    bool weak = false;
+    if (adaptive) {
+      for (std::size_t stage = 1; stage < 7 && !weak; stage++) {
+        double q[3];
+        for (std::size_t d = 0; d < 3; d++) {
+          q[d] = p[d];
+          for (std::size_t j = 0; j < stage; j++) {
+            q[d] += taken * a[stage][j] * k[j][d];
+          }
+        }
+        weak = !detail::streamlineSlope(field, settings, q, k[stage]);
+        if (stage == 6) {
+          next[0] = q[0];
+          next[1] = q[1];
+          next[2] = q[2];
+        }
+      }
+
+      if (!weak) {
+        for (std::size_t d = 0; d < 3; d++) {
+          double difference = 0;
+          for (std::size_t j = 0; j < 7; j++) {
+            difference += e[j] * k[j][d];
+          }
+          error += taken * taken * difference * difference;
+        }
+        error = std::sqrt(error);
+      }
+    } else {
+      double q[3];
+      static const double offsets[3] = {0.5, 0.5, 1};
+      for (std::size_t stage = 1; stage < 4 && !weak; stage++) {
+        for (std::size_t d = 0; d < 3; d++) {
+          q[d] = p[d] + offsets[stage - 1] * taken * k[stage - 1][d];
+        }
+        weak = !detail::streamlineSlope(field, settings, q, k[stage]);
+      }
+      for (std::size_t d = 0; d < 3 && !weak; d++) {
+        next[d] = p[d] + taken / 6 *
+                             (k[0][d] + 2 * k[1][d] + 2 * k[2][d] + k[3][d]);
+      }
+    }
+
+    if (weak) {
+      // the step runs into a region where the field vanishes
+      if (adaptive && taken > settings.minStep) {
+        h = taken / 2 > settings.minStep ? taken / 2 : settings.minStep;
+        haveSlope = true;
+        continue;
+      }
+      result.stop = STREAMLINE_STAGNATION;
+      return result;
+    }
+
+    if (adaptive) {
+      double factor =
+          error > 0 ? 0.9 * std::pow(settings.tolerance / error, 0.2) : 5;
+      factor = factor < 0.2 ? 0.2 : (factor > 5 ? 5 : factor);
+      if (error > settings.tolerance) {
+        if (taken <= settings.minStep) {
+          result.stop = STREAMLINE_STEP;
+          return result;
+        }
+        h = taken * factor < settings.minStep ? settings.minStep
+                                              : taken * factor;
+        haveSlope = true;
+        continue;
+      }
+      h = taken * factor > settings.maxStep ? settings.maxStep
+                                            : taken * factor;
+      h = h < settings.minStep ? settings.minStep : h;
+    }
+
+    if (!detail::streamlineInside(settings, next)) {
+      result.stop = STREAMLINE_BOUNDS;
+      return result;
+    }
+
+    const double dx = next[0] - p[0];
+    const double dy = next[1] - p[1];
+    const double dz = next[2] - p[2];
+    result.length += std::sqrt(dx * dx + dy * dy + dz * dz);
+    p[0] = next[0];
+    p[1] = next[1];
+    p[2] = next[2];
+    out[result.count++] = Vector3D(p[0], p[1], p[2]);
+
+    // the last stage of Dormand-Prince is the slope at the new point
+    if (adaptive) {
+      k[0][0] = k[6][0];
+      k[0][1] = k[6][1];
+      k[0][2] = k[6][2];
+      haveSlope = true;
+    }
+
+    if (last) {
+      // the step was shortened to end at the maximum length
+      result.stop = STREAMLINE_LENGTH;
+      return result;
+    }
+  }
+
+  return result;
+}
+
+/**
+ * @brief Traces the streamlines of a range of seeds.
+ *
+ * The points of seed i are written to out[i * capacity] and on.
+ *
+ * @tparam F The type of the field.
+ *
+ * @param field The field, called with a point and returning a 3D vector.
+ * @param seeds The seeds.
+ * @param begin The first seed of the range.
+ * @param end One past the last seed of the range.
+ * @param settings The parameters of the tracing.
+ * @param out The buffer for the points of all seeds.
+ * @param capacity The number of points that fit into the part of the buffer
+ * of each seed.
+ * @param results The results of all seeds, written at the index of the
+ * seed.
+ */
+template <typename F>
+void traceStreamlines(const F &field, const Vector3D *seeds,
+                      const std::size_t begin, const std::size_t end,
+                      const StreamlineSettings &settings, Vector3D *out,
+                      const std::size_t capacity, StreamlineResult *results) {
+  for (std::size_t i = begin; i < end; i++) {
+    results[i] =
+        traceStreamline(field, seeds[i], settings, out + i * capacity,
+                        capacity);
+  }
+}
+} // namespace svector
+
+#endif
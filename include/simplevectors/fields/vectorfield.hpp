@@ -0,0 +1,676 @@
+/**
+ * @file vectorfield.hpp
+ *
+ * @brief Scalar and vector fields sampled on regular grids.
+ *
+ * A field stores one value per node of a regular grid, given by the number
+ * of nodes along each axis, the position of the first node and the spacing
+ * between nodes. The nodes are numbered with the first axis varying the
+ * fastest. Vector fields store each component in a separate array, so
+ * operations on one component read memory in order.
+ *
+ * Fields are sampled between the nodes with bilinear (2D) or trilinear (3D)
+ * interpolation, either at single points or at arrays of points. The
+ * gradient of scalar fields and the divergence and curl of vector fields are
+ * computed with central differences inside the grid and one-sided
+ * differences on its boundary. Each operator has an overload that only
+ * computes a range of slices along the last axis, so that the slices can be
+ * computed independently.
+ *
+ * This file is not included in vectors.hpp, so it has to be included
+ * separately.
+ *
+ * @copyright Copyright (c) 2023 Jonathan Liu. This project is released under
+ * the MIT License. All rights reserved.
+ */
+
+#ifndef INCLUDE_SVECTOR_VECTORFIELD_HPP_
+#define INCLUDE_SVECTOR_VECTORFIELD_HPP_
+
+#include <cmath>   // std::floor
+#include <cstddef> // std::size_t
+#include <vector>  // std::vector
+
+#include "simplevectors/core/vector.hpp" // svector::Vector
+
+namespace svector {
+/**
+ * @brief The nodes of a regular grid.
+ *
+ * @tparam D The number of dimensions.
+ * @tparam T The type of the coordinates.
+ */
+template <std::size_t D, typename T = double> struct FieldGrid {
+  Vector<D, std::size_t> shape; //!< Number of nodes along each axis.
+  Vector<D, T> origin;          //!< Position of the first node.
+  Vector<D, T> spacing;         //!< Distance between nodes along each axis.
+
+  /**
+   * @brief Gets the number of nodes.
+   *
+   * @returns The number of nodes.
+   */
+  std::size_t size() const {
+    std::size_t result = 1;
+    for (std::size_t d = 0; d < D; d++) {
+      result *= this->shape[d];
+    }
+    return result;
+  }
+
+  /**
+   * @brief Gets the distance between neighboring nodes in the node array.
+   *
+   * @param axis The axis.
+   *
+   * @returns The difference of the indices of nodes that are next to each
+   * other along the axis.
+   */
+  std::size_t stride(const std::size_t axis) const {
+    std::size_t result = 1;
+    for (std::size_t d = 0; d < axis; d++) {
+      result *= this->shape[d];
+    }
+    return result;
+  }
+
+  /**
+   * @brief Gets the index of a node.
+   *
+   * @param node The position of the node in the grid along each axis.
+   *
+   * @returns The index of the node.
+   */
+  std::size_t index(const Vector<D, std::size_t> &node) const {
+    std::size_t result = 0;
+    for (std::size_t d = D; d-- > 0;) {
+      result = result * this->shape[d] + node[d];
+    }
+    return result;
+  }
+
+  /**
+   * @brief Gets the position of a node.
+   *
+   * @param index The index of the node.
+   *
+   * @returns The position of the node.
+   */
+  Vector<D, T> position(std::size_t index) const {
+    Vector<D, T> result;
+    for (std::size_t d = 0; d < D; d++) {
+      result[d] = this->origin[d] +
+                  static_cast<T>(index % this->shape[d]) * this->spacing[d];
+      index /= this->shape[d];
+    }
+    return result;
+  }
+};
+
+namespace detail {
+/**
+ * Finds the nodes around a point and the interpolation weights, and calls
+ * visit(offset, weight) for each of the 2^D nodes.
+ */
+template <std::size_t D, typename T, typename F>
+void fieldCorners(const FieldGrid<D, T> &grid, const T *point,
+                  const F &visit) {
+  std::size_t base = 0;
+  std::size_t strides[D];
+  T fractions[D];
+  std::size_t stride = 1;
+  for (std::size_t d = 0; d < D; d++) {
+    const std::size_t n = grid.shape[d];
+    T u = (point[d] - grid.origin[d]) / grid.spacing[d];
+    const T last = static_cast<T>(n > 1 ? n - 1 : 0);
+    u = u < 0 ? 0 : (u > last ? last : u);
+
+    // the last cell also holds the points on the upper boundary
+    T cell = std::floor(u);
+    cell = n > 1 && cell > last - 1 ? last - 1 : cell;
+    base += static_cast<std::size_t>(cell) * stride;
+    strides[d] = n > 1 ? stride : 0;
+    fractions[d] = u - cell;
+    stride *= n;
+  }
+
+  for (std::size_t corner = 0; corner < (std::size_t(1) << D); corner++) {
+    std::size_t offset = base;
+    T weight = 1;
+    for (std::size_t d = 0; d < D; d++) {
+      const bool upper = (corner >> d) & 1;
+      offset += upper ? strides[d] : 0;
+      weight *= upper ? fractions[d] : 1 - fractions[d];
+    }
+    visit(offset, weight);
+  }
+}
+
+/**
+ * Derivative of grid values along an axis at a node, with central
+ * differences inside the grid and one-sided differences on its boundary.
+ */
+template <std::size_t D, typename T>
+T fieldDerivative(const FieldGrid<D, T> &grid, const T *values,
+                  const std::size_t index, const std::size_t coordinate,
+                  const std::size_t axis) {
+  const std::size_t n = grid.shape[axis];
+  if (n < 2) {
+    return 0;
+  }
+
+  const std::size_t stride = grid.stride(axis);
+  const std::size_t lower = coordinate > 0 ? index - stride : index;
+  const std::size_t upper = coordinate + 1 < n ? index + stride : index;
+  const T steps = static_cast<T>((upper - lower) / stride);
+  return (values[upper] - values[lower]) / (steps * grid.spacing[axis]);
+}
+
+/**
+ * Calls visit(index, node) for every node in slices [begin, end) along the
+ * last axis, where node holds the position of the node along each axis.
+ */
+template <std::size_t D, typename T, typename F>
+void fieldNodes(const FieldGrid<D, T> &grid, const std::size_t begin,
+                const std::size_t end, const F &visit) {
+  const std::size_t slice = grid.stride(D - 1);
+  std::size_t node[D] = {};
+  node[D - 1] = begin;
+  for (std::size_t index = begin * slice; index < end * slice; index++) {
+    visit(index, static_cast<const std::size_t *>(node));
+    for (std::size_t d = 0; d < D; d++) {
+      if (++node[d] < grid.shape[d] || d == D - 1) {
+        break;
+      }
+      node[d] = 0;
+    }
+  }
+}
+} // namespace detail
+
+/**
+ * @brief A scalar field on a regular grid.
+ *
+ * @tparam D The number of dimensions.
+ * @tparam T The type of the values and coordinates.
+ */
+template <std::size_t D, typename T = double> class ScalarField {
+public:
+  /**
+   * @brief Creates a field that is zero everywhere.
+   *
+   * @param shape The number of nodes along each axis, at least 1.
+   * @param origin The position of the first node.
+   * @param spacing The distance between nodes along each axis.
+   */
+  ScalarField(const Vector<D, std::size_t> &shape, const Vector<D, T> &origin,
+              const Vector<D, T> &spacing)
+      : m_grid{shape, origin, spacing}, m_values(m_grid.size(), 0) {}
+
+  /**
+   * @brief Gets the grid of the field.
+   *
+   * @returns The grid.
+   */
+  const FieldGrid<D, T> &grid() const { return this->m_grid; }
+
+  /**
+   * @brief Gets the number of nodes.
+   *
+   * @returns The number of nodes.
+   */
+  std::size_t size() const { return this->m_values.size(); }
+
+  /**
+   * @brief Gets the values at all nodes.
+   *
+   * @returns A pointer to the values, in the order of the node indices.
+   */
+  T *data() { return this->m_values.data(); }
+
+  /**
+   * @brief Gets the values at all nodes.
+   *
+   * @returns A pointer to the values, in the order of the node indices.
+   */
+  const T *data() const { return this->m_values.data(); }
+
+  /**
+   * @brief Gets the value at a node.
+   *
+   * @param index The index of the node.
+   *
+   * @returns The value.
+   */
+  T value(const std::size_t index) const { return this->m_values[index]; }
+
+  /**
+   * @brief Sets the value at a node.
+   *
+   * @param index The index of the node.
+   * @param value The new value.
+   */
+  void value(const std::size_t index, const T value) {
+    this->m_values[index] = value;
+  }
+
+  /**
+   * @brief Interpolates the field at a point.
+   *
+   * Points outside of the grid take the value at the closest point on its
+   * boundary.
+   *
+   * @param point The point.
+   *
+   * @returns The interpolated value.
+   */
+  T sample(const Vector<D, T> &point) const {
+    T coordinates[D];
+    for (std::size_t d = 0; d < D; d++) {
+      coordinates[d] = point[d];
+    }
+    return this->sampleAt(coordinates);
+  }
+
+  /**
+   * @brief Interpolates the field at many points.
+   *
+   * @param coordinates One array of coordinates for each axis.
+   * @param out The interpolated values.
+   * @param count The number of points.
+   */
+  void sample(const T *const *coordinates, T *out,
+              const std::size_t count) const {
+    for (std::size_t i = 0; i < count; i++) {
+      T point[D];
+      for (std::size_t d = 0; d < D; d++) {
+        point[d] = coordinates[d][i];
+      }
+      out[i] = this->sampleAt(point);
+    }
+  }
+
+private:
+  FieldGrid<D, T> m_grid;  //!< The grid.
+  std::vector<T> m_values; //!< Values at the nodes.
+
+  /**
+   * @brief Interpolates the field at a point given as an array.
+   */
+  T sampleAt(const T *point) const {
+    T result = 0;
+    const T *values = this->m_values.data();
+    detail::fieldCorners(this->m_grid, point,
+                         [&result, values](const std::size_t offset,
+                                           const T weight) {
+                           result += weight * values[offset];
+                         });
+    return result;
+  }
+};
+
+/**
+ * @brief A vector field on a regular grid.
+ *
+ * @tparam D The number of dimensions.
+ * @tparam T The type of the components and coordinates.
+ */
+template <std::size_t D, typename T = double> class VectorField {
+public:
+  /**
+   * @brief Creates a field that is zero everywhere.
+   *
+   * @param shape The number of nodes along each axis, at least 1.
+   * @param origin The position of the first node.
+   * @param spacing The distance between nodes along each axis.
+   */
+  VectorField(const Vector<D, std::size_t> &shape, const Vector<D, T> &origin,
+              const Vector<D, T> &spacing)
+      : m_grid{shape, origin, spacing} {
+    for (std::size_t d = 0; d < D; d++) {
+      this->m_components[d].assign(this->m_grid.size(), 0);
+    }
+  }
+
+  /**
+   * @brief Gets the grid of the field.
+   *
+   * @returns The grid.
+   */
+  const FieldGrid<D, T> &grid() const { return this->m_grid; }
+
+  /**
+   * @brief Gets the number of nodes.
+   *
+   * @returns The number of nodes.
+   */
+  std::size_t size() const { return this->m_components[0].size(); }
+
+  /**
+   * @brief Gets one component at all nodes.
+   *
+   * @param axis The axis of the component.
+   *
+   * @returns A pointer to the components, in the order of the node indices.
+   */
+  T *component(const std::size_t axis) {
+    return this->m_components[axis].data();
+  }
+
+  /**
+   * @brief Gets one component at all nodes.
+   *
+   * @param axis The axis of the component.
+   *
+   * @returns A pointer to the components, in the order of the node indices.
+   */
+  const T *component(const std::size_t axis) const {
+    return this->m_components[axis].data();
+  }
+
+  /**
+   * @brief Gets the vector at a node.
+   *
+   * @param index The index of the node.
+   *
+   * @returns The vector.
+   */
+  Vector<D, T> value(const std::size_t index) const {
+    Vector<D, T> result;
+    for (std::size_t d = 0; d < D; d++) {
+      result[d] = this->m_components[d][index];
+    }
+    return result;
+  }
+
+  /**
+   * @brief Sets the vector at a node.
+   *
+   * @param index The index of the node.
+   * @param value The new vector.
+   */
+  void value(const std::size_t index, const Vector<D, T> &value) {
+    for (std::size_t d = 0; d < D; d++) {
+      this->m_components[d][index] = value[d];
+    }
+  }
+
+  /**
+   * @brief Interpolates the field at a point.
+   *
+   * Points outside of the grid take the vector at the closest point on its
+   * boundary.
+   *
+   * @param point The point.
+   *
+   * @returns The interpolated vector.
+   */
+  Vector<D, T> sample(const Vector<D, T> &point) const {
+    T coordinates[D];
+    T values[D];
+    for (std::size_t d = 0; d < D; d++) {
+      coordinates[d] = point[d];
+    }
+    this->sampleAt(coordinates, values);
+
+    Vector<D, T> result;
+    for (std::size_t d = 0; d < D; d++) {
+      result[d] = values[d];
+    }
+    return result;
+  }
+
+  /**
+   * @brief Interpolates the field at many points.
+   *
+   * @param coordinates One array of coordinates for each axis.
+   * @param out One array for each component of the interpolated vectors.
+   * @param count The number of points.
+   */
+  void sample(const T *const *coordinates, T *const *out,
+              const std::size_t count) const {
+    for (std::size_t i = 0; i < count; i++) {
+      T point[D];
+      T values[D];
+      for (std::size_t d = 0; d < D; d++) {
+        point[d] = coordinates[d][i];
+      }
+      this->sampleAt(point, values);
+      for (std::size_t d = 0; d < D; d++) {
+        out[d][i] = values[d];
+      }
+    }
+  }
+
+private:
+  FieldGrid<D, T> m_grid;            //!< The grid.
+  std::vector<T> m_components[D];    //!< Each component at the nodes.
+
+  /**
+   * @brief Interpolates the field at a point given as an array.
+   */
+  void sampleAt(const T *point, T *out) const {
+    for (std::size_t d = 0; d < D; d++) {
+      out[d] = 0;
+    }
+    const std::vector<T> *components = this->m_components;
+    detail::fieldCorners(this->m_grid, point,
+                         [out, components](const std::size_t offset,
+                                           const T weight) {
+                           for (std::size_t d = 0; d < D; d++) {
+                             out[d] += weight * components[d][offset];
+                           }
+                         });
+  }
+};
+
+/**
+ * @brief A 2D scalar field.
+ *
+ * @tparam T The type of the values and coordinates.
+ */
+template <typename T = double> using ScalarField2D = ScalarField<2, T>;
+
+/**
+ * @brief A 3D scalar field.
+ *
+ * @tparam T The type of the values and coordinates.
+ */
+template <typename T = double> using ScalarField3D = ScalarField<3, T>;
+
+/**
+ * @brief A 2D vector field.
+ *
+ * @tparam T The type of the components and coordinates.
+ */
+template <typename T = double> using VectorField2D = VectorField<2, T>;
+
+/**
+ * @brief A 3D vector field.
+ *
+ * @tparam T The type of the components and coordinates.
+ */
+template <typename T = double> using VectorField3D = VectorField<3, T>;
+
+/**
+ * @brief Computes the gradient of a scalar field in a range of slices.
+ *
+ * @tparam D The number of dimensions.
+ * @tparam T The type of the values and coordinates.
+ *
+ * @param field The scalar field.
+ * @param out The gradient, on the same grid as the field.
+ * @param begin The first slice along the last axis.
+ * @param end One past the last slice along the last axis.
+ */
+template <std::size_t D, typename T>
+void gradient(const ScalarField<D, T> &field, VectorField<D, T> &out,
+              const std::size_t begin, const std::size_t end) {
+  const FieldGrid<D, T> &grid = field.grid();
+  const T *values = field.data();
+  T *components[D];
+  for (std::size_t d = 0; d < D; d++) {
+    components[d] = out.component(d);
+  }
+
+  detail::fieldNodes(grid, begin, end,
+                     [&](const std::size_t index, const std::size_t *node) {
+                       for (std::size_t d = 0; d < D; d++) {
+                         components[d][index] = detail::fieldDerivative(
+                             grid, values, index, node[d], d);
+                       }
+                     });
+}
+
+/**
+ * @brief Computes the gradient of a scalar field.
+ *
+ * @tparam D The number of dimensions.
+ * @tparam T The type of the values and coordinates.
+ *
+ * @param field The scalar field.
+ *
+ * @returns The gradient, on the same grid as the field.
+ */
+template <std::size_t D, typename T>
+VectorField<D, T> gradient(const ScalarField<D, T> &field) {
+  const FieldGrid<D, T> &grid = field.grid();
+  VectorField<D, T> result(grid.shape, grid.origin, grid.spacing);
+  gradient(field, result, 0, grid.shape[D - 1]);
+  return result;
+}
+
+/**
+ * @brief Computes the divergence of a vector field in a range of slices.
+ *
+ * @tparam D The number of dimensions.
+ * @tparam T The type of the components and coordinates.
+ *
+ * @param field The vector field.
+ * @param out The divergence, on the same grid as the field.
+ * @param begin The first slice along the last axis.
+ * @param end One past the last slice along the last axis.
+ */
+template <std::size_t D, typename T>
+void divergence(const VectorField<D, T> &field, ScalarField<D, T> &out,
+                const std::size_t begin, const std::size_t end) {
+  const FieldGrid<D, T> &grid = field.grid();
+  T *values = out.data();
+  detail::fieldNodes(grid, begin, end,
+                     [&](const std::size_t index, const std::size_t *node) {
+                       T sum = 0;
+                       for (std::size_t d = 0; d < D; d++) {
+                         sum += detail::fieldDerivative(
+                             grid, field.component(d), index, node[d], d);
+                       }
+                       values[index] = sum;
+                     });
+}
+
+/**
+ * @brief Computes the divergence of a vector field.
+ *
+ * @tparam D The number of dimensions.
+ * @tparam T The type of the components and coordinates.
+ *
+ * @param field The vector field.
+ *
+ * @returns The divergence, on the same grid as the field.
+ */
+template <std::size_t D, typename T>
+ScalarField<D, T> divergence(const VectorField<D, T> &field) {
+  const FieldGrid<D, T> &grid = field.grid();
+  ScalarField<D, T> result(grid.shape, grid.origin, grid.spacing);
+  divergence(field, result, 0, grid.shape[D - 1]);
+  return result;
+}
+
+/**
+ * @brief Computes the curl of a 3D vector field in a range of slices.
+ *
+ * @tparam T The type of the components and coordinates.
+ *
+ * @param field The vector field.
+ * @param out The curl, on the same grid as the field.
+ * @param begin The first slice along the z-axis.
+ * @param end One past the last slice along the z-axis.
+ */
+template <typename T>
+void curl(const VectorField<3, T> &field, VectorField<3, T> &out,
+          const std::size_t begin, const std::size_t end) {
+  const FieldGrid<3, T> &grid = field.grid();
+  const T *x = field.component(0);
+  const T *y = field.component(1);
+  const T *z = field.component(2);
+  T *cx = out.component(0);
+  T *cy = out.component(1);
+  T *cz = out.component(2);
+  detail::fieldNodes(
+      grid, begin, end, [&](const std::size_t index, const std::size_t *node) {
+        cx[index] = detail::fieldDerivative(grid, z, index, node[1], 1) -
+                    detail::fieldDerivative(grid, y, index, node[2], 2);
+        cy[index] = detail::fieldDerivative(grid, x, index, node[2], 2) -
+                    detail::fieldDerivative(grid, z, index, node[0], 0);
+        cz[index] = detail::fieldDerivative(grid, y, index, node[0], 0) -
+                    detail::fieldDerivative(grid, x, index, node[1], 1);
+      });
+}
+
+/**
+ * @brief Computes the curl of a 3D vector field.
+ *
+ * @tparam T The type of the components and coordinates.
+ *
+ * @param field The vector field.
+ *
+ * @returns The curl, on the same grid as the field.
+ */
+template <typename T> VectorField<3, T> curl(const VectorField<3, T> &field) {
+  const FieldGrid<3, T> &grid = field.grid();
+  VectorField<3, T> result(grid.shape, grid.origin, grid.spacing);
+  curl(field, result, 0, grid.shape[2]);
+  return result;
+}
+
+/**
+ * @brief Computes the curl of a 2D vector field in a range of rows.
+ *
+ * @tparam T The type of the components and coordinates.
+ *
+ * @param field The vector field.
+ * @param out The z-component of the curl, on the same grid as the field.
+ * @param begin The first row along the y-axis.
+ * @param end One past the last row along the y-axis.
+ */
+template <typename T>
+void curl(const VectorField<2, T> &field, ScalarField<2, T> &out,
+          const std::size_t begin, const std::size_t end) {
+  const FieldGrid<2, T> &grid = field.grid();
+  const T *x = field.component(0);
+  const T *y = field.component(1);
+  T *values = out.data();
+  detail::fieldNodes(
+      grid, begin, end, [&](const std::size_t index, const std::size_t *node) {
+        values[index] = detail::fieldDerivative(grid, y, index, node[0], 0) -
+                        detail::fieldDerivative(grid, x, index, node[1], 1);
+      });
+}
+
+/**
+ * @brief Computes the curl of a 2D vector field.
+ *
+ * @tparam T The type of the components and coordinates.
+ *
+ * @param field The vector field.
+ *
+ * @returns The z-component of the curl, on the same grid as the field.
+ */
+template <typename T> ScalarField<2, T> curl(const VectorField<2, T> &field) {
+  const FieldGrid<2, T> &grid = field.grid();
+  ScalarField<2, T> result(grid.shape, grid.origin, grid.spacing);
+  curl(field, result, 0, grid.shape[1]);
+  return result;
+}
+} // namespace svector
+
+#endif
@@ -15,11 +15,12 @@
 
 #include <algorithm>        // std::min
 #include <array>            // std::array
-#include <cmath>            // std::atan2, std::acos, std::sqrt
 #include <cstddef>          // std::size_t
 #include <initializer_list> // std::initializer_list
+#include <type_traits>      // std::is_same
 #include <vector>           // std::vector
 
+#include "simplevectors/core/mathpolicy.hpp"
 #include "simplevectors/core/vector.hpp"
 #include "simplevectors/core/vector2d.hpp"
 #include "simplevectors/core/vector3d.hpp"
@@ -210,18 +211,82 @@ inline T dot(const Vector<D, T> &lhs, const Vector<D, T> &rhs) {
  * @tparam D The number of dimensions.
  * @tparam T Vector type.
  *
+ * @tparam P The math policy, see svector::ExactMath.
+ *
  * @param v The vector to get magnitude of.
  *
  * @returns magnitude of vector.
  */
-template <typename T, std::size_t D> inline T magn(const Vector<D, T> &v) {
+template <typename T, std::size_t D, typename P = SVECTOR_MATH_POLICY>
+inline T magn(const Vector<D, T> &v) {
   T sum_of_squares = 0;
 
   for (std::size_t i = 0; i < D; i++) {
     sum_of_squares += v[i] * v[i];
   }
 
-  return std::sqrt(sum_of_squares);
+  return P::sqrt(sum_of_squares);
+}
+
+/**
+ * @brief Gets the squared magnitude of the vector.
+ *
+ * The square root is not taken, so this is cheaper than magn() for
+ * comparing lengths.
+ *
+ * @tparam D The number of dimensions.
+ * @tparam T Vector type.
+ *
+ * @param v The vector to get squared magnitude of.
+ *
+ * @returns squared magnitude of vector.
+ */
+template <typename T, std::size_t D>
+inline T magnSquared(const Vector<D, T> &v) {
+  return dot(v, v);
+}
+
+/**
+ * @brief Gets the squared distance between two vectors.
+ *
+ * The square root is not taken, so this is cheaper than distance() for
+ * comparing distances.
+ *
+ * @tparam D The number of dimensions.
+ * @tparam T Vector type.
+ *
+ * @param lhs First vector.
+ * @param rhs Second vector.
+ *
+ * @returns squared magnitude of the difference of the vectors.
+ */
+template <typename T, std::size_t D>
+inline T distanceSquared(const Vector<D, T> &lhs, const Vector<D, T> &rhs) {
+  T sum_of_squares = 0;
+
+  for (std::size_t i = 0; i < D; i++) {
+    const T difference = lhs[i] - rhs[i];
+    sum_of_squares += difference * difference;
+  }
+
+  return sum_of_squares;
+}
+
+/**
+ * @brief Gets the distance between two vectors.
+ *
+ * @tparam D The number of dimensions.
+ * @tparam T Vector type.
+ * @tparam P The math policy, see svector::ExactMath.
+ *
+ * @param lhs First vector.
+ * @param rhs Second vector.
+ *
+ * @returns magnitude of the difference of the vectors.
+ */
+template <typename T, std::size_t D, typename P = SVECTOR_MATH_POLICY>
+inline T distance(const Vector<D, T> &lhs, const Vector<D, T> &rhs) {
+  return P::sqrt(distanceSquared(lhs, rhs));
 }
 
 /**
@@ -235,13 +300,19 @@ template <typename T, std::size_t D> inline T magn(const Vector<D, T> &v) {
  * @tparam D The number of dimensions.
  * @tparam T Vector type.
  *
+ * @tparam P The math policy. Except with svector::ExactMath, the components
+ * are multiplied by the reciprocal of the magnitude.
+ *
  * @param v The vector to normalize.
  *
  * @returns Normalized vector.
  */
-template <typename T, std::size_t D>
+template <typename T, std::size_t D, typename P = SVECTOR_MATH_POLICY>
 inline Vector<D, T> normalize(const Vector<D, T> &v) {
-  return v / magn(v);
+  if (std::is_same<P, ExactMath>::value) {
+    return v / magn<T, D, P>(v);
+  }
+  return v * P::rsqrt(dot(v, v));
 }
 
 /**
@@ -253,7 +324,7 @@ inline Vector<D, T> normalize(const Vector<D, T> &v) {
  * @returns Whether the given vector is a zero vector.
  */
 template <typename T, std::size_t D> inline bool isZero(const Vector<D, T> &v) {
-  return magn(v) == 0;
+  return magnSquared(v) == 0;
 }
 
 /**
@@ -261,11 +332,16 @@ template <typename T, std::size_t D> inline bool isZero(const Vector<D, T> &v) {
  *
  * The angle will be in the range (-π, π].
  *
+ * @tparam P The math policy, see svector::ExactMath.
+ *
  * @param v A 2D vector.
  *
  * @returns angle of the vector.
  */
-inline double angle(const Vector2D &v) { return std::atan2(y(v), x(v)); }
+template <typename P = SVECTOR_MATH_POLICY>
+inline double angle(const Vector2D &v) {
+  return P::atan2(y(v), x(v));
+}
 
 /**
  * @brief Rotates a 2D vector by a certain angle.
@@ -274,11 +350,14 @@ inline double angle(const Vector2D &v) { return std::atan2(y(v), x(v)); }
  * counterclockwise when the angle is positive and clockwise
  * when the angle is negative.
  *
+ * @tparam P The math policy, see svector::ExactMath.
+ *
  * @param v A 2D vector.
  * @param ang the angle to rotate the vector, in radians.
  *
  * @returns a new, rotated vector.
  */
+template <typename P = SVECTOR_MATH_POLICY>
 inline Vector2D rotate(const Vector2D &v, const double ang) {
   //
   // Rotation matrix:
@@ -287,8 +366,10 @@ inline Vector2D rotate(const Vector2D &v, const double ang) {
   // | sin(ang)    cos(ang) | |y|
   //
 
-  const double xPrime = x(v) * std::cos(ang) - y(v) * std::sin(ang);
-  const double yPrime = x(v) * std::sin(ang) + y(v) * std::cos(ang);
+  const double cosine = P::cos(ang);
+  const double sine = P::sin(ang);
+  const double xPrime = x(v) * cosine - y(v) * sine;
+  const double yPrime = x(v) * sine + y(v) * cosine;
 
   return Vector2D{xPrime, yPrime};
 }
@@ -317,11 +398,16 @@ inline Vector3D cross(const Vector3D &lhs, const Vector3D &rhs) {
  * @note This method will result in undefined behavior if the vector is a zero
  * vector (if the magnitude equals zero).
  *
+ * @tparam P The math policy, see svector::ExactMath.
+ *
  * @param v A 3D vector.
  *
  * @returns α
  */
-inline double alpha(const Vector3D &v) { return std::acos(x(v) / magn(v)); }
+template <typename P = SVECTOR_MATH_POLICY>
+inline double alpha(const Vector3D &v) {
+  return P::acos(x(v.directionCosines<P>()));
+}
 
 /**
  * @brief Gets β angle.
@@ -331,11 +417,16 @@ inline double alpha(const Vector3D &v) { return std::acos(x(v) / magn(v)); }
  * @note This method will result in undefined behavior if the vector is a zero
  * vector (if the magnitude equals zero).
  *
+ * @tparam P The math policy, see svector::ExactMath.
+ *
  * @param v A 3D vector.
  *
  * @returns β
  */
-inline double beta(const Vector3D &v) { return std::acos(y(v) / magn(v)); }
+template <typename P = SVECTOR_MATH_POLICY>
+inline double beta(const Vector3D &v) {
+  return P::acos(y(v.directionCosines<P>()));
+}
 
 /**
  * @brief Gets γ angle.
@@ -345,22 +436,30 @@ inline double beta(const Vector3D &v) { return std::acos(y(v) / magn(v)); }
  * @note This method will result in undefined behavior if the vector is a zero
  * vector (if the magnitude equals zero).
  *
+ * @tparam P The math policy, see svector::ExactMath.
+ *
  * @param v A 3D vector.
  *
  * @returns γ
  */
-inline double gamma(const Vector3D &v) { return std::acos(z(v) / magn(v)); }
+template <typename P = SVECTOR_MATH_POLICY>
+inline double gamma(const Vector3D &v) {
+  return P::acos(z(v.directionCosines<P>()));
+}
 
 /**
  * @brief Rotates around x-axis.
  *
  * Uses the basic gimbal-like 3D rotation matrices for rotation.
  *
+ * @tparam P The math policy, see svector::ExactMath.
+ *
  * @param v A 3D vector.
  * @param ang The angle to rotate the vector, in radians.
  *
  * @returns A new, rotated vector.
  */
+template <typename P = SVECTOR_MATH_POLICY>
 inline Vector3D rotateAlpha(const Vector3D &v, const double &ang) {
   //
   // Rotation matrix:
@@ -370,9 +469,11 @@ inline Vector3D rotateAlpha(const Vector3D &v, const double &ang) {
   // |0  sin(ang)   cos(ang)| |z|
   //
 
+  const double cosine = P::cos(ang);
+  const double sine = P::sin(ang);
   const double xPrime = x(v);
-  const double yPrime = y(v) * std::cos(ang) - z(v) * std::sin(ang);
-  const double zPrime = y(v) * std::sin(ang) + z(v) * std::cos(ang);
+  const double yPrime = y(v) * cosine - z(v) * sine;
+  const double zPrime = y(v) * sine + z(v) * cosine;
 
   return Vector3D{xPrime, yPrime, zPrime};
 }
@@ -382,11 +483,14 @@ inline Vector3D rotateAlpha(const Vector3D &v, const double &ang) {
  *
  * Uses the basic gimbal-like 3D rotation matrices for rotation.
  *
+ * @tparam P The math policy, see svector::ExactMath.
+ *
  * @param v A 3D vector.
  * @param ang The angle to rotate the vector, in radians.
  *
  * @returns A new, rotated vector.
  */
+template <typename P = SVECTOR_MATH_POLICY>
 inline Vector3D rotateBeta(const Vector3D &v, const double &ang) {
   //
   // Rotation matrix:
@@ -396,9 +500,11 @@ inline Vector3D rotateBeta(const Vector3D &v, const double &ang) {
   // |−sin(ang)  0  cos(ang)| |z|
   //
 
-  const double xPrime = x(v) * std::cos(ang) + z(v) * std::sin(ang);
+  const double cosine = P::cos(ang);
+  const double sine = P::sin(ang);
+  const double xPrime = x(v) * cosine + z(v) * sine;
   const double yPrime = y(v);
-  const double zPrime = -x(v) * std::sin(ang) + z(v) * std::cos(ang);
+  const double zPrime = -x(v) * sine + z(v) * cosine;
 
   return Vector3D{xPrime, yPrime, zPrime};
 }
@@ -408,11 +514,14 @@ inline Vector3D rotateBeta(const Vector3D &v, const double &ang) {
  *
  * Uses the basic gimbal-like 3D rotation matrices for rotation.
  *
+ * @tparam P The math policy, see svector::ExactMath.
+ *
  * @param v A 3D vector.
  * @param ang The angle to rotate the vector, in radians.
  *
  * @returns A new, rotated vector.
  */
+template <typename P = SVECTOR_MATH_POLICY>
 inline Vector3D rotateGamma(const Vector3D &v, const double &ang) {
   //
   // Rotation matrix:
@@ -422,8 +531,10 @@ inline Vector3D rotateGamma(const Vector3D &v, const double &ang) {
   // |  0         0        1| |z|
   //
 
-  const double xPrime = x(v) * std::cos(ang) - y(v) * std::sin(ang);
-  const double yPrime = x(v) * std::sin(ang) + y(v) * std::cos(ang);
+  const double cosine = P::cos(ang);
+  const double sine = P::sin(ang);
+  const double xPrime = x(v) * cosine - y(v) * sine;
+  const double yPrime = x(v) * sine + y(v) * cosine;
   const double zPrime = z(v);
 
   return Vector3D{xPrime, yPrime, zPrime};
@@ -0,0 +1,554 @@
+/**
+ * @file delaunay.hpp
+ *
+ * @brief Delaunay triangulation of 2D point sets.
+ *
+ * The triangulation is built with a radial sweep: points are inserted in
+ * order of distance from a seed triangle, so every new point lies outside the
+ * current triangulation and only the visible part of the hull has to be
+ * searched. A small hash of the hull by angle finds the visible edge in
+ * nearly constant time, and edges are made Delaunay by flipping. Orientation
+ * and incircle tests use the robust predicates in predicates.hpp.
+ *
+ * This file is not included in vectors.hpp, so it has to be included
+ * separately.
+ *
+ * @copyright Copyright (c) 2023 Jonathan Liu. This project is released under
+ * the MIT License. All rights reserved.
+ */
+
+#ifndef INCLUDE_SVECTOR_DELAUNAY_HPP_
+#define INCLUDE_SVECTOR_DELAUNAY_HPP_
+
+#include <algorithm> // std::sort, std::unique, std::min, std::max
+#include <cmath>     // std::ceil, std::floor, std::sqrt
+#include <cstddef>   // std::size_t
+#include <limits>    // std::numeric_limits
+#include <vector>    // std::vector
+
+#include "simplevectors/core/traits.hpp"         // svector::VectorTraits
+#include "simplevectors/geometry/predicates.hpp" // svector::incircle
+
+namespace svector {
+/**
+ * Value of a half-edge that has no opposite half-edge, i.e. lies on the hull.
+ */
+constexpr std::size_t NO_EDGE = static_cast<std::size_t>(-1);
+
+/**
+ * @brief A triangulation stored as half-edges.
+ *
+ * Half-edge e belongs to triangle e / 3 and goes from point triangles[e] to
+ * point triangles[nextHalfedge(e)]. Triangles are in counterclockwise order.
+ */
+struct Triangulation {
+  std::vector<std::size_t> triangles; //!< Three point indices per triangle.
+  std::vector<std::size_t> halfedges; //!< Opposite half-edge, or NO_EDGE.
+  std::vector<std::size_t> hull; //!< Hull point indices, counterclockwise.
+};
+
+/**
+ * @brief The next half-edge in the same triangle.
+ *
+ * @param edge The half-edge.
+ *
+ * @returns The half-edge that starts where edge ends.
+ */
+inline std::size_t nextHalfedge(const std::size_t edge) {
+  return edge % 3 == 2 ? edge - 2 : edge + 1;
+}
+
+/**
+ * @brief The previous half-edge in the same triangle.
+ *
+ * @param edge The half-edge.
+ *
+ * @returns The half-edge that ends where edge starts.
+ */
+inline std::size_t prevHalfedge(const std::size_t edge) {
+  return edge % 3 == 0 ? edge + 2 : edge - 1;
+}
+
+namespace detail {
+/**
+ * Monotonic function of the angle of (dx, dy), in [0, 1].
+ */
+inline double pseudoAngle(const double dx, const double dy) {
+  const double ax = dx < 0 ? -dx : dx;
+  const double ay = dy < 0 ? -dy : dy;
+  const double sum = ax + ay;
+  const double p = sum == 0 ? 0 : dx / sum;
+  return (dy > 0 ? 3 - p : 1 + p) / 4;
+}
+
+/**
+ * Squared circumradius of a triangle, or infinity if it is degenerate.
+ */
+inline double circumradiusSquared(const double ax, const double ay,
+                                  const double bx, const double by,
+                                  const double cx, const double cy) {
+  const double dx = bx - ax;
+  const double dy = by - ay;
+  const double ex = cx - ax;
+  const double ey = cy - ay;
+  const double bl = dx * dx + dy * dy;
+  const double cl = ex * ex + ey * ey;
+  const double d = dx * ey - dy * ex;
+  if (d == 0) {
+    return std::numeric_limits<double>::infinity();
+  }
+
+  const double x = (ey * bl - dy * cl) * 0.5 / d;
+  const double y = (dx * cl - ex * bl) * 0.5 / d;
+  return x * x + y * y;
+}
+
+/**
+ * State of the sweep, kept together so the helpers can share it.
+ */
+template <typename V> class DelaunaySweep {
+public:
+  DelaunaySweep(const std::vector<V> &points, Triangulation &out)
+      : m_points(points), m_out(out), m_hullPrev(points.size()),
+        m_hullNext(points.size()), m_hullTri(points.size()),
+        m_hashSize(static_cast<std::size_t>(
+            std::ceil(std::sqrt(static_cast<double>(points.size()))))),
+        m_hullHash(m_hashSize, NO_EDGE), m_coords(2 * points.size()), m_cx(0),
+        m_cy(0), m_hullStart(0) {
+    for (std::size_t i = 0; i < points.size(); i++) {
+      this->m_coords[2 * i] = static_cast<double>(points[i][0]);
+      this->m_coords[2 * i + 1] = static_cast<double>(points[i][1]);
+    }
+  }
+
+  /**
+   * Triangulates the points.
+   */
+  void run() {
+    const std::size_t n = this->m_points.size();
+    if (n < 3) {
+      this->finishDegenerate();
+      return;
+    }
+
+    std::size_t i0 = 0;
+    std::size_t i1 = 0;
+    std::size_t i2 = 0;
+    if (!this->seed(i0, i1, i2)) {
+      this->finishDegenerate();
+      return;
+    }
+
+    std::vector<std::size_t> order(n);
+    std::vector<double> dists(n);
+    for (std::size_t i = 0; i < n; i++) {
+      order[i] = i;
+      const double dx = this->x(i) - this->m_cx;
+      const double dy = this->y(i) - this->m_cy;
+      dists[i] = dx * dx + dy * dy;
+    }
+    std::sort(order.begin(), order.end(),
+              [&dists](const std::size_t lhs, const std::size_t rhs) {
+                return dists[lhs] < dists[rhs];
+              });
+
+    // from here on points are numbered in insertion order, so consecutive
+    // insertions touch nearby memory
+    std::vector<double> sorted(2 * n);
+    const std::size_t seeds[3] = {i0, i1, i2};
+    for (std::size_t k = 0; k < n; k++) {
+      sorted[2 * k] = this->m_coords[2 * order[k]];
+      sorted[2 * k + 1] = this->m_coords[2 * order[k] + 1];
+      if (order[k] == seeds[0]) {
+        i0 = k;
+      } else if (order[k] == seeds[1]) {
+        i1 = k;
+      } else if (order[k] == seeds[2]) {
+        i2 = k;
+      }
+    }
+    this->m_coords.swap(sorted);
+
+    // a triangulation of n points has at most 2n - 5 triangles
+    const std::size_t maxTriangles = 2 * n - 5;
+    this->m_out.triangles.reserve(maxTriangles * 3);
+    this->m_out.halfedges.reserve(maxTriangles * 3);
+
+    this->m_hullNext[i0] = i1;
+    this->m_hullNext[i1] = i2;
+    this->m_hullNext[i2] = i0;
+    this->m_hullPrev[i1] = i0;
+    this->m_hullPrev[i2] = i1;
+    this->m_hullPrev[i0] = i2;
+    this->m_hullTri[i0] = 0;
+    this->m_hullTri[i1] = 1;
+    this->m_hullTri[i2] = 2;
+    this->m_hullStart = i0;
+    this->m_hullHash[this->hashKey(i0)] = i0;
+    this->m_hullHash[this->hashKey(i1)] = i1;
+    this->m_hullHash[this->hashKey(i2)] = i2;
+    this->addTriangle(i0, i1, i2, NO_EDGE, NO_EDGE, NO_EDGE);
+
+    std::size_t previous = i0;
+    for (std::size_t i = 0; i < n; i++) {
+      if (i == i0 || i == i1 || i == i2) {
+        continue;
+      }
+
+      // skip duplicates of the previously inserted point
+      if (this->x(i) == this->x(previous) && this->y(i) == this->y(previous)) {
+        continue;
+      }
+      previous = i;
+
+      this->insert(i);
+    }
+
+    std::size_t e = this->m_hullStart;
+    do {
+      this->m_out.hull.push_back(order[e]);
+      e = this->m_hullNext[e];
+    } while (e != this->m_hullStart);
+
+    for (auto &vertex : this->m_out.triangles) {
+      vertex = order[vertex];
+    }
+  }
+
+private:
+  const std::vector<V> &m_points;
+  Triangulation &m_out;
+  std::vector<std::size_t> m_hullPrev; //!< Previous hull point.
+  std::vector<std::size_t> m_hullNext; //!< Next hull point.
+  std::vector<std::size_t> m_hullTri;  //!< Half-edge from a hull point.
+  std::size_t m_hashSize;
+  std::vector<std::size_t> m_hullHash; //!< Hull points by angle.
+  std::vector<std::size_t> m_stack;    //!< Edges left to legalize.
+  std::vector<double> m_coords;        //!< Interleaved coordinates.
+  double m_cx;                         //!< Sweep center x.
+  double m_cy;                         //!< Sweep center y.
+  std::size_t m_hullStart;
+
+  double x(const std::size_t i) const { return this->m_coords[2 * i]; }
+
+  double y(const std::size_t i) const { return this->m_coords[2 * i + 1]; }
+
+  std::size_t hashKey(const std::size_t i) const {
+    const double angle =
+        pseudoAngle(this->x(i) - this->m_cx, this->y(i) - this->m_cy);
+    return static_cast<std::size_t>(
+               std::floor(angle * static_cast<double>(this->m_hashSize))) %
+           this->m_hashSize;
+  }
+
+  /**
+   * Whether edge a -> b of the counterclockwise hull is visible from p.
+   */
+  bool visible(const std::size_t p, const std::size_t a,
+               const std::size_t b) const {
+    return orient2dAdaptive(this->x(a), this->y(a), this->x(b), this->y(b),
+                            this->x(p), this->y(p)) < 0;
+  }
+
+  /**
+   * Picks a seed triangle near the center with a small circumcircle, in
+   * counterclockwise order, and sets the sweep center to its circumcenter.
+   */
+  bool seed(std::size_t &i0, std::size_t &i1, std::size_t &i2) {
+    const std::size_t n = this->m_points.size();
+    double minX = this->x(0);
+    double minY = this->y(0);
+    double maxX = minX;
+    double maxY = minY;
+    for (std::size_t i = 1; i < n; i++) {
+      minX = std::min(minX, this->x(i));
+      minY = std::min(minY, this->y(i));
+      maxX = std::max(maxX, this->x(i));
+      maxY = std::max(maxY, this->y(i));
+    }
+    const double midX = (minX + maxX) / 2;
+    const double midY = (minY + maxY) / 2;
+
+    const double inf = std::numeric_limits<double>::infinity();
+    double best = inf;
+    for (std::size_t i = 0; i < n; i++) {
+      const double dx = this->x(i) - midX;
+      const double dy = this->y(i) - midY;
+      const double d = dx * dx + dy * dy;
+      if (d < best) {
+        i0 = i;
+        best = d;
+      }
+    }
+
+    best = inf;
+    for (std::size_t i = 0; i < n; i++) {
+      const double dx = this->x(i) - this->x(i0);
+      const double dy = this->y(i) - this->y(i0);
+      const double d = dx * dx + dy * dy;
+      if (d > 0 && d < best) {
+        i1 = i;
+        best = d;
+      }
+    }
+    if (best == inf) {
+      return false;
+    }
+
+    best = inf;
+    for (std::size_t i = 0; i < n; i++) {
+      const double r =
+          circumradiusSquared(this->x(i0), this->y(i0), this->x(i1),
+                              this->y(i1), this->x(i), this->y(i));
+      if (r < best) {
+        i2 = i;
+        best = r;
+      }
+    }
+    if (best == inf) {
+      return false;
+    }
+
+    if (orient2dAdaptive(this->x(i0), this->y(i0), this->x(i1), this->y(i1),
+                         this->x(i2), this->y(i2)) < 0) {
+      const std::size_t tmp = i1;
+      i1 = i2;
+      i2 = tmp;
+    }
+
+    const double dx = this->x(i1) - this->x(i0);
+    const double dy = this->y(i1) - this->y(i0);
+    const double ex = this->x(i2) - this->x(i0);
+    const double ey = this->y(i2) - this->y(i0);
+    const double bl = dx * dx + dy * dy;
+    const double cl = ex * ex + ey * ey;
+    const double d = dx * ey - dy * ex;
+    this->m_cx = this->x(i0) + (ey * bl - dy * cl) * 0.5 / d;
+    this->m_cy = this->y(i0) + (dx * cl - ex * bl) * 0.5 / d;
+    return true;
+  }
+
+  /**
+   * Output for fewer than three points or collinear points: no triangles,
+   * and the distinct points sorted along the line as the hull.
+   */
+  void finishDegenerate() {
+    std::vector<std::size_t> &hull = this->m_out.hull;
+    for (std::size_t i = 0; i < this->m_points.size(); i++) {
+      hull.push_back(i);
+    }
+
+    const std::vector<V> &points = this->m_points;
+    std::sort(hull.begin(), hull.end(),
+              [&points](const std::size_t lhs, const std::size_t rhs) {
+                return points[lhs][0] < points[rhs][0] ||
+                       (points[lhs][0] == points[rhs][0] &&
+                        points[lhs][1] < points[rhs][1]);
+              });
+    hull.erase(std::unique(hull.begin(), hull.end(),
+                           [&points](const std::size_t lhs,
+                                     const std::size_t rhs) {
+                             return points[lhs][0] == points[rhs][0] &&
+                                    points[lhs][1] == points[rhs][1];
+                           }),
+               hull.end());
+  }
+
+  /**
+   * Inserts a point outside the current triangulation.
+   */
+  void insert(const std::size_t i) {
+    // find a visible hull edge, starting from the hull point closest in angle
+    const std::size_t key = this->hashKey(i);
+    std::size_t start = this->m_hullStart;
+    for (std::size_t j = 0; j < this->m_hashSize; j++) {
+      const std::size_t candidate =
+          this->m_hullHash[(key + j) % this->m_hashSize];
+      if (candidate != NO_EDGE &&
+          candidate != this->m_hullNext[candidate]) {
+        start = candidate;
+        break;
+      }
+    }
+
+    start = this->m_hullPrev[start];
+    std::size_t e = start;
+    while (!this->visible(i, e, this->m_hullNext[e])) {
+      e = this->m_hullNext[e];
+      if (e == start) {
+        // on the hull or inside it; only possible for degenerate input
+        return;
+      }
+    }
+
+    std::size_t t = this->addTriangle(e, i, this->m_hullNext[e], NO_EDGE,
+                                      NO_EDGE, this->m_hullTri[e]);
+    this->m_hullTri[i] = this->legalize(t + 2);
+    this->m_hullTri[e] = t;
+
+    // walk forward through the hull, adding triangles for visible edges
+    std::size_t next = this->m_hullNext[e];
+    std::size_t q = this->m_hullNext[next];
+    while (this->visible(i, next, q)) {
+      t = this->addTriangle(next, i, q, this->m_hullTri[i], NO_EDGE,
+                            this->m_hullTri[next]);
+      this->m_hullTri[i] = this->legalize(t + 2);
+      this->m_hullNext[next] = next; // removed from the hull
+      next = q;
+      q = this->m_hullNext[next];
+    }
+
+    // walk backward only if the first visible edge was the search start
+    if (e == start) {
+      q = this->m_hullPrev[e];
+      while (this->visible(i, q, e)) {
+        t = this->addTriangle(q, i, e, NO_EDGE, this->m_hullTri[e],
+                              this->m_hullTri[q]);
+        this->legalize(t + 2);
+        this->m_hullTri[q] = t;
+        this->m_hullNext[e] = e; // removed from the hull
+        e = q;
+        q = this->m_hullPrev[e];
+      }
+    }
+
+    this->m_hullStart = e;
+    this->m_hullPrev[i] = e;
+    this->m_hullNext[e] = i;
+    this->m_hullPrev[next] = i;
+    this->m_hullNext[i] = next;
+    this->m_hullHash[this->hashKey(i)] = i;
+    this->m_hullHash[this->hashKey(e)] = e;
+  }
+
+  /**
+   * Appends a triangle and links its half-edges.
+   *
+   * @returns The first half-edge of the triangle.
+   */
+  std::size_t addTriangle(const std::size_t i0, const std::size_t i1,
+                          const std::size_t i2, const std::size_t a,
+                          const std::size_t b, const std::size_t c) {
+    const std::size_t t = this->m_out.triangles.size();
+    this->m_out.triangles.push_back(i0);
+    this->m_out.triangles.push_back(i1);
+    this->m_out.triangles.push_back(i2);
+    this->m_out.halfedges.push_back(NO_EDGE);
+    this->m_out.halfedges.push_back(NO_EDGE);
+    this->m_out.halfedges.push_back(NO_EDGE);
+    this->link(t, a);
+    this->link(t + 1, b);
+    this->link(t + 2, c);
+    return t;
+  }
+
+  void link(const std::size_t a, const std::size_t b) {
+    this->m_out.halfedges[a] = b;
+    if (b != NO_EDGE) {
+      this->m_out.halfedges[b] = a;
+    }
+  }
+
+  /**
+   * Flips edges until the triangles around edge a are Delaunay.
+   *
+   * Half-edge a is in triangle (pr, pl, p0) and its opposite b is in
+   * triangle (pl, pr, p1). If p1 is inside the circumcircle of the first
+   * triangle, edge pr-pl is replaced with p0-p1 and the two outer edges of
+   * the second triangle are checked next.
+   *
+   * @returns The half-edge that now plays the role of the one before a.
+   */
+  std::size_t legalize(std::size_t a) {
+    std::vector<std::size_t> &triangles = this->m_out.triangles;
+    std::vector<std::size_t> &halfedges = this->m_out.halfedges;
+    this->m_stack.clear();
+
+    std::size_t ar = 0;
+    while (true) {
+      const std::size_t b = halfedges[a];
+      ar = prevHalfedge(a);
+
+      if (b == NO_EDGE) {
+        if (this->m_stack.empty()) {
+          break;
+        }
+        a = this->m_stack.back();
+        this->m_stack.pop_back();
+        continue;
+      }
+
+      const std::size_t al = nextHalfedge(a);
+      const std::size_t bl = prevHalfedge(b);
+      const std::size_t p0 = triangles[ar];
+      const std::size_t pr = triangles[a];
+      const std::size_t pl = triangles[al];
+      const std::size_t p1 = triangles[bl];
+
+      if (incircleAdaptive(this->x(p0), this->y(p0), this->x(pr),
+                           this->y(pr), this->x(pl), this->y(pl),
+                           this->x(p1), this->y(p1)) > 0) {
+        triangles[a] = p1;
+        triangles[b] = p0;
+
+        const std::size_t hbl = halfedges[bl];
+        if (hbl == NO_EDGE) {
+          // the flipped edge was on the hull; fix the hull reference
+          std::size_t e = this->m_hullStart;
+          do {
+            if (this->m_hullTri[e] == bl) {
+              this->m_hullTri[e] = a;
+              break;
+            }
+            e = this->m_hullPrev[e];
+          } while (e != this->m_hullStart);
+        }
+
+        this->link(a, hbl);
+        this->link(b, halfedges[ar]);
+        this->link(ar, bl);
+        this->m_stack.push_back(nextHalfedge(b));
+      } else {
+        if (this->m_stack.empty()) {
+          break;
+        }
+        a = this->m_stack.back();
+        this->m_stack.pop_back();
+      }
+    }
+
+    return ar;
+  }
+};
+} // namespace detail
+
+/**
+ * @brief Delaunay triangulation of 2D points.
+ *
+ * No point lies strictly inside the circumcircle of any triangle. When four
+ * or more points are cocircular, any of the valid triangulations may be
+ * returned. Duplicate points are triangulated once.
+ *
+ * Runs in O(n log n) time for typical inputs.
+ *
+ * @tparam V 2D point type.
+ *
+ * @param points The points.
+ *
+ * @returns The triangulation. If there are fewer than three points or all
+ * points are collinear, there are no triangles and the hull contains the
+ * distinct points sorted by x, then y.
+ */
+template <typename V>
+Triangulation delaunay(const std::vector<V> &points) {
+  static_assert(VectorTraits<V>::dimensions == 2,
+                "delaunay requires 2D vectors");
+
+  Triangulation result;
+  detail::DelaunaySweep<V> sweep(points, result);
+  sweep.run();
+  return result;
+}
+} // namespace svector
+
+#endif
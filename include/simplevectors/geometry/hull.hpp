@@ -0,0 +1,537 @@
+/**
+ * @file hull.hpp
+ *
+ * @brief Convex hulls of 2D and 3D point sets.
+ *
+ * Orientation tests use the robust predicates in predicates.hpp, so nearly
+ * collinear or coplanar points do not break the hull.
+ *
+ * The hull of a union of point sets is the hull of the union of their hulls.
+ * To build a hull in chunks, split the indices, compute the hull of each
+ * chunk with the overloads that take indices, then compute the hull of the
+ * concatenated results.
+ *
+ * This file is not included in vectors.hpp, so it has to be included
+ * separately.
+ *
+ * @copyright Copyright (c) 2023 Jonathan Liu. This project is released under
+ * the MIT License. All rights reserved.
+ */
+
+#ifndef INCLUDE_SVECTOR_HULL_HPP_
+#define INCLUDE_SVECTOR_HULL_HPP_
+
+#include <algorithm> // std::sort, std::lower_bound
+#include <array>     // std::array
+#include <cstddef>   // std::size_t
+#include <utility>   // std::pair, std::swap
+#include <vector>    // std::vector
+
+#include "simplevectors/core/traits.hpp"         // svector::VectorTraits
+#include "simplevectors/geometry/predicates.hpp" // svector::orient2d
+
+namespace svector {
+/**
+ * @brief Convex hull of a subset of 2D points.
+ *
+ * Uses Andrew's monotone chain algorithm, which runs in O(n log n).
+ *
+ * @tparam V 2D point type.
+ *
+ * @param points The points.
+ * @param indices The indices of the points to use.
+ *
+ * @returns The indices of the hull vertices in counterclockwise order,
+ * starting from the point with the smallest x (and smallest y among those).
+ * Points on the edges of the hull are not included. Two indices are returned
+ * if all points are collinear, and one if all points are equal.
+ */
+template <typename V>
+std::vector<std::size_t> convexHull2D(const std::vector<V> &points,
+                                      std::vector<std::size_t> indices) {
+  static_assert(VectorTraits<V>::dimensions == 2,
+                "convexHull2D requires 2D vectors");
+
+  std::sort(indices.begin(), indices.end(),
+            [&points](const std::size_t lhs, const std::size_t rhs) {
+              return points[lhs][0] < points[rhs][0] ||
+                     (points[lhs][0] == points[rhs][0] &&
+                      points[lhs][1] < points[rhs][1]);
+            });
+
+  // remove duplicate points
+  indices.erase(std::unique(indices.begin(), indices.end(),
+                            [&points](const std::size_t lhs,
+                                      const std::size_t rhs) {
+                              return points[lhs][0] == points[rhs][0] &&
+                                     points[lhs][1] == points[rhs][1];
+                            }),
+                indices.end());
+
+  const std::size_t n = indices.size();
+  if (n < 3) {
+    return indices;
+  }
+
+  std::vector<std::size_t> hull(2 * n);
+  std::size_t k = 0;
+
+  // lower hull
+  for (std::size_t i = 0; i < n; i++) {
+    while (k >= 2 && orient2d(points[hull[k - 2]], points[hull[k - 1]],
+                              points[indices[i]]) <= 0) {
+      k--;
+    }
+    hull[k++] = indices[i];
+  }
+
+  // upper hull
+  const std::size_t lowerSize = k + 1;
+  for (std::size_t i = n - 1; i > 0; i--) {
+    while (k >= lowerSize && orient2d(points[hull[k - 2]], points[hull[k - 1]],
+                                      points[indices[i - 1]]) <= 0) {
+      k--;
+    }
+    hull[k++] = indices[i - 1];
+  }
+
+  // the last point is the first point again
+  hull.resize(k - 1);
+  return hull;
+}
+
+/**
+ * @brief Convex hull of 2D points.
+ *
+ * @see svector::convexHull2D(const std::vector<V> &, std::vector<std::size_t>)
+ *
+ * @tparam V 2D point type.
+ *
+ * @param points The points.
+ *
+ * @returns The indices of the hull vertices in counterclockwise order.
+ */
+template <typename V>
+std::vector<std::size_t> convexHull2D(const std::vector<V> &points) {
+  std::vector<std::size_t> indices(points.size());
+  for (std::size_t i = 0; i < indices.size(); i++) {
+    indices[i] = i;
+  }
+
+  return convexHull2D(points, indices);
+}
+
+namespace detail {
+/**
+ * A triangle of the 3D hull under construction.
+ */
+struct HullFace {
+  std::array<std::size_t, 3> v;         //!< Vertices, counterclockwise outside.
+  std::array<std::size_t, 3> neighbor;  //!< Face across edge v[e], v[e + 1].
+  std::vector<std::size_t> outside;     //!< Points above this face.
+  bool alive;                           //!< Whether the face is on the hull.
+  bool visible;                         //!< Whether the eye sees it.
+  std::size_t visit;                    //!< Last step that visited it.
+};
+
+/**
+ * Whether p is strictly above the face (outside of the hull).
+ */
+template <typename V>
+bool hullAbove(const std::vector<V> &points, const HullFace &face,
+               const std::size_t p) {
+  return orient3d(points[face.v[0]], points[face.v[1]], points[face.v[2]],
+                  points[p]) < 0;
+}
+
+/**
+ * Adds p to the outside set of the first of the given faces that it is
+ * above. Points that are above none of them are inside the hull.
+ */
+template <typename V>
+void hullAssign(const std::vector<V> &points, std::vector<HullFace> &faces,
+                const std::vector<std::size_t> &candidates,
+                const std::size_t p) {
+  for (const auto &f : candidates) {
+    if (hullAbove(points, faces[f], p)) {
+      faces[f].outside.push_back(p);
+      return;
+    }
+  }
+}
+
+/**
+ * Index e of the edge of a face that goes from a to b, so that v[e] = a and
+ * v[e + 1] = b, or 3 if the face has no such edge.
+ */
+inline std::size_t hullEdge(const HullFace &face, const std::size_t a,
+                            const std::size_t b) {
+  for (std::size_t e = 0; e < 3; e++) {
+    if (face.v[e] == a && face.v[(e + 1) % 3] == b) {
+      return e;
+    }
+  }
+
+  return 3;
+}
+
+/**
+ * Squared distance between two 3D points.
+ */
+template <typename V>
+double hullDistanceSquared(const V &a, const V &b) {
+  double sum = 0;
+  for (std::size_t i = 0; i < 3; i++) {
+    const double diff = static_cast<double>(b[i]) - static_cast<double>(a[i]);
+    sum += diff * diff;
+  }
+
+  return sum;
+}
+
+/**
+ * Squared magnitude of (b - a) × (c - a), which is proportional to the
+ * squared distance from c to the line ab.
+ */
+template <typename V>
+double hullLineDistance(const V &a, const V &b, const V &c) {
+  const double ux = b[0] - a[0];
+  const double uy = b[1] - a[1];
+  const double uz = b[2] - a[2];
+  const double vx = c[0] - a[0];
+  const double vy = c[1] - a[1];
+  const double vz = c[2] - a[2];
+  const double cx = uy * vz - uz * vy;
+  const double cy = uz * vx - ux * vz;
+  const double cz = ux * vy - uy * vx;
+  return cx * cx + cy * cy + cz * cz;
+}
+
+/**
+ * Finds four points that form a tetrahedron with nonzero volume.
+ *
+ * @returns Whether the points were found. All points are coplanar otherwise.
+ */
+template <typename V>
+bool hullSimplex(const std::vector<V> &points,
+                 const std::vector<std::size_t> &indices,
+                 std::array<std::size_t, 4> &simplex) {
+  // extreme points along the axis with the largest extent
+  std::size_t best0 = indices[0];
+  std::size_t best1 = indices[0];
+  double bestExtent = -1;
+  for (std::size_t axis = 0; axis < 3; axis++) {
+    std::size_t lo = indices[0];
+    std::size_t hi = indices[0];
+    for (const auto &i : indices) {
+      if (points[i][axis] < points[lo][axis]) {
+        lo = i;
+      }
+      if (points[i][axis] > points[hi][axis]) {
+        hi = i;
+      }
+    }
+
+    const double extent = points[hi][axis] - points[lo][axis];
+    if (extent > bestExtent) {
+      bestExtent = extent;
+      best0 = lo;
+      best1 = hi;
+    }
+  }
+
+  if (hullDistanceSquared(points[best0], points[best1]) == 0) {
+    return false;
+  }
+
+  // farthest from the line
+  std::size_t best2 = best0;
+  double bestLine = 0;
+  for (const auto &i : indices) {
+    const double dist = hullLineDistance(points[best0], points[best1],
+                                         points[i]);
+    if (dist > bestLine) {
+      bestLine = dist;
+      best2 = i;
+    }
+  }
+
+  if (bestLine == 0) {
+    return false;
+  }
+
+  // farthest from the plane
+  std::size_t best3 = best0;
+  double bestPlane = 0;
+  for (const auto &i : indices) {
+    double vol = orient3d(points[best0], points[best1], points[best2],
+                          points[i]);
+    vol = vol < 0 ? -vol : vol;
+    if (vol > bestPlane) {
+      bestPlane = vol;
+      best3 = i;
+    }
+  }
+
+  if (bestPlane == 0) {
+    return false;
+  }
+
+  simplex[0] = best0;
+  simplex[1] = best1;
+  simplex[2] = best2;
+  simplex[3] = best3;
+  return true;
+}
+} // namespace detail
+
+/**
+ * @brief Convex hull of a subset of 3D points.
+ *
+ * Uses the quickhull algorithm, which runs in O(n log n) on average. The
+ * faces that each new point can see are found by searching outward from the
+ * face the point was assigned to, and the slots of removed faces are reused.
+ *
+ * @tparam V 3D point type.
+ *
+ * @param points The points.
+ * @param indices The indices of the points to use.
+ *
+ * @returns The triangles of the hull as indices into points. Each triangle is
+ * in counterclockwise order when viewed from outside of the hull. Returns no
+ * triangles if there are fewer than four points or all points are coplanar.
+ */
+template <typename V>
+std::vector<std::array<std::size_t, 3>>
+convexHull3D(const std::vector<V> &points,
+             const std::vector<std::size_t> &indices) {
+  static_assert(VectorTraits<V>::dimensions == 3,
+                "convexHull3D requires 3D vectors");
+
+  std::vector<std::array<std::size_t, 3>> result;
+  std::array<std::size_t, 4> s;
+  if (indices.size() < 4 || !detail::hullSimplex(points, indices, s)) {
+    return result;
+  }
+
+  // initial tetrahedron, each face oriented away from the opposite vertex
+  std::vector<detail::HullFace> faces(4);
+  const std::size_t opposite[4][4] = {
+      {s[0], s[1], s[2], s[3]},
+      {s[0], s[3], s[1], s[2]},
+      {s[0], s[2], s[3], s[1]},
+      {s[1], s[3], s[2], s[0]}};
+  for (std::size_t f = 0; f < 4; f++) {
+    detail::HullFace &face = faces[f];
+    face.v = {{opposite[f][0], opposite[f][1], opposite[f][2]}};
+    face.alive = true;
+    face.visible = false;
+    face.visit = 0;
+    if (orient3d(points[face.v[0]], points[face.v[1]], points[face.v[2]],
+                 points[opposite[f][3]]) < 0) {
+      std::swap(face.v[1], face.v[2]);
+    }
+  }
+
+  // every edge of the tetrahedron is shared with the face that has it
+  // reversed
+  for (std::size_t f = 0; f < 4; f++) {
+    for (std::size_t e = 0; e < 3; e++) {
+      const std::size_t a = faces[f].v[e];
+      const std::size_t b = faces[f].v[(e + 1) % 3];
+      for (std::size_t g = 0; g < 4; g++) {
+        if (detail::hullEdge(faces[g], b, a) != 3) {
+          faces[f].neighbor[e] = g;
+        }
+      }
+    }
+  }
+
+  std::vector<std::size_t> created{0, 1, 2, 3};
+  for (const auto &i : indices) {
+    if (i != s[0] && i != s[1] && i != s[2] && i != s[3]) {
+      detail::hullAssign(points, faces, created, i);
+    }
+  }
+
+  // faces that may have points above them, and slots of removed faces that
+  // can be reused; a slot can be pending more than once, or be reused for a
+  // later face, so each one is checked again when it is taken
+  std::vector<std::size_t> pending(created);
+  std::vector<std::size_t> unused;
+
+  std::vector<std::size_t> visible;
+  std::vector<std::array<std::size_t, 3>> horizon;
+  std::vector<std::pair<std::size_t, std::size_t>> byFirstVertex;
+  std::vector<std::size_t> orphans;
+  std::size_t step = 0;
+
+  while (!pending.empty()) {
+    const std::size_t f = pending.back();
+    pending.pop_back();
+    if (!faces[f].alive || faces[f].outside.empty()) {
+      continue;
+    }
+
+    // farthest point above the face
+    const detail::HullFace &current = faces[f];
+    std::size_t eye = current.outside[0];
+    double farthest = 0;
+    for (const auto &p : current.outside) {
+      const double dist =
+          -orient3d(points[current.v[0]], points[current.v[1]],
+                    points[current.v[2]], points[p]);
+      if (dist > farthest) {
+        farthest = dist;
+        eye = p;
+      }
+    }
+
+    // the faces that the eye can see are connected, so search outward from
+    // this one; the edges to faces it cannot see form the horizon, as
+    // (a, b, face behind the edge)
+    step++;
+    visible.clear();
+    horizon.clear();
+    visible.push_back(f);
+    faces[f].visit = step;
+    faces[f].visible = true;
+    for (std::size_t k = 0; k < visible.size(); k++) {
+      const std::size_t g = visible[k];
+      for (std::size_t e = 0; e < 3; e++) {
+        const std::size_t h = faces[g].neighbor[e];
+        if (faces[h].visit != step) {
+          faces[h].visit = step;
+          faces[h].visible = detail::hullAbove(points, faces[h], eye);
+          if (faces[h].visible) {
+            visible.push_back(h);
+          }
+        }
+        if (!faces[h].visible) {
+          horizon.push_back(
+              {{faces[g].v[e], faces[g].v[(e + 1) % 3], h}});
+        }
+      }
+    }
+
+    // remove the visible faces, keeping their points to reassign
+    orphans.clear();
+    for (const auto &g : visible) {
+      for (const auto &p : faces[g].outside) {
+        if (p != eye) {
+          orphans.push_back(p);
+        }
+      }
+      faces[g].outside.clear();
+      faces[g].alive = false;
+      unused.push_back(g);
+    }
+
+    // one new face on each horizon edge, linked to the face behind it
+    created.clear();
+    byFirstVertex.clear();
+    for (const auto &edge : horizon) {
+      std::size_t slot = faces.size();
+      if (unused.empty()) {
+        faces.emplace_back();
+      } else {
+        slot = unused.back();
+        unused.pop_back();
+      }
+
+      detail::HullFace &face = faces[slot];
+      face.v = {{edge[0], edge[1], eye}};
+      face.neighbor[0] = edge[2];
+      face.alive = true;
+      face.visible = false;
+      face.visit = 0;
+
+      detail::HullFace &behind = faces[edge[2]];
+      behind.neighbor[detail::hullEdge(behind, edge[1], edge[0])] = slot;
+      created.push_back(slot);
+      byFirstVertex.push_back(std::make_pair(edge[0], slot));
+    }
+
+    // the horizon is a cycle, so the new face after (a, b, eye) is the one
+    // that starts at b
+    std::sort(byFirstVertex.begin(), byFirstVertex.end());
+    for (const auto &slot : created) {
+      const std::size_t b = faces[slot].v[1];
+      const std::size_t next =
+          std::lower_bound(byFirstVertex.begin(), byFirstVertex.end(),
+                           std::make_pair(b, std::size_t(0)))
+              ->second;
+      faces[slot].neighbor[1] = next;
+      faces[next].neighbor[2] = slot;
+    }
+
+    for (const auto &p : orphans) {
+      detail::hullAssign(points, faces, created, p);
+    }
+    for (const auto &slot : created) {
+      if (!faces[slot].outside.empty()) {
+        pending.push_back(slot);
+      }
+    }
+  }
+
+  for (const auto &face : faces) {
+    if (face.alive) {
+      result.push_back(face.v);
+    }
+  }
+
+  return result;
+}
+
+/**
+ * @brief Convex hull of 3D points.
+ *
+ * @see svector::convexHull3D(const std::vector<V> &, const
+ * std::vector<std::size_t> &)
+ *
+ * @tparam V 3D point type.
+ *
+ * @param points The points.
+ *
+ * @returns The triangles of the hull as indices into points.
+ */
+template <typename V>
+std::vector<std::array<std::size_t, 3>>
+convexHull3D(const std::vector<V> &points) {
+  std::vector<std::size_t> indices(points.size());
+  for (std::size_t i = 0; i < indices.size(); i++) {
+    indices[i] = i;
+  }
+
+  return convexHull3D(points, indices);
+}
+
+/**
+ * @brief Vertices used by a list of triangles.
+ *
+ * This can be used to get the vertices of a 3D hull, for example to merge the
+ * hulls of chunks that were computed in parallel.
+ *
+ * @param triangles The triangles.
+ *
+ * @returns The sorted, unique vertex indices.
+ */
+inline std::vector<std::size_t>
+hullVertices(const std::vector<std::array<std::size_t, 3>> &triangles) {
+  std::vector<std::size_t> vertices;
+  vertices.reserve(triangles.size() * 3);
+  for (const auto &tri : triangles) {
+    vertices.push_back(tri[0]);
+    vertices.push_back(tri[1]);
+    vertices.push_back(tri[2]);
+  }
+
+  std::sort(vertices.begin(), vertices.end());
+  vertices.erase(std::unique(vertices.begin(), vertices.end()),
+                 vertices.end());
+  return vertices;
+}
+} // namespace svector
+
+#endif
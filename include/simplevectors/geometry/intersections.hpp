@@ -0,0 +1,730 @@
+/**
+ * @file intersections.hpp
+ *
+ * @brief All intersecting pairs among a set of 2D segments.
+ *
+ * Two methods are provided: a Bentley-Ottmann sweep that runs in
+ * O((n + k) log n) for n segments and k intersecting pairs, and a uniform
+ * grid that is faster for many short, evenly spread segments. Both decide
+ * whether two segments intersect with the exact predicates in predicates.hpp,
+ * and both count segments that only touch, share an end point or overlap as
+ * intersecting.
+ *
+ * This file is not included in vectors.hpp, so it has to be included
+ * separately.
+ *
+ * @copyright Copyright (c) 2023 Jonathan Liu. This project is released under
+ * the MIT License. All rights reserved.
+ */
+
+#ifndef INCLUDE_SVECTOR_INTERSECTIONS_HPP_
+#define INCLUDE_SVECTOR_INTERSECTIONS_HPP_
+
+#include <algorithm>  // std::sort, std::unique, std::min, std::max
+#include <cmath>      // std::abs, std::floor, std::sqrt
+#include <cstddef>    // std::size_t
+#include <iterator>   // std::next, std::prev
+#include <queue>      // std::priority_queue
+#include <set>        // std::set
+#include <utility>    // std::pair, std::swap
+#include <vector>     // std::vector
+
+#include "simplevectors/core/traits.hpp"         // svector::VectorTraits
+#include "simplevectors/geometry/predicates.hpp" // svector::orient2d
+
+namespace svector {
+namespace detail {
+/**
+ * Segment end points as doubles, ordered so that the first end point is
+ * lexicographically smaller (by x, then y).
+ */
+struct SweepSegment {
+  double lx;
+  double ly;
+  double rx;
+  double ry;
+};
+
+/**
+ * Lexicographic order of points by x, then y.
+ */
+inline bool pointLess(const double ax, const double ay, const double bx,
+                      const double by) {
+  return ax < bx || (ax == bx && ay < by);
+}
+
+/**
+ * Orientation of a point relative to the line through a segment.
+ */
+inline double segmentOrient(const SweepSegment &s, const double px,
+                            const double py) {
+  return orient2dAdaptive(s.lx, s.ly, s.rx, s.ry, px, py);
+}
+
+/**
+ * Orientation of a point relative to the line through a segment, with a
+ * bound on the error of its magnitude rather than only an exact sign.
+ */
+inline double segmentOrientValue(const SweepSegment &s, const double px,
+                                 const double py, double &error) {
+  const double detLeft = (s.lx - px) * (s.ry - py);
+  const double detRight = (s.ly - py) * (s.rx - px);
+  const double det = detLeft - detRight;
+  error = PredicateBounds::orient2dA() *
+          (std::abs(detLeft) + std::abs(detRight));
+  if (det > 64 * error || -det > 64 * error) {
+    return det;
+  }
+
+  double t1[4];
+  double t2[4];
+  double t3[4];
+  double s12[8];
+  double exact[12];
+  const std::size_t l1 = twoTwoDiff(s.lx, s.ry, s.ly, s.rx, t1);
+  const std::size_t l2 = twoTwoDiff(s.rx, py, s.ry, px, t2);
+  const std::size_t l3 = twoTwoDiff(px, s.ly, py, s.lx, t3);
+  const std::size_t l12 = expansionSum(l1, t1, l2, t2, s12);
+  const std::size_t len = expansionSum(l12, s12, l3, t3, exact);
+
+  // the components increase in magnitude and do not overlap
+  double value = 0;
+  for (std::size_t i = 0; i < len; i++) {
+    value += exact[i];
+  }
+
+  error = 4 * PredicateBounds::epsilon() * std::abs(value);
+  return value;
+}
+
+/**
+ * Whether a point collinear with a segment lies on it.
+ */
+inline bool inSegmentBox(const SweepSegment &s, const double px,
+                         const double py) {
+  return std::min(s.lx, s.rx) <= px && px <= std::max(s.lx, s.rx) &&
+         std::min(s.ly, s.ry) <= py && py <= std::max(s.ly, s.ry);
+}
+
+/**
+ * Whether a point lies on a segment, exactly.
+ */
+inline bool segmentContains(const SweepSegment &s, const double px,
+                            const double py) {
+  return segmentOrient(s, px, py) == 0 && inSegmentBox(s, px, py);
+}
+
+/**
+ * Whether two segments intersect, exactly. Touching counts.
+ */
+inline bool sweepIntersect(const SweepSegment &a, const SweepSegment &b) {
+  const double d1 = segmentOrient(a, b.lx, b.ly);
+  const double d2 = segmentOrient(a, b.rx, b.ry);
+  const double d3 = segmentOrient(b, a.lx, a.ly);
+  const double d4 = segmentOrient(b, a.rx, a.ry);
+
+  if (((d1 > 0 && d2 < 0) || (d1 < 0 && d2 > 0)) &&
+      ((d3 > 0 && d4 < 0) || (d3 < 0 && d4 > 0))) {
+    return true;
+  }
+
+  return (d1 == 0 && inSegmentBox(a, b.lx, b.ly)) ||
+         (d2 == 0 && inSegmentBox(a, b.rx, b.ry)) ||
+         (d3 == 0 && inSegmentBox(b, a.lx, a.ly)) ||
+         (d4 == 0 && inSegmentBox(b, a.rx, a.ry));
+}
+
+/**
+ * Whether two segments cross at a single point interior to both.
+ */
+inline bool sweepCross(const SweepSegment &a, const SweepSegment &b) {
+  const double d1 = segmentOrient(a, b.lx, b.ly);
+  const double d2 = segmentOrient(a, b.rx, b.ry);
+  const double d3 = segmentOrient(b, a.lx, a.ly);
+  const double d4 = segmentOrient(b, a.rx, a.ry);
+  return ((d1 > 0 && d2 < 0) || (d1 < 0 && d2 > 0)) &&
+         ((d3 > 0 && d4 < 0) || (d3 < 0 && d4 > 0));
+}
+
+/**
+ * Converts a segment to doubles with ordered end points.
+ */
+template <typename V> SweepSegment toSweepSegment(const V &a, const V &b) {
+  double ax = static_cast<double>(a[0]);
+  double ay = static_cast<double>(a[1]);
+  double bx = static_cast<double>(b[0]);
+  double by = static_cast<double>(b[1]);
+  if (pointLess(bx, by, ax, ay)) {
+    std::swap(ax, bx);
+    std::swap(ay, by);
+  }
+
+  return SweepSegment{ax, ay, bx, by};
+}
+
+/**
+ * Converts segments to doubles with ordered end points.
+ */
+template <typename V>
+std::vector<SweepSegment>
+toSweepSegments(const std::vector<std::pair<V, V>> &segments) {
+  std::vector<SweepSegment> result;
+  result.reserve(segments.size());
+  for (const auto &segment : segments) {
+    result.push_back(toSweepSegment(segment.first, segment.second));
+  }
+
+  return result;
+}
+
+/**
+ * Sweep event types, in the order they are handled at the same point.
+ */
+enum SweepEventType { SWEEP_CROSS, SWEEP_RIGHT, SWEEP_LEFT };
+
+/**
+ * A sweep event. For crossings, a is the lower segment before the crossing,
+ * and x and y are rounded and within error of the exact crossing point.
+ */
+struct SweepEvent {
+  double x;
+  double y;
+  SweepEventType type;
+  std::size_t a;
+  std::size_t b;
+  double error;
+};
+
+/**
+ * Exact orientation of a point relative to the line through a segment.
+ */
+inline Expansion segmentOrientExact(const SweepSegment &s, const double px,
+                                    const double py) {
+  return Expansion::difference(s.rx, s.lx) * Expansion::difference(py, s.ly) -
+         Expansion::difference(s.ry, s.ly) * Expansion::difference(px, s.lx);
+}
+
+/**
+ * Exact coordinate of an event point as the fraction numerator /
+ * denominator, with the y-coordinate if vertical is set and the x-coordinate
+ * otherwise.
+ */
+inline void eventCoordinate(const std::vector<SweepSegment> &segments,
+                            const SweepEvent &event, const bool vertical,
+                            Expansion &numerator, Expansion &denominator) {
+  if (event.type != SWEEP_CROSS) {
+    numerator = Expansion(vertical ? event.y : event.x);
+    denominator = Expansion(1);
+    return;
+  }
+
+  // the crossing is at (d1 r - d2 l) / (d1 - d2) on segment a
+  const SweepSegment &a = segments[event.a];
+  const SweepSegment &b = segments[event.b];
+  const Expansion d1 = segmentOrientExact(b, a.lx, a.ly);
+  const Expansion d2 = segmentOrientExact(b, a.rx, a.ry);
+  numerator = d1 * Expansion(vertical ? a.ry : a.rx) -
+              d2 * Expansion(vertical ? a.ly : a.lx);
+  denominator = d1 - d2;
+}
+
+/**
+ * Compares one coordinate of two event points exactly.
+ *
+ * @returns A positive value if the coordinate of e is greater than that of
+ * f, a negative value if it is smaller, and 0 if they are equal.
+ */
+inline double compareEventCoordinate(const std::vector<SweepSegment> &segments,
+                                     const SweepEvent &e, const SweepEvent &f,
+                                     const bool vertical) {
+  Expansion numE;
+  Expansion denE;
+  Expansion numF;
+  Expansion denF;
+  eventCoordinate(segments, e, vertical, numE, denE);
+  eventCoordinate(segments, f, vertical, numF, denF);
+  const double difference = (numE * denF - numF * denE).sign();
+  return (denE.sign() > 0) == (denF.sign() > 0) ? difference : -difference;
+}
+
+/**
+ * Exact lexicographic order of sweep events, with ties broken by type and
+ * segments. Rounded crossing points are only compared exactly when they are
+ * within error of the other point.
+ */
+struct SweepEventAfter {
+  const std::vector<SweepSegment> *segments;
+
+  bool operator()(const SweepEvent &e, const SweepEvent &f) const {
+    if (e.type == f.type && e.a == f.a && e.b == f.b) {
+      // the same event, which is scheduled again when the segments become
+      // neighbors again
+      return false;
+    }
+
+    const double error = e.error + f.error;
+    double order = e.x - f.x;
+    if (error > 0 && order <= error && -order <= error) {
+      order = compareEventCoordinate(*this->segments, e, f, false);
+    }
+    if (order != 0) {
+      return order > 0;
+    }
+
+    order = e.y - f.y;
+    if (error > 0 && order <= error && -order <= error) {
+      order = compareEventCoordinate(*this->segments, e, f, true);
+    }
+    if (order != 0) {
+      return order > 0;
+    }
+
+    if (e.type != f.type) {
+      return e.type > f.type;
+    }
+    if (e.a != f.a) {
+      return e.a > f.a;
+    }
+    return e.b > f.b;
+  }
+};
+
+/**
+ * Bentley-Ottmann sweep state.
+ *
+ * The sweep line moves in lexicographic order, so vertical segments behave
+ * like segments that are very slightly tilted. The status structure is only
+ * searched when a segment is inserted at its left end point, and then the
+ * comparison is exact: the new segment's end point is tested against the
+ * lines through the segments already present. Crossings swap the two
+ * segments in place. Events are ordered by their exact points, so the status
+ * always matches the order of the segments at the sweep line, and a segment
+ * that has been removed is never swapped again.
+ */
+class SegmentSweep {
+public:
+  explicit SegmentSweep(const std::vector<SweepSegment> &segments)
+      : m_segments(segments), m_status(Below{&segments}),
+        m_nodes(segments.size()), m_active(segments.size(), false),
+        m_events(SweepEventAfter{&segments}), m_x(0), m_y(0) {}
+
+  std::vector<std::pair<std::size_t, std::size_t>> run() {
+    for (std::size_t i = 0; i < this->m_segments.size(); i++) {
+      const SweepSegment &s = this->m_segments[i];
+      this->m_events.push(SweepEvent{s.lx, s.ly, SWEEP_LEFT, i, i, 0});
+      if (s.lx != s.rx || s.ly != s.ry) {
+        this->m_events.push(SweepEvent{s.rx, s.ry, SWEEP_RIGHT, i, i, 0});
+      }
+    }
+
+    while (!this->m_events.empty()) {
+      const SweepEvent event = this->m_events.top();
+      this->m_events.pop();
+      if (event.type == SWEEP_CROSS) {
+        this->cross(event.a, event.b);
+        continue;
+      }
+
+      // only end points move the current point, since crossing points are
+      // rounded and can be exactly at an end point
+      if (event.x != this->m_x || event.y != this->m_y) {
+        this->m_ended.clear();
+      }
+      this->m_x = event.x;
+      this->m_y = event.y;
+
+      if (event.type == SWEEP_LEFT) {
+        this->insert(event.a);
+      } else {
+        this->remove(event.a);
+      }
+    }
+
+    std::sort(this->m_pairs.begin(), this->m_pairs.end());
+    this->m_pairs.erase(std::unique(this->m_pairs.begin(), this->m_pairs.end()),
+                        this->m_pairs.end());
+    return this->m_pairs;
+  }
+
+private:
+  struct Node {
+    mutable std::size_t segment;
+  };
+
+  /**
+   * Order of two segments at the left end point of the one inserted later.
+   */
+  struct Below {
+    const std::vector<SweepSegment> *segments;
+
+    bool operator()(const Node &lhs, const Node &rhs) const {
+      const SweepSegment &a = (*this->segments)[lhs.segment];
+      const SweepSegment &b = (*this->segments)[rhs.segment];
+      if (lhs.segment == rhs.segment) {
+        return false;
+      }
+      if (!pointLess(a.lx, a.ly, b.lx, b.ly)) {
+        return this->startBelow(lhs.segment, rhs.segment);
+      }
+      return !this->startBelow(rhs.segment, lhs.segment);
+    }
+
+    /**
+     * Whether s is below t where s starts, with ties broken by direction.
+     */
+    bool startBelow(const std::size_t s, const std::size_t t) const {
+      const SweepSegment &a = (*this->segments)[s];
+      const SweepSegment &b = (*this->segments)[t];
+      double o = segmentOrient(b, a.lx, a.ly);
+      if (o != 0) {
+        return o < 0;
+      }
+      o = segmentOrient(b, a.rx, a.ry);
+      if (o != 0) {
+        return o < 0;
+      }
+      return s < t;
+    }
+  };
+
+  typedef std::set<Node, Below> Status;
+
+  const std::vector<SweepSegment> &m_segments;
+  Status m_status;
+  std::vector<Status::iterator> m_nodes; //!< Node of each segment.
+  std::vector<bool> m_active; //!< Whether each segment is in the status.
+  std::priority_queue<SweepEvent, std::vector<SweepEvent>, SweepEventAfter>
+      m_events;
+  std::vector<std::pair<std::size_t, std::size_t>> m_pairs;
+  std::vector<std::size_t> m_ended; //!< Removed at the current point.
+  double m_x; //!< Current end point x.
+  double m_y; //!< Current end point y.
+
+  void report(const std::size_t a, const std::size_t b) {
+    this->m_pairs.push_back(std::make_pair(std::min(a, b), std::max(a, b)));
+  }
+
+  /**
+   * Reports every segment next to it in the status that also passes
+   * through the current event point. These form a contiguous block.
+   */
+  void reportThrough(const Status::iterator it) {
+    const std::size_t s = it->segment;
+    Status::iterator up = std::next(it);
+    while (up != this->m_status.end() &&
+           segmentContains(this->m_segments[up->segment], this->m_x,
+                           this->m_y)) {
+      this->report(s, up->segment);
+      ++up;
+    }
+
+    Status::iterator down = it;
+    while (down != this->m_status.begin()) {
+      --down;
+      if (!segmentContains(this->m_segments[down->segment], this->m_x,
+                           this->m_y)) {
+        break;
+      }
+      this->report(s, down->segment);
+    }
+  }
+
+  /**
+   * Tests two segments that just became neighbors.
+   */
+  void check(const Status::iterator lower,
+             const Status::iterator upper) {
+    const std::size_t a = lower->segment;
+    const std::size_t b = upper->segment;
+    const SweepSegment &sa = this->m_segments[a];
+    const SweepSegment &sb = this->m_segments[b];
+    if (!sweepIntersect(sa, sb)) {
+      return;
+    }
+
+    this->report(a, b);
+
+    // only schedule the swap while b still starts above a; once they have
+    // been swapped they must not be swapped back
+    if (!sweepCross(sa, sb) || segmentOrient(sa, sb.lx, sb.ly) < 0) {
+      return;
+    }
+
+    // the crossing point is rounded, so keep each coordinate within the
+    // extent of both segments, which only moves it closer to the exact point;
+    // the events are ordered exactly when the rounding matters
+    double e1 = 0;
+    double e2 = 0;
+    const double d1 = segmentOrientValue(sb, sa.lx, sa.ly, e1);
+    const double d2 = segmentOrientValue(sb, sa.rx, sa.ry, e2);
+    const double t = d1 / (d1 - d2);
+    const double x = std::min(
+        std::max(sa.lx + t * (sa.rx - sa.lx), std::max(sa.lx, sb.lx)),
+        std::min(sa.rx, sb.rx));
+    const double y = std::min(
+        std::max(sa.ly + t * (sa.ry - sa.ly),
+                 std::max(std::min(sa.ly, sa.ry), std::min(sb.ly, sb.ry))),
+        std::min(std::max(sa.ly, sa.ry), std::max(sb.ly, sb.ry)));
+
+    // d1 and d2 have opposite signs and are each within a small fraction of
+    // their size, so the error of t is at most 4 (e1 + e2) / (|d1| + |d2|)
+    const double tError =
+        4 * (e1 + e2) / (std::abs(d1) + std::abs(d2)) +
+        16 * PredicateBounds::epsilon();
+    const double error = tError * (std::abs(sa.lx) + std::abs(sa.ly) +
+                                   std::abs(sa.rx) + std::abs(sa.ry));
+    this->m_events.push(SweepEvent{x, y, SWEEP_CROSS, a, b, error});
+  }
+
+  void insert(const std::size_t s) {
+    const Status::iterator it =
+        this->m_status.insert(Node{s}).first;
+    this->m_nodes[s] = it;
+    this->m_active[s] = true;
+    this->reportThrough(it);
+    for (const std::size_t ended : this->m_ended) {
+      this->report(s, ended);
+    }
+
+    const SweepSegment &segment = this->m_segments[s];
+    if (segment.lx == segment.rx && segment.ly == segment.ry) {
+      // a single point ends where it starts
+      this->m_status.erase(it);
+      this->m_active[s] = false;
+      this->m_ended.push_back(s);
+      return;
+    }
+
+    if (it != this->m_status.begin()) {
+      this->check(std::prev(it), it);
+    }
+    const Status::iterator up = std::next(it);
+    if (up != this->m_status.end()) {
+      this->check(it, up);
+    }
+  }
+
+  void remove(const std::size_t s) {
+    const Status::iterator it = this->m_nodes[s];
+    this->reportThrough(it);
+    this->m_ended.push_back(s);
+    this->m_active[s] = false;
+
+    const Status::iterator up = std::next(it);
+    const bool hasUp = up != this->m_status.end();
+    const bool hasDown = it != this->m_status.begin();
+    if (hasUp && hasDown) {
+      const Status::iterator down = std::prev(it);
+      this->m_status.erase(it);
+      this->check(down, up);
+    } else {
+      this->m_status.erase(it);
+    }
+  }
+
+  void cross(const std::size_t a, const std::size_t b) {
+    if (!this->m_active[a] || !this->m_active[b]) {
+      // one of them was removed already, so its node no longer exists
+      return;
+    }
+    const Status::iterator lower = this->m_nodes[a];
+    const Status::iterator upper = this->m_nodes[b];
+    if (std::next(lower) != upper) {
+      // an earlier copy of this event swapped them already
+      return;
+    }
+
+    lower->segment = b;
+    upper->segment = a;
+    std::swap(this->m_nodes[a], this->m_nodes[b]);
+
+    if (lower != this->m_status.begin()) {
+      this->check(std::prev(lower), lower);
+    }
+    const Status::iterator above = std::next(upper);
+    if (above != this->m_status.end()) {
+      this->check(upper, above);
+    }
+  }
+};
+} // namespace detail
+
+/**
+ * @brief Whether two 2D segments intersect.
+ *
+ * The test is exact. Segments that touch, share an end point or overlap
+ * intersect.
+ *
+ * @tparam V 2D point type.
+ *
+ * @param a0 The first end point of the first segment.
+ * @param a1 The second end point of the first segment.
+ * @param b0 The first end point of the second segment.
+ * @param b1 The second end point of the second segment.
+ *
+ * @returns Whether the segments have at least one point in common.
+ */
+template <typename V>
+bool segmentsIntersect(const V &a0, const V &a1, const V &b0, const V &b1) {
+  static_assert(VectorTraits<V>::dimensions == 2,
+                "segmentsIntersect requires 2D vectors");
+
+  return detail::sweepIntersect(detail::toSweepSegment(a0, a1),
+                                detail::toSweepSegment(b0, b1));
+}
+
+/**
+ * @brief All intersecting pairs of 2D segments, with a plane sweep.
+ *
+ * Uses the Bentley-Ottmann algorithm, which runs in O((n + k) log n) time
+ * for n segments and k intersecting pairs. Vertical segments, shared end
+ * points, several segments through one point and overlapping segments are
+ * handled. Crossing points are rounded, but events whose rounded points are
+ * within rounding error of each other are ordered exactly, so the result
+ * is exact.
+ *
+ * @tparam V 2D point type.
+ *
+ * @param segments The segments, as pairs of end points.
+ *
+ * @returns The index pairs (i, j) with i < j of all intersecting segments,
+ * sorted.
+ */
+template <typename V>
+std::vector<std::pair<std::size_t, std::size_t>>
+segmentIntersections(const std::vector<std::pair<V, V>> &segments) {
+  static_assert(VectorTraits<V>::dimensions == 2,
+                "segmentIntersections requires 2D vectors");
+
+  const std::vector<detail::SweepSegment> converted =
+      detail::toSweepSegments(segments);
+  detail::SegmentSweep sweep(converted);
+  return sweep.run();
+}
+
+/**
+ * @brief All intersecting pairs of 2D segments, with a uniform grid.
+ *
+ * Each segment is added to every grid cell its bounding box overlaps, then
+ * the segments sharing a cell are tested pairwise. This is faster than the
+ * sweep when the segments are short compared to the size of the whole set
+ * and evenly spread, but can be much slower when they are long or clustered.
+ *
+ * @tparam V 2D point type.
+ *
+ * @param segments The segments, as pairs of end points.
+ * @param cellSize The width and height of the grid cells. If this is not
+ * positive, a size is chosen from the average segment length.
+ *
+ * @returns The index pairs (i, j) with i < j of all intersecting segments,
+ * sorted.
+ */
+template <typename V>
+std::vector<std::pair<std::size_t, std::size_t>>
+segmentIntersectionsGrid(const std::vector<std::pair<V, V>> &segments,
+                         double cellSize = 0) {
+  static_assert(VectorTraits<V>::dimensions == 2,
+                "segmentIntersectionsGrid requires 2D vectors");
+
+  std::vector<std::pair<std::size_t, std::size_t>> result;
+  const std::size_t n = segments.size();
+  if (n < 2) {
+    return result;
+  }
+
+  const std::vector<detail::SweepSegment> s = detail::toSweepSegments(segments);
+  double minX = s[0].lx;
+  double maxX = s[0].lx;
+  double minY = s[0].ly;
+  double maxY = s[0].ly;
+  double extent = 0;
+  for (const auto &seg : s) {
+    minX = std::min(minX, seg.lx);
+    maxX = std::max(maxX, seg.rx);
+    minY = std::min(minY, std::min(seg.ly, seg.ry));
+    maxY = std::max(maxY, std::max(seg.ly, seg.ry));
+    extent += std::max(seg.rx - seg.lx, std::max(seg.ly - seg.ry,
+                                                 seg.ry - seg.ly));
+  }
+
+  if (!(cellSize > 0)) {
+    const double area = (maxX - minX) * (maxY - minY);
+    cellSize = std::max(extent / static_cast<double>(n),
+                        std::sqrt(area / static_cast<double>(n)));
+  }
+  if (!(cellSize > 0)) {
+    // every segment is the same point
+    cellSize = 1;
+  }
+
+  // keep the number of cells proportional to the number of segments
+  const double maxCells = 4.0 * static_cast<double>(n);
+  while (((maxX - minX) / cellSize + 1) * ((maxY - minY) / cellSize + 1) >
+         maxCells) {
+    cellSize *= 2;
+  }
+
+  const auto cellOf = [cellSize](const double value, const double origin) {
+    return static_cast<std::size_t>(std::floor((value - origin) / cellSize));
+  };
+  const std::size_t width = cellOf(maxX, minX) + 1;
+  const std::size_t height = cellOf(maxY, minY) + 1;
+
+  // cell ranges of each segment's bounding box
+  std::vector<std::size_t> x0(n);
+  std::vector<std::size_t> x1(n);
+  std::vector<std::size_t> y0(n);
+  std::vector<std::size_t> y1(n);
+  std::vector<std::size_t> cellStart(width * height + 1, 0);
+  for (std::size_t i = 0; i < n; i++) {
+    x0[i] = cellOf(s[i].lx, minX);
+    x1[i] = cellOf(s[i].rx, minX);
+    y0[i] = cellOf(std::min(s[i].ly, s[i].ry), minY);
+    y1[i] = cellOf(std::max(s[i].ly, s[i].ry), minY);
+    for (std::size_t cy = y0[i]; cy <= y1[i]; cy++) {
+      for (std::size_t cx = x0[i]; cx <= x1[i]; cx++) {
+        cellStart[cy * width + cx + 1]++;
+      }
+    }
+  }
+  for (std::size_t c = 0; c < width * height; c++) {
+    cellStart[c + 1] += cellStart[c];
+  }
+
+  std::vector<std::size_t> fill(cellStart.begin(), cellStart.end() - 1);
+  std::vector<std::size_t> items(cellStart.back());
+  for (std::size_t i = 0; i < n; i++) {
+    for (std::size_t cy = y0[i]; cy <= y1[i]; cy++) {
+      for (std::size_t cx = x0[i]; cx <= x1[i]; cx++) {
+        items[fill[cy * width + cx]++] = i;
+      }
+    }
+  }
+
+  for (std::size_t cy = 0; cy < height; cy++) {
+    for (std::size_t cx = 0; cx < width; cx++) {
+      const std::size_t begin = cellStart[cy * width + cx];
+      const std::size_t end = cellStart[cy * width + cx + 1];
+      for (std::size_t p = begin; p < end; p++) {
+        const std::size_t i = items[p];
+        for (std::size_t q = p + 1; q < end; q++) {
+          const std::size_t j = items[q];
+
+          // a pair sharing several cells is only tested in the first one
+          if (cx != std::max(x0[i], x0[j]) || cy != std::max(y0[i], y0[j])) {
+            continue;
+          }
+          if (detail::sweepIntersect(s[i], s[j])) {
+            result.push_back(std::make_pair(std::min(i, j), std::max(i, j)));
+          }
+        }
+      }
+    }
+  }
+
+  std::sort(result.begin(), result.end());
+  return result;
+}
+} // namespace svector
+
+#endif
@@ -0,0 +1,464 @@
+/**
+ * @file polygon.hpp
+ *
+ * @brief Area, centroid, perimeter and point containment of 2D polygons.
+ *
+ * A polygon is a ring of vertices; the last vertex connects back to the
+ * first, so it should not be repeated. Polygons with holes can be handled by
+ * adding the winding numbers of the outer ring (counterclockwise) and the
+ * holes (clockwise).
+ *
+ * Containment uses the winding number, so self-intersecting rings are
+ * supported. Points exactly on an edge may be reported as inside or outside.
+ *
+ * This file is not included in vectors.hpp, so it has to be included
+ * separately.
+ *
+ * @copyright Copyright (c) 2023 Jonathan Liu. This project is released under
+ * the MIT License. All rights reserved.
+ */
+
+#ifndef INCLUDE_SVECTOR_POLYGON_HPP_
+#define INCLUDE_SVECTOR_POLYGON_HPP_
+
+#include <algorithm> // std::min, std::min_element, std::max_element
+#include <cmath>     // std::floor, std::sqrt
+#include <cstddef>   // std::size_t
+#include <vector>    // std::vector
+
+#include "simplevectors/core/batch.hpp"  // svector::detail::BATCH_CHUNK
+#include "simplevectors/core/traits.hpp" // svector::VectorTraits
+
+namespace svector {
+namespace detail {
+/**
+ * Winding number contribution of edge (ax, ay) -> (bx, by) for a chunk of
+ * points in structure-of-arrays form.
+ *
+ * The loop has no branches so that the compiler can vectorize it.
+ */
+inline void windingEdge(const double ax, const double ay, const double bx,
+                        const double by, const double *xs, const double *ys,
+                        const std::size_t n, double *winding) {
+  const double ex = bx - ax;
+  const double ey = by - ay;
+  for (std::size_t k = 0; k < n; k++) {
+    const double cross = ex * (ys[k] - ay) - ey * (xs[k] - ax);
+    const double up = (ay <= ys[k]) & (by > ys[k]) & (cross > 0) ? 1.0 : 0.0;
+    const double down = (ay > ys[k]) & (by <= ys[k]) & (cross < 0) ? 1.0 : 0.0;
+    winding[k] += up - down;
+  }
+}
+
+/**
+ * Winding number of one point with respect to a list of edges.
+ */
+inline int windingPoint(const double *ax, const double *ay, const double *bx,
+                        const double *by, const std::size_t edges,
+                        const double x, const double y) {
+  int winding = 0;
+  for (std::size_t e = 0; e < edges; e++) {
+    const double cross =
+        (bx[e] - ax[e]) * (y - ay[e]) - (by[e] - ay[e]) * (x - ax[e]);
+    if (ay[e] <= y) {
+      if (by[e] > y && cross > 0) {
+        winding++;
+      }
+    } else if (by[e] <= y && cross < 0) {
+      winding--;
+    }
+  }
+
+  return winding;
+}
+} // namespace detail
+
+/**
+ * @brief Signed area of a polygon.
+ *
+ * @tparam V 2D point type.
+ *
+ * @param ring The vertices of the polygon.
+ *
+ * @returns The area, positive if the vertices are in counterclockwise order
+ * and negative if they are in clockwise order.
+ */
+template <typename V>
+typename VectorTraits<V>::value_type polygonArea(const std::vector<V> &ring) {
+  static_assert(VectorTraits<V>::dimensions == 2,
+                "polygonArea requires 2D vectors");
+  typedef typename VectorTraits<V>::value_type T;
+
+  if (ring.size() < 3) {
+    return 0;
+  }
+
+  // relative to the first vertex, which keeps the products small
+  const T x0 = ring[0][0];
+  const T y0 = ring[0][1];
+  T sum = 0;
+  for (std::size_t i = 1; i + 1 < ring.size(); i++) {
+    sum += (ring[i][0] - x0) * (ring[i + 1][1] - y0) -
+           (ring[i + 1][0] - x0) * (ring[i][1] - y0);
+  }
+
+  return sum / 2;
+}
+
+/**
+ * @brief Perimeter of a polygon.
+ *
+ * @tparam V 2D point type.
+ *
+ * @param ring The vertices of the polygon.
+ *
+ * @returns The total length of the edges, including the closing edge.
+ */
+template <typename V>
+typename VectorTraits<V>::value_type
+polygonPerimeter(const std::vector<V> &ring) {
+  static_assert(VectorTraits<V>::dimensions == 2,
+                "polygonPerimeter requires 2D vectors");
+  typedef typename VectorTraits<V>::value_type T;
+
+  T sum = 0;
+  for (std::size_t i = 0; i < ring.size(); i++) {
+    const V &a = ring[i];
+    const V &b = ring[i + 1 == ring.size() ? 0 : i + 1];
+    const T dx = b[0] - a[0];
+    const T dy = b[1] - a[1];
+    sum += std::sqrt(dx * dx + dy * dy);
+  }
+
+  return sum;
+}
+
+/**
+ * @brief Centroid of the area of a polygon.
+ *
+ * @tparam V 2D point type.
+ *
+ * @param ring The vertices of the polygon.
+ *
+ * @returns The centroid. If the polygon has no area, the average of the
+ * vertices is returned instead.
+ *
+ * @note This method will result in undefined behavior if the ring is empty.
+ */
+template <typename V> V polygonCentroid(const std::vector<V> &ring) {
+  static_assert(VectorTraits<V>::dimensions == 2,
+                "polygonCentroid requires 2D vectors");
+  typedef typename VectorTraits<V>::value_type T;
+
+  const T x0 = ring[0][0];
+  const T y0 = ring[0][1];
+  T area = 0;
+  T cx = 0;
+  T cy = 0;
+  for (std::size_t i = 1; i + 1 < ring.size(); i++) {
+    const T ax = ring[i][0] - x0;
+    const T ay = ring[i][1] - y0;
+    const T bx = ring[i + 1][0] - x0;
+    const T by = ring[i + 1][1] - y0;
+    const T cross = ax * by - bx * ay;
+    area += cross;
+    cx += (ax + bx) * cross;
+    cy += (ay + by) * cross;
+  }
+
+  V result;
+  if (area == 0) {
+    T sx = 0;
+    T sy = 0;
+    for (const auto &p : ring) {
+      sx += p[0];
+      sy += p[1];
+    }
+    result[0] = sx / static_cast<T>(ring.size());
+    result[1] = sy / static_cast<T>(ring.size());
+    return result;
+  }
+
+  result[0] = x0 + cx / (3 * area);
+  result[1] = y0 + cy / (3 * area);
+  return result;
+}
+
+/**
+ * @brief Winding number of a polygon around a point.
+ *
+ * @tparam V 2D point type.
+ *
+ * @param ring The vertices of the polygon.
+ * @param point The point.
+ *
+ * @returns The number of times the polygon winds counterclockwise around the
+ * point. This is 0 outside a simple polygon, and 1 or -1 inside depending on
+ * the orientation of the ring.
+ */
+template <typename V>
+int windingNumber(const std::vector<V> &ring, const V &point) {
+  static_assert(VectorTraits<V>::dimensions == 2,
+                "windingNumber requires 2D vectors");
+
+  const double x = static_cast<double>(point[0]);
+  const double y = static_cast<double>(point[1]);
+  int winding = 0;
+  for (std::size_t i = 0; i < ring.size(); i++) {
+    const V &a = ring[i];
+    const V &b = ring[i + 1 == ring.size() ? 0 : i + 1];
+    const double ax = static_cast<double>(a[0]);
+    const double ay = static_cast<double>(a[1]);
+    const double bx = static_cast<double>(b[0]);
+    const double by = static_cast<double>(b[1]);
+    const double cross = (bx - ax) * (y - ay) - (by - ay) * (x - ax);
+    if (ay <= y) {
+      if (by > y && cross > 0) {
+        winding++;
+      }
+    } else if (by <= y && cross < 0) {
+      winding--;
+    }
+  }
+
+  return winding;
+}
+
+/**
+ * @brief Winding numbers of a polygon around many points.
+ *
+ * Points are processed in chunks laid out as separate x and y arrays, and
+ * each edge is tested against a whole chunk in a branch-free loop that the
+ * compiler can vectorize.
+ *
+ * @tparam V 2D point type.
+ *
+ * @param ring The vertices of the polygon.
+ * @param points The points.
+ * @param count The number of points.
+ * @param out Output array of winding numbers with room for count values.
+ */
+template <typename V>
+void windingNumbers(const std::vector<V> &ring, const V *points,
+                    const std::size_t count, int *out) {
+  static_assert(VectorTraits<V>::dimensions == 2,
+                "windingNumbers requires 2D vectors");
+
+  // the counters are doubles so that the vectorized comparisons and
+  // additions stay in lanes of the same width
+  double xs[detail::BATCH_CHUNK];
+  double ys[detail::BATCH_CHUNK];
+  double winding[detail::BATCH_CHUNK];
+  for (std::size_t start = 0; start < count; start += detail::BATCH_CHUNK) {
+    const std::size_t n = std::min(detail::BATCH_CHUNK, count - start);
+    for (std::size_t k = 0; k < n; k++) {
+      xs[k] = static_cast<double>(points[start + k][0]);
+      ys[k] = static_cast<double>(points[start + k][1]);
+      winding[k] = 0;
+    }
+
+    for (std::size_t i = 0; i < ring.size(); i++) {
+      const V &a = ring[i];
+      const V &b = ring[i + 1 == ring.size() ? 0 : i + 1];
+      detail::windingEdge(static_cast<double>(a[0]), static_cast<double>(a[1]),
+                          static_cast<double>(b[0]), static_cast<double>(b[1]),
+                          xs, ys, n, winding);
+    }
+
+    for (std::size_t k = 0; k < n; k++) {
+      out[start + k] = static_cast<int>(winding[k]);
+    }
+  }
+}
+
+/**
+ * @brief Winding numbers of a polygon around many points.
+ *
+ * @tparam V 2D point type.
+ *
+ * @param ring The vertices of the polygon.
+ * @param points The points.
+ *
+ * @returns The winding number of each point.
+ */
+template <typename V>
+std::vector<int> windingNumbers(const std::vector<V> &ring,
+                                const std::vector<V> &points) {
+  std::vector<int> result(points.size());
+  windingNumbers(ring, points.data(), points.size(), result.data());
+  return result;
+}
+
+/**
+ * @brief A polygon preprocessed for repeated point containment queries.
+ *
+ * The bounding box of the polygon is cut into horizontal slabs of equal
+ * height, and each slab stores the edges that overlap it. A query only tests
+ * the edges of the slab containing the point, so for polygons whose edges are
+ * spread evenly it takes time proportional to the number of edges divided by
+ * the number of slabs.
+ */
+class PolygonSlabs {
+public:
+  /**
+   * @brief Preprocesses a polygon.
+   *
+   * @tparam V 2D point type.
+   *
+   * @param ring The vertices of the polygon.
+   * @param slabs The number of slabs. If this is 0, the square root of the
+   * number of edges is used.
+   */
+  template <typename V>
+  explicit PolygonSlabs(const std::vector<V> &ring, std::size_t slabs = 0)
+      : m_minX(0), m_maxX(0), m_minY(0), m_maxY(0), m_invHeight(0) {
+    static_assert(VectorTraits<V>::dimensions == 2,
+                  "PolygonSlabs requires 2D vectors");
+
+    const std::size_t n = ring.size();
+    if (n < 2) {
+      this->m_starts.assign(2, 0);
+      return;
+    }
+    if (slabs == 0) {
+      slabs = static_cast<std::size_t>(std::sqrt(static_cast<double>(n))) + 1;
+    }
+
+    std::vector<double> x(n);
+    std::vector<double> y(n);
+    for (std::size_t i = 0; i < n; i++) {
+      x[i] = static_cast<double>(ring[i][0]);
+      y[i] = static_cast<double>(ring[i][1]);
+    }
+    this->m_minX = *std::min_element(x.begin(), x.end());
+    this->m_maxX = *std::max_element(x.begin(), x.end());
+    this->m_minY = *std::min_element(y.begin(), y.end());
+    this->m_maxY = *std::max_element(y.begin(), y.end());
+    const double height = this->m_maxY - this->m_minY;
+    this->m_invHeight = height > 0 ? static_cast<double>(slabs) / height : 0;
+
+    // count the edges in each slab, then fill them in
+    this->m_starts.assign(slabs + 1, 0);
+    for (int pass = 0; pass < 2; pass++) {
+      std::vector<std::size_t> fill(this->m_starts.begin(),
+                                    this->m_starts.end() - 1);
+      for (std::size_t i = 0; i < n; i++) {
+        const std::size_t j = i + 1 == n ? 0 : i + 1;
+        const std::size_t first = this->slab(std::min(y[i], y[j]));
+        const std::size_t last = this->slab(std::max(y[i], y[j]));
+        for (std::size_t s = first; s <= last; s++) {
+          if (pass == 0) {
+            this->m_starts[s + 1]++;
+          } else {
+            const std::size_t at = fill[s]++;
+            this->m_ax[at] = x[i];
+            this->m_ay[at] = y[i];
+            this->m_bx[at] = x[j];
+            this->m_by[at] = y[j];
+          }
+        }
+      }
+
+      if (pass == 0) {
+        for (std::size_t s = 0; s < slabs; s++) {
+          this->m_starts[s + 1] += this->m_starts[s];
+        }
+        this->m_ax.resize(this->m_starts.back());
+        this->m_ay.resize(this->m_starts.back());
+        this->m_bx.resize(this->m_starts.back());
+        this->m_by.resize(this->m_starts.back());
+      }
+    }
+  }
+
+  /**
+   * @brief Winding number of the polygon around a point.
+   *
+   * @param x The x-coordinate of the point.
+   * @param y The y-coordinate of the point.
+   *
+   * @returns The winding number, see svector::windingNumber().
+   */
+  int winding(const double x, const double y) const {
+    if (x < this->m_minX || x > this->m_maxX || y < this->m_minY ||
+        y > this->m_maxY || this->m_ax.empty()) {
+      return 0;
+    }
+
+    const std::size_t s = this->slab(y);
+    const std::size_t begin = this->m_starts[s];
+    return detail::windingPoint(
+        this->m_ax.data() + begin, this->m_ay.data() + begin,
+        this->m_bx.data() + begin, this->m_by.data() + begin,
+        this->m_starts[s + 1] - begin, x, y);
+  }
+
+  /**
+   * @brief Winding number of the polygon around a point.
+   *
+   * @tparam V 2D point type.
+   *
+   * @param point The point.
+   *
+   * @returns The winding number, see svector::windingNumber().
+   */
+  template <typename V> int winding(const V &point) const {
+    return this->winding(static_cast<double>(point[0]),
+                         static_cast<double>(point[1]));
+  }
+
+  /**
+   * @brief Winding numbers of the polygon around many points.
+   *
+   * @tparam V 2D point type.
+   *
+   * @param points The points.
+   * @param count The number of points.
+   * @param out Output array of winding numbers with room for count values.
+   */
+  template <typename V>
+  void winding(const V *points, const std::size_t count, int *out) const {
+    for (std::size_t k = 0; k < count; k++) {
+      out[k] = this->winding(points[k]);
+    }
+  }
+
+  /**
+   * @brief Whether a point is inside the polygon.
+   *
+   * Uses the nonzero rule.
+   *
+   * @tparam V 2D point type.
+   *
+   * @param point The point.
+   *
+   * @returns Whether the winding number around the point is not zero.
+   */
+  template <typename V> bool contains(const V &point) const {
+    return this->winding(point) != 0;
+  }
+
+private:
+  double m_minX;
+  double m_maxX;
+  double m_minY;
+  double m_maxY;
+  double m_invHeight; //!< Slabs per unit of y.
+  std::vector<std::size_t> m_starts; //!< First edge of each slab.
+  std::vector<double> m_ax;          //!< Edge start x, grouped by slab.
+  std::vector<double> m_ay;          //!< Edge start y, grouped by slab.
+  std::vector<double> m_bx;          //!< Edge end x, grouped by slab.
+  std::vector<double> m_by;          //!< Edge end y, grouped by slab.
+
+  /**
+   * Slab containing a y-coordinate inside the bounding box.
+   */
+  std::size_t slab(const double y) const {
+    const std::size_t last = this->m_starts.size() - 2;
+    const double s = std::floor((y - this->m_minY) * this->m_invHeight);
+    return s < 0 ? 0 : std::min(static_cast<std::size_t>(s), last);
+  }
+};
+} // namespace svector
+
+#endif
@@ -0,0 +1,378 @@
+/**
+ * @file polyline.hpp
+ *
+ * @brief Simplification and resampling of polylines.
+ *
+ * A polyline is an open path given as an std::vector of points, which can be
+ * svector::Vector2D, svector::Vector3D, or any svector::Vector.
+ *
+ * This file is not included in vectors.hpp, so it has to be included
+ * separately.
+ *
+ * @copyright Copyright (c) 2023 Jonathan Liu. This project is released under
+ * the MIT License. All rights reserved.
+ */
+
+#ifndef INCLUDE_SVECTOR_POLYLINE_HPP_
+#define INCLUDE_SVECTOR_POLYLINE_HPP_
+
+#include <cmath>      // std::sqrt
+#include <cstddef>    // std::size_t
+#include <functional> // std::greater
+#include <queue>      // std::priority_queue
+#include <utility>    // std::pair
+#include <vector>     // std::vector
+
+#include "simplevectors/core/traits.hpp" // svector::VectorTraits
+
+namespace svector {
+namespace detail {
+/**
+ * Squared distance from p to the segment ab.
+ */
+template <typename V>
+typename VectorTraits<V>::value_type
+segmentDistanceSquared(const V &p, const V &a, const V &b) {
+  typedef typename VectorTraits<V>::value_type T;
+  const std::size_t D = VectorTraits<V>::dimensions;
+
+  T abab = 0;
+  T apab = 0;
+  for (std::size_t i = 0; i < D; i++) {
+    const T ab = b[i] - a[i];
+    abab += ab * ab;
+    apab += (p[i] - a[i]) * ab;
+  }
+
+  T u = abab == 0 ? 0 : apab / abab;
+  if (u < 0) {
+    u = 0;
+  } else if (u > 1) {
+    u = 1;
+  }
+
+  T dist = 0;
+  for (std::size_t i = 0; i < D; i++) {
+    const T diff = p[i] - (a[i] + (b[i] - a[i]) * u);
+    dist += diff * diff;
+  }
+
+  return dist;
+}
+
+/**
+ * Area of the triangle abc, in any number of dimensions.
+ *
+ * Uses |u|²|v|² - (u·v)², which is the squared magnitude of u × v in 3D.
+ */
+template <typename V>
+typename VectorTraits<V>::value_type triangleArea(const V &a, const V &b,
+                                                  const V &c) {
+  typedef typename VectorTraits<V>::value_type T;
+  const std::size_t D = VectorTraits<V>::dimensions;
+
+  T uu = 0;
+  T vv = 0;
+  T uv = 0;
+  for (std::size_t i = 0; i < D; i++) {
+    const T u = b[i] - a[i];
+    const T v = c[i] - a[i];
+    uu += u * u;
+    vv += v * v;
+    uv += u * v;
+  }
+
+  const T sq = uu * vv - uv * uv;
+  return sq <= 0 ? 0 : std::sqrt(sq) / 2;
+}
+
+/**
+ * Distance between two points.
+ */
+template <typename V>
+typename VectorTraits<V>::value_type pointDistance(const V &a, const V &b) {
+  typedef typename VectorTraits<V>::value_type T;
+  T sum = 0;
+  for (std::size_t i = 0; i < VectorTraits<V>::dimensions; i++) {
+    const T diff = b[i] - a[i];
+    sum += diff * diff;
+  }
+
+  return std::sqrt(sum);
+}
+} // namespace detail
+
+/**
+ * @brief Simplifies a polyline with the Douglas-Peucker algorithm.
+ *
+ * Starting from the chord between the first and last points, keeps the
+ * point farthest from the chord and repeats on both halves until every
+ * dropped point is within the tolerance of its chord. This is greedy, so it
+ * does not always keep the fewest points. The first and last points are
+ * always kept.
+ *
+ * This uses an explicit stack instead of recursion, so long polylines cannot
+ * overflow the call stack.
+ *
+ * @tparam V Point type.
+ *
+ * @param points The polyline.
+ * @param tolerance The maximum distance between a removed point and the
+ * simplified polyline.
+ *
+ * @returns The indices of the kept points, in increasing order.
+ */
+template <typename V>
+std::vector<std::size_t>
+douglasPeucker(const std::vector<V> &points,
+               const typename VectorTraits<V>::value_type tolerance) {
+  typedef typename VectorTraits<V>::value_type T;
+
+  std::vector<std::size_t> result;
+  const std::size_t n = points.size();
+  if (n <= 2) {
+    for (std::size_t i = 0; i < n; i++) {
+      result.push_back(i);
+    }
+    return result;
+  }
+
+  const T tolSquared = tolerance * tolerance;
+  std::vector<char> keep(n, 0);
+  keep[0] = 1;
+  keep[n - 1] = 1;
+
+  std::vector<std::pair<std::size_t, std::size_t>> stack;
+  stack.push_back(std::make_pair(std::size_t{0}, n - 1));
+
+  while (!stack.empty()) {
+    const std::size_t first = stack.back().first;
+    const std::size_t last = stack.back().second;
+    stack.pop_back();
+
+    T maxDist = 0;
+    std::size_t index = first;
+    for (std::size_t i = first + 1; i < last; i++) {
+      const T dist = detail::segmentDistanceSquared(points[i], points[first],
+                                                    points[last]);
+      if (dist > maxDist) {
+        maxDist = dist;
+        index = i;
+      }
+    }
+
+    if (maxDist > tolSquared) {
+      keep[index] = 1;
+      if (index - first > 1) {
+        stack.push_back(std::make_pair(first, index));
+      }
+      if (last - index > 1) {
+        stack.push_back(std::make_pair(index, last));
+      }
+    }
+  }
+
+  for (std::size_t i = 0; i < n; i++) {
+    if (keep[i] != 0) {
+      result.push_back(i);
+    }
+  }
+
+  return result;
+}
+
+/**
+ * @brief Simplifies a polyline with the Visvalingam-Whyatt algorithm.
+ *
+ * Repeatedly removes the point whose triangle with its two neighbors has the
+ * smallest area, until every remaining triangle has at least the given area.
+ * The first and last points are always kept.
+ *
+ * Runs in O(n log n) using a priority queue with lazy deletion.
+ *
+ * @tparam V Point type.
+ *
+ * @param points The polyline.
+ * @param minArea The smallest triangle area that is kept.
+ *
+ * @returns The indices of the kept points, in increasing order.
+ */
+template <typename V>
+std::vector<std::size_t>
+visvalingamWhyatt(const std::vector<V> &points,
+                  const typename VectorTraits<V>::value_type minArea) {
+  typedef typename VectorTraits<V>::value_type T;
+  typedef std::pair<T, std::size_t> Entry;
+
+  std::vector<std::size_t> result;
+  const std::size_t n = points.size();
+  if (n <= 2) {
+    for (std::size_t i = 0; i < n; i++) {
+      result.push_back(i);
+    }
+    return result;
+  }
+
+  // doubly linked list of remaining points, and the current area of each
+  std::vector<std::size_t> prev(n);
+  std::vector<std::size_t> next(n);
+  std::vector<T> area(n, 0);
+  std::vector<char> removed(n, 0);
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+
+  for (std::size_t i = 0; i < n; i++) {
+    prev[i] = i - 1;
+    next[i] = i + 1;
+  }
+
+  for (std::size_t i = 1; i + 1 < n; i++) {
+    area[i] = detail::triangleArea(points[i - 1], points[i], points[i + 1]);
+    heap.push(Entry(area[i], i));
+  }
+
+  while (!heap.empty()) {
+    const Entry top = heap.top();
+    heap.pop();
+
+    const std::size_t i = top.second;
+    if (removed[i] != 0 || top.first != area[i]) {
+      // stale entry
+      continue;
+    }
+
+    if (top.first >= minArea) {
+      break;
+    }
+
+    removed[i] = 1;
+    const std::size_t p = prev[i];
+    const std::size_t q = next[i];
+    next[p] = q;
+    prev[q] = p;
+
+    // effective areas never decrease, so a neighbor is not removed before
+    // points that were already removed
+    if (p != 0) {
+      T a = detail::triangleArea(points[prev[p]], points[p], points[q]);
+      area[p] = a < top.first ? top.first : a;
+      heap.push(Entry(area[p], p));
+    }
+    if (q != n - 1) {
+      T a = detail::triangleArea(points[p], points[q], points[next[q]]);
+      area[q] = a < top.first ? top.first : a;
+      heap.push(Entry(area[q], q));
+    }
+  }
+
+  for (std::size_t i = 0; i < n; i++) {
+    if (removed[i] == 0) {
+      result.push_back(i);
+    }
+  }
+
+  return result;
+}
+
+/**
+ * @brief Selects points of a polyline by index.
+ *
+ * This can be used with the indices returned by svector::douglasPeucker()
+ * and svector::visvalingamWhyatt().
+ *
+ * @tparam V Point type.
+ *
+ * @param points The polyline.
+ * @param indices The indices of the points to select.
+ *
+ * @returns The selected points.
+ */
+template <typename V>
+std::vector<V> selectPoints(const std::vector<V> &points,
+                            const std::vector<std::size_t> &indices) {
+  std::vector<V> result;
+  result.reserve(indices.size());
+  for (const auto &i : indices) {
+    result.push_back(points[i]);
+  }
+
+  return result;
+}
+
+/**
+ * @brief Length of a polyline.
+ *
+ * @tparam V Point type.
+ *
+ * @param points The polyline.
+ *
+ * @returns The sum of the lengths of the segments.
+ */
+template <typename V>
+typename VectorTraits<V>::value_type
+polylineLength(const std::vector<V> &points) {
+  typename VectorTraits<V>::value_type length = 0;
+  for (std::size_t i = 1; i < points.size(); i++) {
+    length += detail::pointDistance(points[i - 1], points[i]);
+  }
+
+  return length;
+}
+
+/**
+ * @brief Resamples a polyline at uniform arc length.
+ *
+ * Returns points that are evenly spaced along the polyline, measured along
+ * the path. The first and last points are the ends of the polyline.
+ *
+ * @tparam V Point type.
+ *
+ * @param points The polyline.
+ * @param count The number of points to return. Must be at least 2.
+ *
+ * @returns The resampled points.
+ */
+template <typename V>
+std::vector<V> resample(const std::vector<V> &points, const std::size_t count) {
+  typedef typename VectorTraits<V>::value_type T;
+  const std::size_t D = VectorTraits<V>::dimensions;
+
+  std::vector<V> result;
+  if (points.empty() || count == 0) {
+    return result;
+  }
+
+  result.reserve(count);
+  if (points.size() == 1 || count == 1) {
+    result.assign(count, points.front());
+    return result;
+  }
+
+  const T step = polylineLength(points) / static_cast<T>(count - 1);
+  result.push_back(points.front());
+
+  // walk the segments once, carrying the distance into the current segment
+  std::size_t seg = 1;
+  T segStart = 0;
+  T segLength = detail::pointDistance(points[0], points[1]);
+  for (std::size_t k = 1; k + 1 < count; k++) {
+    const T target = step * static_cast<T>(k);
+    while (segStart + segLength < target && seg + 1 < points.size()) {
+      segStart += segLength;
+      seg++;
+      segLength = detail::pointDistance(points[seg - 1], points[seg]);
+    }
+
+    const T u = segLength == 0 ? 0 : (target - segStart) / segLength;
+    V p;
+    for (std::size_t i = 0; i < D; i++) {
+      p[i] = points[seg - 1][i] + (points[seg][i] - points[seg - 1][i]) * u;
+    }
+    result.push_back(p);
+  }
+
+  result.push_back(points.back());
+  return result;
+}
+} // namespace svector
+
+#endif
@@ -0,0 +1,845 @@
+/**
+ * @file predicates.hpp
+ *
+ * @brief Robust geometric predicates.
+ *
+ * The predicates first evaluate the determinant in floating point and compare
+ * it against an error bound. Only when the sign cannot be trusted do they
+ * escalate: first to an exact determinant of the rounded coordinate
+ * differences (which is enough when the subtractions were exact), then to a
+ * fully exact determinant using floating-point expansions (see Shewchuk,
+ * "Adaptive Precision Floating-Point Arithmetic and Fast Robust Geometric
+ * Predicates").
+ *
+ * The components are converted to double, so the signs are exact for double
+ * and float vectors.
+ *
+ * This file is not included in vectors.hpp, so it has to be included
+ * separately.
+ *
+ * @copyright Copyright (c) 2023 Jonathan Liu. This project is released under
+ * the MIT License. All rights reserved.
+ */
+
+#ifndef INCLUDE_SVECTOR_PREDICATES_HPP_
+#define INCLUDE_SVECTOR_PREDICATES_HPP_
+
+#include <cstddef> // std::size_t
+#include <vector>  // std::vector
+
+#include "simplevectors/core/traits.hpp" // svector::VectorTraits
+
+namespace svector {
+namespace detail {
+/**
+ * Error bound constants, where epsilon is half of a unit in the last place
+ * of 1.0 (2^-53 for doubles).
+ */
+struct PredicateBounds {
+  static double epsilon() { return 1.1102230246251565e-16; }
+  static double splitter() { return 134217729.0; } // 2^27 + 1
+  static double orient2dA() { return (3.0 + 16.0 * epsilon()) * epsilon(); }
+  static double orient2dB() { return (2.0 + 12.0 * epsilon()) * epsilon(); }
+  static double orient3dA() { return (7.0 + 56.0 * epsilon()) * epsilon(); }
+  static double incircleA() { return (10.0 + 96.0 * epsilon()) * epsilon(); }
+  static double insphereA() { return (16.0 + 224.0 * epsilon()) * epsilon(); }
+};
+
+/**
+ * Computes a + b exactly as x + y, where x is the rounded sum.
+ */
+inline void twoSum(const double a, const double b, double &x, double &y) {
+  x = a + b;
+  const double bVirtual = x - a;
+  const double aVirtual = x - bVirtual;
+  const double bRound = b - bVirtual;
+  const double aRound = a - aVirtual;
+  y = aRound + bRound;
+}
+
+/**
+ * Splits a into two non-overlapping halves with 26 bits each.
+ */
+inline void split(const double a, double &hi, double &lo) {
+  const double c = PredicateBounds::splitter() * a;
+  const double aBig = c - a;
+  hi = c - aBig;
+  lo = a - hi;
+}
+
+/**
+ * Computes a * b exactly as x + y, where x is the rounded product.
+ */
+inline void twoProduct(const double a, const double b, double &x, double &y) {
+  x = a * b;
+  double aHi = 0;
+  double aLo = 0;
+  double bHi = 0;
+  double bLo = 0;
+  split(a, aHi, aLo);
+  split(b, bHi, bLo);
+  const double err1 = x - aHi * bHi;
+  const double err2 = err1 - aLo * bHi;
+  const double err3 = err2 - aHi * bLo;
+  y = aLo * bLo - err3;
+}
+
+/**
+ * Adds a scalar to an expansion. h must have room for elen + 1 components.
+ * Zero components are removed.
+ *
+ * @returns The number of components of h.
+ */
+inline std::size_t growExpansion(const std::size_t elen, const double *e,
+                                 const double b, double *h) {
+  double q = b;
+  std::size_t hlen = 0;
+  for (std::size_t i = 0; i < elen; i++) {
+    double sum = 0;
+    double err = 0;
+    twoSum(q, e[i], sum, err);
+    q = sum;
+    if (err != 0) {
+      h[hlen++] = err;
+    }
+  }
+
+  if (q != 0 || hlen == 0) {
+    h[hlen++] = q;
+  }
+
+  return hlen;
+}
+
+/**
+ * Adds two expansions. h must have room for elen + flen components.
+ *
+ * @returns The number of components of h.
+ */
+inline std::size_t expansionSum(const std::size_t elen, const double *e,
+                                const std::size_t flen, const double *f,
+                                double *h) {
+  for (std::size_t i = 0; i < elen; i++) {
+    h[i] = e[i];
+  }
+
+  std::size_t hlen = elen;
+  for (std::size_t i = 0; i < flen; i++) {
+    // grow in place: each step reads h[0..hlen) and writes at most hlen + 1
+    double q = f[i];
+    std::size_t out = 0;
+    for (std::size_t j = 0; j < hlen; j++) {
+      double sum = 0;
+      double err = 0;
+      twoSum(q, h[j], sum, err);
+      q = sum;
+      if (err != 0) {
+        h[out++] = err;
+      }
+    }
+
+    if (q != 0 || out == 0) {
+      h[out++] = q;
+    }
+    hlen = out;
+  }
+
+  return hlen;
+}
+
+/**
+ * Multiplies an expansion by a scalar. h must have room for 2 * elen
+ * components.
+ *
+ * @returns The number of components of h.
+ */
+inline std::size_t scaleExpansion(const std::size_t elen, const double *e,
+                                  const double b, double *h) {
+  std::size_t hlen = 0;
+  double q = 0;
+  double err = 0;
+  twoProduct(e[0], b, q, err);
+  if (err != 0) {
+    h[hlen++] = err;
+  }
+
+  for (std::size_t i = 1; i < elen; i++) {
+    double product = 0;
+    double productErr = 0;
+    twoProduct(e[i], b, product, productErr);
+
+    double sum = 0;
+    twoSum(q, productErr, sum, err);
+    if (err != 0) {
+      h[hlen++] = err;
+    }
+
+    twoSum(product, sum, q, err);
+    if (err != 0) {
+      h[hlen++] = err;
+    }
+  }
+
+  if (q != 0 || hlen == 0) {
+    h[hlen++] = q;
+  }
+
+  return hlen;
+}
+
+/**
+ * Exact value of a * b - c * d as an expansion of up to 4 components.
+ *
+ * @returns The number of components of h.
+ */
+inline std::size_t twoTwoDiff(const double a, const double b, const double c,
+                              const double d, double *h) {
+  double p[2];
+  double m[2];
+  twoProduct(a, b, p[1], p[0]);
+  twoProduct(c, d, m[1], m[0]);
+  m[0] = -m[0];
+  m[1] = -m[1];
+  return expansionSum(2, p, 2, m, h);
+}
+
+/**
+ * Negates every component of an expansion.
+ */
+inline void negateExpansion(const std::size_t elen, const double *e,
+                            double *h) {
+  for (std::size_t i = 0; i < elen; i++) {
+    h[i] = -e[i];
+  }
+}
+
+/**
+ * Sign-carrying approximation of an expansion: its largest component.
+ */
+inline double expansionSign(const std::size_t elen, const double *e) {
+  return e[elen - 1];
+}
+
+/**
+ * Exact orient2d of six coordinates.
+ */
+inline double orient2dExact(const double ax, const double ay, const double bx,
+                            const double by, const double cx,
+                            const double cy) {
+  // ax by - ay bx + bx cy - by cx + cx ay - cy ax
+  double t1[4];
+  double t2[4];
+  double t3[4];
+  double s12[8];
+  double det[12];
+  const std::size_t l1 = twoTwoDiff(ax, by, ay, bx, t1);
+  const std::size_t l2 = twoTwoDiff(bx, cy, by, cx, t2);
+  const std::size_t l3 = twoTwoDiff(cx, ay, cy, ax, t3);
+  const std::size_t l12 = expansionSum(l1, t1, l2, t2, s12);
+  const std::size_t len = expansionSum(l12, s12, l3, t3, det);
+  return expansionSign(len, det);
+}
+
+/**
+ * Exact orient3d of four points given as coordinate arrays.
+ *
+ * Expands the 4x4 determinant with rows (x, y, z, 1) along the z and 1
+ * columns, so every term is a 2x2 xy-minor multiplied by one z-coordinate.
+ */
+inline double orient3dExact(const double *a, const double *b, const double *c,
+                            const double *d) {
+  double ab[4];
+  double ac[4];
+  double ad[4];
+  double bc[4];
+  double bd[4];
+  double cd[4];
+  const std::size_t lab = twoTwoDiff(a[0], b[1], b[0], a[1], ab);
+  const std::size_t lac = twoTwoDiff(a[0], c[1], c[0], a[1], ac);
+  const std::size_t lad = twoTwoDiff(a[0], d[1], d[0], a[1], ad);
+  const std::size_t lbc = twoTwoDiff(b[0], c[1], c[0], b[1], bc);
+  const std::size_t lbd = twoTwoDiff(b[0], d[1], d[0], b[1], bd);
+  const std::size_t lcd = twoTwoDiff(c[0], d[1], d[0], c[1], cd);
+
+  // negated copies of the minors
+  double nab[4];
+  double nac[4];
+  double nad[4];
+  double nbd[4];
+  double ncd[4];
+  double nbc[4];
+  negateExpansion(lab, ab, nab);
+  negateExpansion(lac, ac, nac);
+  negateExpansion(lad, ad, nad);
+  negateExpansion(lbd, bd, nbd);
+  negateExpansion(lcd, cd, ncd);
+  negateExpansion(lbc, bc, nbc);
+
+  // the factor of each z-coordinate is a sum of three minors
+  double tmp[8];
+  double fa[12];
+  double fb[12];
+  double fc[12];
+  double fd[12];
+  std::size_t ltmp = expansionSum(lbc, bc, lbd, nbd, tmp);
+  const std::size_t lfa = expansionSum(ltmp, tmp, lcd, cd, fa);
+  ltmp = expansionSum(lad, ad, lac, nac, tmp);
+  const std::size_t lfb = expansionSum(ltmp, tmp, lcd, ncd, fb);
+  ltmp = expansionSum(lab, ab, lad, nad, tmp);
+  const std::size_t lfc = expansionSum(ltmp, tmp, lbd, bd, fc);
+  ltmp = expansionSum(lac, ac, lab, nab, tmp);
+  const std::size_t lfd = expansionSum(ltmp, tmp, lbc, nbc, fd);
+
+  double za[24];
+  double zb[24];
+  double zc[24];
+  double zd[24];
+  const std::size_t lza = scaleExpansion(lfa, fa, a[2], za);
+  const std::size_t lzb = scaleExpansion(lfb, fb, b[2], zb);
+  const std::size_t lzc = scaleExpansion(lfc, fc, c[2], zc);
+  const std::size_t lzd = scaleExpansion(lfd, fd, d[2], zd);
+
+  double sab[48];
+  double scd[48];
+  double det[96];
+  const std::size_t lsab = expansionSum(lza, za, lzb, zb, sab);
+  const std::size_t lscd = expansionSum(lzc, zc, lzd, zd, scd);
+  const std::size_t len = expansionSum(lsab, sab, lscd, scd, det);
+  return expansionSign(len, det);
+}
+
+/**
+ * Exact orient3d of the translated points a - d, b - d, c - d, used when the
+ * subtractions were exact. This is cheaper than svector::detail::orient3dExact
+ * because only three minors are needed.
+ */
+inline double orient3dDiffExact(const double adx, const double bdx,
+                                const double cdx, const double ady,
+                                const double bdy, const double cdy,
+                                const double adz, const double bdz,
+                                const double cdz) {
+  double bc[4];
+  double ca[4];
+  double ab[4];
+  const std::size_t lbc = twoTwoDiff(bdx, cdy, cdx, bdy, bc);
+  const std::size_t lca = twoTwoDiff(cdx, ady, adx, cdy, ca);
+  const std::size_t lab = twoTwoDiff(adx, bdy, bdx, ady, ab);
+
+  double ta[8];
+  double tb[8];
+  double tc[8];
+  const std::size_t lta = scaleExpansion(lbc, bc, adz, ta);
+  const std::size_t ltb = scaleExpansion(lca, ca, bdz, tb);
+  const std::size_t ltc = scaleExpansion(lab, ab, cdz, tc);
+
+  double tab[16];
+  double det[24];
+  const std::size_t ltab = expansionSum(lta, ta, ltb, tb, tab);
+  const std::size_t len = expansionSum(ltab, tab, ltc, tc, det);
+  return expansionSign(len, det);
+}
+
+/**
+ * An arbitrary precision number stored as a floating-point expansion.
+ *
+ * This is used for the exact stage of the predicates with large
+ * determinants, where fixed-size buffers would be wasteful. Differences of
+ * coordinates that happen to be exact have a single component, so the cost
+ * of each operation adapts to how much precision is actually needed.
+ */
+class Expansion {
+public:
+  /**
+   * Initializes zero.
+   */
+  Expansion() = default;
+
+  /**
+   * Initializes from a double.
+   */
+  explicit Expansion(const double value) {
+    if (value != 0) {
+      this->m_components.push_back(value);
+    }
+  }
+
+  /**
+   * Exact difference a - b.
+   */
+  static Expansion difference(const double a, const double b) {
+    Expansion result;
+    double x = 0;
+    double y = 0;
+    twoSum(a, -b, x, y);
+    if (y != 0) {
+      result.m_components.push_back(y);
+    }
+    if (x != 0) {
+      result.m_components.push_back(x);
+    }
+
+    return result;
+  }
+
+  /**
+   * Exact sum.
+   */
+  Expansion operator+(const Expansion &other) const {
+    if (this->m_components.empty()) {
+      return other;
+    }
+    if (other.m_components.empty()) {
+      return *this;
+    }
+
+    Expansion result;
+    result.m_components.resize(this->m_components.size() +
+                               other.m_components.size());
+    const std::size_t len = expansionSum(
+        this->m_components.size(), this->m_components.data(),
+        other.m_components.size(), other.m_components.data(),
+        result.m_components.data());
+    result.m_components.resize(len);
+    result.trim();
+    return result;
+  }
+
+  /**
+   * Exact negation.
+   */
+  Expansion operator-() const {
+    Expansion result(*this);
+    for (auto &component : result.m_components) {
+      component = -component;
+    }
+
+    return result;
+  }
+
+  /**
+   * Exact difference.
+   */
+  Expansion operator-(const Expansion &other) const {
+    return (*this) + (-other);
+  }
+
+  /**
+   * Exact product.
+   */
+  Expansion operator*(const Expansion &other) const {
+    Expansion result;
+    if (this->m_components.empty()) {
+      return result;
+    }
+
+    Expansion term;
+    for (const auto &factor : other.m_components) {
+      term.m_components.resize(2 * this->m_components.size());
+      const std::size_t len =
+          scaleExpansion(this->m_components.size(), this->m_components.data(),
+                         factor, term.m_components.data());
+      term.m_components.resize(len);
+      term.trim();
+      result = result + term;
+    }
+
+    return result;
+  }
+
+  /**
+   * Sign-carrying approximation of the value.
+   */
+  double sign() const {
+    return this->m_components.empty() ? 0 : this->m_components.back();
+  }
+
+private:
+  std::vector<double> m_components; //!< Components in increasing magnitude.
+
+  /**
+   * Removes the single zero component left by zero elimination.
+   */
+  void trim() {
+    if (this->m_components.size() == 1 && this->m_components[0] == 0) {
+      this->m_components.clear();
+    }
+  }
+};
+
+/**
+ * Adaptive orient2d on raw coordinates, see svector::orient2d().
+ */
+inline double orient2dAdaptive(const double ax, const double ay,
+                               const double bx, const double by,
+                               const double cx, const double cy) {
+  const double detLeft = (ax - cx) * (by - cy);
+  const double detRight = (ay - cy) * (bx - cx);
+  const double det = detLeft - detRight;
+
+  double detSum = 0;
+  if (detLeft > 0) {
+    if (detRight <= 0) {
+      return det;
+    }
+    detSum = detLeft + detRight;
+  } else if (detLeft < 0) {
+    if (detRight >= 0) {
+      return det;
+    }
+    detSum = -detLeft - detRight;
+  } else {
+    return det;
+  }
+
+  const double errBound = PredicateBounds::orient2dA() * detSum;
+  if (det >= errBound || -det >= errBound) {
+    return det;
+  }
+
+  // exact determinant of the rounded differences
+  const double acx = ax - cx;
+  const double bcx = bx - cx;
+  const double acy = ay - cy;
+  const double bcy = by - cy;
+  double diffDet[4];
+  const std::size_t diffLen = twoTwoDiff(acx, bcy, acy, bcx, diffDet);
+
+  double acxTail = 0;
+  double bcxTail = 0;
+  double acyTail = 0;
+  double bcyTail = 0;
+  double rounded = 0;
+  twoSum(ax, -cx, rounded, acxTail);
+  twoSum(bx, -cx, rounded, bcxTail);
+  twoSum(ay, -cy, rounded, acyTail);
+  twoSum(by, -cy, rounded, bcyTail);
+  if (acxTail == 0 && bcxTail == 0 && acyTail == 0 && bcyTail == 0) {
+    return expansionSign(diffLen, diffDet);
+  }
+
+  double estimate = 0;
+  for (std::size_t i = 0; i < diffLen; i++) {
+    estimate += diffDet[i];
+  }
+
+  const double errBoundB = PredicateBounds::orient2dB() * detSum;
+  if (estimate >= errBoundB || -estimate >= errBoundB) {
+    return estimate;
+  }
+
+  return orient2dExact(ax, ay, bx, by, cx, cy);
+}
+
+/**
+ * Adaptive incircle on raw coordinates, see svector::incircle().
+ */
+inline double incircleAdaptive(const double ax, const double ay,
+                               const double bx, const double by,
+                               const double cx, const double cy,
+                               const double dx, const double dy) {
+  const double adx = ax - dx;
+  const double bdx = bx - dx;
+  const double cdx = cx - dx;
+  const double ady = ay - dy;
+  const double bdy = by - dy;
+  const double cdy = cy - dy;
+
+  const double bdxcdy = bdx * cdy;
+  const double cdxbdy = cdx * bdy;
+  const double alift = adx * adx + ady * ady;
+
+  const double cdxady = cdx * ady;
+  const double adxcdy = adx * cdy;
+  const double blift = bdx * bdx + bdy * bdy;
+
+  const double adxbdy = adx * bdy;
+  const double bdxady = bdx * ady;
+  const double clift = cdx * cdx + cdy * cdy;
+
+  const double det = alift * (bdxcdy - cdxbdy) + blift * (cdxady - adxcdy) +
+                     clift * (adxbdy - bdxady);
+
+  const auto abs = [](const double x) { return x < 0 ? -x : x; };
+  const double permanent = (abs(bdxcdy) + abs(cdxbdy)) * alift +
+                           (abs(cdxady) + abs(adxcdy)) * blift +
+                           (abs(adxbdy) + abs(bdxady)) * clift;
+  const double errBound = PredicateBounds::incircleA() * permanent;
+  if (det > errBound || -det > errBound) {
+    return det;
+  }
+
+  typedef Expansion E;
+  const E eadx = E::difference(ax, dx);
+  const E ebdx = E::difference(bx, dx);
+  const E ecdx = E::difference(cx, dx);
+  const E eady = E::difference(ay, dy);
+  const E ebdy = E::difference(by, dy);
+  const E ecdy = E::difference(cy, dy);
+
+  const E exact = (eadx * eadx + eady * eady) * (ebdx * ecdy - ecdx * ebdy) +
+                  (ebdx * ebdx + ebdy * ebdy) * (ecdx * eady - eadx * ecdy) +
+                  (ecdx * ecdx + ecdy * ecdy) * (eadx * ebdy - ebdx * eady);
+  return exact.sign();
+}
+
+/**
+ * Copies the first three components of a vector into an array of doubles.
+ */
+template <typename V> void toArray3(const V &v, double *out) {
+  for (std::size_t i = 0; i < 3; i++) {
+    out[i] = static_cast<double>(v[i]);
+  }
+}
+} // namespace detail
+
+/**
+ * @brief Orientation of three 2D points.
+ *
+ * @tparam V 2D point type.
+ *
+ * @param a The first point.
+ * @param b The second point.
+ * @param c The third point.
+ *
+ * @returns A positive value if a, b, c are in counterclockwise order, a
+ * negative value if they are in clockwise order, and zero if they are
+ * collinear. The sign is always exact; the value approximates twice the
+ * signed area of the triangle.
+ */
+template <typename V> double orient2d(const V &a, const V &b, const V &c) {
+  static_assert(VectorTraits<V>::dimensions == 2,
+                "orient2d requires 2D vectors");
+
+  return detail::orient2dAdaptive(
+      static_cast<double>(a[0]), static_cast<double>(a[1]),
+      static_cast<double>(b[0]), static_cast<double>(b[1]),
+      static_cast<double>(c[0]), static_cast<double>(c[1]));
+}
+
+/**
+ * @brief Orientation of four 3D points.
+ *
+ * @tparam V 3D point type.
+ *
+ * @param a The first point.
+ * @param b The second point.
+ * @param c The third point.
+ * @param d The point to test.
+ *
+ * @returns A positive value if d lies below the plane through a, b, c, where
+ * "below" means that a, b, c appear in counterclockwise order when viewed
+ * from above. Returns a negative value if d lies above the plane, and zero if
+ * the points are coplanar. The sign is always exact; the value approximates
+ * six times the signed volume of the tetrahedron.
+ */
+template <typename V>
+double orient3d(const V &a, const V &b, const V &c, const V &d) {
+  static_assert(VectorTraits<V>::dimensions == 3,
+                "orient3d requires 3D vectors");
+
+  double pa[3];
+  double pb[3];
+  double pc[3];
+  double pd[3];
+  detail::toArray3(a, pa);
+  detail::toArray3(b, pb);
+  detail::toArray3(c, pc);
+  detail::toArray3(d, pd);
+
+  const double adx = pa[0] - pd[0];
+  const double bdx = pb[0] - pd[0];
+  const double cdx = pc[0] - pd[0];
+  const double ady = pa[1] - pd[1];
+  const double bdy = pb[1] - pd[1];
+  const double cdy = pc[1] - pd[1];
+  const double adz = pa[2] - pd[2];
+  const double bdz = pb[2] - pd[2];
+  const double cdz = pc[2] - pd[2];
+
+  const double bdxcdy = bdx * cdy;
+  const double cdxbdy = cdx * bdy;
+  const double cdxady = cdx * ady;
+  const double adxcdy = adx * cdy;
+  const double adxbdy = adx * bdy;
+  const double bdxady = bdx * ady;
+
+  const double det = adz * (bdxcdy - cdxbdy) + bdz * (cdxady - adxcdy) +
+                     cdz * (adxbdy - bdxady);
+
+  const auto abs = [](const double x) { return x < 0 ? -x : x; };
+  const double permanent =
+      (abs(bdxcdy) + abs(cdxbdy)) * abs(adz) +
+      (abs(cdxady) + abs(adxcdy)) * abs(bdz) +
+      (abs(adxbdy) + abs(bdxady)) * abs(cdz);
+  const double errBound = detail::PredicateBounds::orient3dA() * permanent;
+  if (det > errBound || -det > errBound) {
+    return det;
+  }
+
+  // nearby coordinates usually subtract exactly, and then only the 3x3
+  // determinant of the differences has to be computed exactly
+  bool exactDiffs = true;
+  for (std::size_t i = 0; i < 3 && exactDiffs; i++) {
+    double rounded = 0;
+    double tail = 0;
+    detail::twoSum(pa[i], -pd[i], rounded, tail);
+    exactDiffs = tail == 0;
+    detail::twoSum(pb[i], -pd[i], rounded, tail);
+    exactDiffs = exactDiffs && tail == 0;
+    detail::twoSum(pc[i], -pd[i], rounded, tail);
+    exactDiffs = exactDiffs && tail == 0;
+  }
+
+  if (exactDiffs) {
+    return detail::orient3dDiffExact(adx, bdx, cdx, ady, bdy, cdy, adz, bdz,
+                                     cdz);
+  }
+
+  return detail::orient3dExact(pa, pb, pc, pd);
+}
+
+/**
+ * @brief Whether a point is inside the circle through three 2D points.
+ *
+ * @tparam V 2D point type.
+ *
+ * @param a The first point on the circle.
+ * @param b The second point on the circle.
+ * @param c The third point on the circle.
+ * @param d The point to test.
+ *
+ * @returns A positive value if d lies inside the circle through a, b, c, a
+ * negative value if it lies outside, and zero if the four points are
+ * cocircular. a, b, c must be in counterclockwise order, otherwise the sign
+ * is reversed. The sign is always exact.
+ */
+template <typename V>
+double incircle(const V &a, const V &b, const V &c, const V &d) {
+  static_assert(VectorTraits<V>::dimensions == 2,
+                "incircle requires 2D vectors");
+
+  return detail::incircleAdaptive(
+      static_cast<double>(a[0]), static_cast<double>(a[1]),
+      static_cast<double>(b[0]), static_cast<double>(b[1]),
+      static_cast<double>(c[0]), static_cast<double>(c[1]),
+      static_cast<double>(d[0]), static_cast<double>(d[1]));
+}
+
+/**
+ * @brief Whether a point is inside the sphere through four 3D points.
+ *
+ * @tparam V 3D point type.
+ *
+ * @param a The first point on the sphere.
+ * @param b The second point on the sphere.
+ * @param c The third point on the sphere.
+ * @param d The fourth point on the sphere.
+ * @param e The point to test.
+ *
+ * @returns A positive value if e lies inside the sphere through a, b, c, d, a
+ * negative value if it lies outside, and zero if the five points are
+ * cospherical. The points a, b, c, d must have positive orientation (see
+ * svector::orient3d()), otherwise the sign is reversed. The sign is always
+ * exact.
+ */
+template <typename V>
+double insphere(const V &a, const V &b, const V &c, const V &d, const V &e) {
+  static_assert(VectorTraits<V>::dimensions == 3,
+                "insphere requires 3D vectors");
+
+  double pa[3];
+  double pb[3];
+  double pc[3];
+  double pd[3];
+  double pe[3];
+  detail::toArray3(a, pa);
+  detail::toArray3(b, pb);
+  detail::toArray3(c, pc);
+  detail::toArray3(d, pd);
+  detail::toArray3(e, pe);
+
+  double ae[3];
+  double be[3];
+  double ce[3];
+  double de[3];
+  for (std::size_t i = 0; i < 3; i++) {
+    ae[i] = pa[i] - pe[i];
+    be[i] = pb[i] - pe[i];
+    ce[i] = pc[i] - pe[i];
+    de[i] = pd[i] - pe[i];
+  }
+
+  // 2x2 xy-minors, and the permanents with every product made positive
+  const auto abs = [](const double x) { return x < 0 ? -x : x; };
+  const double ab = ae[0] * be[1] - be[0] * ae[1];
+  const double bc = be[0] * ce[1] - ce[0] * be[1];
+  const double cd = ce[0] * de[1] - de[0] * ce[1];
+  const double da = de[0] * ae[1] - ae[0] * de[1];
+  const double ac = ae[0] * ce[1] - ce[0] * ae[1];
+  const double bd = be[0] * de[1] - de[0] * be[1];
+  const double abP = abs(ae[0] * be[1]) + abs(be[0] * ae[1]);
+  const double bcP = abs(be[0] * ce[1]) + abs(ce[0] * be[1]);
+  const double cdP = abs(ce[0] * de[1]) + abs(de[0] * ce[1]);
+  const double daP = abs(de[0] * ae[1]) + abs(ae[0] * de[1]);
+  const double acP = abs(ae[0] * ce[1]) + abs(ce[0] * ae[1]);
+  const double bdP = abs(be[0] * de[1]) + abs(de[0] * be[1]);
+
+  const double abc = ae[2] * bc - be[2] * ac + ce[2] * ab;
+  const double bcd = be[2] * cd - ce[2] * bd + de[2] * bc;
+  const double cda = ce[2] * da + de[2] * ac + ae[2] * cd;
+  const double dab = de[2] * ab + ae[2] * bd + be[2] * da;
+  const double abcP = abs(ae[2]) * bcP + abs(be[2]) * acP + abs(ce[2]) * abP;
+  const double bcdP = abs(be[2]) * cdP + abs(ce[2]) * bdP + abs(de[2]) * bcP;
+  const double cdaP = abs(ce[2]) * daP + abs(de[2]) * acP + abs(ae[2]) * cdP;
+  const double dabP = abs(de[2]) * abP + abs(ae[2]) * bdP + abs(be[2]) * daP;
+
+  const double alift = ae[0] * ae[0] + ae[1] * ae[1] + ae[2] * ae[2];
+  const double blift = be[0] * be[0] + be[1] * be[1] + be[2] * be[2];
+  const double clift = ce[0] * ce[0] + ce[1] * ce[1] + ce[2] * ce[2];
+  const double dlift = de[0] * de[0] + de[1] * de[1] + de[2] * de[2];
+
+  const double det =
+      (dlift * abc - clift * dab) + (blift * cda - alift * bcd);
+  const double permanent =
+      dlift * abcP + clift * dabP + blift * cdaP + alift * bcdP;
+  const double errBound = detail::PredicateBounds::insphereA() * permanent;
+  if (det > errBound || -det > errBound) {
+    return det;
+  }
+
+  typedef detail::Expansion E;
+  E ex[4][3];
+  for (std::size_t i = 0; i < 3; i++) {
+    ex[0][i] = E::difference(pa[i], pe[i]);
+    ex[1][i] = E::difference(pb[i], pe[i]);
+    ex[2][i] = E::difference(pc[i], pe[i]);
+    ex[3][i] = E::difference(pd[i], pe[i]);
+  }
+
+  const auto minor = [&ex](const std::size_t i, const std::size_t j) {
+    return ex[i][0] * ex[j][1] - ex[j][0] * ex[i][1];
+  };
+  const E eab = minor(0, 1);
+  const E ebc = minor(1, 2);
+  const E ecd = minor(2, 3);
+  const E eda = minor(3, 0);
+  const E eac = minor(0, 2);
+  const E ebd = minor(1, 3);
+
+  const E eabc = ex[0][2] * ebc - ex[1][2] * eac + ex[2][2] * eab;
+  const E ebcd = ex[1][2] * ecd - ex[2][2] * ebd + ex[3][2] * ebc;
+  const E ecda = ex[2][2] * eda + ex[3][2] * eac + ex[0][2] * ecd;
+  const E edab = ex[3][2] * eab + ex[0][2] * ebd + ex[1][2] * eda;
+
+  E lift[4];
+  for (std::size_t i = 0; i < 4; i++) {
+    lift[i] = ex[i][0] * ex[i][0] + ex[i][1] * ex[i][1] + ex[i][2] * ex[i][2];
+  }
+
+  const E exact = (lift[3] * eabc - lift[2] * edab) +
+                  (lift[1] * ecda - lift[0] * ebcd);
+  return exact.sign();
+}
+} // namespace svector
+
+#endif
@@ -0,0 +1,378 @@
+/**
+ * @file rays.hpp
+ *
+ * @brief Intersection of ray packets with spheres, planes, boxes and
+ * triangles.
+ *
+ * Rays are grouped into packets of a fixed width, stored as separate arrays
+ * for each coordinate. Every kernel tests one primitive against all rays of
+ * a packet in a loop without branches, which the compiler can turn into SIMD
+ * instructions of the matching width (for example 4 doubles with AVX).
+ *
+ * The kernels keep the closest hit: a hit record is only overwritten where
+ * the new hit is closer than the one already stored. To find the closest hit
+ * among many primitives, reset the hits once and call the kernels for every
+ * primitive.
+ *
+ * This file is not included in vectors.hpp, so it has to be included
+ * separately.
+ *
+ * @copyright Copyright (c) 2023 Jonathan Liu. This project is released under
+ * the MIT License. All rights reserved.
+ */
+
+#ifndef INCLUDE_SVECTOR_RAYS_HPP_
+#define INCLUDE_SVECTOR_RAYS_HPP_
+
+#include <cmath>   // std::sqrt
+#include <cstddef> // std::size_t
+#include <limits>  // std::numeric_limits
+
+#include "simplevectors/core/traits.hpp" // svector::VectorTraits
+
+namespace svector {
+/**
+ * @brief A packet of rays in structure-of-arrays layout.
+ *
+ * Directions do not have to be normalized; hit distances are then measured
+ * in multiples of the direction length.
+ *
+ * @tparam N The number of rays in the packet.
+ */
+template <std::size_t N> struct RayPacket {
+  double ox[N]; //!< Origin x-coordinates.
+  double oy[N]; //!< Origin y-coordinates.
+  double oz[N]; //!< Origin z-coordinates.
+  double dx[N]; //!< Direction x-coordinates.
+  double dy[N]; //!< Direction y-coordinates.
+  double dz[N]; //!< Direction z-coordinates.
+
+  /**
+   * @brief Sets one ray of the packet.
+   *
+   * @tparam V 3D point type.
+   *
+   * @param i The lane to set.
+   * @param origin The origin of the ray.
+   * @param direction The direction of the ray.
+   */
+  template <typename V>
+  void set(const std::size_t i, const V &origin, const V &direction) {
+    static_assert(VectorTraits<V>::dimensions == 3,
+                  "RayPacket requires 3D vectors");
+
+    this->ox[i] = static_cast<double>(origin[0]);
+    this->oy[i] = static_cast<double>(origin[1]);
+    this->oz[i] = static_cast<double>(origin[2]);
+    this->dx[i] = static_cast<double>(direction[0]);
+    this->dy[i] = static_cast<double>(direction[1]);
+    this->dz[i] = static_cast<double>(direction[2]);
+  }
+
+  /**
+   * @brief Fills the packet from arrays of rays.
+   *
+   * Lanes past count get a zero direction, which never hits anything.
+   *
+   * @tparam V 3D point type.
+   *
+   * @param origins The origins of the rays.
+   * @param directions The directions of the rays.
+   * @param count The number of rays to load, at most N.
+   */
+  template <typename V>
+  void load(const V *origins, const V *directions, const std::size_t count) {
+    for (std::size_t i = 0; i < N; i++) {
+      if (i < count) {
+        this->set(i, origins[i], directions[i]);
+      } else {
+        this->ox[i] = this->oy[i] = this->oz[i] = 0;
+        this->dx[i] = this->dy[i] = this->dz[i] = 0;
+      }
+    }
+  }
+};
+
+/**
+ * @brief The closest hits of a packet of rays.
+ *
+ * @tparam N The number of rays in the packet.
+ */
+template <std::size_t N> struct HitPacket {
+  double t[N];       //!< Hit distance, or the maximum distance if none.
+  double nx[N];      //!< Unit normal x-coordinates at the hit.
+  double ny[N];      //!< Unit normal y-coordinates at the hit.
+  double nz[N];      //!< Unit normal z-coordinates at the hit.
+  std::size_t id[N]; //!< Id of the primitive that was hit.
+
+  /**
+   * @brief Clears all hits.
+   *
+   * @param maxDistance Hits farther than this are ignored.
+   */
+  void reset(const double maxDistance =
+                 std::numeric_limits<double>::infinity()) {
+    for (std::size_t i = 0; i < N; i++) {
+      this->t[i] = maxDistance;
+      this->nx[i] = this->ny[i] = this->nz[i] = 0;
+      this->id[i] = static_cast<std::size_t>(-1);
+    }
+  }
+
+  /**
+   * @brief Whether a ray hit anything.
+   *
+   * @param i The lane.
+   * @param maxDistance The distance the hits were reset with.
+   *
+   * @returns Whether a hit closer than maxDistance was found.
+   */
+  bool hit(const std::size_t i,
+           const double maxDistance =
+               std::numeric_limits<double>::infinity()) const {
+    return this->t[i] < maxDistance;
+  }
+};
+
+typedef RayPacket<4> RayPacket4; //!< Packet of 4 rays.
+typedef RayPacket<8> RayPacket8; //!< Packet of 8 rays.
+typedef HitPacket<4> HitPacket4; //!< Hits of 4 rays.
+typedef HitPacket<8> HitPacket8; //!< Hits of 8 rays.
+
+/**
+ * @brief Intersects a packet of rays with a sphere.
+ *
+ * Rays starting inside the sphere hit it from the inside; the normal always
+ * points away from the center.
+ *
+ * @tparam N The number of rays in the packet.
+ * @tparam V 3D point type.
+ *
+ * @param rays The rays.
+ * @param center The center of the sphere.
+ * @param radius The radius of the sphere.
+ * @param id The id to store for hits.
+ * @param hits The closest hits so far, updated in place.
+ */
+template <std::size_t N, typename V>
+void intersectSphere(const RayPacket<N> &rays, const V &center,
+                     const double radius, const std::size_t id,
+                     HitPacket<N> &hits) {
+  static_assert(VectorTraits<V>::dimensions == 3,
+                "intersectSphere requires 3D vectors");
+
+  const double cx = static_cast<double>(center[0]);
+  const double cy = static_cast<double>(center[1]);
+  const double cz = static_cast<double>(center[2]);
+  const double invRadius = 1 / radius;
+  for (std::size_t i = 0; i < N; i++) {
+    const double px = rays.ox[i] - cx;
+    const double py = rays.oy[i] - cy;
+    const double pz = rays.oz[i] - cz;
+    const double a = rays.dx[i] * rays.dx[i] + rays.dy[i] * rays.dy[i] +
+                     rays.dz[i] * rays.dz[i];
+    const double b = px * rays.dx[i] + py * rays.dy[i] + pz * rays.dz[i];
+    const double c = px * px + py * py + pz * pz - radius * radius;
+    const double disc = b * b - a * c;
+    const double root = std::sqrt(disc > 0 ? disc : 0);
+    const double t0 = (-b - root) / a;
+    const double t1 = (-b + root) / a;
+    const double t = t0 > 0 ? t0 : t1;
+
+    const bool hit = (disc >= 0) & (t > 0) & (t < hits.t[i]);
+    hits.t[i] = hit ? t : hits.t[i];
+    hits.nx[i] = hit ? (px + t * rays.dx[i]) * invRadius : hits.nx[i];
+    hits.ny[i] = hit ? (py + t * rays.dy[i]) * invRadius : hits.ny[i];
+    hits.nz[i] = hit ? (pz + t * rays.dz[i]) * invRadius : hits.nz[i];
+    hits.id[i] = hit ? id : hits.id[i];
+  }
+}
+
+/**
+ * @brief Intersects a packet of rays with a plane.
+ *
+ * Rays parallel to the plane never hit it.
+ *
+ * @tparam N The number of rays in the packet.
+ * @tparam V 3D point type.
+ *
+ * @param rays The rays.
+ * @param point A point on the plane.
+ * @param normal The normal of the plane; it does not need to be normalized.
+ * @param id The id to store for hits.
+ * @param hits The closest hits so far, updated in place.
+ */
+template <std::size_t N, typename V>
+void intersectPlane(const RayPacket<N> &rays, const V &point, const V &normal,
+                    const std::size_t id, HitPacket<N> &hits) {
+  static_assert(VectorTraits<V>::dimensions == 3,
+                "intersectPlane requires 3D vectors");
+
+  const double nx = static_cast<double>(normal[0]);
+  const double ny = static_cast<double>(normal[1]);
+  const double nz = static_cast<double>(normal[2]);
+  const double invLength = 1 / std::sqrt(nx * nx + ny * ny + nz * nz);
+  const double offset = nx * static_cast<double>(point[0]) +
+                        ny * static_cast<double>(point[1]) +
+                        nz * static_cast<double>(point[2]);
+  for (std::size_t i = 0; i < N; i++) {
+    const double denom = nx * rays.dx[i] + ny * rays.dy[i] + nz * rays.dz[i];
+    const double t =
+        (offset - nx * rays.ox[i] - ny * rays.oy[i] - nz * rays.oz[i]) / denom;
+
+    // a ray parallel to the plane gives an infinite or NaN distance
+    const bool hit = (t > 0) & (t < hits.t[i]);
+    hits.t[i] = hit ? t : hits.t[i];
+    hits.nx[i] = hit ? nx * invLength : hits.nx[i];
+    hits.ny[i] = hit ? ny * invLength : hits.ny[i];
+    hits.nz[i] = hit ? nz * invLength : hits.nz[i];
+    hits.id[i] = hit ? id : hits.id[i];
+  }
+}
+
+/**
+ * @brief Intersects a packet of rays with an axis-aligned box.
+ *
+ * Uses the slab test. Rays starting inside the box hit its far side; the
+ * normal always points out of the box.
+ *
+ * @tparam N The number of rays in the packet.
+ * @tparam V 3D point type.
+ *
+ * @param rays The rays.
+ * @param lower The corner of the box with the smallest coordinates.
+ * @param upper The corner of the box with the largest coordinates.
+ * @param id The id to store for hits.
+ * @param hits The closest hits so far, updated in place.
+ */
+template <std::size_t N, typename V>
+void intersectBox(const RayPacket<N> &rays, const V &lower, const V &upper,
+                  const std::size_t id, HitPacket<N> &hits) {
+  static_assert(VectorTraits<V>::dimensions == 3,
+                "intersectBox requires 3D vectors");
+
+  const double lx = static_cast<double>(lower[0]);
+  const double ly = static_cast<double>(lower[1]);
+  const double lz = static_cast<double>(lower[2]);
+  const double ux = static_cast<double>(upper[0]);
+  const double uy = static_cast<double>(upper[1]);
+  const double uz = static_cast<double>(upper[2]);
+  for (std::size_t i = 0; i < N; i++) {
+    // a zero direction component gives infinite slab distances
+    const double ix = 1 / rays.dx[i];
+    const double iy = 1 / rays.dy[i];
+    const double iz = 1 / rays.dz[i];
+    const double x0 = (lx - rays.ox[i]) * ix;
+    const double x1 = (ux - rays.ox[i]) * ix;
+    const double y0 = (ly - rays.oy[i]) * iy;
+    const double y1 = (uy - rays.oy[i]) * iy;
+    const double z0 = (lz - rays.oz[i]) * iz;
+    const double z1 = (uz - rays.oz[i]) * iz;
+
+    const double xNear = x0 < x1 ? x0 : x1;
+    const double xFar = x0 < x1 ? x1 : x0;
+    const double yNear = y0 < y1 ? y0 : y1;
+    const double yFar = y0 < y1 ? y1 : y0;
+    const double zNear = z0 < z1 ? z0 : z1;
+    const double zFar = z0 < z1 ? z1 : z0;
+
+    const double xyNear = xNear > yNear ? xNear : yNear;
+    const double tNear = xyNear > zNear ? xyNear : zNear;
+    const double xyFar = xFar < yFar ? xFar : yFar;
+    const double tFar = xyFar < zFar ? xyFar : zFar;
+
+    const bool inside = tNear <= 0;
+    const double t = inside ? tFar : tNear;
+    const bool hit = (tNear <= tFar) & (t > 0) & (t < hits.t[i]);
+
+    // entering: the normal faces the ray; leaving: it faces along the ray
+    const double sx = rays.dx[i] < 0 ? 1 : -1;
+    const double sy = rays.dy[i] < 0 ? 1 : -1;
+    const double sz = rays.dz[i] < 0 ? 1 : -1;
+    const double side = inside ? -1 : 1;
+    const bool onX = inside ? t == xFar : t == xNear;
+    const bool onY = !onX & (inside ? t == yFar : t == yNear);
+    const bool onZ = !onX & !onY;
+
+    hits.t[i] = hit ? t : hits.t[i];
+    hits.nx[i] = hit ? (onX ? side * sx : 0) : hits.nx[i];
+    hits.ny[i] = hit ? (onY ? side * sy : 0) : hits.ny[i];
+    hits.nz[i] = hit ? (onZ ? side * sz : 0) : hits.nz[i];
+    hits.id[i] = hit ? id : hits.id[i];
+  }
+}
+
+/**
+ * @brief Intersects a packet of rays with a triangle.
+ *
+ * Uses the Möller-Trumbore algorithm. Both sides of the triangle can be hit;
+ * the normal is that of the counterclockwise triangle a, b, c regardless of
+ * the side.
+ *
+ * @tparam N The number of rays in the packet.
+ * @tparam V 3D point type.
+ *
+ * @param rays The rays.
+ * @param a The first vertex of the triangle.
+ * @param b The second vertex of the triangle.
+ * @param c The third vertex of the triangle.
+ * @param id The id to store for hits.
+ * @param hits The closest hits so far, updated in place.
+ */
+template <std::size_t N, typename V>
+void intersectTriangle(const RayPacket<N> &rays, const V &a, const V &b,
+                       const V &c, const std::size_t id, HitPacket<N> &hits) {
+  static_assert(VectorTraits<V>::dimensions == 3,
+                "intersectTriangle requires 3D vectors");
+
+  const double ax = static_cast<double>(a[0]);
+  const double ay = static_cast<double>(a[1]);
+  const double az = static_cast<double>(a[2]);
+  const double e1x = static_cast<double>(b[0]) - ax;
+  const double e1y = static_cast<double>(b[1]) - ay;
+  const double e1z = static_cast<double>(b[2]) - az;
+  const double e2x = static_cast<double>(c[0]) - ax;
+  const double e2y = static_cast<double>(c[1]) - ay;
+  const double e2z = static_cast<double>(c[2]) - az;
+
+  double nx = e1y * e2z - e1z * e2y;
+  double ny = e1z * e2x - e1x * e2z;
+  double nz = e1x * e2y - e1y * e2x;
+  const double invLength = 1 / std::sqrt(nx * nx + ny * ny + nz * nz);
+  nx *= invLength;
+  ny *= invLength;
+  nz *= invLength;
+
+  for (std::size_t i = 0; i < N; i++) {
+    const double px = rays.dy[i] * e2z - rays.dz[i] * e2y;
+    const double py = rays.dz[i] * e2x - rays.dx[i] * e2z;
+    const double pz = rays.dx[i] * e2y - rays.dy[i] * e2x;
+    const double det = e1x * px + e1y * py + e1z * pz;
+    const double invDet = 1 / det;
+
+    const double sx = rays.ox[i] - ax;
+    const double sy = rays.oy[i] - ay;
+    const double sz = rays.oz[i] - az;
+    const double u = (sx * px + sy * py + sz * pz) * invDet;
+
+    const double qx = sy * e1z - sz * e1y;
+    const double qy = sz * e1x - sx * e1z;
+    const double qz = sx * e1y - sy * e1x;
+    const double v =
+        (rays.dx[i] * qx + rays.dy[i] * qy + rays.dz[i] * qz) * invDet;
+    const double t = (e2x * qx + e2y * qy + e2z * qz) * invDet;
+
+    // a ray parallel to the triangle has a zero determinant, which makes
+    // u, v and t infinite or NaN and fails the tests below
+    const bool hit = (det != 0) & (u >= 0) & (v >= 0) & (u + v <= 1) &
+                     (t > 0) & (t < hits.t[i]);
+    hits.t[i] = hit ? t : hits.t[i];
+    hits.nx[i] = hit ? nx : hits.nx[i];
+    hits.ny[i] = hit ? ny : hits.ny[i];
+    hits.nz[i] = hit ? nz : hits.nz[i];
+    hits.id[i] = hit ? id : hits.id[i];
+  }
+}
+} // namespace svector
+
+#endif
@@ -0,0 +1,444 @@
+/**
+ * @file curves.hpp
+ *
+ * @brief Interpolation and cubic spline functions for vectors.
+ *
+ * Each function has a single-vector form and a batch form that works on
+ * arrays of vectors, so that many curves can be evaluated at once.
+ *
+ * This file is not included in vectors.hpp, so it has to be included
+ * separately.
+ *
+ * @copyright Copyright (c) 2023 Jonathan Liu. This project is released under
+ * the MIT License. All rights reserved.
+ */
+
+#ifndef INCLUDE_SVECTOR_CURVES_HPP_
+#define INCLUDE_SVECTOR_CURVES_HPP_
+
+#include <cmath>   // std::acos, std::sin
+#include <cstddef> // std::size_t
+#include <vector>  // std::vector
+
+#include "simplevectors/core/traits.hpp" // svector::VectorTraits
+#include "simplevectors/core/vector.hpp" // svector::Vector
+
+namespace svector {
+/**
+ * @brief Spline basis enumerator
+ *
+ * An enum representing the basis used to evaluate a cubic segment from four
+ * control points.
+ *
+ * This is used in svector::cubic(), svector::sampleCubic(), and
+ * svector::samplePath().
+ */
+enum SplineBasis {
+  BEZIER,      //!< Cubic Bézier; passes through the first and last points.
+  CATMULL_ROM, //!< Catmull-Rom; passes through the middle two points.
+  B_SPLINE     //!< Uniform cubic B-spline; passes through no points.
+};
+
+namespace detail {
+/**
+ * Power-basis matrix of each spline basis.
+ *
+ * Row k holds the weights of the four control points for the t^k coefficient.
+ */
+template <typename T> struct SplineMatrix {
+  static void get(const SplineBasis basis, T m[4][4]) {
+    static const double bezier[4][4] = {
+        {1, 0, 0, 0}, {-3, 3, 0, 0}, {3, -6, 3, 0}, {-1, 3, -3, 1}};
+    static const double catmullRom[4][4] = {{0, 1, 0, 0},
+                                            {-0.5, 0, 0.5, 0},
+                                            {1, -2.5, 2, -0.5},
+                                            {-0.5, 1.5, -1.5, 0.5}};
+    static const double bspline[4][4] = {{1.0 / 6, 4.0 / 6, 1.0 / 6, 0},
+                                         {-0.5, 0, 0.5, 0},
+                                         {0.5, -1, 0.5, 0},
+                                         {-1.0 / 6, 0.5, -0.5, 1.0 / 6}};
+
+    const double(*src)[4] = basis == BEZIER        ? bezier
+                            : basis == CATMULL_ROM ? catmullRom
+                                                   : bspline;
+    for (std::size_t k = 0; k < 4; k++) {
+      for (std::size_t j = 0; j < 4; j++) {
+        m[k][j] = static_cast<T>(src[k][j]);
+      }
+    }
+  }
+};
+
+/**
+ * Weights of the four control points at parameter t.
+ */
+template <SplineBasis B, typename T> void splineWeights(const T t, T w[4]) {
+  T m[4][4];
+  SplineMatrix<T>::get(B, m);
+  for (std::size_t j = 0; j < 4; j++) {
+    w[j] = m[0][j] + t * (m[1][j] + t * (m[2][j] + t * m[3][j]));
+  }
+}
+
+/**
+ * Slerp of two unit vectors, written into out.
+ */
+template <typename T, std::size_t D>
+void slerpUnit(const Vector<D, T> &a, const Vector<D, T> &b, const T t,
+               Vector<D, T> &out) {
+  T cosTheta = 0;
+  for (std::size_t i = 0; i < D; i++) {
+    cosTheta += a[i] * b[i];
+  }
+
+  if (cosTheta > 1) {
+    cosTheta = 1;
+  } else if (cosTheta < -1) {
+    cosTheta = -1;
+  }
+
+  const T theta = std::acos(cosTheta);
+  const T sinTheta = std::sin(theta);
+
+  // nearly parallel vectors: the rotation plane is not defined, so fall back
+  // to linear interpolation
+  T w0 = 1 - t;
+  T w1 = t;
+  if (sinTheta > static_cast<T>(1e-6)) {
+    w0 = std::sin((1 - t) * theta) / sinTheta;
+    w1 = std::sin(t * theta) / sinTheta;
+  }
+
+  for (std::size_t i = 0; i < D; i++) {
+    out[i] = w0 * a[i] + w1 * b[i];
+  }
+}
+} // namespace detail
+
+/**
+ * @brief Linear interpolation of two vectors.
+ *
+ * @tparam D The number of dimensions.
+ * @tparam T Vector type.
+ *
+ * @param a The vector at t = 0.
+ * @param b The vector at t = 1.
+ * @param t The interpolation parameter.
+ *
+ * @returns The interpolated vector.
+ */
+template <typename T, std::size_t D>
+inline Vector<D, T> lerp(const Vector<D, T> &a, const Vector<D, T> &b,
+                         const T t) {
+  Vector<D, T> tmp;
+  for (std::size_t i = 0; i < D; i++) {
+    tmp[i] = a[i] + (b[i] - a[i]) * t;
+  }
+
+  return tmp;
+}
+
+/**
+ * @brief Linear interpolation of many pairs of vectors.
+ *
+ * @tparam V Vector type, such as svector::Vector3D or svector::Vector<3>.
+ *
+ * @param a An array of n vectors at t = 0.
+ * @param b An array of n vectors at t = 1.
+ * @param n The number of pairs.
+ * @param t The interpolation parameter.
+ * @param out An array of at least n vectors to write the results to.
+ */
+template <typename V>
+inline void lerp(const V *a, const V *b, const std::size_t n,
+                 const typename VectorTraits<V>::value_type t, V *out) {
+  for (std::size_t k = 0; k < n; k++) {
+    for (std::size_t i = 0; i < VectorTraits<V>::dimensions; i++) {
+      out[k][i] = a[k][i] + (b[k][i] - a[k][i]) * t;
+    }
+  }
+}
+
+/**
+ * @brief Normalized linear interpolation of two vectors.
+ *
+ * This is a cheaper approximation of slerp for unit vectors that does not
+ * move at constant angular speed.
+ *
+ * @note This method will result in undefined behavior if the interpolated
+ * vector is a zero vector.
+ *
+ * @tparam D The number of dimensions.
+ * @tparam T Vector type.
+ *
+ * @param a The vector at t = 0.
+ * @param b The vector at t = 1.
+ * @param t The interpolation parameter.
+ *
+ * @returns The normalized interpolated vector.
+ */
+template <typename T, std::size_t D>
+inline Vector<D, T> nlerp(const Vector<D, T> &a, const Vector<D, T> &b,
+                          const T t) {
+  Vector<D, T> tmp = lerp(a, b, t);
+  return tmp /= tmp.magn();
+}
+
+/**
+ * @brief Normalized linear interpolation of many pairs of vectors.
+ *
+ * @see svector::nlerp(const Vector<D, T> &, const Vector<D, T> &, const T)
+ *
+ * @tparam V Vector type, such as svector::Vector3D or svector::Vector<3>.
+ *
+ * @param a An array of n vectors at t = 0.
+ * @param b An array of n vectors at t = 1.
+ * @param n The number of pairs.
+ * @param t The interpolation parameter.
+ * @param out An array of at least n vectors to write the results to.
+ */
+template <typename V>
+inline void nlerp(const V *a, const V *b, const std::size_t n,
+                  const typename VectorTraits<V>::value_type t, V *out) {
+  lerp(a, b, n, t, out);
+  for (std::size_t k = 0; k < n; k++) {
+    out[k] /= out[k].magn();
+  }
+}
+
+/**
+ * @brief Spherical linear interpolation of two unit vectors.
+ *
+ * Rotates from a to b at a constant angular speed.
+ *
+ * @note Both vectors should be unit vectors. Nearly parallel vectors are
+ * linearly interpolated instead.
+ *
+ * @tparam D The number of dimensions.
+ * @tparam T Vector type.
+ *
+ * @param a The unit vector at t = 0.
+ * @param b The unit vector at t = 1.
+ * @param t The interpolation parameter.
+ *
+ * @returns The interpolated unit vector.
+ */
+template <typename T, std::size_t D>
+inline Vector<D, T> slerp(const Vector<D, T> &a, const Vector<D, T> &b,
+                          const T t) {
+  Vector<D, T> tmp;
+  detail::slerpUnit(a, b, t, tmp);
+  return tmp;
+}
+
+/**
+ * @brief Spherical linear interpolation of many pairs of unit vectors.
+ *
+ * @see svector::slerp(const Vector<D, T> &, const Vector<D, T> &, const T)
+ *
+ * @tparam V Vector type, such as svector::Vector3D or svector::Vector<3>.
+ *
+ * @param a An array of n unit vectors at t = 0.
+ * @param b An array of n unit vectors at t = 1.
+ * @param n The number of pairs.
+ * @param t The interpolation parameter.
+ * @param out An array of at least n vectors to write the results to.
+ */
+template <typename V>
+inline void slerp(const V *a, const V *b, const std::size_t n,
+                  const typename VectorTraits<V>::value_type t, V *out) {
+  typedef typename VectorTraits<V>::value_type T;
+  const std::size_t D = VectorTraits<V>::dimensions;
+
+  for (std::size_t k = 0; k < n; k++) {
+    detail::slerpUnit(static_cast<const Vector<D, T> &>(a[k]),
+                      static_cast<const Vector<D, T> &>(b[k]), t,
+                      static_cast<Vector<D, T> &>(out[k]));
+  }
+}
+
+/**
+ * @brief Evaluates a cubic segment.
+ *
+ * Specify the basis in the template argument.
+ *
+ * @see svector::SplineBasis
+ *
+ * @tparam B The spline basis.
+ * @tparam D The number of dimensions.
+ * @tparam T Vector type.
+ *
+ * @param p0 The first control point.
+ * @param p1 The second control point.
+ * @param p2 The third control point.
+ * @param p3 The fourth control point.
+ * @param t The curve parameter, in the range [0, 1].
+ *
+ * @returns The point on the curve.
+ */
+template <SplineBasis B, typename T, std::size_t D>
+inline Vector<D, T> cubic(const Vector<D, T> &p0, const Vector<D, T> &p1,
+                          const Vector<D, T> &p2, const Vector<D, T> &p3,
+                          const T t) {
+  T w[4];
+  detail::splineWeights<B>(t, w);
+
+  Vector<D, T> tmp;
+  for (std::size_t i = 0; i < D; i++) {
+    tmp[i] = w[0] * p0[i] + w[1] * p1[i] + w[2] * p2[i] + w[3] * p3[i];
+  }
+
+  return tmp;
+}
+
+/**
+ * @brief Evaluates many cubic segments at the same parameter.
+ *
+ * The basis weights are computed once and applied to every curve.
+ *
+ * @see svector::SplineBasis
+ *
+ * @tparam B The spline basis.
+ * @tparam V Vector type, such as svector::Vector3D or svector::Vector<3>.
+ *
+ * @param ctrl An array of 4 * n control points, four for each curve.
+ * @param n The number of curves.
+ * @param t The curve parameter, in the range [0, 1].
+ * @param out An array of at least n vectors to write the results to.
+ */
+template <SplineBasis B, typename V>
+inline void cubic(const V *ctrl, const std::size_t n,
+                  const typename VectorTraits<V>::value_type t, V *out) {
+  typedef typename VectorTraits<V>::value_type T;
+  T w[4];
+  detail::splineWeights<B>(t, w);
+
+  for (std::size_t k = 0; k < n; k++) {
+    const V *p = ctrl + 4 * k;
+    for (std::size_t i = 0; i < VectorTraits<V>::dimensions; i++) {
+      out[k][i] =
+          w[0] * p[0][i] + w[1] * p[1][i] + w[2] * p[2][i] + w[3] * p[3][i];
+    }
+  }
+}
+
+/**
+ * @brief Samples a cubic segment at uniform parameters.
+ *
+ * Writes the points at t = 0, 1 / (n - 1), ..., 1. Uses forward differencing,
+ * so each point after the first costs three vector additions.
+ *
+ * @see svector::SplineBasis
+ *
+ * @tparam B The spline basis.
+ * @tparam D The number of dimensions.
+ * @tparam T Vector type.
+ *
+ * @param p0 The first control point.
+ * @param p1 The second control point.
+ * @param p2 The third control point.
+ * @param p3 The fourth control point.
+ * @param n The number of samples.
+ * @param out An array of at least n vectors to write the results to.
+ */
+template <SplineBasis B, typename T, std::size_t D>
+inline void sampleCubic(const Vector<D, T> &p0, const Vector<D, T> &p1,
+                        const Vector<D, T> &p2, const Vector<D, T> &p3,
+                        const std::size_t n, Vector<D, T> *out) {
+  if (n == 0) {
+    return;
+  }
+
+  T m[4][4];
+  detail::SplineMatrix<T>::get(B, m);
+
+  const T h = n > 1 ? 1 / static_cast<T>(n - 1) : 0;
+  const T h2 = h * h;
+  const T h3 = h2 * h;
+
+  // f is the value, d1..d3 are the forward differences
+  T f[D];
+  T d1[D];
+  T d2[D];
+  T d3[D];
+  for (std::size_t i = 0; i < D; i++) {
+    T c[4];
+    for (std::size_t k = 0; k < 4; k++) {
+      c[k] = m[k][0] * p0[i] + m[k][1] * p1[i] + m[k][2] * p2[i] +
+             m[k][3] * p3[i];
+    }
+
+    f[i] = c[0];
+    d1[i] = c[1] * h + c[2] * h2 + c[3] * h3;
+    d2[i] = 2 * c[2] * h2 + 6 * c[3] * h3;
+    d3[i] = 6 * c[3] * h3;
+  }
+
+  for (std::size_t k = 0; k < n; k++) {
+    for (std::size_t i = 0; i < D; i++) {
+      out[k][i] = f[i];
+      f[i] += d1[i];
+      d1[i] += d2[i];
+      d2[i] += d3[i];
+    }
+  }
+}
+
+/**
+ * @brief Samples a piecewise cubic path through a list of control points.
+ *
+ * For Catmull-Rom and B-splines, each window of four consecutive control
+ * points is a segment. For Bézier curves, segments share their end points, so
+ * the control points are p0 p1 p2 p3 p4 p5 p6 ..., where p3 ends the first
+ * segment and starts the second one.
+ *
+ * Each segment is sampled with svector::sampleCubic(), and the last sample of
+ * a segment is not repeated as the first sample of the next one.
+ *
+ * @see svector::SplineBasis
+ *
+ * @tparam B The spline basis.
+ * @tparam V Point type, such as svector::Vector3D or svector::Vector<3>.
+ *
+ * @param ctrl The control points.
+ * @param perSegment The number of samples per segment, including both ends.
+ * Must be at least 2.
+ *
+ * @returns The sampled points.
+ */
+template <SplineBasis B, typename V>
+inline std::vector<V> samplePath(const std::vector<V> &ctrl,
+                                 const std::size_t perSegment) {
+  typedef typename VectorTraits<V>::value_type T;
+  const std::size_t D = VectorTraits<V>::dimensions;
+
+  std::vector<V> out;
+  if (ctrl.size() < 4 || perSegment < 2) {
+    return out;
+  }
+
+  const std::size_t step = B == BEZIER ? 3 : 1;
+  const std::size_t segments = (ctrl.size() - 4) / step + 1;
+  out.resize(segments * (perSegment - 1) + 1);
+
+  std::vector<Vector<D, T>> samples(perSegment);
+  for (std::size_t s = 0; s < segments; s++) {
+    const V *p = ctrl.data() + s * step;
+    sampleCubic<B>(static_cast<const Vector<D, T> &>(p[0]),
+                   static_cast<const Vector<D, T> &>(p[1]),
+                   static_cast<const Vector<D, T> &>(p[2]),
+                   static_cast<const Vector<D, T> &>(p[3]), perSegment,
+                   samples.data());
+
+    // overwrites the first sample of the next segment, which is the same point
+    V *dest = out.data() + s * (perSegment - 1);
+    for (std::size_t k = 0; k < perSegment; k++) {
+      static_cast<Vector<D, T> &>(dest[k]) = samples[k];
+    }
+  }
+
+  return out;
+}
+} // namespace svector
+
+#endif
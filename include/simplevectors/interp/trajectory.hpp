@@ -0,0 +1,405 @@
+/**
+ * @file trajectory.hpp
+ *
+ * @brief Contains a time-indexed trajectory of vectors.
+ *
+ * This file is not included in vectors.hpp, so it has to be included
+ * separately.
+ *
+ * @copyright Copyright (c) 2023 Jonathan Liu. This project is released under
+ * the MIT License. All rights reserved.
+ */
+
+#ifndef INCLUDE_SVECTOR_TRAJECTORY_HPP_
+#define INCLUDE_SVECTOR_TRAJECTORY_HPP_
+
+#include <algorithm>   // std::upper_bound
+#include <cmath>       // std::acos, std::sin, std::sqrt
+#include <cstddef>     // std::size_t
+#include <type_traits> // std::is_floating_point
+#include <vector>      // std::vector
+
+#include "simplevectors/core/vector.hpp" // svector::Vector
+
+namespace svector {
+/**
+ * @brief Interpolation enumerator
+ *
+ * An enum representing how a trajectory interpolates between two samples.
+ *
+ * This is used in svector::Trajectory::at() and svector::Trajectory::sample().
+ */
+enum InterpMode {
+  LINEAR,  //!< Straight line between the two samples.
+  HERMITE, //!< Cubic Hermite spline with finite-difference tangents.
+  SLERP    //!< Spherical interpolation of direction, linear in magnitude.
+};
+
+/**
+ * @brief A time-indexed sequence of vectors.
+ *
+ * Samples are stored as a contiguous array of times and a contiguous array of
+ * components (D values per sample), so a lookup only touches the time array
+ * until the segment has been found.
+ *
+ * Looking up a time first checks the segment returned by the previous lookup
+ * and the one after it, which makes monotonic queries (playback, resampling)
+ * O(1). Otherwise, the segment is guessed by interpolating the time between
+ * the first and last samples and the guess is refined with a binary search,
+ * which is also O(1) for uniformly sampled trajectories.
+ *
+ * @note Times must be added in strictly increasing order. Adding a time that
+ * is less than or equal to the last time will result in undefined behavior.
+ *
+ * @note The overloads of at() that do not take a hint update a cached segment
+ * index, so they must not be called concurrently on the same object. Use the
+ * overloads that take a hint to query from several threads.
+ *
+ * @tparam D The number of dimensions.
+ * @tparam T Vector type.
+ */
+template <std::size_t D, typename T = double> class Trajectory {
+public:
+  // makes sure that type can be interpolated
+  static_assert(std::is_floating_point<T>::value,
+                "Trajectory type must be a floating point type");
+
+  /**
+   * @brief No-argument constructor
+   *
+   * Initializes an empty trajectory.
+   */
+  Trajectory() : m_hint{0} {}
+
+  /**
+   * @brief Reserves memory for a number of samples.
+   *
+   * @param n The number of samples to reserve memory for.
+   */
+  void reserve(const std::size_t n) {
+    this->m_times.reserve(n);
+    this->m_components.reserve(n * D);
+  }
+
+  /**
+   * @brief Adds a sample to the end of the trajectory.
+   *
+   * @param t The time of the sample. Must be greater than the time of the
+   * last sample.
+   * @param v The vector at that time.
+   */
+  void push_back(const T t, const Vector<D, T> &v) {
+    this->m_times.push_back(t);
+    for (std::size_t i = 0; i < D; i++) {
+      this->m_components.push_back(v[i]);
+    }
+  }
+
+  /**
+   * @brief Removes all samples.
+   */
+  void clear() {
+    this->m_times.clear();
+    this->m_components.clear();
+    this->m_hint = 0;
+  }
+
+  /**
+   * @brief Gets the number of samples.
+   *
+   * @returns Number of samples.
+   */
+  std::size_t size() const { return this->m_times.size(); }
+
+  /**
+   * @brief Determines whether the trajectory has no samples.
+   *
+   * @returns Whether the trajectory is empty.
+   */
+  bool empty() const { return this->m_times.empty(); }
+
+  /**
+   * @brief Gets the time of a sample.
+   *
+   * @param index The sample number.
+   *
+   * @returns The time of the sample.
+   */
+  T time(const std::size_t index) const { return this->m_times[index]; }
+
+  /**
+   * @brief Gets the vector of a sample.
+   *
+   * @param index The sample number.
+   *
+   * @returns The vector of the sample.
+   */
+  Vector<D, T> point(const std::size_t index) const {
+    Vector<D, T> tmp;
+    for (std::size_t i = 0; i < D; i++) {
+      tmp[i] = this->m_components[index * D + i];
+    }
+
+    return tmp;
+  }
+
+  /**
+   * @brief Finds the segment containing a time.
+   *
+   * The segment i is the one between sample i and sample i + 1. Times before
+   * the first sample map to segment 0 and times after the last sample map to
+   * the last segment. NaN maps to segment 0.
+   *
+   * @note The trajectory must have at least two samples.
+   *
+   * @param t The time to look up.
+   * @param hint The segment to check first. This is updated to the result.
+   *
+   * @returns The index of the first sample of the segment.
+   */
+  std::size_t segment(const T t, std::size_t &hint) const {
+    const std::size_t last = this->m_times.size() - 2;
+    const T *times = this->m_times.data();
+
+    // cached segment, then the next one (monotonic queries)
+    if (hint <= last && times[hint] <= t) {
+      if (t <= times[hint + 1]) {
+        return hint;
+      }
+
+      if (hint < last && t <= times[hint + 2]) {
+        hint++;
+        return hint;
+      }
+    }
+
+    // also catches NaN, which would be cast to an index below
+    if (!(t > times[0])) {
+      hint = 0;
+      return hint;
+    }
+
+    if (t >= times[last + 1]) {
+      hint = last;
+      return hint;
+    }
+
+    // interpolation guess, then binary search on the side it missed
+    std::size_t guess = static_cast<std::size_t>(
+        (t - times[0]) / (times[last + 1] - times[0]) * static_cast<T>(last));
+    if (guess > last) {
+      guess = last;
+    }
+
+    std::size_t lo = 0;
+    std::size_t hi = last + 1;
+    if (times[guess] <= t) {
+      if (t <= times[guess + 1]) {
+        hint = guess;
+        return hint;
+      }
+
+      lo = guess + 1;
+    } else {
+      hi = guess;
+    }
+
+    const T *found = std::upper_bound(times + lo, times + hi + 1, t);
+    hint = static_cast<std::size_t>(found - times) - 1;
+    return hint;
+  }
+
+  /**
+   * @brief Interpolated vector at a time.
+   *
+   * Specify the interpolation in the template argument. Times outside of the
+   * trajectory are clamped to the first or last sample.
+   *
+   * @see svector::InterpMode
+   *
+   * @note The trajectory must not be empty.
+   *
+   * @param t The time to look up.
+   * @param hint The segment to check first. This is updated to the segment
+   * that contains the time.
+   *
+   * @returns The interpolated vector.
+   */
+  template <InterpMode M>
+  Vector<D, T> at(const T t, std::size_t &hint) const {
+    Vector<D, T> tmp;
+    this->interpolate<M>(t, hint, tmp);
+    return tmp;
+  }
+
+  /**
+   * @brief Interpolated vector at a time.
+   *
+   * Uses the segment found by the previous lookup as the hint.
+   *
+   * @see svector::Trajectory::at(const T, std::size_t &) const
+   *
+   * @param t The time to look up.
+   *
+   * @returns The interpolated vector.
+   */
+  template <InterpMode M> Vector<D, T> at(const T t) const {
+    return this->at<M>(t, this->m_hint);
+  }
+
+  /**
+   * @brief Interpolates the trajectory at many times.
+   *
+   * This is fastest when the times are sorted.
+   *
+   * @param times The times to look up.
+   * @param n The number of times.
+   * @param out An array of at least n vectors to write the results to.
+   */
+  template <InterpMode M>
+  void sample(const T *times, const std::size_t n, Vector<D, T> *out) const {
+    std::size_t hint = 0;
+    for (std::size_t i = 0; i < n; i++) {
+      this->interpolate<M>(times[i], hint, out[i]);
+    }
+  }
+
+  /**
+   * @brief Interpolates the trajectory at many times.
+   *
+   * @param times The times to look up.
+   *
+   * @returns The interpolated vectors, in the same order as the times.
+   */
+  template <InterpMode M>
+  std::vector<Vector<D, T>> sample(const std::vector<T> &times) const {
+    std::vector<Vector<D, T>> out(times.size());
+    this->sample<M>(times.data(), times.size(), out.data());
+    return out;
+  }
+
+private:
+  std::vector<T> m_times;      //!< Time of each sample.
+  std::vector<T> m_components; //!< Components of each sample, D per sample.
+  mutable std::size_t m_hint;  //!< Segment of the previous lookup.
+
+  /**
+   * Writes the interpolated vector at time t into out.
+   */
+  template <InterpMode M>
+  void interpolate(const T t, std::size_t &hint, Vector<D, T> &out) const {
+    if (this->m_times.size() < 2) {
+      for (std::size_t i = 0; i < D; i++) {
+        out[i] = this->m_components[i];
+      }
+      return;
+    }
+
+    const std::size_t seg = this->segment(t, hint);
+    const T t0 = this->m_times[seg];
+    const T t1 = this->m_times[seg + 1];
+    T u = (t - t0) / (t1 - t0);
+    if (u < 0) {
+      u = 0;
+    } else if (u > 1) {
+      u = 1;
+    }
+
+    const T *p0 = this->m_components.data() + seg * D;
+    const T *p1 = p0 + D;
+
+    switch (M) {
+    case LINEAR:
+      for (std::size_t i = 0; i < D; i++) {
+        out[i] = p0[i] + (p1[i] - p0[i]) * u;
+      }
+      break;
+    case HERMITE:
+      this->hermite(seg, u, out);
+      break;
+    default:
+      slerp(p0, p1, u, out);
+      break;
+    }
+  }
+
+  /**
+   * Cubic Hermite interpolation on segment seg.
+   *
+   * Tangents are central differences (one-sided at the ends), scaled to the
+   * length of the segment so that non-uniform sampling stays smooth.
+   */
+  void hermite(const std::size_t seg, const T u, Vector<D, T> &out) const {
+    const std::size_t n = this->m_times.size();
+    const std::size_t prev = seg == 0 ? 0 : seg - 1;
+    const std::size_t next = seg + 2 >= n ? n - 1 : seg + 2;
+    const T *times = this->m_times.data();
+    const T *c = this->m_components.data();
+
+    const T dt = times[seg + 1] - times[seg];
+    const T s0 = dt / (times[seg + 1] - times[prev]);
+    const T s1 = dt / (times[next] - times[seg]);
+
+    const T u2 = u * u;
+    const T u3 = u2 * u;
+    const T h00 = 2 * u3 - 3 * u2 + 1;
+    const T h10 = u3 - 2 * u2 + u;
+    const T h01 = -2 * u3 + 3 * u2;
+    const T h11 = u3 - u2;
+
+    for (std::size_t i = 0; i < D; i++) {
+      const T p0 = c[seg * D + i];
+      const T p1 = c[(seg + 1) * D + i];
+      const T m0 = (p1 - c[prev * D + i]) * s0;
+      const T m1 = (c[next * D + i] - p0) * s1;
+      out[i] = h00 * p0 + h10 * m0 + h01 * p1 + h11 * m1;
+    }
+  }
+
+  /**
+   * Spherical interpolation of direction with linear interpolation of
+   * magnitude. Falls back to linear interpolation for (anti)parallel or zero
+   * vectors, where the rotation plane is not defined.
+   */
+  static void slerp(const T *p0, const T *p1, const T u, Vector<D, T> &out) {
+    T dot = 0;
+    T sq0 = 0;
+    T sq1 = 0;
+    for (std::size_t i = 0; i < D; i++) {
+      dot += p0[i] * p1[i];
+      sq0 += p0[i] * p0[i];
+      sq1 += p1[i] * p1[i];
+    }
+
+    const T m0 = std::sqrt(sq0);
+    const T m1 = std::sqrt(sq1);
+    T cosTheta = m0 * m1 == 0 ? 1 : dot / (m0 * m1);
+    if (cosTheta > 1) {
+      cosTheta = 1;
+    } else if (cosTheta < -1) {
+      cosTheta = -1;
+    }
+
+    const T theta = std::acos(cosTheta);
+    const T sinTheta = std::sin(theta);
+    if (sinTheta < static_cast<T>(1e-6)) {
+      for (std::size_t i = 0; i < D; i++) {
+        out[i] = p0[i] + (p1[i] - p0[i]) * u;
+      }
+      return;
+    }
+
+    const T magn = m0 + (m1 - m0) * u;
+    const T w0 = std::sin((1 - u) * theta) / sinTheta * magn / m0;
+    const T w1 = std::sin(u * theta) / sinTheta * magn / m1;
+    for (std::size_t i = 0; i < D; i++) {
+      out[i] = w0 * p0[i] + w1 * p1[i];
+    }
+  }
+};
+
+typedef Trajectory<2> Trajectory2D; //!< A trajectory of 2D vectors.
+typedef Trajectory<3> Trajectory3D; //!< A trajectory of 3D vectors.
+} // namespace svector
+
+#endif
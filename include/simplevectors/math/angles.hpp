@@ -0,0 +1,139 @@
+/**
+ * @file angles.hpp
+ *
+ * @brief Batch angle kernels with selectable accuracy.
+ *
+ * The angles of 2D vectors are computed with arctan2() and the angles α, β
+ * and γ of 3D vectors with arccos(), from arrays of vectors or of their
+ * components. The magnitude of each 3D vector is only computed once for all
+ * three angles.
+ *
+ * The accuracy is chosen in the template argument. The scalar kernels
+ * svector::arctan2() and svector::arccos() are in mathpolicy.hpp, where they
+ * are also used by the math policies. svector::ANGLE_EXACT uses the
+ * functions of the standard library. svector::ANGLE_PRECISE and
+ * svector::ANGLE_FAST use polynomial approximations without branches, so the
+ * compiler can vectorize loops over many vectors: the precise kernels
+ * are within about 1e-15 radians of the standard library and the fast ones
+ * within about 1e-4 radians. The 3D kernels take square roots, which most
+ * compilers only vectorize when errno can be ignored, as with
+ * -fno-math-errno, and write three arrays, so they are vectorized more
+ * easily when the compiler knows that the arrays do not overlap.
+ *
+ * This file is not included in vectors.hpp, so it has to be included
+ * separately.
+ *
+ * @copyright Copyright (c) 2023 Jonathan Liu. This project is released under
+ * the MIT License. All rights reserved.
+ */
+
+#ifndef INCLUDE_SVECTOR_ANGLES_HPP_
+#define INCLUDE_SVECTOR_ANGLES_HPP_
+
+#include <cmath>   // std::sqrt
+#include <cstddef> // std::size_t
+
+#include "simplevectors/core/mathpolicy.hpp" // svector::arctan2
+#include "simplevectors/core/vector2d.hpp"   // svector::Vector2D
+#include "simplevectors/core/vector3d.hpp"   // svector::Vector3D
+
+namespace svector {
+/**
+ * @brief Computes the angles of 2D vectors from their components.
+ *
+ * The angles are the same as svector::Vector2D::angle().
+ *
+ * @tparam A The accuracy.
+ *
+ * @param xs The x-components.
+ * @param ys The y-components.
+ * @param out The angles.
+ * @param n The number of vectors.
+ */
+template <AngleAccuracy A = ANGLE_EXACT>
+void angles(const double *xs, const double *ys, double *out,
+            const std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) {
+    out[i] = arctan2<A>(ys[i], xs[i]);
+  }
+}
+
+/**
+ * @brief Computes the angles of 2D vectors.
+ *
+ * The angles are the same as svector::Vector2D::angle().
+ *
+ * @tparam A The accuracy.
+ *
+ * @param vectors The vectors.
+ * @param out The angles.
+ * @param n The number of vectors.
+ */
+template <AngleAccuracy A = ANGLE_EXACT>
+void angles(const Vector2D *vectors, double *out, const std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) {
+    out[i] = arctan2<A>(vectors[i].y(), vectors[i].x());
+  }
+}
+
+/**
+ * @brief Computes the angles α, β and γ of 3D vectors from their
+ * components.
+ *
+ * The angles are those of svector::Vector3D::angle(), up to rounding.
+ *
+ * @note This function will result in undefined behavior if any vector is a
+ * zero vector.
+ *
+ * @tparam A The accuracy.
+ *
+ * @param xs The x-components.
+ * @param ys The y-components.
+ * @param zs The z-components.
+ * @param alphas The angles with the x-axis.
+ * @param betas The angles with the y-axis.
+ * @param gammas The angles with the z-axis.
+ * @param n The number of vectors.
+ */
+template <AngleAccuracy A = ANGLE_EXACT>
+void angles(const double *xs, const double *ys, const double *zs,
+            double *alphas, double *betas, double *gammas,
+            const std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) {
+    const double inverse =
+        1 / std::sqrt(xs[i] * xs[i] + ys[i] * ys[i] + zs[i] * zs[i]);
+    alphas[i] = arccos<A>(xs[i] * inverse);
+    betas[i] = arccos<A>(ys[i] * inverse);
+    gammas[i] = arccos<A>(zs[i] * inverse);
+  }
+}
+
+/**
+ * @brief Computes the angles α, β and γ of 3D vectors.
+ *
+ * The angles are the same as svector::Vector3D::angle().
+ *
+ * @note This function will result in undefined behavior if any vector is a
+ * zero vector.
+ *
+ * @tparam A The accuracy.
+ *
+ * @param vectors The vectors.
+ * @param alphas The angles with the x-axis.
+ * @param betas The angles with the y-axis.
+ * @param gammas The angles with the z-axis.
+ * @param n The number of vectors.
+ */
+template <AngleAccuracy A = ANGLE_EXACT>
+void angles(const Vector3D *vectors, double *alphas, double *betas,
+            double *gammas, const std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) {
+    const Vector3D cosines = vectors[i].directionCosines();
+    alphas[i] = arccos<A>(cosines.x());
+    betas[i] = arccos<A>(cosines.y());
+    gammas[i] = arccos<A>(cosines.z());
+  }
+}
+} // namespace svector
+
+#endif
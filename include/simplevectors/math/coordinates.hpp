@@ -0,0 +1,332 @@
+/**
+ * @file coordinates.hpp
+ *
+ * @brief Batch conversions between Cartesian, polar, spherical and
+ * cylindrical coordinates.
+ *
+ * Polar coordinates are a radius and an angle from the positive x-axis
+ * towards the positive y-axis, in (-π, π]. Spherical coordinates are a
+ * range, an azimuth like the polar angle and an elevation from the xy-plane
+ * towards the positive z-axis, in [-π/2, π/2], as reported by range sensors;
+ * the polar angle from the z-axis is π/2 minus the elevation. Cylindrical
+ * coordinates are polar coordinates in the xy-plane and the z-coordinate.
+ *
+ * The accuracy is chosen in the template argument, as in angles.hpp, and
+ * applies to the svector::sinCos() and svector::arctan2() calls. The
+ * svector::ANGLE_PRECISE kernels have no branches, so the compiler can
+ * vectorize loops over the overloads that take one array per coordinate.
+ * Conversions to spherical coordinates take square roots, which most
+ * compilers only vectorize when errno can be ignored, as with
+ * -fno-math-errno. The spherical conversions read and write six arrays, so
+ * they are vectorized more easily when the compiler knows that the arrays
+ * do not overlap.
+ *
+ * This file is not included in vectors.hpp, so it has to be included
+ * separately.
+ *
+ * @copyright Copyright (c) 2023 Jonathan Liu. This project is released under
+ * the MIT License. All rights reserved.
+ */
+
+#ifndef INCLUDE_SVECTOR_COORDINATES_HPP_
+#define INCLUDE_SVECTOR_COORDINATES_HPP_
+
+#include <cmath>   // std::sqrt
+#include <cstddef> // std::size_t
+
+#include "simplevectors/core/mathpolicy.hpp" // svector::sinCos
+#include "simplevectors/core/vector2d.hpp"   // svector::Vector2D
+#include "simplevectors/core/vector3d.hpp"   // svector::Vector3D
+
+namespace svector {
+/**
+ * @brief Converts 2D points to polar coordinates, from their coordinates.
+ *
+ * @tparam A The accuracy.
+ *
+ * @param xs The x-coordinates.
+ * @param ys The y-coordinates.
+ * @param radii The distances from the origin.
+ * @param angles The angles from the positive x-axis.
+ * @param n The number of points.
+ */
+template <AngleAccuracy A = ANGLE_EXACT>
+void toPolar(const double *xs, const double *ys, double *radii,
+             double *angles, const std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) {
+    const double x = xs[i];
+    const double y = ys[i];
+    radii[i] = std::sqrt(x * x + y * y);
+    angles[i] = arctan2<A>(y, x);
+  }
+}
+
+/**
+ * @brief Converts 2D points to polar coordinates.
+ *
+ * @tparam A The accuracy.
+ *
+ * @param points The points.
+ * @param radii The distances from the origin.
+ * @param angles The angles from the positive x-axis.
+ * @param n The number of points.
+ */
+template <AngleAccuracy A = ANGLE_EXACT>
+void toPolar(const Vector2D *points, double *radii, double *angles,
+             const std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) {
+    const double x = points[i].x();
+    const double y = points[i].y();
+    radii[i] = std::sqrt(x * x + y * y);
+    angles[i] = arctan2<A>(y, x);
+  }
+}
+
+/**
+ * @brief Converts polar coordinates to the coordinates of 2D points.
+ *
+ * @tparam A The accuracy.
+ *
+ * @param radii The distances from the origin.
+ * @param angles The angles from the positive x-axis.
+ * @param xs The x-coordinates.
+ * @param ys The y-coordinates.
+ * @param n The number of points.
+ */
+template <AngleAccuracy A = ANGLE_EXACT>
+void fromPolar(const double *radii, const double *angles, double *xs,
+               double *ys, const std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) {
+    double sine;
+    double cosine;
+    sinCos<A>(angles[i], sine, cosine);
+    xs[i] = radii[i] * cosine;
+    ys[i] = radii[i] * sine;
+  }
+}
+
+/**
+ * @brief Converts polar coordinates to 2D points.
+ *
+ * @tparam A The accuracy.
+ *
+ * @param radii The distances from the origin.
+ * @param angles The angles from the positive x-axis.
+ * @param points The points.
+ * @param n The number of points.
+ */
+template <AngleAccuracy A = ANGLE_EXACT>
+void fromPolar(const double *radii, const double *angles, Vector2D *points,
+               const std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) {
+    double sine;
+    double cosine;
+    sinCos<A>(angles[i], sine, cosine);
+    points[i] = Vector2D{radii[i] * cosine, radii[i] * sine};
+  }
+}
+
+/**
+ * @brief Converts 3D points to spherical coordinates, from their
+ * coordinates.
+ *
+ * The azimuth and elevation of the origin are 0.
+ *
+ * @tparam A The accuracy.
+ *
+ * @param xs The x-coordinates.
+ * @param ys The y-coordinates.
+ * @param zs The z-coordinates.
+ * @param ranges The distances from the origin.
+ * @param azimuths The angles from the positive x-axis in the xy-plane.
+ * @param elevations The angles from the xy-plane.
+ * @param n The number of points.
+ */
+template <AngleAccuracy A = ANGLE_EXACT>
+void toSpherical(const double *xs, const double *ys, const double *zs,
+                 double *ranges, double *azimuths, double *elevations,
+                 const std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) {
+    const double x = xs[i];
+    const double y = ys[i];
+    const double z = zs[i];
+    const double planar2 = x * x + y * y;
+    ranges[i] = std::sqrt(planar2 + z * z);
+    azimuths[i] = arctan2<A>(y, x);
+    elevations[i] = arctan2<A>(z, std::sqrt(planar2));
+  }
+}
+
+/**
+ * @brief Converts 3D points to spherical coordinates.
+ *
+ * The azimuth and elevation of the origin are 0.
+ *
+ * @tparam A The accuracy.
+ *
+ * @param points The points.
+ * @param ranges The distances from the origin.
+ * @param azimuths The angles from the positive x-axis in the xy-plane.
+ * @param elevations The angles from the xy-plane.
+ * @param n The number of points.
+ */
+template <AngleAccuracy A = ANGLE_EXACT>
+void toSpherical(const Vector3D *points, double *ranges, double *azimuths,
+                 double *elevations, const std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) {
+    const double x = points[i].x();
+    const double y = points[i].y();
+    const double z = points[i].z();
+    const double planar2 = x * x + y * y;
+    ranges[i] = std::sqrt(planar2 + z * z);
+    azimuths[i] = arctan2<A>(y, x);
+    elevations[i] = arctan2<A>(z, std::sqrt(planar2));
+  }
+}
+
+/**
+ * @brief Converts spherical coordinates to the coordinates of 3D points.
+ *
+ * @tparam A The accuracy.
+ *
+ * @param ranges The distances from the origin.
+ * @param azimuths The angles from the positive x-axis in the xy-plane.
+ * @param elevations The angles from the xy-plane.
+ * @param xs The x-coordinates.
+ * @param ys The y-coordinates.
+ * @param zs The z-coordinates.
+ * @param n The number of points.
+ */
+template <AngleAccuracy A = ANGLE_EXACT>
+void fromSpherical(const double *ranges, const double *azimuths,
+                   const double *elevations, double *xs, double *ys,
+                   double *zs, const std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) {
+    double sinAzimuth;
+    double cosAzimuth;
+    double sinElevation;
+    double cosElevation;
+    sinCos<A>(azimuths[i], sinAzimuth, cosAzimuth);
+    sinCos<A>(elevations[i], sinElevation, cosElevation);
+    const double planar = ranges[i] * cosElevation;
+    xs[i] = planar * cosAzimuth;
+    ys[i] = planar * sinAzimuth;
+    zs[i] = ranges[i] * sinElevation;
+  }
+}
+
+/**
+ * @brief Converts spherical coordinates to 3D points.
+ *
+ * @tparam A The accuracy.
+ *
+ * @param ranges The distances from the origin.
+ * @param azimuths The angles from the positive x-axis in the xy-plane.
+ * @param elevations The angles from the xy-plane.
+ * @param points The points.
+ * @param n The number of points.
+ */
+template <AngleAccuracy A = ANGLE_EXACT>
+void fromSpherical(const double *ranges, const double *azimuths,
+                   const double *elevations, Vector3D *points,
+                   const std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) {
+    double sinAzimuth;
+    double cosAzimuth;
+    double sinElevation;
+    double cosElevation;
+    sinCos<A>(azimuths[i], sinAzimuth, cosAzimuth);
+    sinCos<A>(elevations[i], sinElevation, cosElevation);
+    const double planar = ranges[i] * cosElevation;
+    points[i] = Vector3D{planar * cosAzimuth, planar * sinAzimuth,
+                         ranges[i] * sinElevation};
+  }
+}
+
+/**
+ * @brief Converts 3D points to cylindrical coordinates, from their
+ * coordinates.
+ *
+ * The z-coordinates are unchanged, so they are not written again.
+ *
+ * @tparam A The accuracy.
+ *
+ * @param xs The x-coordinates.
+ * @param ys The y-coordinates.
+ * @param radii The distances from the z-axis.
+ * @param angles The angles from the positive x-axis in the xy-plane.
+ * @param n The number of points.
+ */
+template <AngleAccuracy A = ANGLE_EXACT>
+void toCylindrical(const double *xs, const double *ys, double *radii,
+                   double *angles, const std::size_t n) {
+  toPolar<A>(xs, ys, radii, angles, n);
+}
+
+/**
+ * @brief Converts 3D points to cylindrical coordinates.
+ *
+ * @tparam A The accuracy.
+ *
+ * @param points The points.
+ * @param radii The distances from the z-axis.
+ * @param angles The angles from the positive x-axis in the xy-plane.
+ * @param heights The z-coordinates.
+ * @param n The number of points.
+ */
+template <AngleAccuracy A = ANGLE_EXACT>
+void toCylindrical(const Vector3D *points, double *radii, double *angles,
+                   double *heights, const std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) {
+    const double x = points[i].x();
+    const double y = points[i].y();
+    radii[i] = std::sqrt(x * x + y * y);
+    angles[i] = arctan2<A>(y, x);
+    heights[i] = points[i].z();
+  }
+}
+
+/**
+ * @brief Converts cylindrical coordinates to the coordinates of 3D points.
+ *
+ * The z-coordinates are unchanged, so they are not read or written.
+ *
+ * @tparam A The accuracy.
+ *
+ * @param radii The distances from the z-axis.
+ * @param angles The angles from the positive x-axis in the xy-plane.
+ * @param xs The x-coordinates.
+ * @param ys The y-coordinates.
+ * @param n The number of points.
+ */
+template <AngleAccuracy A = ANGLE_EXACT>
+void fromCylindrical(const double *radii, const double *angles, double *xs,
+                     double *ys, const std::size_t n) {
+  fromPolar<A>(radii, angles, xs, ys, n);
+}
+
+/**
+ * @brief Converts cylindrical coordinates to 3D points.
+ *
+ * @tparam A The accuracy.
+ *
+ * @param radii The distances from the z-axis.
+ * @param angles The angles from the positive x-axis in the xy-plane.
+ * @param heights The z-coordinates.
+ * @param points The points.
+ * @param n The number of points.
+ */
+template <AngleAccuracy A = ANGLE_EXACT>
+void fromCylindrical(const double *radii, const double *angles,
+                     const double *heights, Vector3D *points,
+                     const std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) {
+    double sine;
+    double cosine;
+    sinCos<A>(angles[i], sine, cosine);
+    points[i] = Vector3D{radii[i] * cosine, radii[i] * sine, heights[i]};
+  }
+}
+} // namespace svector
+
+#endif
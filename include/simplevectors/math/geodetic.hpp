@@ -0,0 +1,491 @@
+/**
+ * @file geodetic.hpp
+ *
+ * @brief Conversions between WGS-84 geodetic, Earth-centered Earth-fixed
+ * (ECEF) and local east-north-up (ENU) coordinates.
+ *
+ * Geodetic positions are svector::Vector3D with the latitude and longitude
+ * in radians and the altitude above the WGS-84 ellipsoid in meters. ECEF
+ * and ENU positions are in meters.
+ *
+ * The inverse conversion from ECEF starts from Bowring's estimate of the
+ * latitude and refines it with two fixed iterations of his formula, which
+ * only take square roots and divisions. This is within about 1e-15 radians
+ * and 1e-8 meters for altitudes from -10 km to beyond geostationary orbit,
+ * and has no branches. It is undefined at the center of the Earth.
+ *
+ * The accuracy of the sines, cosines and arctangents is chosen in the
+ * template argument, as in angles.hpp. svector::ANGLE_PRECISE is within
+ * about 1e-8 meters of svector::ANGLE_EXACT and has no branches, so the
+ * compiler can vectorize loops over the overloads that take one array per
+ * coordinate, as in coordinates.hpp. These read and write six arrays, so
+ * they are vectorized more easily when the compiler knows that the arrays do
+ * not overlap, and the square roots are only vectorized when errno can be
+ * ignored. svector::ANGLE_FAST is off by up to about a meter from geodetic
+ * positions and about 100 meters to them, which is too coarse for most
+ * tracks.
+ *
+ * svector::EnuFrame precomputes the rotation of a local frame, so that many
+ * positions can be converted with one subtraction and one rotation each.
+ *
+ * This file is not included in vectors.hpp, so it has to be included
+ * separately.
+ *
+ * @copyright Copyright (c) 2023 Jonathan Liu. This project is released under
+ * the MIT License. All rights reserved.
+ */
+
+#ifndef INCLUDE_SVECTOR_GEODETIC_HPP_
+#define INCLUDE_SVECTOR_GEODETIC_HPP_
+
+#include <cmath>   // std::sqrt
+#include <cstddef> // std::size_t
+
+#include "simplevectors/core/mathpolicy.hpp" // svector::sinCos
+#include "simplevectors/core/vector3d.hpp"   // svector::Vector3D
+
+namespace svector {
+namespace detail {
+/** Semi-major axis of the WGS-84 ellipsoid in meters. */
+constexpr double WGS84_A = 6378137.0;
+/** Flattening of the WGS-84 ellipsoid. */
+constexpr double WGS84_F = 1 / 298.257223563;
+/** Semi-minor axis of the WGS-84 ellipsoid in meters. */
+constexpr double WGS84_B = WGS84_A * (1 - WGS84_F);
+/** First eccentricity squared. */
+constexpr double WGS84_E2 = WGS84_F * (2 - WGS84_F);
+/** Second eccentricity squared. */
+constexpr double WGS84_EP2 = WGS84_E2 / (1 - WGS84_E2);
+
+/**
+ * Converts a geodetic position to ECEF coordinates.
+ */
+template <AngleAccuracy A>
+inline void geodeticToEcef(const double latitude, const double longitude,
+                           const double altitude, double &x, double &y,
+                           double &z) {
+  double sinLatitude;
+  double cosLatitude;
+  double sinLongitude;
+  double cosLongitude;
+  sinCos<A>(latitude, sinLatitude, cosLatitude);
+  sinCos<A>(longitude, sinLongitude, cosLongitude);
+
+  // the radius of curvature in the prime vertical
+  const double normal =
+      WGS84_A / std::sqrt(1 - WGS84_E2 * sinLatitude * sinLatitude);
+  const double planar = (normal + altitude) * cosLatitude;
+  x = planar * cosLongitude;
+  y = planar * sinLongitude;
+  z = (normal * (1 - WGS84_E2) + altitude) * sinLatitude;
+}
+
+/**
+ * Converts ECEF coordinates to a geodetic position.
+ */
+template <AngleAccuracy A>
+inline void ecefToGeodetic(const double x, const double y, const double z,
+                           double &latitude, double &longitude,
+                           double &altitude) {
+  const double p = std::sqrt(x * x + y * y);
+
+  // the direction of the parametric latitude starts at Bowring's estimate,
+  // and each iteration computes the geodetic latitude from it and then the
+  // parametric latitude from the geodetic one
+  double sinParametric = z;
+  double cosParametric = (1 - WGS84_F) * p;
+  double numerator = z;
+  double denominator = p;
+  for (int i = 0; i < 2; i++) {
+    const double length = std::sqrt(sinParametric * sinParametric +
+                                    cosParametric * cosParametric);
+    const double s = sinParametric / length;
+    const double c = cosParametric / length;
+    numerator = z + WGS84_EP2 * WGS84_B * s * s * s;
+    denominator = p - WGS84_E2 * WGS84_A * c * c * c;
+    sinParametric = (1 - WGS84_F) * numerator;
+    cosParametric = denominator;
+  }
+
+  const double length =
+      std::sqrt(numerator * numerator + denominator * denominator);
+  const double sinLatitude = numerator / length;
+  const double cosLatitude = denominator / length;
+  latitude = arctan2<A>(numerator, denominator);
+  longitude = arctan2<A>(y, x);
+  altitude = p * cosLatitude + z * sinLatitude -
+             WGS84_A * std::sqrt(1 - WGS84_E2 * sinLatitude * sinLatitude);
+}
+} // namespace detail
+
+/**
+ * @brief Converts a geodetic position to ECEF coordinates.
+ *
+ * @tparam A The accuracy.
+ *
+ * @param lla The latitude and longitude in radians and the altitude in
+ * meters.
+ *
+ * @returns The ECEF position in meters.
+ */
+template <AngleAccuracy A = ANGLE_EXACT>
+inline Vector3D llaToEcef(const Vector3D &lla) {
+  double x;
+  double y;
+  double z;
+  detail::geodeticToEcef<A>(lla.x(), lla.y(), lla.z(), x, y, z);
+  return Vector3D{x, y, z};
+}
+
+/**
+ * @brief Converts ECEF coordinates to a geodetic position.
+ *
+ * @note This function will result in undefined behavior at the center of
+ * the Earth.
+ *
+ * @tparam A The accuracy.
+ *
+ * @param ecef The ECEF position in meters.
+ *
+ * @returns The latitude and longitude in radians and the altitude in meters.
+ */
+template <AngleAccuracy A = ANGLE_EXACT>
+inline Vector3D ecefToLla(const Vector3D &ecef) {
+  double latitude;
+  double longitude;
+  double altitude;
+  detail::ecefToGeodetic<A>(ecef.x(), ecef.y(), ecef.z(), latitude, longitude,
+                            altitude);
+  return Vector3D{latitude, longitude, altitude};
+}
+
+/**
+ * @brief Converts geodetic positions to ECEF coordinates.
+ *
+ * @tparam A The accuracy.
+ *
+ * @param lla The latitudes and longitudes in radians and the altitudes in
+ * meters.
+ * @param ecef The ECEF positions in meters.
+ * @param n The number of positions.
+ */
+template <AngleAccuracy A = ANGLE_EXACT>
+void llaToEcef(const Vector3D *lla, Vector3D *ecef, const std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) {
+    ecef[i] = llaToEcef<A>(lla[i]);
+  }
+}
+
+/**
+ * @brief Converts geodetic positions to ECEF coordinates, from their
+ * coordinates.
+ *
+ * @tparam A The accuracy.
+ *
+ * @param latitudes The latitudes in radians.
+ * @param longitudes The longitudes in radians.
+ * @param altitudes The altitudes in meters.
+ * @param xs The ECEF x-coordinates in meters.
+ * @param ys The ECEF y-coordinates in meters.
+ * @param zs The ECEF z-coordinates in meters.
+ * @param n The number of positions.
+ */
+template <AngleAccuracy A = ANGLE_EXACT>
+void llaToEcef(const double *latitudes, const double *longitudes,
+               const double *altitudes, double *xs, double *ys, double *zs,
+               const std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) {
+    detail::geodeticToEcef<A>(latitudes[i], longitudes[i], altitudes[i], xs[i],
+                              ys[i], zs[i]);
+  }
+}
+
+/**
+ * @brief Converts ECEF coordinates to geodetic positions.
+ *
+ * @note This function will result in undefined behavior if any position is
+ * at the center of the Earth.
+ *
+ * @tparam A The accuracy.
+ *
+ * @param ecef The ECEF positions in meters.
+ * @param lla The latitudes and longitudes in radians and the altitudes in
+ * meters.
+ * @param n The number of positions.
+ */
+template <AngleAccuracy A = ANGLE_EXACT>
+void ecefToLla(const Vector3D *ecef, Vector3D *lla, const std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) {
+    lla[i] = ecefToLla<A>(ecef[i]);
+  }
+}
+
+/**
+ * @brief Converts ECEF coordinates to geodetic positions, from their
+ * coordinates.
+ *
+ * @note This function will result in undefined behavior if any position is
+ * at the center of the Earth.
+ *
+ * @tparam A The accuracy.
+ *
+ * @param xs The ECEF x-coordinates in meters.
+ * @param ys The ECEF y-coordinates in meters.
+ * @param zs The ECEF z-coordinates in meters.
+ * @param latitudes The latitudes in radians.
+ * @param longitudes The longitudes in radians.
+ * @param altitudes The altitudes in meters.
+ * @param n The number of positions.
+ */
+template <AngleAccuracy A = ANGLE_EXACT>
+void ecefToLla(const double *xs, const double *ys, const double *zs,
+               double *latitudes, double *longitudes, double *altitudes,
+               const std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) {
+    detail::ecefToGeodetic<A>(xs[i], ys[i], zs[i], latitudes[i],
+                              longitudes[i], altitudes[i]);
+  }
+}
+
+/**
+ * @brief A local east-north-up frame on the WGS-84 ellipsoid.
+ *
+ * The frame has its origin at a geodetic position, with the x-axis pointing
+ * east, the y-axis pointing north and the z-axis pointing up along the
+ * normal of the ellipsoid. The origin and the rotation are computed once
+ * when the frame is made, so converting a position only takes a subtraction
+ * and a rotation.
+ */
+class EnuFrame {
+public:
+  /**
+   * @brief Makes a frame at a geodetic position.
+   *
+   * @param originLla The latitude and longitude of the origin in radians
+   * and its altitude in meters.
+   */
+  explicit EnuFrame(const Vector3D &originLla)
+      : m_originLla(originLla), m_originEcef(llaToEcef(originLla)) {
+    const double sinLatitude = std::sin(originLla.x());
+    const double cosLatitude = std::cos(originLla.x());
+    const double sinLongitude = std::sin(originLla.y());
+    const double cosLongitude = std::cos(originLla.y());
+
+    this->m_east = Vector3D{-sinLongitude, cosLongitude, 0};
+    this->m_north = Vector3D{-sinLatitude * cosLongitude,
+                             -sinLatitude * sinLongitude, cosLatitude};
+    this->m_up = Vector3D{cosLatitude * cosLongitude,
+                          cosLatitude * sinLongitude, sinLatitude};
+  }
+
+  /**
+   * @brief Gets the geodetic position of the origin.
+   *
+   * @returns The latitude and longitude in radians and the altitude in
+   * meters.
+   */
+  const Vector3D &originLla() const { return this->m_originLla; }
+
+  /**
+   * @brief Gets the ECEF position of the origin.
+   *
+   * @returns The ECEF position in meters.
+   */
+  const Vector3D &originEcef() const { return this->m_originEcef; }
+
+  /**
+   * @brief Gets the east direction.
+   *
+   * @returns The unit vector pointing east, in ECEF coordinates.
+   */
+  const Vector3D &east() const { return this->m_east; }
+
+  /**
+   * @brief Gets the north direction.
+   *
+   * @returns The unit vector pointing north, in ECEF coordinates.
+   */
+  const Vector3D &north() const { return this->m_north; }
+
+  /**
+   * @brief Gets the up direction.
+   *
+   * @returns The unit vector pointing up, in ECEF coordinates.
+   */
+  const Vector3D &up() const { return this->m_up; }
+
+  /**
+   * @brief Converts an ECEF position to the frame.
+   *
+   * @param ecef The ECEF position in meters.
+   *
+   * @returns The east, north and up coordinates in meters.
+   */
+  Vector3D ecefToEnu(const Vector3D &ecef) const {
+    const Vector3D d{ecef.x() - this->m_originEcef.x(),
+                     ecef.y() - this->m_originEcef.y(),
+                     ecef.z() - this->m_originEcef.z()};
+    return Vector3D{d.dot(this->m_east), d.dot(this->m_north),
+                    d.dot(this->m_up)};
+  }
+
+  /**
+   * @brief Converts a position in the frame to ECEF coordinates.
+   *
+   * @param enu The east, north and up coordinates in meters.
+   *
+   * @returns The ECEF position in meters.
+   */
+  Vector3D enuToEcef(const Vector3D &enu) const {
+    const double e = enu.x();
+    const double n = enu.y();
+    const double u = enu.z();
+    return Vector3D{this->m_originEcef.x() + this->m_east.x() * e +
+                        this->m_north.x() * n + this->m_up.x() * u,
+                    this->m_originEcef.y() + this->m_east.y() * e +
+                        this->m_north.y() * n + this->m_up.y() * u,
+                    this->m_originEcef.z() + this->m_north.z() * n +
+                        this->m_up.z() * u};
+  }
+
+  /**
+   * @brief Converts a geodetic position to the frame.
+   *
+   * @tparam A The accuracy.
+   *
+   * @param lla The latitude and longitude in radians and the altitude in
+   * meters.
+   *
+   * @returns The east, north and up coordinates in meters.
+   */
+  template <AngleAccuracy A = ANGLE_EXACT>
+  Vector3D llaToEnu(const Vector3D &lla) const {
+    return this->ecefToEnu(llaToEcef<A>(lla));
+  }
+
+  /**
+   * @brief Converts a position in the frame to a geodetic position.
+   *
+   * @tparam A The accuracy.
+   *
+   * @param enu The east, north and up coordinates in meters.
+   *
+   * @returns The latitude and longitude in radians and the altitude in
+   * meters.
+   */
+  template <AngleAccuracy A = ANGLE_EXACT>
+  Vector3D enuToLla(const Vector3D &enu) const {
+    return ecefToLla<A>(this->enuToEcef(enu));
+  }
+
+  /**
+   * @brief Converts ECEF positions to the frame.
+   *
+   * @param ecef The ECEF positions in meters.
+   * @param enu The east, north and up coordinates in meters.
+   * @param n The number of positions.
+   */
+  void ecefToEnu(const Vector3D *ecef, Vector3D *enu,
+                 const std::size_t n) const {
+    for (std::size_t i = 0; i < n; i++) {
+      enu[i] = this->ecefToEnu(ecef[i]);
+    }
+  }
+
+  /**
+   * @brief Converts ECEF positions to the frame, from their coordinates.
+   *
+   * @param xs The ECEF x-coordinates in meters.
+   * @param ys The ECEF y-coordinates in meters.
+   * @param zs The ECEF z-coordinates in meters.
+   * @param es The east coordinates in meters.
+   * @param ns The north coordinates in meters.
+   * @param us The up coordinates in meters.
+   * @param n The number of positions.
+   */
+  void ecefToEnu(const double *xs, const double *ys, const double *zs,
+                 double *es, double *ns, double *us,
+                 const std::size_t n) const {
+    // the rotation is copied out of the vectors so that the loop only
+    // works on doubles
+    const double ox = this->m_originEcef.x();
+    const double oy = this->m_originEcef.y();
+    const double oz = this->m_originEcef.z();
+    const double ex = this->m_east.x();
+    const double ey = this->m_east.y();
+    const double nx = this->m_north.x();
+    const double ny = this->m_north.y();
+    const double nz = this->m_north.z();
+    const double ux = this->m_up.x();
+    const double uy = this->m_up.y();
+    const double uz = this->m_up.z();
+    for (std::size_t i = 0; i < n; i++) {
+      const double dx = xs[i] - ox;
+      const double dy = ys[i] - oy;
+      const double dz = zs[i] - oz;
+      es[i] = ex * dx + ey * dy;
+      ns[i] = nx * dx + ny * dy + nz * dz;
+      us[i] = ux * dx + uy * dy + uz * dz;
+    }
+  }
+
+  /**
+   * @brief Converts positions in the frame to ECEF coordinates.
+   *
+   * @param enu The east, north and up coordinates in meters.
+   * @param ecef The ECEF positions in meters.
+   * @param n The number of positions.
+   */
+  void enuToEcef(const Vector3D *enu, Vector3D *ecef,
+                 const std::size_t n) const {
+    for (std::size_t i = 0; i < n; i++) {
+      ecef[i] = this->enuToEcef(enu[i]);
+    }
+  }
+
+  /**
+   * @brief Converts positions in the frame to ECEF coordinates, from their
+   * coordinates.
+   *
+   * @param es The east coordinates in meters.
+   * @param ns The north coordinates in meters.
+   * @param us The up coordinates in meters.
+   * @param xs The ECEF x-coordinates in meters.
+   * @param ys The ECEF y-coordinates in meters.
+   * @param zs The ECEF z-coordinates in meters.
+   * @param n The number of positions.
+   */
+  void enuToEcef(const double *es, const double *ns, const double *us,
+                 double *xs, double *ys, double *zs,
+                 const std::size_t n) const {
+    const double ox = this->m_originEcef.x();
+    const double oy = this->m_originEcef.y();
+    const double oz = this->m_originEcef.z();
+    const double ex = this->m_east.x();
+    const double ey = this->m_east.y();
+    const double nx = this->m_north.x();
+    const double ny = this->m_north.y();
+    const double nz = this->m_north.z();
+    const double ux = this->m_up.x();
+    const double uy = this->m_up.y();
+    const double uz = this->m_up.z();
+    for (std::size_t i = 0; i < n; i++) {
+      const double e = es[i];
+      const double north = ns[i];
+      const double u = us[i];
+      xs[i] = ox + ex * e + nx * north + ux * u;
+      ys[i] = oy + ey * e + ny * north + uy * u;
+      zs[i] = oz + nz * north + uz * u;
+    }
+  }
+
+private:
+  Vector3D m_originLla;  //!< The geodetic position of the origin.
+  Vector3D m_originEcef; //!< The ECEF position of the origin.
+  Vector3D m_east;       //!< The east direction in ECEF coordinates.
+  Vector3D m_north;      //!< The north direction in ECEF coordinates.
+  Vector3D m_up;         //!< The up direction in ECEF coordinates.
+};
+} // namespace svector
+
+#endif
@@ -0,0 +1,266 @@
+/**
+ * @file lengths.hpp
+ *
+ * @brief Batch length comparisons without square roots.
+ *
+ * Comparing lengths does not need the lengths themselves: |a| < |b| exactly
+ * when |a|² < |b|², and a point is within a radius r of a center exactly
+ * when its squared distance is at most r². The functions in this file only
+ * compute squared lengths, so they take no square roots.
+ *
+ * The kernels that take separate arrays for each coordinate have no
+ * branches, so the compiler can vectorize them. The radius queries test a
+ * chunk of points into flags and then pack the indices of the points inside
+ * into the output, like the culling kernels. Each call only touches the
+ * range of points it is given.
+ *
+ * This file is not included in vectors.hpp, so it has to be included
+ * separately.
+ *
+ * @copyright Copyright (c) 2023 Jonathan Liu. This project is released under
+ * the MIT License. All rights reserved.
+ */
+
+#ifndef INCLUDE_SVECTOR_LENGTHS_HPP_
+#define INCLUDE_SVECTOR_LENGTHS_HPP_
+
+#include <algorithm> // std::sort
+#include <cstddef>   // std::size_t
+#include <vector>    // std::vector
+
+#include "simplevectors/core/batch.hpp"  // svector::detail::batchCompact
+#include "simplevectors/core/traits.hpp" // svector::VectorTraits
+
+namespace svector {
+/**
+ * @brief Computes the squared magnitudes of vectors.
+ *
+ * @tparam V svector::Vector or a class derived from it.
+ *
+ * @param vectors The vectors.
+ * @param out The squared magnitudes.
+ * @param n The number of vectors.
+ */
+template <typename V>
+void magnitudesSquared(const V *vectors,
+                       typename VectorTraits<V>::value_type *out,
+                       const std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) {
+    out[i] = vectors[i].magnSquared();
+  }
+}
+
+/**
+ * @brief Computes the squared magnitudes of 2D vectors from their
+ * components.
+ *
+ * @param xs The x-components.
+ * @param ys The y-components.
+ * @param out The squared magnitudes.
+ * @param n The number of vectors.
+ */
+inline void magnitudesSquared(const double *xs, const double *ys,
+                              double *out, const std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) {
+    out[i] = xs[i] * xs[i] + ys[i] * ys[i];
+  }
+}
+
+/**
+ * @brief Computes the squared magnitudes of 3D vectors from their
+ * components.
+ *
+ * @param xs The x-components.
+ * @param ys The y-components.
+ * @param zs The z-components.
+ * @param out The squared magnitudes.
+ * @param n The number of vectors.
+ */
+inline void magnitudesSquared(const double *xs, const double *ys,
+                              const double *zs, double *out,
+                              const std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) {
+    out[i] = xs[i] * xs[i] + ys[i] * ys[i] + zs[i] * zs[i];
+  }
+}
+
+/**
+ * @brief Finds the points in a range that are within a radius of a center.
+ *
+ * Points exactly at the radius are inside.
+ *
+ * @tparam V svector::Vector or a class derived from it.
+ *
+ * @param points The points.
+ * @param begin The first point to test.
+ * @param end One past the last point to test.
+ * @param center The center.
+ * @param radius The radius.
+ * @param out Where to write the indices of the points inside, in increasing
+ * order. It needs room for end - begin indices.
+ *
+ * @returns The number of indices written.
+ */
+template <typename V>
+std::size_t withinRadius(const V *points, const std::size_t begin,
+                         const std::size_t end, const V &center,
+                         const double radius, std::size_t *out) {
+  const double radiusSquared = radius * radius;
+  double inside[detail::BATCH_CHUNK];
+  std::size_t count = 0;
+  for (std::size_t start = begin; start < end; start += detail::BATCH_CHUNK) {
+    const std::size_t m =
+        end - start < detail::BATCH_CHUNK ? end - start : detail::BATCH_CHUNK;
+    for (std::size_t i = 0; i < m; i++) {
+      inside[i] = static_cast<double>(
+          static_cast<double>(points[start + i].distanceSquared(center)) <=
+          radiusSquared);
+    }
+    count = detail::batchCompact(inside, m, start, out, count);
+  }
+  return count;
+}
+
+/**
+ * @brief Finds the 2D points in a range that are within a radius of a
+ * center, from their coordinates.
+ *
+ * Points exactly at the radius are inside.
+ *
+ * @param xs The x-coordinates.
+ * @param ys The y-coordinates.
+ * @param begin The first point to test.
+ * @param end One past the last point to test.
+ * @param cx The x-coordinate of the center.
+ * @param cy The y-coordinate of the center.
+ * @param radius The radius.
+ * @param out Where to write the indices of the points inside, in increasing
+ * order. It needs room for end - begin indices.
+ *
+ * @returns The number of indices written.
+ */
+inline std::size_t withinRadius(const double *xs, const double *ys,
+                                const std::size_t begin, const std::size_t end,
+                                const double cx, const double cy,
+                                const double radius, std::size_t *out) {
+  const double radiusSquared = radius * radius;
+  double inside[detail::BATCH_CHUNK];
+  std::size_t count = 0;
+  for (std::size_t start = begin; start < end; start += detail::BATCH_CHUNK) {
+    const std::size_t m =
+        end - start < detail::BATCH_CHUNK ? end - start : detail::BATCH_CHUNK;
+    const double *x = xs + start;
+    const double *y = ys + start;
+    for (std::size_t i = 0; i < m; i++) {
+      const double dx = x[i] - cx;
+      const double dy = y[i] - cy;
+      inside[i] = static_cast<double>(dx * dx + dy * dy <= radiusSquared);
+    }
+    count = detail::batchCompact(inside, m, start, out, count);
+  }
+  return count;
+}
+
+/**
+ * @brief Finds the 3D points in a range that are within a radius of a
+ * center, from their coordinates.
+ *
+ * Points exactly at the radius are inside.
+ *
+ * @param xs The x-coordinates.
+ * @param ys The y-coordinates.
+ * @param zs The z-coordinates.
+ * @param begin The first point to test.
+ * @param end One past the last point to test.
+ * @param cx The x-coordinate of the center.
+ * @param cy The y-coordinate of the center.
+ * @param cz The z-coordinate of the center.
+ * @param radius The radius.
+ * @param out Where to write the indices of the points inside, in increasing
+ * order. It needs room for end - begin indices.
+ *
+ * @returns The number of indices written.
+ */
+inline std::size_t withinRadius(const double *xs, const double *ys,
+                                const double *zs, const std::size_t begin,
+                                const std::size_t end, const double cx,
+                                const double cy, const double cz,
+                                const double radius, std::size_t *out) {
+  const double radiusSquared = radius * radius;
+  double inside[detail::BATCH_CHUNK];
+  std::size_t count = 0;
+  for (std::size_t start = begin; start < end; start += detail::BATCH_CHUNK) {
+    const std::size_t m =
+        end - start < detail::BATCH_CHUNK ? end - start : detail::BATCH_CHUNK;
+    const double *x = xs + start;
+    const double *y = ys + start;
+    const double *z = zs + start;
+    for (std::size_t i = 0; i < m; i++) {
+      const double dx = x[i] - cx;
+      const double dy = y[i] - cy;
+      const double dz = z[i] - cz;
+      inside[i] =
+          static_cast<double>(dx * dx + dy * dy + dz * dz <= radiusSquared);
+    }
+    count = detail::batchCompact(inside, m, start, out, count);
+  }
+  return count;
+}
+
+/**
+ * @brief Finds the order of vectors by their magnitude, from shortest to
+ * longest.
+ *
+ * Each squared magnitude is only computed once. Vectors of the same length
+ * keep their order.
+ *
+ * @tparam V svector::Vector or a class derived from it.
+ *
+ * @param vectors The vectors.
+ * @param n The number of vectors.
+ * @param order Where to write the indices of the vectors in sorted order. It
+ * needs room for n indices.
+ */
+template <typename V>
+void sortByLength(const V *vectors, const std::size_t n, std::size_t *order) {
+  typedef typename VectorTraits<V>::value_type T;
+  std::vector<T> keys(n);
+  magnitudesSquared(vectors, keys.data(), n);
+
+  for (std::size_t i = 0; i < n; i++) {
+    order[i] = i;
+  }
+  // ties are broken by index, which keeps the sort stable
+  std::sort(order, order + n,
+            [&keys](const std::size_t a, const std::size_t b) {
+              return keys[a] < keys[b] || (keys[a] == keys[b] && a < b);
+            });
+}
+
+/**
+ * @brief Sorts vectors by their magnitude, from shortest to longest.
+ *
+ * The vectors are compared by their squared magnitudes. Vectors of the same
+ * length keep their order.
+ *
+ * @tparam V svector::Vector or a class derived from it.
+ *
+ * @param vectors The vectors, which are sorted in place.
+ * @param n The number of vectors.
+ */
+template <typename V> void sortByLength(V *vectors, const std::size_t n) {
+  std::vector<std::size_t> order(n);
+  sortByLength(static_cast<const V *>(vectors), n, order.data());
+
+  std::vector<V> sorted;
+  sorted.reserve(n);
+  for (std::size_t i = 0; i < n; i++) {
+    sorted.push_back(vectors[order[i]]);
+  }
+  for (std::size_t i = 0; i < n; i++) {
+    vectors[i] = sorted[i];
+  }
+}
+} // namespace svector
+
+#endif
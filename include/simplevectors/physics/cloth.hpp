@@ -0,0 +1,566 @@
+/**
+ * @file cloth.hpp
+ *
+ * @brief Cloth simulation with position-based dynamics.
+ *
+ * svector::Cloth moves particles connected by distance constraints. Every
+ * substep predicts the positions from the velocities, projects the
+ * constraints onto the predicted positions and derives the new velocities
+ * from how far the particles moved. Constraints have a compliance, the
+ * inverse of their stiffness, as in extended position-based dynamics, so the
+ * stiffness does not depend on the time step or on the number of
+ * iterations. A constraint with compliance works like a spring of a
+ * mass-spring system that cannot become unstable.
+ *
+ * Bending is resisted by distance constraints across the bends, for example
+ * between particles two apart on a grid or between the vertices opposite to
+ * the shared edge of neighboring triangles. They are usually given a larger
+ * compliance than the edges.
+ *
+ * The constraints are colored so that no two constraints of the same color
+ * share a particle, and are stored sorted by color with one array for each
+ * of their fields. The constraints of one color can be projected in any
+ * order, so a color can be split into ranges that are solved
+ * independently.
+ *
+ * This file is not included in vectors.hpp, so it has to be included
+ * separately.
+ *
+ * @copyright Copyright (c) 2023 Jonathan Liu. This project is released under
+ * the MIT License. All rights reserved.
+ */
+
+#ifndef INCLUDE_SVECTOR_CLOTH_HPP_
+#define INCLUDE_SVECTOR_CLOTH_HPP_
+
+#include <algorithm> // std::fill
+#include <cmath>     // std::sqrt
+#include <cstddef>   // std::size_t
+#include <utility>   // std::pair
+#include <vector>    // std::vector
+
+#include "simplevectors/core/vector3d.hpp" // svector::Vector3D
+
+namespace svector {
+/**
+ * @brief Particles connected by distance constraints.
+ *
+ * Cloths are stepped with step(), or with the stages of a substep, which
+ * allow solving the ranges of a color separately:
+ *
+ * @code
+ * cloth.predict(h);
+ * for (std::size_t iteration = 0; iteration < iterations; iteration++) {
+ *   for (std::size_t c = 0; c < cloth.colors(); c++) {
+ *     cloth.solveColor(c, 0, cloth.colorSize(c), h); // split in parallel
+ *   }
+ * }
+ * cloth.updateVelocities(h);
+ * @endcode
+ */
+class Cloth {
+public:
+  /**
+   * @brief Creates a cloth without particles, with gravity along the
+   * negative y-axis.
+   */
+  Cloth()
+      : m_gravity{0, -9.81, 0}, m_damping(0), m_substeps(8), m_iterations(1),
+        m_colored(true), m_colorOffsets(1, 0) {}
+
+  /**
+   * @brief Adds a particle.
+   *
+   * @param position The position of the particle.
+   * @param inverseMass The inverse of the mass of the particle. Particles
+   * with zero inverse mass are pinned and only move when they are moved with
+   * position().
+   *
+   * @returns The index of the particle.
+   */
+  std::size_t add(const Vector3D &position, const double inverseMass) {
+    this->m_x.push_back(position.x());
+    this->m_y.push_back(position.y());
+    this->m_z.push_back(position.z());
+    this->m_px.push_back(position.x());
+    this->m_py.push_back(position.y());
+    this->m_pz.push_back(position.z());
+    this->m_vx.push_back(0);
+    this->m_vy.push_back(0);
+    this->m_vz.push_back(0);
+    this->m_w.push_back(inverseMass);
+    return this->m_w.size() - 1;
+  }
+
+  /**
+   * @brief Adds a distance constraint.
+   *
+   * The rest length is the current distance between the particles.
+   *
+   * @param a The first particle.
+   * @param b The second particle.
+   * @param compliance The inverse stiffness, zero for an inextensible
+   * constraint.
+   */
+  void addDistance(const std::size_t a, const std::size_t b,
+                   const double compliance = 0) {
+    const double dx = this->m_x[b] - this->m_x[a];
+    const double dy = this->m_y[b] - this->m_y[a];
+    const double dz = this->m_z[b] - this->m_z[a];
+    this->m_a.push_back(a);
+    this->m_b.push_back(b);
+    this->m_rest.push_back(std::sqrt(dx * dx + dy * dy + dz * dz));
+    this->m_compliance.push_back(compliance);
+    this->m_lambda.push_back(0);
+    this->m_colored = false;
+  }
+
+  /**
+   * @brief Adds a bending constraint across a bend.
+   *
+   * @param a The particle on one side of the bend.
+   * @param b The particle on the other side of the bend.
+   * @param compliance The inverse bending stiffness.
+   */
+  void addBending(const std::size_t a, const std::size_t b,
+                  const double compliance) {
+    this->addDistance(a, b, compliance);
+  }
+
+  /**
+   * @brief Gets the number of particles.
+   *
+   * @returns The number of particles.
+   */
+  std::size_t size() const { return this->m_w.size(); }
+
+  /**
+   * @brief Gets the number of constraints.
+   *
+   * @returns The number of distance and bending constraints.
+   */
+  std::size_t constraints() const { return this->m_a.size(); }
+
+  /**
+   * @brief Gets the position of a particle.
+   *
+   * @param i The index of the particle.
+   *
+   * @returns The position.
+   */
+  Vector3D position(const std::size_t i) const {
+    return Vector3D(this->m_x[i], this->m_y[i], this->m_z[i]);
+  }
+
+  /**
+   * @brief Moves a particle, for example a pinned one.
+   *
+   * @param i The index of the particle.
+   * @param position The new position.
+   */
+  void position(const std::size_t i, const Vector3D &position) {
+    this->m_x[i] = position.x();
+    this->m_y[i] = position.y();
+    this->m_z[i] = position.z();
+  }
+
+  /**
+   * @brief Gets the velocity of a particle.
+   *
+   * @param i The index of the particle.
+   *
+   * @returns The velocity.
+   */
+  Vector3D velocity(const std::size_t i) const {
+    return Vector3D(this->m_vx[i], this->m_vy[i], this->m_vz[i]);
+  }
+
+  /**
+   * @brief Sets the velocity of a particle.
+   *
+   * @param i The index of the particle.
+   * @param velocity The new velocity.
+   */
+  void velocity(const std::size_t i, const Vector3D &velocity) {
+    this->m_vx[i] = velocity.x();
+    this->m_vy[i] = velocity.y();
+    this->m_vz[i] = velocity.z();
+  }
+
+  /**
+   * @brief Gets the inverse mass of a particle.
+   *
+   * @param i The index of the particle.
+   *
+   * @returns The inverse mass, zero for pinned particles.
+   */
+  double inverseMass(const std::size_t i) const { return this->m_w[i]; }
+
+  /**
+   * @brief Sets the inverse mass of a particle, zero to pin it.
+   *
+   * @param i The index of the particle.
+   * @param inverseMass The new inverse mass.
+   */
+  void inverseMass(const std::size_t i, const double inverseMass) {
+    this->m_w[i] = inverseMass;
+  }
+
+  /**
+   * @brief Sets the gravity.
+   *
+   * @param gravity The acceleration of all particles due to gravity.
+   */
+  void gravity(const Vector3D &gravity) {
+    this->m_gravity[0] = gravity.x();
+    this->m_gravity[1] = gravity.y();
+    this->m_gravity[2] = gravity.z();
+  }
+
+  /**
+   * @brief Sets the damping.
+   *
+   * @param damping The fraction of the velocity lost per second.
+   */
+  void damping(const double damping) { this->m_damping = damping; }
+
+  /**
+   * @brief Sets how finely step() divides a time step.
+   *
+   * Substeps improve the stiffness more than iterations for the same cost.
+   *
+   * @param substeps The number of substeps per step.
+   * @param iterations The number of passes over the constraints per
+   * substep.
+   */
+  void substeps(const std::size_t substeps, const std::size_t iterations) {
+    this->m_substeps = substeps;
+    this->m_iterations = iterations;
+  }
+
+  /**
+   * @brief Advances the cloth by one time step.
+   *
+   * @param dt The time step.
+   */
+  void step(const double dt) {
+    const double h = dt / static_cast<double>(this->m_substeps);
+    for (std::size_t substep = 0; substep < this->m_substeps; substep++) {
+      this->predict(h);
+      for (std::size_t iteration = 0; iteration < this->m_iterations;
+           iteration++) {
+        for (std::size_t c = 0; c < this->colors(); c++) {
+          this->solveColor(c, 0, this->colorSize(c), h);
+        }
+      }
+      this->updateVelocities(h);
+    }
+  }
+
+  /**
+   * @brief Starts a substep by moving the particles by their velocities.
+   *
+   * Colors the constraints if constraints were added since the last
+   * substep.
+   *
+   * @param h The length of the substep.
+   */
+  void predict(const double h) {
+    if (!this->m_colored) {
+      this->color();
+    }
+
+    const double gx = h * this->m_gravity[0];
+    const double gy = h * this->m_gravity[1];
+    const double gz = h * this->m_gravity[2];
+    const double keep = 1 - this->m_damping * h > 0 ? 1 - this->m_damping * h
+                                                     : 0;
+    const std::size_t n = this->size();
+    double *x = this->m_x.data();
+    double *y = this->m_y.data();
+    double *z = this->m_z.data();
+    double *px = this->m_px.data();
+    double *py = this->m_py.data();
+    double *pz = this->m_pz.data();
+    double *vx = this->m_vx.data();
+    double *vy = this->m_vy.data();
+    double *vz = this->m_vz.data();
+    const double *w = this->m_w.data();
+    for (std::size_t i = 0; i < n; i++) {
+      // pinned particles have no velocity and ignore gravity
+      const double free = w[i] != 0 ? 1 : 0;
+      vx[i] = free * (keep * vx[i] + gx);
+      vy[i] = free * (keep * vy[i] + gy);
+      vz[i] = free * (keep * vz[i] + gz);
+      px[i] = x[i];
+      py[i] = y[i];
+      pz[i] = z[i];
+      x[i] += h * vx[i];
+      y[i] += h * vy[i];
+      z[i] += h * vz[i];
+    }
+
+    std::fill(this->m_lambda.begin(), this->m_lambda.end(), 0);
+  }
+
+  /**
+   * @brief Gets the number of colors of the constraints.
+   *
+   * @returns The number of colors.
+   *
+   * @note This method will result in undefined behavior if constraints
+   * were added since the last call to predict() or step().
+   */
+  std::size_t colors() const { return this->m_colorOffsets.size() - 1; }
+
+  /**
+   * @brief Gets the number of constraints of a color.
+   *
+   * @param color The color.
+   *
+   * @returns The number of constraints.
+   */
+  std::size_t colorSize(const std::size_t color) const {
+    return this->m_colorOffsets[color + 1] - this->m_colorOffsets[color];
+  }
+
+  /**
+   * @brief Gets the particles of a constraint.
+   *
+   * @param color The color of the constraint.
+   * @param k The index of the constraint within the color.
+   *
+   * @returns The two particles connected by the constraint.
+   */
+  std::pair<std::size_t, std::size_t> constraint(const std::size_t color,
+                                                 const std::size_t k) const {
+    const std::size_t index = this->m_colorOffsets[color] + k;
+    return std::make_pair(this->m_a[index], this->m_b[index]);
+  }
+
+  /**
+   * @brief Projects a range of the constraints of one color.
+   *
+   * Different ranges of the same color touch different particles and can be
+   * solved at the same time.
+   *
+   * @param color The color.
+   * @param begin The first constraint of the range within the color.
+   * @param end One past the last constraint of the range within the color.
+   * @param h The length of the substep.
+   */
+  void solveColor(const std::size_t color, const std::size_t begin,
+                  const std::size_t end, const double h) {
+    const std::size_t offset = this->m_colorOffsets[color];
+    const double inverseH2 = 1 / (h * h);
+    const std::size_t *ca = this->m_a.data() + offset;
+    const std::size_t *cb = this->m_b.data() + offset;
+    const double *rest = this->m_rest.data() + offset;
+    const double *compliance = this->m_compliance.data() + offset;
+    double *lambda = this->m_lambda.data() + offset;
+    double *x = this->m_x.data();
+    double *y = this->m_y.data();
+    double *z = this->m_z.data();
+    const double *w = this->m_w.data();
+
+    for (std::size_t k = begin; k < end; k++) {
+      const std::size_t a = ca[k];
+      const std::size_t b = cb[k];
+      const double dx = x[b] - x[a];
+      const double dy = y[b] - y[a];
+      const double dz = z[b] - z[a];
+      const double length = std::sqrt(dx * dx + dy * dy + dz * dz);
+      const double alpha = compliance[k] * inverseH2;
+      const double weight = w[a] + w[b] + alpha;
+      if (length == 0 || weight == 0) {
+        continue;
+      }
+
+      const double change =
+          (rest[k] - length - alpha * lambda[k]) / weight;
+      lambda[k] += change;
+      const double scale = change / length;
+      x[a] -= w[a] * scale * dx;
+      y[a] -= w[a] * scale * dy;
+      z[a] -= w[a] * scale * dz;
+      x[b] += w[b] * scale * dx;
+      y[b] += w[b] * scale * dy;
+      z[b] += w[b] * scale * dz;
+    }
+  }
+
+  /**
+   * @brief Ends a substep by setting the velocities from the distance the
+   * particles moved.
+   *
+   * @param h The length of the substep.
+   */
+  void updateVelocities(const double h) {
+    const double inverseH = 1 / h;
+    const std::size_t n = this->size();
+    for (std::size_t i = 0; i < n; i++) {
+      const double free = this->m_w[i] != 0 ? inverseH : 0;
+      this->m_vx[i] = free * (this->m_x[i] - this->m_px[i]);
+      this->m_vy[i] = free * (this->m_y[i] - this->m_py[i]);
+      this->m_vz[i] = free * (this->m_z[i] - this->m_pz[i]);
+    }
+  }
+
+private:
+  std::vector<double> m_x;  //!< x-coordinates of the particles.
+  std::vector<double> m_y;  //!< y-coordinates of the particles.
+  std::vector<double> m_z;  //!< z-coordinates of the particles.
+  std::vector<double> m_px; //!< x-coordinates at the start of the substep.
+  std::vector<double> m_py; //!< y-coordinates at the start of the substep.
+  std::vector<double> m_pz; //!< z-coordinates at the start of the substep.
+  std::vector<double> m_vx; //!< x-components of the velocities.
+  std::vector<double> m_vy; //!< y-components of the velocities.
+  std::vector<double> m_vz; //!< z-components of the velocities.
+  std::vector<double> m_w;  //!< Inverse masses of the particles.
+
+  std::vector<std::size_t> m_a;     //!< First particle of each constraint.
+  std::vector<std::size_t> m_b;     //!< Second particle of each constraint.
+  std::vector<double> m_rest;       //!< Rest lengths.
+  std::vector<double> m_compliance; //!< Inverse stiffnesses.
+  std::vector<double> m_lambda;     //!< Multipliers of the substep.
+
+  double m_gravity[3];      //!< Gravity acceleration.
+  double m_damping;         //!< Fraction of the velocity lost per second.
+  std::size_t m_substeps;   //!< Substeps per step.
+  std::size_t m_iterations; //!< Iterations per substep.
+  bool m_colored;           //!< Whether the constraints are sorted by color.
+  std::vector<std::size_t> m_colorOffsets; //!< Start of each color.
+
+  /**
+   * @brief Colors the constraints greedily and sorts them by color.
+   *
+   * Each constraint gets the smallest color that no earlier constraint on
+   * either of its particles has.
+   */
+  void color() {
+    const std::size_t m = this->m_a.size();
+    std::vector<std::vector<std::size_t>> used(this->size());
+    std::vector<std::size_t> colorOf(m);
+    std::size_t count = 0;
+    std::vector<char> taken;
+    for (std::size_t k = 0; k < m; k++) {
+      const std::vector<std::size_t> &ua = used[this->m_a[k]];
+      const std::vector<std::size_t> &ub = used[this->m_b[k]];
+      taken.assign(ua.size() + ub.size() + 1, 0);
+      for (const std::size_t c : ua) {
+        if (c < taken.size()) {
+          taken[c] = 1;
+        }
+      }
+      for (const std::size_t c : ub) {
+        if (c < taken.size()) {
+          taken[c] = 1;
+        }
+      }
+
+      std::size_t c = 0;
+      while (taken[c]) {
+        c++;
+      }
+      colorOf[k] = c;
+      used[this->m_a[k]].push_back(c);
+      used[this->m_b[k]].push_back(c);
+      count = c + 1 > count ? c + 1 : count;
+    }
+
+    this->m_colorOffsets.assign(count + 1, 0);
+    for (std::size_t k = 0; k < m; k++) {
+      this->m_colorOffsets[colorOf[k] + 1]++;
+    }
+    for (std::size_t c = 0; c < count; c++) {
+      this->m_colorOffsets[c + 1] += this->m_colorOffsets[c];
+    }
+
+    std::vector<std::size_t> next(this->m_colorOffsets.begin(),
+                                  this->m_colorOffsets.end() - 1);
+    std::vector<std::size_t> a(m);
+    std::vector<std::size_t> b(m);
+    std::vector<double> rest(m);
+    std::vector<double> compliance(m);
+    for (std::size_t k = 0; k < m; k++) {
+      const std::size_t to = next[colorOf[k]]++;
+      a[to] = this->m_a[k];
+      b[to] = this->m_b[k];
+      rest[to] = this->m_rest[k];
+      compliance[to] = this->m_compliance[k];
+    }
+    this->m_a.swap(a);
+    this->m_b.swap(b);
+    this->m_rest.swap(rest);
+    this->m_compliance.swap(compliance);
+    this->m_colored = true;
+  }
+};
+
+/**
+ * @brief Creates a rectangular cloth of particles on a grid.
+ *
+ * Neighboring particles along the rows and columns and across both
+ * diagonals of the cells are connected by distance constraints, and
+ * particles two apart along the rows and columns by bending constraints.
+ *
+ * @param origin The position of the first particle.
+ * @param across The offset between neighboring particles of a row.
+ * @param down The offset between neighboring rows.
+ * @param columns The number of particles in each row.
+ * @param rows The number of rows.
+ * @param mass The mass of the whole cloth.
+ * @param compliance The compliance of the distance constraints.
+ * @param bendingCompliance The compliance of the bending constraints.
+ *
+ * @returns The cloth. The particle in row r and column c has the index
+ * r * columns + c.
+ *
+ * @note This method will result in undefined behavior if there are fewer
+ * than two rows or columns.
+ */
+inline Cloth clothGrid(const Vector3D &origin, const Vector3D &across,
+                       const Vector3D &down, const std::size_t columns,
+                       const std::size_t rows, const double mass,
+                       const double compliance = 0,
+                       const double bendingCompliance = 1e-3) {
+  Cloth cloth;
+  const double inverseMass = static_cast<double>(columns * rows) / mass;
+  for (std::size_t r = 0; r < rows; r++) {
+    for (std::size_t c = 0; c < columns; c++) {
+      const double fr = static_cast<double>(r);
+      const double fc = static_cast<double>(c);
+      cloth.add(Vector3D(origin.x() + fc * across.x() + fr * down.x(),
+                         origin.y() + fc * across.y() + fr * down.y(),
+                         origin.z() + fc * across.z() + fr * down.z()),
+                inverseMass);
+    }
+  }
+
+  for (std::size_t r = 0; r < rows; r++) {
+    for (std::size_t c = 0; c < columns; c++) {
+      const std::size_t i = r * columns + c;
+      if (c + 1 < columns) {
+        cloth.addDistance(i, i + 1, compliance);
+      }
+      if (r + 1 < rows) {
+        cloth.addDistance(i, i + columns, compliance);
+      }
+      if (c + 1 < columns && r + 1 < rows) {
+        cloth.addDistance(i, i + columns + 1, compliance);
+        cloth.addDistance(i + 1, i + columns, compliance);
+      }
+      if (c + 2 < columns) {
+        cloth.addBending(i, i + 2, bendingCompliance);
+      }
+      if (r + 2 < rows) {
+        cloth.addBending(i, i + 2 * columns, bendingCompliance);
+      }
+    }
+  }
+
+  return cloth;
+}
+} // namespace svector
+
+#endif
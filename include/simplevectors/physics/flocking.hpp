@@ -0,0 +1,385 @@
+/**
+ * @file flocking.hpp
+ *
+ * @brief Flocking of 2D agents with separation, alignment and cohesion.
+ *
+ * svector::Flock steers every agent by the three rules of Reynolds' boids:
+ * move away from agents that are too close, match the velocity of the
+ * agents around, and move towards their center. The agents live on a torus,
+ * so agents that leave one side of the world come back on the other.
+ *
+ * Every step the agents are sorted into the cells of a grid whose cells are
+ * at least as large as the neighbor radius, and copies of their positions
+ * and velocities are stored in cell order. The neighbors of an agent are in
+ * the 9 cells around it, which are contiguous ranges of the copies, so the
+ * loops over them read memory in order and have no branches.
+ *
+ * The state is double buffered: steering reads the state of the last step
+ * and writes the state of the next, which is swapped in at the end. Any
+ * range of agents can therefore be steered independently.
+ *
+ * This file is not included in vectors.hpp, so it has to be included
+ * separately.
+ *
+ * @copyright Copyright (c) 2023 Jonathan Liu. This project is released under
+ * the MIT License. All rights reserved.
+ */
+
+#ifndef INCLUDE_SVECTOR_FLOCKING_HPP_
+#define INCLUDE_SVECTOR_FLOCKING_HPP_
+
+#include <cmath>   // std::sqrt, std::floor
+#include <cstddef> // std::size_t
+#include <vector>  // std::vector
+
+#include "simplevectors/core/vector2d.hpp" // svector::Vector2D
+
+namespace svector {
+/**
+ * @brief Parameters of the flocking rules.
+ */
+struct FlockSettings {
+  double radius;           //!< Distance within which agents see each other.
+  double separationRadius; //!< Distance below which agents move apart.
+  double separation;       //!< Weight of the separation rule.
+  double alignment;        //!< Weight of the alignment rule.
+  double cohesion;         //!< Weight of the cohesion rule.
+  double maxForce;         //!< Largest acceleration from the rules.
+  double maxSpeed;         //!< Largest speed of an agent.
+
+  /**
+   * @brief Creates the default settings.
+   */
+  FlockSettings()
+      : radius(1), separationRadius(0.4), separation(1.5), alignment(1),
+        cohesion(1), maxForce(5), maxSpeed(2) {}
+};
+
+/**
+ * @brief Agents that flock in a 2D world that wraps around.
+ *
+ * Flocks are stepped with step(), or with the stages of a step, which allow
+ * steering ranges of agents separately:
+ *
+ * @code
+ * flock.buildGrid();
+ * flock.steer(begin, end, dt); // for all ranges
+ * flock.swap();
+ * @endcode
+ */
+class Flock {
+public:
+  /**
+   * @brief Creates a flock without agents.
+   *
+   * @param settings The parameters of the rules.
+   * @param width The width of the world.
+   * @param height The height of the world.
+   */
+  Flock(const FlockSettings &settings, const double width,
+        const double height)
+      : m_settings(settings), m_width(width), m_height(height) {
+    const double columns = std::floor(width / settings.radius);
+    const double rows = std::floor(height / settings.radius);
+    this->m_columns = columns < 1 ? 1 : static_cast<std::size_t>(columns);
+    this->m_rows = rows < 1 ? 1 : static_cast<std::size_t>(rows);
+  }
+
+  /**
+   * @brief Adds an agent.
+   *
+   * @param position The position, inside the world.
+   * @param velocity The velocity.
+   *
+   * @returns The index of the agent.
+   */
+  std::size_t add(const Vector2D &position, const Vector2D &velocity) {
+    this->m_x.push_back(position.x());
+    this->m_y.push_back(position.y());
+    this->m_vx.push_back(velocity.x());
+    this->m_vy.push_back(velocity.y());
+    this->m_nextX.push_back(position.x());
+    this->m_nextY.push_back(position.y());
+    this->m_nextVx.push_back(velocity.x());
+    this->m_nextVy.push_back(velocity.y());
+    return this->m_x.size() - 1;
+  }
+
+  /**
+   * @brief Gets the number of agents.
+   *
+   * @returns The number of agents.
+   */
+  std::size_t size() const { return this->m_x.size(); }
+
+  /**
+   * @brief Gets the position of an agent.
+   *
+   * @param i The index of the agent.
+   *
+   * @returns The position.
+   */
+  Vector2D position(const std::size_t i) const {
+    return Vector2D(this->m_x[i], this->m_y[i]);
+  }
+
+  /**
+   * @brief Gets the velocity of an agent.
+   *
+   * @param i The index of the agent.
+   *
+   * @returns The velocity.
+   */
+  Vector2D velocity(const std::size_t i) const {
+    return Vector2D(this->m_vx[i], this->m_vy[i]);
+  }
+
+  /**
+   * @brief Gets the x-coordinates of all agents.
+   *
+   * @returns The x-coordinates, for example for drawing.
+   */
+  const std::vector<double> &x() const { return this->m_x; }
+
+  /**
+   * @brief Gets the y-coordinates of all agents.
+   *
+   * @returns The y-coordinates, for example for drawing.
+   */
+  const std::vector<double> &y() const { return this->m_y; }
+
+  /**
+   * @brief Advances the flock by one time step.
+   *
+   * @param dt The time step.
+   */
+  void step(const double dt) {
+    this->buildGrid();
+    this->steer(0, this->size(), dt);
+    this->swap();
+  }
+
+  /**
+   * @brief Sorts the agents into the grid.
+   */
+  void buildGrid() {
+    const std::size_t n = this->size();
+    const std::size_t cells = this->m_columns * this->m_rows;
+    std::vector<std::size_t> &cell = this->m_cell;
+    cell.resize(n);
+    this->m_cellStart.assign(cells + 1, 0);
+    for (std::size_t i = 0; i < n; i++) {
+      cell[i] = this->row(this->m_y[i]) * this->m_columns +
+                this->column(this->m_x[i]);
+      this->m_cellStart[cell[i] + 1]++;
+    }
+    for (std::size_t c = 0; c < cells; c++) {
+      this->m_cellStart[c + 1] += this->m_cellStart[c];
+    }
+
+    std::vector<std::size_t> &next = this->m_next;
+    next.assign(this->m_cellStart.begin(), this->m_cellStart.end() - 1);
+    this->m_sortedX.resize(n);
+    this->m_sortedY.resize(n);
+    this->m_sortedVx.resize(n);
+    this->m_sortedVy.resize(n);
+    this->m_order.resize(n);
+    for (std::size_t i = 0; i < n; i++) {
+      const std::size_t to = next[cell[i]]++;
+      this->m_order[to] = i;
+      this->m_sortedX[to] = this->m_x[i];
+      this->m_sortedY[to] = this->m_y[i];
+      this->m_sortedVx[to] = this->m_vx[i];
+      this->m_sortedVy[to] = this->m_vy[i];
+    }
+  }
+
+  /**
+   * @brief Steers and moves a range of agents into the next state.
+   *
+   * The range is taken in the order of the grid rather than in the order of
+   * the indices, so the agents of a range are close to each other and share
+   * most of their neighbors. buildGrid() must have been called since the
+   * last swap().
+   *
+   * @param begin The first agent of the range in grid order.
+   * @param end One past the last agent of the range in grid order.
+   * @param dt The time step.
+   */
+  void steer(const std::size_t begin, const std::size_t end,
+             const double dt) {
+    const FlockSettings &s = this->m_settings;
+    const double r2 = s.radius * s.radius;
+    const double separation2 = s.separationRadius * s.separationRadius;
+    const double width = this->m_width;
+    const double height = this->m_height;
+    const double *sx = this->m_sortedX.data();
+    const double *sy = this->m_sortedY.data();
+    const double *svx = this->m_sortedVx.data();
+    const double *svy = this->m_sortedVy.data();
+
+    std::size_t columns[3];
+    std::size_t rows[3];
+    for (std::size_t k = begin; k < end; k++) {
+      const double x = sx[k];
+      const double y = sy[k];
+      const double vx = svx[k];
+      const double vy = svy[k];
+      const std::size_t columnCount =
+          this->around(this->column(x), this->m_columns, columns);
+      const std::size_t rowCount =
+          this->around(this->row(y), this->m_rows, rows);
+
+      double count = 0;
+      double sumVx = 0;
+      double sumVy = 0;
+      double sumDx = 0;
+      double sumDy = 0;
+      double awayX = 0;
+      double awayY = 0;
+      for (std::size_t r = 0; r < rowCount; r++) {
+        for (std::size_t c = 0; c < columnCount; c++) {
+          const std::size_t cell = rows[r] * this->m_columns + columns[c];
+          const std::size_t first = this->m_cellStart[cell];
+          const std::size_t last = this->m_cellStart[cell + 1];
+          for (std::size_t j = first; j < last; j++) {
+            // offset to the closest copy of the other agent on the torus
+            double dx = sx[j] - x;
+            double dy = sy[j] - y;
+            dx -= dx > width / 2 ? width : (dx < -width / 2 ? -width : 0);
+            dy -= dy > height / 2 ? height : (dy < -height / 2 ? -height : 0);
+            const double d2 = dx * dx + dy * dy;
+
+            // the agent itself is at distance zero and is skipped
+            const double seen = d2 < r2 && d2 > 0 ? 1 : 0;
+            const double close = d2 < separation2 && d2 > 0 ? 1 : 0;
+            const double inverse = close / (d2 + (1 - close));
+            count += seen;
+            sumVx += seen * svx[j];
+            sumVy += seen * svy[j];
+            sumDx += seen * dx;
+            sumDy += seen * dy;
+            awayX -= inverse * dx;
+            awayY -= inverse * dy;
+          }
+        }
+      }
+
+      double ax = s.separation * awayX;
+      double ay = s.separation * awayY;
+      if (count > 0) {
+        ax += s.alignment * (sumVx / count - vx) +
+              s.cohesion * sumDx / count;
+        ay += s.alignment * (sumVy / count - vy) +
+              s.cohesion * sumDy / count;
+      }
+
+      const double force = std::sqrt(ax * ax + ay * ay);
+      if (force > s.maxForce) {
+        ax *= s.maxForce / force;
+        ay *= s.maxForce / force;
+      }
+
+      double nvx = vx + dt * ax;
+      double nvy = vy + dt * ay;
+      const double speed = std::sqrt(nvx * nvx + nvy * nvy);
+      if (speed > s.maxSpeed) {
+        nvx *= s.maxSpeed / speed;
+        nvy *= s.maxSpeed / speed;
+      }
+
+      const std::size_t i = this->m_order[k];
+      this->m_nextVx[i] = nvx;
+      this->m_nextVy[i] = nvy;
+      this->m_nextX[i] = this->wrap(x + dt * nvx, width);
+      this->m_nextY[i] = this->wrap(y + dt * nvy, height);
+    }
+  }
+
+  /**
+   * @brief Makes the next state the current one.
+   */
+  void swap() {
+    this->m_x.swap(this->m_nextX);
+    this->m_y.swap(this->m_nextY);
+    this->m_vx.swap(this->m_nextVx);
+    this->m_vy.swap(this->m_nextVy);
+  }
+
+private:
+  FlockSettings m_settings; //!< Parameters of the rules.
+  double m_width;           //!< Width of the world.
+  double m_height;          //!< Height of the world.
+  std::size_t m_columns;    //!< Number of grid columns.
+  std::size_t m_rows;       //!< Number of grid rows.
+
+  std::vector<double> m_x;      //!< Current x-coordinates.
+  std::vector<double> m_y;      //!< Current y-coordinates.
+  std::vector<double> m_vx;     //!< Current x-components of velocities.
+  std::vector<double> m_vy;     //!< Current y-components of velocities.
+  std::vector<double> m_nextX;  //!< Next x-coordinates.
+  std::vector<double> m_nextY;  //!< Next y-coordinates.
+  std::vector<double> m_nextVx; //!< Next x-components of velocities.
+  std::vector<double> m_nextVy; //!< Next y-components of velocities.
+
+  std::vector<std::size_t> m_cellStart; //!< Start of each cell.
+  std::vector<std::size_t> m_cell;      //!< Cell of each agent.
+  std::vector<std::size_t> m_next;      //!< Next free slot of each cell.
+  std::vector<double> m_sortedX;        //!< x-coordinates in cell order.
+  std::vector<double> m_sortedY;        //!< y-coordinates in cell order.
+  std::vector<double> m_sortedVx;       //!< x-velocities in cell order.
+  std::vector<double> m_sortedVy;       //!< y-velocities in cell order.
+  std::vector<std::size_t> m_order;     //!< Agent in each slot of the order.
+
+  /**
+   * @brief Gets the grid column of an x-coordinate.
+   */
+  std::size_t column(const double x) const {
+    const double c = std::floor(x / this->m_width *
+                                static_cast<double>(this->m_columns));
+    const double last = static_cast<double>(this->m_columns - 1);
+    return static_cast<std::size_t>(c < 0 ? 0 : (c > last ? last : c));
+  }
+
+  /**
+   * @brief Gets the grid row of a y-coordinate.
+   */
+  std::size_t row(const double y) const {
+    const double r =
+        std::floor(y / this->m_height * static_cast<double>(this->m_rows));
+    const double last = static_cast<double>(this->m_rows - 1);
+    return static_cast<std::size_t>(r < 0 ? 0 : (r > last ? last : r));
+  }
+
+  /**
+   * @brief Lists the distinct cells next to a cell along one axis,
+   * wrapping around.
+   *
+   * @returns The number of cells written to out.
+   */
+  static std::size_t around(const std::size_t cell, const std::size_t count,
+                            std::size_t *out) {
+    if (count < 3) {
+      for (std::size_t i = 0; i < count; i++) {
+        out[i] = i;
+      }
+      return count;
+    }
+
+    out[0] = cell == 0 ? count - 1 : cell - 1;
+    out[1] = cell;
+    out[2] = cell + 1 == count ? 0 : cell + 1;
+    return 3;
+  }
+
+  /**
+   * @brief Wraps a coordinate into [0, size).
+   */
+  static double wrap(const double value, const double size) {
+    const double wrapped = value - size * std::floor(value / size);
+    return wrapped < size ? wrapped : 0;
+  }
+};
+} // namespace svector
+
+#endif
@@ -0,0 +1,1185 @@
+/**
+ * @file rigidbody.hpp
+ *
+ * @brief Rigid body dynamics with a sequential impulse contact solver.
+ *
+ * svector::RigidBodyWorld stores the state of many rigid bodies in flat
+ * arrays and steps them with semi-implicit Euler integration. Contacts are
+ * found by the caller, for example with the broad phase and GJK, and are
+ * resolved with sequential impulses: every iteration visits the contacts one
+ * after another and applies the impulse that fixes the relative velocity at
+ * each of them, clamped so that bodies are never pulled together and
+ * friction stays inside its cone. Penetration is removed by a Baumgarte bias
+ * on the target velocity.
+ *
+ * Contacts are grouped into islands of bodies that touch each other. Static
+ * bodies do not join islands, so a floor with many stacks on it gives one
+ * island per stack. Islands share no dynamic bodies and can be solved
+ * independently.
+ *
+ * The file also contains quaternions for the orientation of the bodies,
+ * inertia tensors and the mass properties of simple shapes.
+ *
+ * This file is not included in vectors.hpp, so it has to be included
+ * separately.
+ *
+ * @copyright Copyright (c) 2023 Jonathan Liu. This project is released under
+ * the MIT License. All rights reserved.
+ */
+
+#ifndef INCLUDE_SVECTOR_RIGIDBODY_HPP_
+#define INCLUDE_SVECTOR_RIGIDBODY_HPP_
+
+#include <cmath>   // std::sqrt, std::sin, std::cos, std::abs
+#include <cstddef> // std::size_t
+#include <vector>  // std::vector
+
+#include "simplevectors/core/vector3d.hpp" // svector::Vector3D
+
+namespace svector {
+/**
+ * @brief A quaternion, used to represent rotations.
+ */
+struct Quaternion {
+  double w; //!< The real part.
+  double x; //!< The i part.
+  double y; //!< The j part.
+  double z; //!< The k part.
+
+  /**
+   * @brief Creates the identity rotation.
+   */
+  Quaternion() : w(1), x(0), y(0), z(0) {}
+
+  /**
+   * @brief Creates a quaternion from its parts.
+   *
+   * @param real The real part.
+   * @param i The i part.
+   * @param j The j part.
+   * @param k The k part.
+   */
+  Quaternion(const double real, const double i, const double j, const double k)
+      : w(real), x(i), y(j), z(k) {}
+
+  /**
+   * @brief Gets the conjugate, which is the inverse rotation for unit
+   * quaternions.
+   *
+   * @returns The conjugate.
+   */
+  Quaternion conjugate() const { return Quaternion(w, -x, -y, -z); }
+
+  /**
+   * @brief Scales the quaternion to unit length.
+   *
+   * @returns The unit quaternion.
+   *
+   * @note This method will result in undefined behavior if the quaternion
+   * is zero.
+   */
+  Quaternion normalized() const {
+    const double length = std::sqrt(w * w + x * x + y * y + z * z);
+    return Quaternion(w / length, x / length, y / length, z / length);
+  }
+
+  /**
+   * @brief Rotates a vector.
+   *
+   * @param v The vector.
+   *
+   * @returns The vector rotated by this unit quaternion.
+   */
+  Vector3D rotate(const Vector3D &v) const {
+    // v + 2w (q x v) + 2 q x (q x v)
+    const double tx = 2 * (y * v.z() - z * v.y());
+    const double ty = 2 * (z * v.x() - x * v.z());
+    const double tz = 2 * (x * v.y() - y * v.x());
+    return Vector3D(v.x() + w * tx + (y * tz - z * ty),
+                    v.y() + w * ty + (z * tx - x * tz),
+                    v.z() + w * tz + (x * ty - y * tx));
+  }
+};
+
+/**
+ * @brief Multiplies two quaternions.
+ *
+ * @param lhs The first quaternion.
+ * @param rhs The second quaternion.
+ *
+ * @returns The product, which rotates by rhs and then by lhs.
+ */
+inline Quaternion operator*(const Quaternion &lhs, const Quaternion &rhs) {
+  return Quaternion(lhs.w * rhs.w - lhs.x * rhs.x - lhs.y * rhs.y -
+                        lhs.z * rhs.z,
+                    lhs.w * rhs.x + lhs.x * rhs.w + lhs.y * rhs.z -
+                        lhs.z * rhs.y,
+                    lhs.w * rhs.y - lhs.x * rhs.z + lhs.y * rhs.w +
+                        lhs.z * rhs.x,
+                    lhs.w * rhs.z + lhs.x * rhs.y - lhs.y * rhs.x +
+                        lhs.z * rhs.w);
+}
+
+/**
+ * @brief Creates a rotation about an axis.
+ *
+ * @param axis The axis of the rotation.
+ * @param angle The angle of the rotation in radians, counterclockwise when
+ * looking against the axis.
+ *
+ * @returns The unit quaternion of the rotation.
+ *
+ * @note This method will result in undefined behavior if the axis is zero.
+ */
+inline Quaternion axisAngle(const Vector3D &axis, const double angle) {
+  const double scale = std::sin(angle / 2) / axis.magn();
+  return Quaternion(std::cos(angle / 2), axis.x() * scale, axis.y() * scale,
+                    axis.z() * scale);
+}
+
+/**
+ * @brief A symmetric 3x3 matrix, used for inertia tensors.
+ */
+struct InertiaTensor {
+  double xx; //!< Moment of inertia about the x-axis.
+  double yy; //!< Moment of inertia about the y-axis.
+  double zz; //!< Moment of inertia about the z-axis.
+  double xy; //!< The xy and yx entries.
+  double xz; //!< The xz and zx entries.
+  double yz; //!< The yz and zy entries.
+
+  /**
+   * @brief Creates the zero tensor.
+   */
+  InertiaTensor() : xx(0), yy(0), zz(0), xy(0), xz(0), yz(0) {}
+
+  /**
+   * @brief Creates a diagonal tensor.
+   *
+   * @param momentX Moment of inertia about the x-axis.
+   * @param momentY Moment of inertia about the y-axis.
+   * @param momentZ Moment of inertia about the z-axis.
+   */
+  InertiaTensor(const double momentX, const double momentY,
+                const double momentZ)
+      : xx(momentX), yy(momentY), zz(momentZ), xy(0), xz(0), yz(0) {}
+
+  /**
+   * @brief Multiplies a vector by the tensor.
+   *
+   * @param v The vector, for example an angular velocity.
+   *
+   * @returns The product, for example an angular momentum.
+   */
+  Vector3D apply(const Vector3D &v) const {
+    return Vector3D(xx * v.x() + xy * v.y() + xz * v.z(),
+                    xy * v.x() + yy * v.y() + yz * v.z(),
+                    xz * v.x() + yz * v.y() + zz * v.z());
+  }
+
+  /**
+   * @brief Gets the inverse of the tensor.
+   *
+   * @returns The inverse, or the zero tensor if the tensor is singular.
+   */
+  InertiaTensor inverse() const {
+    const double cxx = yy * zz - yz * yz;
+    const double cxy = xz * yz - xy * zz;
+    const double cxz = xy * yz - xz * yy;
+    const double det = xx * cxx + xy * cxy + xz * cxz;
+
+    InertiaTensor result;
+    if (det == 0) {
+      return result;
+    }
+
+    result.xx = cxx / det;
+    result.xy = cxy / det;
+    result.xz = cxz / det;
+    result.yy = (xx * zz - xz * xz) / det;
+    result.yz = (xy * xz - xx * yz) / det;
+    result.zz = (xx * yy - xy * xy) / det;
+    return result;
+  }
+
+  /**
+   * @brief Expresses the tensor in a rotated frame.
+   *
+   * @param rotation The unit quaternion that rotates the body frame into the
+   * world frame.
+   *
+   * @returns R * I * R^T, where R is the rotation matrix.
+   */
+  InertiaTensor rotated(const Quaternion &rotation) const {
+    const Vector3D cx = rotation.rotate(Vector3D(1, 0, 0));
+    const Vector3D cy = rotation.rotate(Vector3D(0, 1, 0));
+    const Vector3D cz = rotation.rotate(Vector3D(0, 0, 1));
+    const double r[3][3] = {{cx.x(), cy.x(), cz.x()},
+                            {cx.y(), cy.y(), cz.y()},
+                            {cx.z(), cy.z(), cz.z()}};
+    const double m[3][3] = {{xx, xy, xz}, {xy, yy, yz}, {xz, yz, zz}};
+
+    // rm = R * I
+    double rm[3][3];
+    for (std::size_t i = 0; i < 3; i++) {
+      for (std::size_t j = 0; j < 3; j++) {
+        rm[i][j] = r[i][0] * m[0][j] + r[i][1] * m[1][j] + r[i][2] * m[2][j];
+      }
+    }
+
+    const auto entry = [&rm, &r](const std::size_t i, const std::size_t j) {
+      return rm[i][0] * r[j][0] + rm[i][1] * r[j][1] + rm[i][2] * r[j][2];
+    };
+
+    InertiaTensor result;
+    result.xx = entry(0, 0);
+    result.yy = entry(1, 1);
+    result.zz = entry(2, 2);
+    result.xy = entry(0, 1);
+    result.xz = entry(0, 2);
+    result.yz = entry(1, 2);
+    return result;
+  }
+};
+
+/**
+ * @brief Mass, center of mass and inertia of a body.
+ */
+struct MassProperties {
+  double mass;           //!< The mass.
+  Vector3D center;       //!< The center of mass in body coordinates.
+  InertiaTensor inertia; //!< The inertia tensor about the center of mass.
+
+  /**
+   * @brief Creates the properties of a body without mass.
+   */
+  MassProperties() : mass(0), center(0, 0, 0) {}
+
+  /**
+   * @brief Creates mass properties.
+   *
+   * @param bodyMass The mass.
+   * @param centerOfMass The center of mass in body coordinates.
+   * @param inertiaTensor The inertia tensor about the center of mass.
+   */
+  MassProperties(const double bodyMass, const Vector3D &centerOfMass,
+                 const InertiaTensor &inertiaTensor)
+      : mass(bodyMass), center(centerOfMass), inertia(inertiaTensor) {}
+};
+
+/**
+ * @brief Mass properties of a solid sphere centered at the origin.
+ *
+ * @param density The mass per volume.
+ * @param radius The radius of the sphere.
+ *
+ * @returns The mass properties.
+ */
+inline MassProperties sphereMass(const double density, const double radius) {
+  const double mass =
+      density * 4.0 / 3.0 * 3.14159265358979323846 * radius * radius * radius;
+  const double moment = 0.4 * mass * radius * radius;
+  return MassProperties(mass, Vector3D(0, 0, 0),
+                        InertiaTensor(moment, moment, moment));
+}
+
+/**
+ * @brief Mass properties of a solid box centered at the origin.
+ *
+ * @param density The mass per volume.
+ * @param halfExtents Half of the size of the box along each axis.
+ *
+ * @returns The mass properties.
+ */
+inline MassProperties boxMass(const double density,
+                              const Vector3D &halfExtents) {
+  const double x2 = halfExtents.x() * halfExtents.x();
+  const double y2 = halfExtents.y() * halfExtents.y();
+  const double z2 = halfExtents.z() * halfExtents.z();
+  const double mass =
+      density * 8 * halfExtents.x() * halfExtents.y() * halfExtents.z();
+  return MassProperties(mass, Vector3D(0, 0, 0),
+                        InertiaTensor(mass / 3 * (y2 + z2),
+                                      mass / 3 * (x2 + z2),
+                                      mass / 3 * (x2 + y2)));
+}
+
+/**
+ * @brief Moves mass properties within the body.
+ *
+ * @param properties The mass properties.
+ * @param offset The translation.
+ *
+ * @returns The mass properties of the body translated by the offset.
+ */
+inline MassProperties translateMass(const MassProperties &properties,
+                                    const Vector3D &offset) {
+  return MassProperties(
+      properties.mass,
+      Vector3D(properties.center.x() + offset.x(),
+               properties.center.y() + offset.y(),
+               properties.center.z() + offset.z()),
+      properties.inertia);
+}
+
+/**
+ * @brief Combines the mass properties of two parts of a body.
+ *
+ * The inertia tensors are moved to the combined center of mass with the
+ * parallel axis theorem.
+ *
+ * @param lhs The first part.
+ * @param rhs The second part.
+ *
+ * @returns The mass properties of both parts together.
+ */
+inline MassProperties combineMass(const MassProperties &lhs,
+                                  const MassProperties &rhs) {
+  const double mass = lhs.mass + rhs.mass;
+  if (mass == 0) {
+    return MassProperties();
+  }
+
+  const Vector3D center((lhs.center.x() * lhs.mass +
+                         rhs.center.x() * rhs.mass) /
+                            mass,
+                        (lhs.center.y() * lhs.mass +
+                         rhs.center.y() * rhs.mass) /
+                            mass,
+                        (lhs.center.z() * lhs.mass +
+                         rhs.center.z() * rhs.mass) /
+                            mass);
+
+  InertiaTensor inertia;
+  const MassProperties *parts[2] = {&lhs, &rhs};
+  for (const MassProperties *part : parts) {
+    const double dx = part->center.x() - center.x();
+    const double dy = part->center.y() - center.y();
+    const double dz = part->center.z() - center.z();
+    const double m = part->mass;
+    inertia.xx += part->inertia.xx + m * (dy * dy + dz * dz);
+    inertia.yy += part->inertia.yy + m * (dx * dx + dz * dz);
+    inertia.zz += part->inertia.zz + m * (dx * dx + dy * dy);
+    inertia.xy += part->inertia.xy - m * dx * dy;
+    inertia.xz += part->inertia.xz - m * dx * dz;
+    inertia.yz += part->inertia.yz - m * dy * dz;
+  }
+
+  return MassProperties(mass, center, inertia);
+}
+
+/**
+ * @brief A contact point between two bodies.
+ *
+ * The solver stores the impulses it applied in the contact. Contacts that
+ * are kept from one step to the next start from these impulses, which makes
+ * stacks converge in fewer iterations.
+ */
+struct Contact {
+  std::size_t a;  //!< The first body.
+  std::size_t b;  //!< The second body.
+  Vector3D point; //!< The contact point in world coordinates.
+  Vector3D normal;       //!< Unit normal pointing from a towards b.
+  double depth;          //!< The penetration depth, positive if overlapping.
+  double friction;       //!< The friction coefficient.
+  double restitution;    //!< The restitution coefficient.
+  double normalImpulse;  //!< Accumulated impulse along the normal.
+  double tangentImpulse[2]; //!< Accumulated friction impulses.
+
+  /**
+   * @brief Creates a contact without accumulated impulses.
+   *
+   * @param bodyA The first body.
+   * @param bodyB The second body.
+   * @param contactPoint The contact point in world coordinates.
+   * @param contactNormal Unit normal pointing from bodyA towards bodyB.
+   * @param penetration The penetration depth, positive if overlapping.
+   * @param frictionCoefficient The friction coefficient.
+   * @param restitutionCoefficient The restitution coefficient.
+   */
+  Contact(const std::size_t bodyA, const std::size_t bodyB,
+          const Vector3D &contactPoint, const Vector3D &contactNormal,
+          const double penetration, const double frictionCoefficient = 0.5,
+          const double restitutionCoefficient = 0)
+      : a(bodyA), b(bodyB), point(contactPoint), normal(contactNormal),
+        depth(penetration), friction(frictionCoefficient),
+        restitution(restitutionCoefficient), normalImpulse(0),
+        tangentImpulse{0, 0} {}
+};
+
+/**
+ * @brief Groups of bodies connected by contacts.
+ *
+ * Island i consists of the bodies bodies[bodyOffsets[i]] to
+ * bodies[bodyOffsets[i + 1] - 1] and the contacts with the indices
+ * contacts[contactOffsets[i]] to contacts[contactOffsets[i + 1] - 1]. Only
+ * dynamic bodies that touch something are in an island.
+ */
+struct ContactIslands {
+  std::vector<std::size_t> bodies;         //!< Bodies of all islands.
+  std::vector<std::size_t> bodyOffsets;    //!< Start of each island in bodies.
+  std::vector<std::size_t> contacts;       //!< Contacts of all islands.
+  std::vector<std::size_t> contactOffsets; //!< Start of each island in
+                                           //!< contacts.
+
+  /**
+   * @brief Gets the number of islands.
+   *
+   * @returns The number of islands.
+   */
+  std::size_t size() const {
+    return bodyOffsets.empty() ? 0 : bodyOffsets.size() - 1;
+  }
+};
+
+/**
+ * @brief Parameters of the contact solver.
+ */
+struct RigidBodySettings {
+  std::size_t iterations; //!< Velocity iterations per step.
+  double baumgarte;       //!< Fraction of the penetration removed per step.
+  double slop;            //!< Penetration that is not corrected.
+  double restitutionThreshold; //!< Slowest approach that bounces.
+
+  /**
+   * @brief Creates the default settings.
+   */
+  RigidBodySettings()
+      : iterations(10), baumgarte(0.2), slop(0.005),
+        restitutionThreshold(1) {}
+};
+
+namespace detail {
+/**
+ * Solver data of one contact: the normal and the two friction directions,
+ * the angular parts of their Jacobians and effective masses.
+ */
+struct ContactRow {
+  double axis[3][3];
+  double crossA[3][3];
+  double crossB[3][3];
+  double angularA[3][3];
+  double angularB[3][3];
+  double mass[3];
+  double bias;
+};
+
+/**
+ * Writes the cross product of two 3D vectors given as arrays.
+ */
+inline void rigidCross(const double *a, const double *b, double *out) {
+  out[0] = a[1] * b[2] - a[2] * b[1];
+  out[1] = a[2] * b[0] - a[0] * b[2];
+  out[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+/**
+ * Dot product of two 3D vectors given as arrays.
+ */
+inline double rigidDot(const double *a, const double *b) {
+  return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+/**
+ * Multiplies a vector by a symmetric matrix stored as xx, yy, zz, xy, xz,
+ * yz.
+ */
+inline void rigidApply(const double *m, const double *v, double *out) {
+  out[0] = m[0] * v[0] + m[3] * v[1] + m[4] * v[2];
+  out[1] = m[3] * v[0] + m[1] * v[1] + m[5] * v[2];
+  out[2] = m[4] * v[0] + m[5] * v[1] + m[2] * v[2];
+}
+
+/**
+ * Finds the root of a union-find tree, halving the path on the way.
+ */
+inline std::size_t islandRoot(std::vector<std::size_t> &parent,
+                              std::size_t i) {
+  while (parent[i] != i) {
+    parent[i] = parent[parent[i]];
+    i = parent[i];
+  }
+  return i;
+}
+} // namespace detail
+
+/**
+ * @brief A set of rigid bodies.
+ *
+ * The position of a body is its center of mass. Bodies added with
+ * addStatic() have infinite mass and are never moved by the world.
+ *
+ * Bodies are stepped with step(), or with the separate stages of a step,
+ * which allow solving the islands separately:
+ *
+ * @code
+ * world.integrateVelocities(dt);
+ * svector::ContactIslands islands = world.islands(contacts);
+ * for (std::size_t i = 0; i < islands.size(); i++) { // in parallel
+ *   world.solveIsland(contacts, islands, i, dt);
+ * }
+ * world.integratePositions(dt);
+ * @endcode
+ */
+class RigidBodyWorld {
+public:
+  /**
+   * @brief Creates an empty world with gravity along the negative y-axis.
+   */
+  RigidBodyWorld() : m_gravity{0, -9.81, 0} {}
+
+  /**
+   * @brief Adds a dynamic body.
+   *
+   * @param properties The mass properties of the body. The center of mass
+   * is not used, since the position is the center of mass.
+   * @param position The position of the center of mass.
+   * @param orientation The unit quaternion that rotates body coordinates to
+   * world coordinates.
+   *
+   * @returns The index of the body.
+   */
+  std::size_t add(const MassProperties &properties, const Vector3D &position,
+                  const Quaternion &orientation = Quaternion()) {
+    const std::size_t index = this->addStatic(position, orientation);
+    if (properties.mass > 0) {
+      const InertiaTensor inverse = properties.inertia.inverse();
+      const double local[6] = {inverse.xx, inverse.yy, inverse.zz,
+                               inverse.xy, inverse.xz, inverse.yz};
+      this->m_inverseMass[index] = 1 / properties.mass;
+      for (std::size_t k = 0; k < 6; k++) {
+        this->m_localInverseInertia[index * 6 + k] = local[k];
+      }
+      this->updateInertia(index);
+    }
+    return index;
+  }
+
+  /**
+   * @brief Adds a static body.
+   *
+   * @param position The position of the body.
+   * @param orientation The unit quaternion that rotates body coordinates to
+   * world coordinates.
+   *
+   * @returns The index of the body.
+   */
+  std::size_t addStatic(const Vector3D &position,
+                        const Quaternion &orientation = Quaternion()) {
+    const std::size_t index = this->m_inverseMass.size();
+    this->m_inverseMass.push_back(0);
+    this->m_position.insert(this->m_position.end(),
+                            {position.x(), position.y(), position.z()});
+    this->m_orientation.insert(
+        this->m_orientation.end(),
+        {orientation.w, orientation.x, orientation.y, orientation.z});
+    this->m_velocity.resize(this->m_velocity.size() + 3, 0);
+    this->m_angularVelocity.resize(this->m_angularVelocity.size() + 3, 0);
+    this->m_force.resize(this->m_force.size() + 3, 0);
+    this->m_torque.resize(this->m_torque.size() + 3, 0);
+    this->m_localInverseInertia.resize(
+        this->m_localInverseInertia.size() + 6, 0);
+    this->m_inverseInertia.resize(this->m_inverseInertia.size() + 6, 0);
+    return index;
+  }
+
+  /**
+   * @brief Gets the number of bodies.
+   *
+   * @returns The number of bodies.
+   */
+  std::size_t size() const { return this->m_inverseMass.size(); }
+
+  /**
+   * @brief Whether a body is static.
+   *
+   * @param i The index of the body.
+   *
+   * @returns True if the body has infinite mass.
+   */
+  bool isStatic(const std::size_t i) const {
+    return this->m_inverseMass[i] == 0;
+  }
+
+  /**
+   * @brief Gets the inverse mass of a body.
+   *
+   * @param i The index of the body.
+   *
+   * @returns The inverse mass, zero for static bodies.
+   */
+  double inverseMass(const std::size_t i) const {
+    return this->m_inverseMass[i];
+  }
+
+  /**
+   * @brief Gets the inverse inertia tensor of a body in world coordinates.
+   *
+   * @param i The index of the body.
+   *
+   * @returns The inverse inertia tensor.
+   */
+  InertiaTensor inverseInertia(const std::size_t i) const {
+    const double *m = &this->m_inverseInertia[i * 6];
+    InertiaTensor result(m[0], m[1], m[2]);
+    result.xy = m[3];
+    result.xz = m[4];
+    result.yz = m[5];
+    return result;
+  }
+
+  /**
+   * @brief Gets the position of a body.
+   *
+   * @param i The index of the body.
+   *
+   * @returns The position of the center of mass.
+   */
+  Vector3D position(const std::size_t i) const {
+    return this->get(this->m_position, i);
+  }
+
+  /**
+   * @brief Moves a body.
+   *
+   * @param i The index of the body.
+   * @param position The new position of the center of mass.
+   */
+  void position(const std::size_t i, const Vector3D &position) {
+    this->set(this->m_position, i, position);
+  }
+
+  /**
+   * @brief Gets the orientation of a body.
+   *
+   * @param i The index of the body.
+   *
+   * @returns The unit quaternion that rotates body coordinates to world
+   * coordinates.
+   */
+  Quaternion orientation(const std::size_t i) const {
+    const double *q = &this->m_orientation[i * 4];
+    return Quaternion(q[0], q[1], q[2], q[3]);
+  }
+
+  /**
+   * @brief Rotates a body.
+   *
+   * @param i The index of the body.
+   * @param orientation The new unit quaternion that rotates body coordinates
+   * to world coordinates.
+   */
+  void orientation(const std::size_t i, const Quaternion &orientation) {
+    double *q = &this->m_orientation[i * 4];
+    q[0] = orientation.w;
+    q[1] = orientation.x;
+    q[2] = orientation.y;
+    q[3] = orientation.z;
+    this->updateInertia(i);
+  }
+
+  /**
+   * @brief Gets the velocity of a body.
+   *
+   * @param i The index of the body.
+   *
+   * @returns The velocity of the center of mass.
+   */
+  Vector3D velocity(const std::size_t i) const {
+    return this->get(this->m_velocity, i);
+  }
+
+  /**
+   * @brief Sets the velocity of a body.
+   *
+   * @param i The index of the body.
+   * @param velocity The new velocity of the center of mass.
+   *
+   * @note This method will result in undefined behavior if the body is
+   * static.
+   */
+  void velocity(const std::size_t i, const Vector3D &velocity) {
+    this->set(this->m_velocity, i, velocity);
+  }
+
+  /**
+   * @brief Gets the angular velocity of a body.
+   *
+   * @param i The index of the body.
+   *
+   * @returns The angular velocity in world coordinates.
+   */
+  Vector3D angularVelocity(const std::size_t i) const {
+    return this->get(this->m_angularVelocity, i);
+  }
+
+  /**
+   * @brief Sets the angular velocity of a body.
+   *
+   * @param i The index of the body.
+   * @param angularVelocity The new angular velocity in world coordinates.
+   *
+   * @note This method will result in undefined behavior if the body is
+   * static.
+   */
+  void angularVelocity(const std::size_t i, const Vector3D &angularVelocity) {
+    this->set(this->m_angularVelocity, i, angularVelocity);
+  }
+
+  /**
+   * @brief Gets the gravity.
+   *
+   * @returns The acceleration of all dynamic bodies due to gravity.
+   */
+  Vector3D gravity() const {
+    return Vector3D(this->m_gravity[0], this->m_gravity[1],
+                    this->m_gravity[2]);
+  }
+
+  /**
+   * @brief Sets the gravity.
+   *
+   * @param gravity The acceleration of all dynamic bodies due to gravity.
+   */
+  void gravity(const Vector3D &gravity) {
+    this->m_gravity[0] = gravity.x();
+    this->m_gravity[1] = gravity.y();
+    this->m_gravity[2] = gravity.z();
+  }
+
+  /**
+   * @brief Gets the solver settings.
+   *
+   * @returns The settings, which can be modified.
+   */
+  RigidBodySettings &settings() { return this->m_settings; }
+
+  /**
+   * @brief Applies a force to a body during the next step.
+   *
+   * @param i The index of the body.
+   * @param force The force.
+   * @param point The point the force acts on in world coordinates.
+   */
+  void applyForce(const std::size_t i, const Vector3D &force,
+                  const Vector3D &point) {
+    const double f[3] = {force.x(), force.y(), force.z()};
+    const double r[3] = {point.x() - this->m_position[i * 3],
+                         point.y() - this->m_position[i * 3 + 1],
+                         point.z() - this->m_position[i * 3 + 2]};
+    double torque[3];
+    detail::rigidCross(r, f, torque);
+    for (std::size_t k = 0; k < 3; k++) {
+      this->m_force[i * 3 + k] += f[k];
+      this->m_torque[i * 3 + k] += torque[k];
+    }
+  }
+
+  /**
+   * @brief Applies an impulse to a body, changing its velocity at once.
+   *
+   * @param i The index of the body.
+   * @param impulse The impulse.
+   * @param point The point the impulse acts on in world coordinates.
+   */
+  void applyImpulse(const std::size_t i, const Vector3D &impulse,
+                    const Vector3D &point) {
+    const double p[3] = {impulse.x(), impulse.y(), impulse.z()};
+    const double r[3] = {point.x() - this->m_position[i * 3],
+                         point.y() - this->m_position[i * 3 + 1],
+                         point.z() - this->m_position[i * 3 + 2]};
+    double torque[3];
+    double change[3];
+    detail::rigidCross(r, p, torque);
+    detail::rigidApply(&this->m_inverseInertia[i * 6], torque, change);
+    for (std::size_t k = 0; k < 3; k++) {
+      this->m_velocity[i * 3 + k] += this->m_inverseMass[i] * p[k];
+      this->m_angularVelocity[i * 3 + k] += change[k];
+    }
+  }
+
+  /**
+   * @brief Advances all bodies by one time step.
+   *
+   * @param contacts The contacts between the bodies at the start of the
+   * step. The accumulated impulses are updated.
+   * @param dt The time step.
+   */
+  void step(std::vector<Contact> &contacts, const double dt) {
+    this->integrateVelocities(dt);
+    const ContactIslands groups = this->islands(contacts);
+    for (std::size_t i = 0; i < groups.size(); i++) {
+      this->solveIsland(contacts, groups, i, dt);
+    }
+    this->integratePositions(dt);
+  }
+
+  /**
+   * @brief Applies gravity and the accumulated forces to the velocities.
+   *
+   * The forces are cleared afterwards.
+   *
+   * @param dt The time step.
+   */
+  void integrateVelocities(const double dt) {
+    for (std::size_t i = 0; i < this->size(); i++) {
+      const double inverseMass = this->m_inverseMass[i];
+      if (inverseMass == 0) {
+        continue;
+      }
+
+      double *v = &this->m_velocity[i * 3];
+      double *w = &this->m_angularVelocity[i * 3];
+      double *f = &this->m_force[i * 3];
+      double *t = &this->m_torque[i * 3];
+      double change[3];
+      detail::rigidApply(&this->m_inverseInertia[i * 6], t, change);
+      for (std::size_t k = 0; k < 3; k++) {
+        v[k] += dt * (this->m_gravity[k] + inverseMass * f[k]);
+        w[k] += dt * change[k];
+        f[k] = 0;
+        t[k] = 0;
+      }
+    }
+  }
+
+  /**
+   * @brief Groups contacts into islands that can be solved independently.
+   *
+   * Contacts between two static bodies are not in any island. This must be
+   * called for the contacts before solveIsland(), and the contacts must not
+   * be added to or removed from in between.
+   *
+   * @param contacts The contacts.
+   *
+   * @returns The islands.
+   */
+  ContactIslands islands(const std::vector<Contact> &contacts) {
+    const std::size_t n = this->size();
+    std::vector<std::size_t> parent(n);
+    for (std::size_t i = 0; i < n; i++) {
+      parent[i] = i;
+    }
+
+    for (const Contact &contact : contacts) {
+      if (!this->isStatic(contact.a) && !this->isStatic(contact.b)) {
+        const std::size_t ra = detail::islandRoot(parent, contact.a);
+        const std::size_t rb = detail::islandRoot(parent, contact.b);
+        parent[ra < rb ? rb : ra] = ra < rb ? ra : rb;
+      }
+    }
+
+    // number the islands in the order of their first contact
+    const std::size_t none = static_cast<std::size_t>(-1);
+    std::vector<std::size_t> island(n, none);
+    std::vector<std::size_t> contactIsland(contacts.size(), none);
+    std::size_t count = 0;
+    for (std::size_t c = 0; c < contacts.size(); c++) {
+      const std::size_t body =
+          this->isStatic(contacts[c].a) ? contacts[c].b : contacts[c].a;
+      if (this->isStatic(body)) {
+        continue;
+      }
+
+      const std::size_t root = detail::islandRoot(parent, body);
+      if (island[root] == none) {
+        island[root] = count++;
+      }
+      contactIsland[c] = island[root];
+    }
+
+    ContactIslands result;
+    result.bodyOffsets.assign(count + 1, 0);
+    result.contactOffsets.assign(count + 1, 0);
+    std::vector<std::size_t> bodyIsland(n, none);
+    for (std::size_t i = 0; i < n; i++) {
+      if (!this->isStatic(i) && island[detail::islandRoot(parent, i)] != none) {
+        bodyIsland[i] = island[detail::islandRoot(parent, i)];
+        result.bodyOffsets[bodyIsland[i] + 1]++;
+      }
+    }
+    for (std::size_t c = 0; c < contacts.size(); c++) {
+      if (contactIsland[c] != none) {
+        result.contactOffsets[contactIsland[c] + 1]++;
+      }
+    }
+    for (std::size_t i = 0; i < count; i++) {
+      result.bodyOffsets[i + 1] += result.bodyOffsets[i];
+      result.contactOffsets[i + 1] += result.contactOffsets[i];
+    }
+
+    // counting sort keeps bodies and contacts in index order
+    result.bodies.resize(result.bodyOffsets[count]);
+    result.contacts.resize(result.contactOffsets[count]);
+    std::vector<std::size_t> next(result.bodyOffsets.begin(),
+                                  result.bodyOffsets.end() - 1);
+    for (std::size_t i = 0; i < n; i++) {
+      if (bodyIsland[i] != none) {
+        result.bodies[next[bodyIsland[i]]++] = i;
+      }
+    }
+    next.assign(result.contactOffsets.begin(),
+                result.contactOffsets.end() - 1);
+    for (std::size_t c = 0; c < contacts.size(); c++) {
+      if (contactIsland[c] != none) {
+        result.contacts[next[contactIsland[c]]++] = c;
+      }
+    }
+
+    this->m_rows.resize(contacts.size());
+    return result;
+  }
+
+  /**
+   * @brief Solves the contacts of one island.
+   *
+   * Different islands of the same call to islands() touch different dynamic
+   * bodies, so they can be solved independently.
+   *
+   * @param contacts The contacts given to islands(). The accumulated
+   * impulses of the contacts in the island are updated.
+   * @param islands The islands.
+   * @param island The index of the island to solve.
+   * @param dt The time step.
+   */
+  void solveIsland(std::vector<Contact> &contacts,
+                   const ContactIslands &islands, const std::size_t island,
+                   const double dt) {
+    const std::size_t begin = islands.contactOffsets[island];
+    const std::size_t end = islands.contactOffsets[island + 1];
+
+    for (std::size_t k = begin; k < end; k++) {
+      this->prepareContact(contacts[islands.contacts[k]],
+                           this->m_rows[islands.contacts[k]], dt);
+    }
+
+    for (std::size_t iteration = 0; iteration < this->m_settings.iterations;
+         iteration++) {
+      for (std::size_t k = begin; k < end; k++) {
+        this->solveContact(contacts[islands.contacts[k]],
+                           this->m_rows[islands.contacts[k]]);
+      }
+    }
+  }
+
+  /**
+   * @brief Moves and rotates the bodies by their velocities.
+   *
+   * @param dt The time step.
+   */
+  void integratePositions(const double dt) {
+    for (std::size_t i = 0; i < this->size(); i++) {
+      if (this->m_inverseMass[i] == 0) {
+        continue;
+      }
+
+      double *x = &this->m_position[i * 3];
+      const double *v = &this->m_velocity[i * 3];
+      const double *w = &this->m_angularVelocity[i * 3];
+      for (std::size_t k = 0; k < 3; k++) {
+        x[k] += dt * v[k];
+      }
+
+      // q += dt / 2 * (0, w) * q
+      const Quaternion q = this->orientation(i);
+      const Quaternion spin = Quaternion(0, w[0], w[1], w[2]) * q;
+      this->orientation(i, Quaternion(q.w + dt / 2 * spin.w,
+                                      q.x + dt / 2 * spin.x,
+                                      q.y + dt / 2 * spin.y,
+                                      q.z + dt / 2 * spin.z)
+                               .normalized());
+    }
+  }
+
+private:
+  std::vector<double> m_position;        //!< xyz of every body.
+  std::vector<double> m_orientation;     //!< wxyz of every body.
+  std::vector<double> m_velocity;        //!< xyz of every body.
+  std::vector<double> m_angularVelocity; //!< xyz of every body.
+  std::vector<double> m_force;           //!< Accumulated forces.
+  std::vector<double> m_torque;          //!< Accumulated torques.
+  std::vector<double> m_inverseMass;     //!< Zero for static bodies.
+  std::vector<double> m_localInverseInertia; //!< In body coordinates.
+  std::vector<double> m_inverseInertia;      //!< In world coordinates.
+  std::vector<detail::ContactRow> m_rows;    //!< Solver data per contact.
+  double m_gravity[3];                       //!< Gravity acceleration.
+  RigidBodySettings m_settings;              //!< Solver settings.
+
+  /**
+   * @brief Reads a 3D vector from a flat array.
+   */
+  static Vector3D get(const std::vector<double> &data, const std::size_t i) {
+    return Vector3D(data[i * 3], data[i * 3 + 1], data[i * 3 + 2]);
+  }
+
+  /**
+   * @brief Writes a 3D vector to a flat array.
+   */
+  static void set(std::vector<double> &data, const std::size_t i,
+                  const Vector3D &value) {
+    data[i * 3] = value.x();
+    data[i * 3 + 1] = value.y();
+    data[i * 3 + 2] = value.z();
+  }
+
+  /**
+   * @brief Updates the world inverse inertia of a body after it rotated.
+   */
+  void updateInertia(const std::size_t i) {
+    const double *local = &this->m_localInverseInertia[i * 6];
+    InertiaTensor tensor(local[0], local[1], local[2]);
+    tensor.xy = local[3];
+    tensor.xz = local[4];
+    tensor.yz = local[5];
+    tensor = tensor.rotated(this->orientation(i));
+
+    double *world = &this->m_inverseInertia[i * 6];
+    world[0] = tensor.xx;
+    world[1] = tensor.yy;
+    world[2] = tensor.zz;
+    world[3] = tensor.xy;
+    world[4] = tensor.xz;
+    world[5] = tensor.yz;
+  }
+
+  /**
+   * @brief Relative velocity of b with respect to a along an axis of a
+   * contact.
+   */
+  double relativeVelocity(const Contact &contact,
+                          const detail::ContactRow &row,
+                          const std::size_t axis) const {
+    const double *va = &this->m_velocity[contact.a * 3];
+    const double *wa = &this->m_angularVelocity[contact.a * 3];
+    const double *vb = &this->m_velocity[contact.b * 3];
+    const double *wb = &this->m_angularVelocity[contact.b * 3];
+    return detail::rigidDot(vb, row.axis[axis]) +
+           detail::rigidDot(wb, row.crossB[axis]) -
+           detail::rigidDot(va, row.axis[axis]) -
+           detail::rigidDot(wa, row.crossA[axis]);
+  }
+
+  /**
+   * @brief Applies an impulse along an axis of a contact, pushing b in the
+   * direction of the axis and a against it.
+   */
+  void applyRow(const Contact &contact, const detail::ContactRow &row,
+                const std::size_t axis, const double impulse) {
+    const double ma = this->m_inverseMass[contact.a];
+    const double mb = this->m_inverseMass[contact.b];
+    // static bodies are shared between islands, so they are never written
+    if (ma != 0) {
+      double *v = &this->m_velocity[contact.a * 3];
+      double *w = &this->m_angularVelocity[contact.a * 3];
+      for (std::size_t k = 0; k < 3; k++) {
+        v[k] -= ma * impulse * row.axis[axis][k];
+        w[k] -= impulse * row.angularA[axis][k];
+      }
+    }
+    if (mb != 0) {
+      double *v = &this->m_velocity[contact.b * 3];
+      double *w = &this->m_angularVelocity[contact.b * 3];
+      for (std::size_t k = 0; k < 3; k++) {
+        v[k] += mb * impulse * row.axis[axis][k];
+        w[k] += impulse * row.angularB[axis][k];
+      }
+    }
+  }
+
+  /**
+   * @brief Computes the solver data of a contact and applies its
+   * accumulated impulses.
+   */
+  void prepareContact(const Contact &contact, detail::ContactRow &row,
+                      const double dt) {
+    const double n[3] = {contact.normal.x(), contact.normal.y(),
+                         contact.normal.z()};
+    const double ra[3] = {contact.point.x() - this->m_position[contact.a * 3],
+                          contact.point.y() -
+                              this->m_position[contact.a * 3 + 1],
+                          contact.point.z() -
+                              this->m_position[contact.a * 3 + 2]};
+    const double rb[3] = {contact.point.x() - this->m_position[contact.b * 3],
+                          contact.point.y() -
+                              this->m_position[contact.b * 3 + 1],
+                          contact.point.z() -
+                              this->m_position[contact.b * 3 + 2]};
+
+    // friction directions perpendicular to the normal
+    double t1[3];
+    if (std::abs(n[0]) >= 0.57735) {
+      const double length = std::sqrt(n[0] * n[0] + n[1] * n[1]);
+      t1[0] = n[1] / length;
+      t1[1] = -n[0] / length;
+      t1[2] = 0;
+    } else {
+      const double length = std::sqrt(n[1] * n[1] + n[2] * n[2]);
+      t1[0] = 0;
+      t1[1] = n[2] / length;
+      t1[2] = -n[1] / length;
+    }
+    double t2[3];
+    detail::rigidCross(n, t1, t2);
+
+    const double *axes[3] = {n, t1, t2};
+    const double ma = this->m_inverseMass[contact.a];
+    const double mb = this->m_inverseMass[contact.b];
+    for (std::size_t axis = 0; axis < 3; axis++) {
+      for (std::size_t k = 0; k < 3; k++) {
+        row.axis[axis][k] = axes[axis][k];
+      }
+      detail::rigidCross(ra, axes[axis], row.crossA[axis]);
+      detail::rigidCross(rb, axes[axis], row.crossB[axis]);
+      detail::rigidApply(&this->m_inverseInertia[contact.a * 6],
+                         row.crossA[axis], row.angularA[axis]);
+      detail::rigidApply(&this->m_inverseInertia[contact.b * 6],
+                         row.crossB[axis], row.angularB[axis]);
+      const double k =
+          ma + mb + detail::rigidDot(row.crossA[axis], row.angularA[axis]) +
+          detail::rigidDot(row.crossB[axis], row.angularB[axis]);
+      row.mass[axis] = k > 0 ? 1 / k : 0;
+    }
+
+    const double penetration = contact.depth - this->m_settings.slop;
+    row.bias = penetration > 0
+                   ? this->m_settings.baumgarte / dt * penetration
+                   : 0;
+    const double approach = this->relativeVelocity(contact, row, 0);
+    if (approach < -this->m_settings.restitutionThreshold &&
+        -contact.restitution * approach > row.bias) {
+      row.bias = -contact.restitution * approach;
+    }
+
+    this->applyRow(contact, row, 0, contact.normalImpulse);
+    this->applyRow(contact, row, 1, contact.tangentImpulse[0]);
+    this->applyRow(contact, row, 2, contact.tangentImpulse[1]);
+  }
+
+  /**
+   * @brief One sequential impulse iteration on a contact.
+   */
+  void solveContact(Contact &contact, const detail::ContactRow &row) {
+    // friction first, limited by the normal impulse of the last iteration
+    const double limit = contact.friction * contact.normalImpulse;
+    for (std::size_t axis = 1; axis < 3; axis++) {
+      double &accumulated = contact.tangentImpulse[axis - 1];
+      const double change =
+          -row.mass[axis] * this->relativeVelocity(contact, row, axis);
+      double total = accumulated + change;
+      total = total > limit ? limit : (total < -limit ? -limit : total);
+      this->applyRow(contact, row, axis, total - accumulated);
+      accumulated = total;
+    }
+
+    const double change =
+        row.mass[0] * (row.bias - this->relativeVelocity(contact, row, 0));
+    const double total =
+        contact.normalImpulse + change > 0 ? contact.normalImpulse + change
+                                           : 0;
+    this->applyRow(contact, row, 0, total - contact.normalImpulse);
+    contact.normalImpulse = total;
+  }
+};
+} // namespace svector
+
+#endif
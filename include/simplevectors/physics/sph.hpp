@@ -0,0 +1,599 @@
+/**
+ * @file sph.hpp
+ *
+ * @brief Smoothed-particle hydrodynamics in a box.
+ *
+ * svector::SPHFluid computes the density, pressure and forces of fluid
+ * particles as sums of smoothing kernels over their neighbors, using the
+ * kernels of Müller et al. (2003): poly6 for the density, the gradient of
+ * the spiky kernel for the pressure and the Laplacian of the viscosity
+ * kernel for the viscosity.
+ *
+ * Neighbors are found with a cell list: the particles are sorted into cells
+ * of a grid over the box, so the neighbors of a particle are in the 27 cells
+ * around it. The neighbor lists are built with a radius larger than the
+ * smoothing length by a skin, and are kept until some particle has moved
+ * half of the skin, which usually takes many steps.
+ *
+ * The kernel sums of a particle only read the neighbor lists and the
+ * quantities of the previous pass, and each pass only writes to the
+ * particles of the range it is given, so the passes can be split into
+ * independent ranges. The loops have no branches on the distances, so the
+ * compiler can vectorize them.
+ *
+ * This file is not included in vectors.hpp, so it has to be included
+ * separately.
+ *
+ * @copyright Copyright (c) 2023 Jonathan Liu. This project is released under
+ * the MIT License. All rights reserved.
+ */
+
+#ifndef INCLUDE_SVECTOR_SPH_HPP_
+#define INCLUDE_SVECTOR_SPH_HPP_
+
+#include <cmath>   // std::sqrt, std::floor
+#include <cstddef> // std::size_t
+#include <vector>  // std::vector
+
+#include "simplevectors/core/vector3d.hpp" // svector::Vector3D
+
+namespace svector {
+/**
+ * @brief The smoothing kernels of SPH with a given smoothing length.
+ *
+ * All kernels are zero at distances of the smoothing length and beyond.
+ */
+class SPHKernel {
+public:
+  /**
+   * @brief Precomputes the normalization of the kernels.
+   *
+   * @param h The smoothing length.
+   */
+  explicit SPHKernel(const double h)
+      : m_h(h), m_h2(h * h),
+        m_poly6(315 / (64 * 3.14159265358979323846 * h * h * h * h * h * h *
+                       h * h * h)),
+        m_spiky(-45 / (3.14159265358979323846 * h * h * h * h * h * h)),
+        m_viscosity(45 / (3.14159265358979323846 * h * h * h * h * h * h)) {}
+
+  /**
+   * @brief Gets the smoothing length.
+   *
+   * @returns The smoothing length.
+   */
+  double h() const { return this->m_h; }
+
+  /**
+   * @brief The poly6 kernel.
+   *
+   * @param r2 The squared distance.
+   *
+   * @returns The value of the kernel.
+   */
+  double poly6(const double r2) const {
+    const double d = r2 < this->m_h2 ? this->m_h2 - r2 : 0;
+    return this->m_poly6 * d * d * d;
+  }
+
+  /**
+   * @brief Evaluates the poly6 kernel for many squared distances.
+   *
+   * @param r2 The squared distances.
+   * @param out The values of the kernel.
+   * @param n The number of distances.
+   */
+  void poly6(const double *r2, double *out, const std::size_t n) const {
+    for (std::size_t i = 0; i < n; i++) {
+      const double d = r2[i] < this->m_h2 ? this->m_h2 - r2[i] : 0;
+      out[i] = this->m_poly6 * d * d * d;
+    }
+  }
+
+  /**
+   * @brief The gradient of the spiky kernel, divided by the distance.
+   *
+   * The gradient at offset r is r times this value.
+   *
+   * @param r2 The squared distance.
+   *
+   * @returns The derivative of the kernel over the distance, which is not
+   * positive, or zero at distance zero.
+   */
+  double spikyGradient(const double r2) const {
+    const bool inside = r2 < this->m_h2 && r2 > 0;
+    const double r = std::sqrt(inside ? r2 : this->m_h2);
+    const double d = this->m_h - r;
+    return inside ? this->m_spiky * d * d / r : 0;
+  }
+
+  /**
+   * @brief Evaluates the gradient of the spiky kernel for many squared
+   * distances.
+   *
+   * @param r2 The squared distances.
+   * @param out The derivatives over the distances.
+   * @param n The number of distances.
+   */
+  void spikyGradient(const double *r2, double *out,
+                     const std::size_t n) const {
+    for (std::size_t i = 0; i < n; i++) {
+      out[i] = this->spikyGradient(r2[i]);
+    }
+  }
+
+  /**
+   * @brief The Laplacian of the viscosity kernel.
+   *
+   * @param r2 The squared distance.
+   *
+   * @returns The value of the Laplacian.
+   */
+  double viscosityLaplacian(const double r2) const {
+    const bool inside = r2 < this->m_h2;
+    const double r = std::sqrt(inside ? r2 : this->m_h2);
+    return inside ? this->m_viscosity * (this->m_h - r) : 0;
+  }
+
+  /**
+   * @brief Evaluates the Laplacian of the viscosity kernel for many squared
+   * distances.
+   *
+   * @param r2 The squared distances.
+   * @param out The values of the Laplacian.
+   * @param n The number of distances.
+   */
+  void viscosityLaplacian(const double *r2, double *out,
+                          const std::size_t n) const {
+    for (std::size_t i = 0; i < n; i++) {
+      out[i] = this->viscosityLaplacian(r2[i]);
+    }
+  }
+
+private:
+  double m_h;         //!< Smoothing length.
+  double m_h2;        //!< Squared smoothing length.
+  double m_poly6;     //!< Normalization of poly6.
+  double m_spiky;     //!< Normalization of the spiky gradient.
+  double m_viscosity; //!< Normalization of the viscosity Laplacian.
+};
+
+/**
+ * @brief Parameters of an SPH fluid.
+ */
+struct SPHSettings {
+  double h;                //!< Smoothing length.
+  double mass;             //!< Mass of every particle.
+  double restDensity;      //!< Density of the fluid at rest.
+  double stiffness;        //!< Pressure per density above the rest density.
+  double viscosity;        //!< Dynamic viscosity.
+  double skin;             //!< Extra radius of the neighbor lists.
+  double wallRestitution;  //!< Fraction of the speed kept at the walls.
+  double gravity[3];       //!< Gravity acceleration.
+
+  /**
+   * @brief Creates settings for water-like particles 0.02 apart.
+   */
+  SPHSettings()
+      : h(0.04), mass(0.008), restDensity(1000), stiffness(20),
+        viscosity(1), skin(0.01), wallRestitution(0.5),
+        gravity{0, -9.81, 0} {}
+};
+
+/**
+ * @brief A fluid of SPH particles inside an axis-aligned box.
+ *
+ * Fluids are stepped with step(), or with the passes of a step, which
+ * allow computing ranges of particles separately:
+ *
+ * @code
+ * fluid.updateNeighbors();
+ * fluid.computeDensity(begin, end);  // for all ranges, then
+ * fluid.computeForces(begin, end);   // for all ranges, then
+ * fluid.integrate(begin, end, dt);   // for all ranges
+ * @endcode
+ */
+class SPHFluid {
+public:
+  /**
+   * @brief Creates an empty fluid.
+   *
+   * @param settings The parameters of the fluid.
+   * @param lower The corner of the box with the smallest coordinates.
+   * @param upper The corner of the box with the largest coordinates.
+   */
+  SPHFluid(const SPHSettings &settings, const Vector3D &lower,
+           const Vector3D &upper)
+      : m_settings(settings), m_kernel(settings.h),
+        m_lower{lower.x(), lower.y(), lower.z()},
+        m_upper{upper.x(), upper.y(), upper.z()}, m_valid(false) {
+    this->m_cellSize = settings.h + settings.skin;
+    for (std::size_t k = 0; k < 3; k++) {
+      const double cells =
+          std::floor((this->m_upper[k] - this->m_lower[k]) / this->m_cellSize);
+      this->m_cells[k] = cells < 1 ? 1 : static_cast<std::size_t>(cells) + 1;
+    }
+  }
+
+  /**
+   * @brief Adds a particle.
+   *
+   * @param position The position, inside the box.
+   * @param velocity The velocity.
+   *
+   * @returns The index of the particle.
+   */
+  std::size_t add(const Vector3D &position,
+                  const Vector3D &velocity = Vector3D(0, 0, 0)) {
+    const double values[6] = {position.x(), position.y(), position.z(),
+                              velocity.x(), velocity.y(), velocity.z()};
+    std::vector<double> *arrays[6] = {&this->m_x,  &this->m_y,  &this->m_z,
+                                      &this->m_vx, &this->m_vy, &this->m_vz};
+    for (std::size_t k = 0; k < 6; k++) {
+      arrays[k]->push_back(values[k]);
+    }
+    this->m_density.push_back(this->m_settings.restDensity);
+    this->m_pressure.push_back(0);
+    this->m_ax.push_back(0);
+    this->m_ay.push_back(0);
+    this->m_az.push_back(0);
+    this->m_valid = false;
+    return this->m_x.size() - 1;
+  }
+
+  /**
+   * @brief Gets the number of particles.
+   *
+   * @returns The number of particles.
+   */
+  std::size_t size() const { return this->m_x.size(); }
+
+  /**
+   * @brief Gets the kernels of the fluid.
+   *
+   * @returns The kernels.
+   */
+  const SPHKernel &kernel() const { return this->m_kernel; }
+
+  /**
+   * @brief Gets the position of a particle.
+   *
+   * @param i The index of the particle.
+   *
+   * @returns The position.
+   */
+  Vector3D position(const std::size_t i) const {
+    return Vector3D(this->m_x[i], this->m_y[i], this->m_z[i]);
+  }
+
+  /**
+   * @brief Gets the velocity of a particle.
+   *
+   * @param i The index of the particle.
+   *
+   * @returns The velocity.
+   */
+  Vector3D velocity(const std::size_t i) const {
+    return Vector3D(this->m_vx[i], this->m_vy[i], this->m_vz[i]);
+  }
+
+  /**
+   * @brief Gets the density of a particle from the last density pass.
+   *
+   * @param i The index of the particle.
+   *
+   * @returns The density.
+   */
+  double density(const std::size_t i) const { return this->m_density[i]; }
+
+  /**
+   * @brief Gets the pressure of a particle from the last density pass.
+   *
+   * @param i The index of the particle.
+   *
+   * @returns The pressure.
+   */
+  double pressure(const std::size_t i) const { return this->m_pressure[i]; }
+
+  /**
+   * @brief Gets the acceleration of a particle from the last force pass.
+   *
+   * @param i The index of the particle.
+   *
+   * @returns The acceleration, including gravity.
+   */
+  Vector3D acceleration(const std::size_t i) const {
+    return Vector3D(this->m_ax[i], this->m_ay[i], this->m_az[i]);
+  }
+
+  /**
+   * @brief Gets the number of neighbors of a particle.
+   *
+   * @param i The index of the particle.
+   *
+   * @returns The number of other particles closer than the smoothing
+   * length plus the skin when the lists were built.
+   */
+  std::size_t neighborCount(const std::size_t i) const {
+    return this->m_offsets[i + 1] - this->m_offsets[i];
+  }
+
+  /**
+   * @brief Gets a neighbor of a particle.
+   *
+   * @param i The index of the particle.
+   * @param k The index of the neighbor.
+   *
+   * @returns The index of the neighboring particle.
+   */
+  std::size_t neighbor(const std::size_t i, const std::size_t k) const {
+    return this->m_neighbors[this->m_offsets[i] + k];
+  }
+
+  /**
+   * @brief Rebuilds the neighbor lists if they may be out of date.
+   *
+   * The lists are rebuilt when particles were added or some particle moved
+   * more than half of the skin since they were built, since two particles
+   * that were not in each other's lists may be within the smoothing length
+   * of each other after that.
+   *
+   * @returns Whether the lists were rebuilt.
+   */
+  bool updateNeighbors() {
+    if (this->m_valid) {
+      const double limit = this->m_settings.skin * this->m_settings.skin / 4;
+      double moved = 0;
+      for (std::size_t i = 0; i < this->size(); i++) {
+        const double dx = this->m_x[i] - this->m_builtX[i];
+        const double dy = this->m_y[i] - this->m_builtY[i];
+        const double dz = this->m_z[i] - this->m_builtZ[i];
+        const double d2 = dx * dx + dy * dy + dz * dz;
+        moved = d2 > moved ? d2 : moved;
+      }
+      if (moved <= limit) {
+        return false;
+      }
+    }
+
+    this->buildNeighbors();
+    return true;
+  }
+
+  /**
+   * @brief Computes the density and pressure of a range of particles.
+   *
+   * @param begin The first particle of the range.
+   * @param end One past the last particle of the range.
+   */
+  void computeDensity(const std::size_t begin, const std::size_t end) {
+    const double self = this->m_kernel.poly6(0);
+    const double *x = this->m_x.data();
+    const double *y = this->m_y.data();
+    const double *z = this->m_z.data();
+    for (std::size_t i = begin; i < end; i++) {
+      double sum = self;
+      const std::size_t *list = this->m_neighbors.data() + this->m_offsets[i];
+      const std::size_t count = this->neighborCount(i);
+      for (std::size_t k = 0; k < count; k++) {
+        const std::size_t j = list[k];
+        const double dx = x[j] - x[i];
+        const double dy = y[j] - y[i];
+        const double dz = z[j] - z[i];
+        sum += this->m_kernel.poly6(dx * dx + dy * dy + dz * dz);
+      }
+
+      const double density = this->m_settings.mass * sum;
+      const double pressure =
+          this->m_settings.stiffness * (density - this->m_settings.restDensity);
+      this->m_density[i] = density;
+      this->m_pressure[i] = pressure > 0 ? pressure : 0;
+    }
+  }
+
+  /**
+   * @brief Computes the acceleration of a range of particles due to
+   * pressure, viscosity and gravity.
+   *
+   * The densities of all particles must have been computed first.
+   *
+   * @param begin The first particle of the range.
+   * @param end One past the last particle of the range.
+   */
+  void computeForces(const std::size_t begin, const std::size_t end) {
+    const double mass = this->m_settings.mass;
+    const double mu = this->m_settings.viscosity;
+    const double *x = this->m_x.data();
+    const double *y = this->m_y.data();
+    const double *z = this->m_z.data();
+    const double *vx = this->m_vx.data();
+    const double *vy = this->m_vy.data();
+    const double *vz = this->m_vz.data();
+    const double *density = this->m_density.data();
+    const double *pressure = this->m_pressure.data();
+    for (std::size_t i = begin; i < end; i++) {
+      double fx = 0;
+      double fy = 0;
+      double fz = 0;
+      const std::size_t *list = this->m_neighbors.data() + this->m_offsets[i];
+      const std::size_t count = this->neighborCount(i);
+      for (std::size_t k = 0; k < count; k++) {
+        const std::size_t j = list[k];
+        const double dx = x[i] - x[j];
+        const double dy = y[i] - y[j];
+        const double dz = z[i] - z[j];
+        const double r2 = dx * dx + dy * dy + dz * dz;
+
+        // the spiky gradient points from j to i and is negative inside
+        const double push = -mass * (pressure[i] + pressure[j]) /
+                            (2 * density[j]) *
+                            this->m_kernel.spikyGradient(r2);
+        const double drag =
+            mu * mass / density[j] * this->m_kernel.viscosityLaplacian(r2);
+        fx += push * dx + drag * (vx[j] - vx[i]);
+        fy += push * dy + drag * (vy[j] - vy[i]);
+        fz += push * dz + drag * (vz[j] - vz[i]);
+      }
+
+      this->m_ax[i] = fx / density[i] + this->m_settings.gravity[0];
+      this->m_ay[i] = fy / density[i] + this->m_settings.gravity[1];
+      this->m_az[i] = fz / density[i] + this->m_settings.gravity[2];
+    }
+  }
+
+  /**
+   * @brief Moves a range of particles by their accelerations and keeps them
+   * in the box.
+   *
+   * The accelerations of the range must have been computed first.
+   *
+   * @param begin The first particle of the range.
+   * @param end One past the last particle of the range.
+   * @param dt The time step.
+   */
+  void integrate(const std::size_t begin, const std::size_t end,
+                 const double dt) {
+    double *position[3] = {this->m_x.data(), this->m_y.data(),
+                           this->m_z.data()};
+    double *velocity[3] = {this->m_vx.data(), this->m_vy.data(),
+                           this->m_vz.data()};
+    const double *acceleration[3] = {this->m_ax.data(), this->m_ay.data(),
+                                     this->m_az.data()};
+    const double bounce = -this->m_settings.wallRestitution;
+    for (std::size_t k = 0; k < 3; k++) {
+      double *p = position[k];
+      double *v = velocity[k];
+      const double *a = acceleration[k];
+      const double lower = this->m_lower[k];
+      const double upper = this->m_upper[k];
+      for (std::size_t i = begin; i < end; i++) {
+        const double speed = v[i] + dt * a[i];
+        const double moved = p[i] + dt * speed;
+        const bool below = moved < lower;
+        const bool above = moved > upper;
+        p[i] = below ? lower : (above ? upper : moved);
+        v[i] = (below && speed < 0) || (above && speed > 0) ? bounce * speed
+                                                            : speed;
+      }
+    }
+  }
+
+  /**
+   * @brief Advances the fluid by one time step.
+   *
+   * @param dt The time step.
+   */
+  void step(const double dt) {
+    const std::size_t n = this->size();
+    this->updateNeighbors();
+    this->computeDensity(0, n);
+    this->computeForces(0, n);
+    this->integrate(0, n, dt);
+  }
+
+private:
+  SPHSettings m_settings;  //!< Parameters of the fluid.
+  SPHKernel m_kernel;      //!< Smoothing kernels.
+  double m_lower[3];       //!< Lower corner of the box.
+  double m_upper[3];       //!< Upper corner of the box.
+  double m_cellSize;       //!< Edge length of the cells.
+  std::size_t m_cells[3];  //!< Number of cells along each axis.
+  bool m_valid;            //!< Whether the neighbor lists exist.
+
+  std::vector<double> m_x;        //!< x-coordinates of the particles.
+  std::vector<double> m_y;        //!< y-coordinates of the particles.
+  std::vector<double> m_z;        //!< z-coordinates of the particles.
+  std::vector<double> m_vx;       //!< x-components of the velocities.
+  std::vector<double> m_vy;       //!< y-components of the velocities.
+  std::vector<double> m_vz;       //!< z-components of the velocities.
+  std::vector<double> m_ax;       //!< x-components of the accelerations.
+  std::vector<double> m_ay;       //!< y-components of the accelerations.
+  std::vector<double> m_az;       //!< z-components of the accelerations.
+  std::vector<double> m_density;  //!< Densities.
+  std::vector<double> m_pressure; //!< Pressures.
+
+  std::vector<double> m_builtX; //!< x-coordinates when the lists were built.
+  std::vector<double> m_builtY; //!< y-coordinates when the lists were built.
+  std::vector<double> m_builtZ; //!< z-coordinates when the lists were built.
+  std::vector<std::size_t> m_offsets;   //!< Start of each neighbor list.
+  std::vector<std::size_t> m_neighbors; //!< All neighbor lists.
+  std::vector<std::size_t> m_cellStart; //!< Start of each cell in m_sorted.
+  std::vector<std::size_t> m_sorted;    //!< Particles sorted by cell.
+
+  /**
+   * @brief Gets the cell coordinate of a particle along an axis.
+   */
+  std::size_t cellOf(const double value, const std::size_t axis) const {
+    const double cell =
+        std::floor((value - this->m_lower[axis]) / this->m_cellSize);
+    const double last = static_cast<double>(this->m_cells[axis] - 1);
+    return static_cast<std::size_t>(cell < 0 ? 0 : (cell > last ? last : cell));
+  }
+
+  /**
+   * @brief Sorts the particles into cells and builds the neighbor lists.
+   */
+  void buildNeighbors() {
+    const std::size_t n = this->size();
+    const std::size_t nx = this->m_cells[0];
+    const std::size_t ny = this->m_cells[1];
+    const std::size_t nz = this->m_cells[2];
+
+    // counting sort of the particles by cell
+    std::vector<std::size_t> cell(n);
+    this->m_cellStart.assign(nx * ny * nz + 1, 0);
+    for (std::size_t i = 0; i < n; i++) {
+      cell[i] = (this->cellOf(this->m_z[i], 2) * ny +
+                 this->cellOf(this->m_y[i], 1)) *
+                    nx +
+                this->cellOf(this->m_x[i], 0);
+      this->m_cellStart[cell[i] + 1]++;
+    }
+    for (std::size_t c = 0; c < nx * ny * nz; c++) {
+      this->m_cellStart[c + 1] += this->m_cellStart[c];
+    }
+    std::vector<std::size_t> next(this->m_cellStart.begin(),
+                                  this->m_cellStart.end() - 1);
+    this->m_sorted.resize(n);
+    for (std::size_t i = 0; i < n; i++) {
+      this->m_sorted[next[cell[i]]++] = i;
+    }
+
+    const double radius2 = this->m_cellSize * this->m_cellSize;
+    this->m_offsets.assign(1, 0);
+    this->m_neighbors.clear();
+    for (std::size_t i = 0; i < n; i++) {
+      const std::size_t cx = this->cellOf(this->m_x[i], 0);
+      const std::size_t cy = this->cellOf(this->m_y[i], 1);
+      const std::size_t cz = this->cellOf(this->m_z[i], 2);
+      for (std::size_t z = cz > 0 ? cz - 1 : 0; z <= cz + 1 && z < nz; z++) {
+        for (std::size_t y = cy > 0 ? cy - 1 : 0; y <= cy + 1 && y < ny;
+             y++) {
+          const std::size_t row = (z * ny + y) * nx;
+          const std::size_t first = this->m_cellStart[row + (cx > 0 ? cx - 1
+                                                                    : 0)];
+          const std::size_t last =
+              this->m_cellStart[row + (cx + 2 < nx ? cx + 2 : nx)];
+          for (std::size_t s = first; s < last; s++) {
+            const std::size_t j = this->m_sorted[s];
+            const double dx = this->m_x[j] - this->m_x[i];
+            const double dy = this->m_y[j] - this->m_y[i];
+            const double dz = this->m_z[j] - this->m_z[i];
+            if (j != i && dx * dx + dy * dy + dz * dz < radius2) {
+              this->m_neighbors.push_back(j);
+            }
+          }
+        }
+      }
+      this->m_offsets.push_back(this->m_neighbors.size());
+    }
+
+    this->m_builtX = this->m_x;
+    this->m_builtY = this->m_y;
+    this->m_builtZ = this->m_z;
+    this->m_valid = true;
+  }
+};
+} // namespace svector
+
+#endif
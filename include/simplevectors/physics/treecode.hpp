@@ -0,0 +1,535 @@
+/**
+ * @file treecode.hpp
+ *
+ * @brief Fast evaluation of Coulomb and gravitational potentials and fields.
+ *
+ * svector::Treecode evaluates the potential and field of many point charges
+ * in O(n log n) instead of summing over all charges for every point. The
+ * charges are sorted into an octree, and the charges of each node are
+ * summarized by their Cartesian multipole moments up to a given order. A
+ * node that is far enough from a point compared to its size is evaluated
+ * with a Taylor expansion of the kernel around its center, using the
+ * recurrence of Duan and Krasny (2001) for the Taylor coefficients, and
+ * close nodes are opened or summed directly. Higher orders and smaller
+ * opening angles are more accurate and slower.
+ *
+ * The potential is the sum of q / r over the charges and the field is its
+ * negative gradient, the sum of q (x - y) / r^3. Multiply both by the
+ * Coulomb constant for electrostatics. For gravity, use the masses as the
+ * charges and multiply by -G, which gives the gravitational potential and
+ * acceleration.
+ *
+ * The moments of each node are computed from its own charges, so ranges of
+ * nodes can be computed independently, and so can ranges of points to
+ * evaluate.
+ *
+ * This file is not included in vectors.hpp, so it has to be included
+ * separately.
+ *
+ * @copyright Copyright (c) 2023 Jonathan Liu. This project is released under
+ * the MIT License. All rights reserved.
+ */
+
+#ifndef INCLUDE_SVECTOR_TREECODE_HPP_
+#define INCLUDE_SVECTOR_TREECODE_HPP_
+
+#include <cmath>   // std::sqrt
+#include <cstddef> // std::size_t
+#include <vector>  // std::vector
+
+#include "simplevectors/core/vector3d.hpp" // svector::Vector3D
+
+namespace svector {
+/**
+ * @brief Parameters of a treecode.
+ */
+struct TreecodeSettings {
+  std::size_t order;    //!< The highest order of the multipole moments.
+  double theta;         //!< The opening angle: the largest ratio of the
+                        //!< radius of a node to its distance to use the
+                        //!< expansion of the node.
+  std::size_t leafSize; //!< The most charges in a leaf.
+  double softening;     //!< The softening length of the kernel.
+
+  /**
+   * @brief Creates settings for order 4, an opening angle of 0.5, leaves of
+   * up to 32 charges and no softening.
+   */
+  TreecodeSettings() : order(4), theta(0.5), leafSize(32), softening(0) {}
+};
+
+/**
+ * @brief An octree of point charges with multipole moments.
+ */
+class Treecode {
+public:
+  /**
+   * @brief Creates an empty treecode.
+   *
+   * @param settings The parameters of the treecode.
+   */
+  explicit Treecode(const TreecodeSettings &settings = TreecodeSettings())
+      : m_settings(settings), m_terms(0) {
+    const std::size_t order = settings.order;
+    const std::size_t side = order + 2;
+
+    // multi-indices up to order + 1, sorted by degree
+    std::vector<std::size_t> lookup(side * side * side);
+    for (std::size_t degree = 0; degree <= order + 1; degree++) {
+      if (degree == order + 1) {
+        this->m_terms = this->m_k.size() / 3;
+      }
+      for (std::size_t i = 0; i <= degree; i++) {
+        for (std::size_t j = 0; i + j <= degree; j++) {
+          lookup[(i * side + j) * side + degree - i - j] = this->m_k.size() / 3;
+          this->m_k.push_back(i);
+          this->m_k.push_back(j);
+          this->m_k.push_back(degree - i - j);
+        }
+      }
+    }
+
+    // indices of neighboring multi-indices, where the missing ones point to
+    // an extra coefficient that is always zero
+    const std::size_t count = this->m_k.size() / 3;
+    this->m_lower.resize(6 * count, count);
+    this->m_raise.resize(3 * this->m_terms, count);
+    this->m_recurrence.resize(2 * count, 0);
+    this->m_factors.resize(3 * this->m_terms);
+    for (std::size_t t = 0; t < count; t++) {
+      const double degree = static_cast<double>(
+          this->m_k[3 * t] + this->m_k[3 * t + 1] + this->m_k[3 * t + 2]);
+      if (t > 0) {
+        this->m_recurrence[2 * t] = (2 * degree - 1) / degree;
+        this->m_recurrence[2 * t + 1] = (degree - 1) / degree;
+      }
+
+      for (std::size_t d = 0; d < 3; d++) {
+        std::size_t k[3] = {this->m_k[3 * t], this->m_k[3 * t + 1],
+                            this->m_k[3 * t + 2]};
+        if (k[d] >= 1) {
+          k[d]--;
+          this->m_lower[6 * t + d] = lookup[(k[0] * side + k[1]) * side + k[2]];
+          k[d]++;
+        }
+        if (k[d] >= 2) {
+          k[d] -= 2;
+          this->m_lower[6 * t + 3 + d] =
+              lookup[(k[0] * side + k[1]) * side + k[2]];
+          k[d] += 2;
+        }
+        if (t < this->m_terms) {
+          this->m_factors[3 * t + d] = static_cast<double>(k[d] + 1);
+          k[d]++;
+          this->m_raise[3 * t + d] = lookup[(k[0] * side + k[1]) * side + k[2]];
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Gets the parameters of the treecode.
+   *
+   * @returns The settings.
+   */
+  const TreecodeSettings &settings() const { return this->m_settings; }
+
+  /**
+   * @brief Gets the number of charges.
+   *
+   * @returns The number of charges.
+   */
+  std::size_t size() const { return this->m_x.size(); }
+
+  /**
+   * @brief Gets the number of nodes of the octree.
+   *
+   * @returns The number of nodes.
+   */
+  std::size_t nodes() const { return this->m_begin.size(); }
+
+  /**
+   * @brief Gets the number of multipole moments of each node.
+   *
+   * @returns The number of moments.
+   */
+  std::size_t moments() const { return this->m_terms; }
+
+  /**
+   * @brief Builds the octree and the moments of all nodes.
+   *
+   * @param positions The positions of the charges.
+   * @param charges The charges.
+   * @param n The number of charges.
+   */
+  void build(const Vector3D *positions, const double *charges,
+             const std::size_t n) {
+    this->buildTree(positions, charges, n);
+    this->computeMoments(0, this->nodes());
+  }
+
+  /**
+   * @brief Builds the octree without the moments.
+   *
+   * computeMoments() has to be called for all nodes before evaluating.
+   *
+   * @param positions The positions of the charges.
+   * @param charges The charges.
+   * @param n The number of charges.
+   */
+  void buildTree(const Vector3D *positions, const double *charges,
+                 const std::size_t n) {
+    this->m_x.resize(n);
+    this->m_y.resize(n);
+    this->m_z.resize(n);
+    this->m_q.assign(charges, charges + n);
+    for (std::size_t i = 0; i < n; i++) {
+      this->m_x[i] = positions[i].x();
+      this->m_y[i] = positions[i].y();
+      this->m_z[i] = positions[i].z();
+    }
+
+    this->m_begin.clear();
+    this->m_end.clear();
+    this->m_child.clear();
+    this->m_children.clear();
+    this->m_cx.clear();
+    this->m_cy.clear();
+    this->m_cz.clear();
+    this->m_radius.clear();
+    if (n == 0) {
+      this->m_moments.clear();
+      return;
+    }
+
+    this->addNode(0, n);
+    this->m_octant.resize(n);
+    this->m_buffer.resize(n);
+
+    // the nodes are split in the order they are created, so the children of
+    // a node are next to each other
+    for (std::size_t node = 0; node < this->nodes(); node++) {
+      const std::size_t begin = this->m_begin[node];
+      const std::size_t end = this->m_end[node];
+      if (end - begin <= this->m_settings.leafSize ||
+          this->m_radius[node] == 0) {
+        continue;
+      }
+
+      std::size_t counts[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+      for (std::size_t i = begin; i < end; i++) {
+        const std::size_t octant =
+            (this->m_x[i] > this->m_cx[node] ? 1u : 0u) |
+            (this->m_y[i] > this->m_cy[node] ? 2u : 0u) |
+            (this->m_z[i] > this->m_cz[node] ? 4u : 0u);
+        this->m_octant[i] = octant;
+        counts[octant]++;
+      }
+
+      // charges that are too close to be split by the midpoint, which
+      // rounds to a bound when the box is an ulp wide, stay in a leaf
+      bool split = true;
+      for (std::size_t octant = 0; octant < 8; octant++) {
+        split = split && counts[octant] < end - begin;
+      }
+      if (!split) {
+        continue;
+      }
+
+      std::size_t starts[8];
+      std::size_t start = begin;
+      for (std::size_t octant = 0; octant < 8; octant++) {
+        starts[octant] = start;
+        start += counts[octant];
+      }
+      this->permute(this->m_x, begin, end, starts);
+      this->permute(this->m_y, begin, end, starts);
+      this->permute(this->m_z, begin, end, starts);
+      this->permute(this->m_q, begin, end, starts);
+
+      this->m_child[node] = this->nodes();
+      start = begin;
+      for (std::size_t octant = 0; octant < 8; octant++) {
+        if (counts[octant] > 0) {
+          this->addNode(start, start + counts[octant]);
+          this->m_children[node]++;
+        }
+        start += counts[octant];
+      }
+    }
+
+    this->m_moments.assign(this->nodes() * this->m_terms, 0);
+  }
+
+  /**
+   * @brief Computes the multipole moments of a range of nodes.
+   *
+   * @param begin The first node of the range.
+   * @param end One past the last node of the range.
+   */
+  void computeMoments(const std::size_t begin, const std::size_t end) {
+    const std::size_t order = this->m_settings.order;
+    std::vector<double> powers(3 * (order + 1));
+    for (std::size_t node = begin; node < end; node++) {
+      double *moments = this->m_moments.data() + node * this->m_terms;
+      for (std::size_t t = 0; t < this->m_terms; t++) {
+        moments[t] = 0;
+      }
+
+      for (std::size_t i = this->m_begin[node]; i < this->m_end[node]; i++) {
+        const double d[3] = {this->m_x[i] - this->m_cx[node],
+                             this->m_y[i] - this->m_cy[node],
+                             this->m_z[i] - this->m_cz[node]};
+        for (std::size_t axis = 0; axis < 3; axis++) {
+          powers[axis * (order + 1)] = 1;
+          for (std::size_t p = 1; p <= order; p++) {
+            powers[axis * (order + 1) + p] =
+                powers[axis * (order + 1) + p - 1] * d[axis];
+          }
+        }
+
+        for (std::size_t t = 0; t < this->m_terms; t++) {
+          moments[t] += this->m_q[i] * powers[this->m_k[3 * t]] *
+                        powers[order + 1 + this->m_k[3 * t + 1]] *
+                        powers[2 * (order + 1) + this->m_k[3 * t + 2]];
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Evaluates the potential at a point.
+   *
+   * @param point The point.
+   *
+   * @returns The potential.
+   */
+  double potential(const Vector3D &point) const {
+    double result;
+    this->evaluate(&point, 0, 1, &result, nullptr);
+    return result;
+  }
+
+  /**
+   * @brief Evaluates the field at a point.
+   *
+   * @param point The point.
+   *
+   * @returns The field.
+   */
+  Vector3D field(const Vector3D &point) const {
+    Vector3D result;
+    this->evaluate(&point, 0, 1, nullptr, &result);
+    return result;
+  }
+
+  /**
+   * @brief Evaluates the potential and field at a range of points.
+   *
+   * Charges at the same position as a point are skipped unless the kernel
+   * is softened.
+   *
+   * @param points The points.
+   * @param begin The first point of the range.
+   * @param end One past the last point of the range.
+   * @param potentials The potentials, written at the index of the point, or
+   * nullptr to skip them.
+   * @param fields The fields, written at the index of the point, or nullptr
+   * to skip them.
+   */
+  void evaluate(const Vector3D *points, const std::size_t begin,
+                const std::size_t end, double *potentials,
+                Vector3D *fields) const {
+    std::vector<double> coefficients(this->m_k.size() / 3 + 1, 0);
+    std::vector<std::size_t> stack;
+    for (std::size_t i = begin; i < end; i++) {
+      double result[4] = {0, 0, 0, 0};
+      if (this->nodes() > 0) {
+        this->evaluatePoint(points[i], coefficients.data(), stack, result);
+      }
+      if (potentials != nullptr) {
+        potentials[i] = result[0];
+      }
+      if (fields != nullptr) {
+        fields[i] = Vector3D(result[1], result[2], result[3]);
+      }
+    }
+  }
+
+private:
+  TreecodeSettings m_settings;   //!< Parameters of the treecode.
+  std::size_t m_terms;           //!< Number of moments of each node.
+  std::vector<std::size_t> m_k;     //!< Multi-indices, three per term.
+  std::vector<std::size_t> m_lower; //!< Terms one and two below each term.
+  std::vector<std::size_t> m_raise; //!< Terms one above each moment.
+  std::vector<double> m_recurrence; //!< Factors of the recurrence.
+  std::vector<double> m_factors;    //!< Factors of the field terms.
+
+  std::vector<double> m_x; //!< x-coordinates of the sorted charges.
+  std::vector<double> m_y; //!< y-coordinates of the sorted charges.
+  std::vector<double> m_z; //!< z-coordinates of the sorted charges.
+  std::vector<double> m_q; //!< Sorted charges.
+
+  std::vector<std::size_t> m_begin;    //!< First charge of each node.
+  std::vector<std::size_t> m_end;      //!< One past the last charge.
+  std::vector<std::size_t> m_child;    //!< First child of each node.
+  std::vector<std::size_t> m_children; //!< Number of children of each node.
+  std::vector<double> m_cx;            //!< x-coordinates of the centers.
+  std::vector<double> m_cy;            //!< y-coordinates of the centers.
+  std::vector<double> m_cz;            //!< z-coordinates of the centers.
+  std::vector<double> m_radius;        //!< Radii of the nodes.
+  std::vector<double> m_moments;       //!< Moments of all nodes.
+
+  std::vector<std::size_t> m_octant; //!< Scratch octants of the charges.
+  std::vector<double> m_buffer;      //!< Scratch for sorting.
+
+  /**
+   * @brief Adds a leaf for a range of charges, centered on their bounding
+   * box.
+   *
+   * @param begin The first charge.
+   * @param end One past the last charge.
+   */
+  void addNode(const std::size_t begin, const std::size_t end) {
+    double lower[3] = {this->m_x[begin], this->m_y[begin], this->m_z[begin]};
+    double upper[3] = {lower[0], lower[1], lower[2]};
+    for (std::size_t i = begin + 1; i < end; i++) {
+      const double p[3] = {this->m_x[i], this->m_y[i], this->m_z[i]};
+      for (std::size_t d = 0; d < 3; d++) {
+        lower[d] = p[d] < lower[d] ? p[d] : lower[d];
+        upper[d] = p[d] > upper[d] ? p[d] : upper[d];
+      }
+    }
+
+    const double cx = (lower[0] + upper[0]) / 2;
+    const double cy = (lower[1] + upper[1]) / 2;
+    const double cz = (lower[2] + upper[2]) / 2;
+    double radius2 = 0;
+    for (std::size_t i = begin; i < end; i++) {
+      const double dx = this->m_x[i] - cx;
+      const double dy = this->m_y[i] - cy;
+      const double dz = this->m_z[i] - cz;
+      const double d2 = dx * dx + dy * dy + dz * dz;
+      radius2 = d2 > radius2 ? d2 : radius2;
+    }
+
+    this->m_begin.push_back(begin);
+    this->m_end.push_back(end);
+    this->m_child.push_back(0);
+    this->m_children.push_back(0);
+    this->m_cx.push_back(cx);
+    this->m_cy.push_back(cy);
+    this->m_cz.push_back(cz);
+    this->m_radius.push_back(std::sqrt(radius2));
+  }
+
+  /**
+   * @brief Sorts a range of values by the octants in m_octant.
+   *
+   * @param values The values.
+   * @param begin The first value of the range.
+   * @param end One past the last value of the range.
+   * @param starts The start of each octant.
+   */
+  void permute(std::vector<double> &values, const std::size_t begin,
+               const std::size_t end, const std::size_t *starts) {
+    std::size_t next[8];
+    for (std::size_t octant = 0; octant < 8; octant++) {
+      next[octant] = starts[octant];
+    }
+    for (std::size_t i = begin; i < end; i++) {
+      this->m_buffer[next[this->m_octant[i]]++] = values[i];
+    }
+    for (std::size_t i = begin; i < end; i++) {
+      values[i] = this->m_buffer[i];
+    }
+  }
+
+  /**
+   * @brief Adds the potential and field of all charges at a point.
+   *
+   * @param point The point.
+   * @param coefficients Scratch for the Taylor coefficients.
+   * @param stack Scratch for the nodes to visit.
+   * @param result The potential and the field.
+   */
+  void evaluatePoint(const Vector3D &point, double *coefficients,
+                     std::vector<std::size_t> &stack, double *result) const {
+    const double x = point.x();
+    const double y = point.y();
+    const double z = point.z();
+    const double epsilon2 =
+        this->m_settings.softening * this->m_settings.softening;
+    const double theta2 = this->m_settings.theta * this->m_settings.theta;
+    const std::size_t count = this->m_k.size() / 3;
+
+    stack.clear();
+    stack.push_back(0);
+    while (!stack.empty()) {
+      const std::size_t node = stack.back();
+      stack.pop_back();
+
+      const double rx = x - this->m_cx[node];
+      const double ry = y - this->m_cy[node];
+      const double rz = z - this->m_cz[node];
+      const double d2 = rx * rx + ry * ry + rz * rz;
+      const bool distant = this->m_radius[node] * this->m_radius[node] <
+                       theta2 * d2;
+      const std::size_t charges = this->m_end[node] - this->m_begin[node];
+
+      if (distant && charges > this->m_terms) {
+        // Taylor coefficients of the kernel around the center of the node
+        const double r2 = d2 + epsilon2;
+        const double r[3] = {rx, ry, rz};
+        const double inverse = 1 / r2;
+        coefficients[0] = std::sqrt(inverse);
+        for (std::size_t t = 1; t < count; t++) {
+          const std::size_t *lower = this->m_lower.data() + 6 * t;
+          coefficients[t] = (this->m_recurrence[2 * t] *
+                                 (r[0] * coefficients[lower[0]] +
+                                  r[1] * coefficients[lower[1]] +
+                                  r[2] * coefficients[lower[2]]) -
+                             this->m_recurrence[2 * t + 1] *
+                                 (coefficients[lower[3]] +
+                                  coefficients[lower[4]] +
+                                  coefficients[lower[5]])) *
+                            inverse;
+        }
+
+        const double *moments = this->m_moments.data() + node * this->m_terms;
+        const std::size_t *raise = this->m_raise.data();
+        const double *factors = this->m_factors.data();
+        for (std::size_t t = 0; t < this->m_terms; t++) {
+          result[0] += coefficients[t] * moments[t];
+          result[1] += factors[3 * t] * coefficients[raise[3 * t]] * moments[t];
+          result[2] +=
+              factors[3 * t + 1] * coefficients[raise[3 * t + 1]] * moments[t];
+          result[3] +=
+              factors[3 * t + 2] * coefficients[raise[3 * t + 2]] * moments[t];
+        }
+      } else if (distant || this->m_children[node] == 0) {
+        for (std::size_t j = this->m_begin[node]; j < this->m_end[node];
+             j++) {
+          const double dx = x - this->m_x[j];
+          const double dy = y - this->m_y[j];
+          const double dz = z - this->m_z[j];
+          const double r2 = dx * dx + dy * dy + dz * dz + epsilon2;
+          const double inverse = r2 > 0 ? 1 / std::sqrt(r2) : 0;
+          const double q = this->m_q[j] * inverse;
+          const double q3 = q * inverse * inverse;
+          result[0] += q;
+          result[1] += q3 * dx;
+          result[2] += q3 * dy;
+          result[3] += q3 * dz;
+        }
+      } else {
+        for (std::size_t c = 0; c < this->m_children[node]; c++) {
+          stack.push_back(this->m_child[node] + c);
+        }
+      }
+    }
+  }
+};
+} // namespace svector
+
+#endif
@@ -0,0 +1,367 @@
+/**
+ * @file culling.hpp
+ *
+ * @brief Culling of bounding spheres and boxes against view frusta.
+ *
+ * Bounding volumes are stored as separate arrays for each coordinate. The
+ * kernels test them in chunks: for every plane of the frustum, one loop
+ * without branches updates a visibility flag for every volume of the chunk,
+ * which the compiler can vectorize, and a second loop then packs the
+ * indices of the visible volumes into the output.
+ *
+ * The tests are conservative: a volume is only culled if it is entirely
+ * outside one plane, so volumes near the corners of a frustum may be kept
+ * although they are outside of it.
+ *
+ * Each call only touches the range of volumes it is given and the output it
+ * writes to.
+ *
+ * This file is not included in vectors.hpp, so it has to be included
+ * separately.
+ *
+ * @copyright Copyright (c) 2023 Jonathan Liu. This project is released under
+ * the MIT License. All rights reserved.
+ */
+
+#ifndef INCLUDE_SVECTOR_CULLING_HPP_
+#define INCLUDE_SVECTOR_CULLING_HPP_
+
+#include <cmath>   // std::sqrt, std::tan, std::abs
+#include <cstddef> // std::size_t
+#include <vector>  // std::vector
+
+#include "simplevectors/core/batch.hpp"        // svector::detail::batchCompact
+#include "simplevectors/core/traits.hpp"       // svector::VectorTraits
+#include "simplevectors/spatial/halfspace.hpp" // svector::Halfspace
+
+namespace svector {
+namespace detail {
+/**
+ * Normalizes a 3D direction given as three doubles.
+ */
+inline void cullNormalize(double *v) {
+  const double length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+  v[0] /= length;
+  v[1] /= length;
+  v[2] /= length;
+}
+} // namespace detail
+
+/**
+ * @brief The six half-spaces of a perspective view frustum.
+ *
+ * @tparam V 3D point type.
+ *
+ * @param eye The position of the camera.
+ * @param forward The direction the camera looks in.
+ * @param up The up direction of the camera, not parallel to forward.
+ * @param fovY The vertical field of view in radians.
+ * @param aspect The width of the view divided by its height.
+ * @param nearDistance The distance of the near plane from the eye.
+ * @param farDistance The distance of the far plane from the eye.
+ *
+ * @returns The near, far, left, right, bottom and top half-spaces, with unit
+ * normals pointing into the frustum.
+ */
+template <typename V>
+std::vector<Halfspace<V>>
+viewFrustum(const V &eye, const V &forward, const V &up, const double fovY,
+            const double aspect, const double nearDistance,
+            const double farDistance) {
+  static_assert(VectorTraits<V>::dimensions == 3,
+                "viewFrustum requires 3D vectors");
+
+  double f[3];
+  double u[3];
+  double e[3];
+  for (std::size_t k = 0; k < 3; k++) {
+    f[k] = static_cast<double>(forward[k]);
+    u[k] = static_cast<double>(up[k]);
+    e[k] = static_cast<double>(eye[k]);
+  }
+  detail::cullNormalize(f);
+
+  // right and true up directions of the camera
+  double r[3] = {f[1] * u[2] - f[2] * u[1], f[2] * u[0] - f[0] * u[2],
+                 f[0] * u[1] - f[1] * u[0]};
+  detail::cullNormalize(r);
+  u[0] = r[1] * f[2] - r[2] * f[1];
+  u[1] = r[2] * f[0] - r[0] * f[2];
+  u[2] = r[0] * f[1] - r[1] * f[0];
+
+  const double halfHeight = std::tan(fovY / 2);
+  const double halfWidth = halfHeight * aspect;
+
+  // the side planes go through the eye; their normals lean towards forward
+  // so they are zero along the edges of the view
+  double normals[6][3];
+  for (std::size_t k = 0; k < 3; k++) {
+    normals[0][k] = f[k];
+    normals[1][k] = -f[k];
+    normals[2][k] = f[k] * halfWidth + r[k];
+    normals[3][k] = f[k] * halfWidth - r[k];
+    normals[4][k] = f[k] * halfHeight + u[k];
+    normals[5][k] = f[k] * halfHeight - u[k];
+  }
+
+  std::vector<Halfspace<V>> result(6);
+  for (std::size_t i = 0; i < 6; i++) {
+    detail::cullNormalize(normals[i]);
+    double offset = 0;
+    for (std::size_t k = 0; k < 3; k++) {
+      result[i].normal[k] =
+          static_cast<typename VectorTraits<V>::value_type>(normals[i][k]);
+      offset -= normals[i][k] * e[k];
+    }
+    result[i].offset = offset;
+  }
+  result[0].offset -= nearDistance;
+  result[1].offset += farDistance;
+
+  return result;
+}
+
+/**
+ * @brief Bounding spheres stored as separate arrays.
+ */
+struct SphereSet {
+  std::vector<double> x;      //!< Center x-coordinates.
+  std::vector<double> y;      //!< Center y-coordinates.
+  std::vector<double> z;      //!< Center z-coordinates.
+  std::vector<double> radius; //!< Radii.
+
+  /**
+   * @brief Adds a sphere.
+   *
+   * @tparam V 3D point type.
+   *
+   * @param center The center of the sphere.
+   * @param r The radius of the sphere.
+   */
+  template <typename V> void add(const V &center, const double r) {
+    static_assert(VectorTraits<V>::dimensions == 3,
+                  "SphereSet requires 3D vectors");
+
+    this->x.push_back(static_cast<double>(center[0]));
+    this->y.push_back(static_cast<double>(center[1]));
+    this->z.push_back(static_cast<double>(center[2]));
+    this->radius.push_back(r);
+  }
+
+  /**
+   * @brief Number of spheres.
+   *
+   * @returns The number of spheres.
+   */
+  std::size_t size() const { return this->radius.size(); }
+};
+
+/**
+ * @brief Axis-aligned boxes stored as centers and half extents in separate
+ * arrays.
+ */
+struct BoxSet {
+  std::vector<double> x;  //!< Center x-coordinates.
+  std::vector<double> y;  //!< Center y-coordinates.
+  std::vector<double> z;  //!< Center z-coordinates.
+  std::vector<double> hx; //!< Half extents along x.
+  std::vector<double> hy; //!< Half extents along y.
+  std::vector<double> hz; //!< Half extents along z.
+
+  /**
+   * @brief Adds a box.
+   *
+   * @tparam V 3D point type.
+   *
+   * @param lower The corner of the box with the smallest coordinates.
+   * @param upper The corner of the box with the largest coordinates.
+   */
+  template <typename V> void add(const V &lower, const V &upper) {
+    static_assert(VectorTraits<V>::dimensions == 3,
+                  "BoxSet requires 3D vectors");
+
+    const double lx = static_cast<double>(lower[0]);
+    const double ly = static_cast<double>(lower[1]);
+    const double lz = static_cast<double>(lower[2]);
+    const double ux = static_cast<double>(upper[0]);
+    const double uy = static_cast<double>(upper[1]);
+    const double uz = static_cast<double>(upper[2]);
+    this->x.push_back((lx + ux) / 2);
+    this->y.push_back((ly + uy) / 2);
+    this->z.push_back((lz + uz) / 2);
+    this->hx.push_back((ux - lx) / 2);
+    this->hy.push_back((uy - ly) / 2);
+    this->hz.push_back((uz - lz) / 2);
+  }
+
+  /**
+   * @brief Number of boxes.
+   *
+   * @returns The number of boxes.
+   */
+  std::size_t size() const { return this->x.size(); }
+};
+
+/**
+ * @brief Convex region given by planes, prepared for culling.
+ */
+class CullRegion {
+public:
+  /**
+   * @brief Prepares a set of half-spaces, such as those of viewFrustum().
+   *
+   * The normals do not need to have unit length.
+   *
+   * @tparam V 3D point type.
+   *
+   * @param halfspaces The half-spaces whose intersection is the region.
+   */
+  template <typename V>
+  explicit CullRegion(const std::vector<Halfspace<V>> &halfspaces) {
+    static_assert(VectorTraits<V>::dimensions == 3,
+                  "CullRegion requires 3D vectors");
+
+    for (const Halfspace<V> &halfspace : halfspaces) {
+      const double nx = static_cast<double>(halfspace.normal[0]);
+      const double ny = static_cast<double>(halfspace.normal[1]);
+      const double nz = static_cast<double>(halfspace.normal[2]);
+      const double length = std::sqrt(nx * nx + ny * ny + nz * nz);
+      this->m_nx.push_back(nx / length);
+      this->m_ny.push_back(ny / length);
+      this->m_nz.push_back(nz / length);
+      this->m_offset.push_back(halfspace.offset / length);
+    }
+  }
+
+  /**
+   * @brief Finds the spheres in a range that are not outside the region.
+   *
+   * @param spheres The spheres.
+   * @param begin The first sphere to test.
+   * @param end One past the last sphere to test.
+   * @param out Where to write the indices of the visible spheres, in
+   * increasing order. It needs room for end - begin indices.
+   *
+   * @returns The number of indices written.
+   */
+  std::size_t cull(const SphereSet &spheres, const std::size_t begin,
+                   const std::size_t end, std::size_t *out) const {
+    const double *x = spheres.x.data();
+    const double *y = spheres.y.data();
+    const double *z = spheres.z.data();
+    const double *r = spheres.radius.data();
+
+    double visible[detail::BATCH_CHUNK];
+    std::size_t count = 0;
+    for (std::size_t start = begin; start < end; start += detail::BATCH_CHUNK) {
+      const std::size_t m =
+          end - start < detail::BATCH_CHUNK ? end - start : detail::BATCH_CHUNK;
+      for (std::size_t i = 0; i < m; i++) {
+        visible[i] = 1;
+      }
+
+      for (std::size_t p = 0; p < this->m_offset.size(); p++) {
+        const double nx = this->m_nx[p];
+        const double ny = this->m_ny[p];
+        const double nz = this->m_nz[p];
+        const double offset = this->m_offset[p];
+        for (std::size_t i = 0; i < m; i++) {
+          const std::size_t j = start + i;
+          const double dist = nx * x[j] + ny * y[j] + nz * z[j] + offset;
+          visible[i] = dist + r[j] >= 0 ? visible[i] : 0;
+        }
+      }
+
+      count = detail::batchCompact(visible, m, start, out, count);
+    }
+
+    return count;
+  }
+
+  /**
+   * @brief Finds the boxes in a range that are not outside the region.
+   *
+   * @param boxes The boxes.
+   * @param begin The first box to test.
+   * @param end One past the last box to test.
+   * @param out Where to write the indices of the visible boxes, in
+   * increasing order. It needs room for end - begin indices.
+   *
+   * @returns The number of indices written.
+   */
+  std::size_t cull(const BoxSet &boxes, const std::size_t begin,
+                   const std::size_t end, std::size_t *out) const {
+    const double *x = boxes.x.data();
+    const double *y = boxes.y.data();
+    const double *z = boxes.z.data();
+    const double *hx = boxes.hx.data();
+    const double *hy = boxes.hy.data();
+    const double *hz = boxes.hz.data();
+
+    double visible[detail::BATCH_CHUNK];
+    std::size_t count = 0;
+    for (std::size_t start = begin; start < end; start += detail::BATCH_CHUNK) {
+      const std::size_t m =
+          end - start < detail::BATCH_CHUNK ? end - start : detail::BATCH_CHUNK;
+      for (std::size_t i = 0; i < m; i++) {
+        visible[i] = 1;
+      }
+
+      for (std::size_t p = 0; p < this->m_offset.size(); p++) {
+        const double nx = this->m_nx[p];
+        const double ny = this->m_ny[p];
+        const double nz = this->m_nz[p];
+        const double ax = std::abs(nx);
+        const double ay = std::abs(ny);
+        const double az = std::abs(nz);
+        const double offset = this->m_offset[p];
+        for (std::size_t i = 0; i < m; i++) {
+          // the box reaches this far towards the normal from its center
+          const std::size_t j = start + i;
+          const double dist = nx * x[j] + ny * y[j] + nz * z[j] + offset;
+          const double reach = ax * hx[j] + ay * hy[j] + az * hz[j];
+          visible[i] = dist + reach >= 0 ? visible[i] : 0;
+        }
+      }
+
+      count = detail::batchCompact(visible, m, start, out, count);
+    }
+
+    return count;
+  }
+
+  /**
+   * @brief Finds all spheres that are not outside the region.
+   *
+   * @param spheres The spheres.
+   *
+   * @returns The indices of the visible spheres in increasing order.
+   */
+  std::vector<std::size_t> cull(const SphereSet &spheres) const {
+    std::vector<std::size_t> result(spheres.size());
+    result.resize(this->cull(spheres, 0, spheres.size(), result.data()));
+    return result;
+  }
+
+  /**
+   * @brief Finds all boxes that are not outside the region.
+   *
+   * @param boxes The boxes.
+   *
+   * @returns The indices of the visible boxes in increasing order.
+   */
+  std::vector<std::size_t> cull(const BoxSet &boxes) const {
+    std::vector<std::size_t> result(boxes.size());
+    result.resize(this->cull(boxes, 0, boxes.size(), result.data()));
+    return result;
+  }
+
+private:
+  std::vector<double> m_nx;     //!< Unit normal x-coordinates.
+  std::vector<double> m_ny;     //!< Unit normal y-coordinates.
+  std::vector<double> m_nz;     //!< Unit normal z-coordinates.
+  std::vector<double> m_offset; //!< Offsets for the unit normals.
+};
+} // namespace svector
+
+#endif
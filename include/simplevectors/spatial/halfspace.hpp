@@ -0,0 +1,81 @@
+/**
+ * @file halfspace.hpp
+ *
+ * @brief Half-spaces, used to describe convex regions such as view frusta.
+ *
+ * A half-space is the set of points p with dot(normal, p) + offset >= 0. A
+ * frustum is the intersection of six of them, each with its normal pointing
+ * into the frustum.
+ *
+ * This file is not included in vectors.hpp, so it has to be included
+ * separately.
+ *
+ * @copyright Copyright (c) 2023 Jonathan Liu. This project is released under
+ * the MIT License. All rights reserved.
+ */
+
+#ifndef INCLUDE_SVECTOR_HALFSPACE_HPP_
+#define INCLUDE_SVECTOR_HALFSPACE_HPP_
+
+#include <cstddef> // std::size_t
+
+#include "simplevectors/core/traits.hpp" // svector::VectorTraits
+
+namespace svector {
+/**
+ * @brief A half-space of points on the positive side of a plane.
+ *
+ * @tparam V Point type.
+ */
+template <typename V> struct Halfspace {
+  V normal;      //!< Normal of the plane, pointing into the half-space.
+  double offset; //!< Offset added to the dot product with the normal.
+};
+
+/**
+ * @brief Creates the half-space in front of a plane through a point.
+ *
+ * @tparam V Point type.
+ *
+ * @param normal The normal of the plane, pointing into the half-space.
+ * @param point A point on the plane.
+ *
+ * @returns The half-space.
+ */
+template <typename V>
+Halfspace<V> makeHalfspace(const V &normal, const V &point) {
+  double offset = 0;
+  for (std::size_t i = 0; i < VectorTraits<V>::dimensions; i++) {
+    offset -= static_cast<double>(normal[i]) * static_cast<double>(point[i]);
+  }
+
+  Halfspace<V> result;
+  result.normal = normal;
+  result.offset = offset;
+  return result;
+}
+
+/**
+ * @brief Signed distance of a point from the plane of a half-space.
+ *
+ * @tparam V Point type.
+ *
+ * @param halfspace The half-space.
+ * @param point The point.
+ *
+ * @returns The dot product of the normal with the point plus the offset,
+ * which is the distance if the normal has unit length. It is not negative
+ * for points in the half-space.
+ */
+template <typename V>
+double signedDistance(const Halfspace<V> &halfspace, const V &point) {
+  double result = halfspace.offset;
+  for (std::size_t i = 0; i < VectorTraits<V>::dimensions; i++) {
+    result += static_cast<double>(halfspace.normal[i]) *
+              static_cast<double>(point[i]);
+  }
+  return result;
+}
+} // namespace svector
+
+#endif
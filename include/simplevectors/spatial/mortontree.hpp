@@ -0,0 +1,595 @@
+/**
+ * @file mortontree.hpp
+ *
+ * @brief Linear quadtrees and octrees of 2D and 3D points.
+ *
+ * Points are sorted by their Morton code, which interleaves the bits of
+ * their quantized coordinates. Every node of the tree is then a contiguous
+ * range of the sorted points whose codes share a prefix, so no nodes or
+ * pointers are stored at all: the tree is the sorted codes, ids and
+ * coordinates. Queries walk the implicit nodes and find their ranges with
+ * binary searches.
+ *
+ * Bulk building sorts once in O(n log n). Inserting and removing single
+ * points keeps the arrays sorted, which costs O(n) moves, so the tree suits
+ * data that changes rarely compared to how often it is queried.
+ *
+ * This file is not included in vectors.hpp, so it has to be included
+ * separately.
+ *
+ * @copyright Copyright (c) 2023 Jonathan Liu. This project is released under
+ * the MIT License. All rights reserved.
+ */
+
+#ifndef INCLUDE_SVECTOR_MORTONTREE_HPP_
+#define INCLUDE_SVECTOR_MORTONTREE_HPP_
+
+#include <algorithm> // std::sort, std::lower_bound, std::upper_bound
+#include <cmath>     // std::floor, std::ldexp
+#include <cstddef>   // std::size_t
+#include <cstdint>   // std::uint64_t
+#include <utility>   // std::pair
+#include <vector>    // std::vector
+
+#include "simplevectors/core/traits.hpp"       // svector::VectorTraits
+#include "simplevectors/core/vector2d.hpp"     // svector::Vector2D
+#include "simplevectors/core/vector3d.hpp"     // svector::Vector3D
+#include "simplevectors/spatial/halfspace.hpp" // svector::Halfspace
+
+namespace svector {
+/**
+ * @brief An occupied cell of a Morton tree at some level.
+ */
+struct MortonCell {
+  std::uint64_t code; //!< Morton code of the cell at its level.
+  std::size_t begin;  //!< First sorted position of the points in the cell.
+  std::size_t end;    //!< One past the last sorted position in the cell.
+};
+
+namespace detail {
+/**
+ * How a cell of a tree relates to a query region.
+ */
+enum RegionOverlap { REGION_OUTSIDE, REGION_PARTIAL, REGION_INSIDE };
+
+/**
+ * Spreads the low bits of a value so there are dims - 1 zero bits between
+ * each of them.
+ */
+inline std::uint64_t mortonSpread(std::uint64_t x, const std::size_t dims) {
+  if (dims == 2) {
+    x &= 0x7FFFFFFFULL;
+    x = (x | (x << 16)) & 0x0000FFFF0000FFFFULL;
+    x = (x | (x << 8)) & 0x00FF00FF00FF00FFULL;
+    x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    x = (x | (x << 2)) & 0x3333333333333333ULL;
+    x = (x | (x << 1)) & 0x5555555555555555ULL;
+    return x;
+  }
+
+  x &= 0x1FFFFFULL;
+  x = (x | (x << 32)) & 0x001F00000000FFFFULL;
+  x = (x | (x << 16)) & 0x001F0000FF0000FFULL;
+  x = (x | (x << 8)) & 0x100F00F00F00F00FULL;
+  x = (x | (x << 4)) & 0x10C30C30C30C30C3ULL;
+  x = (x | (x << 2)) & 0x1249249249249249ULL;
+  return x;
+}
+
+/**
+ * Axis-aligned box query region.
+ */
+template <std::size_t D> struct MortonBoxRegion {
+  double lower[D];
+  double upper[D];
+
+  RegionOverlap classify(const double *lo, const double *hi) const {
+    bool inside = true;
+    for (std::size_t k = 0; k < D; k++) {
+      if (hi[k] < this->lower[k] || lo[k] > this->upper[k]) {
+        return REGION_OUTSIDE;
+      }
+      inside = inside && lo[k] >= this->lower[k] && hi[k] <= this->upper[k];
+    }
+    return inside ? REGION_INSIDE : REGION_PARTIAL;
+  }
+
+  bool contains(const double *p) const {
+    for (std::size_t k = 0; k < D; k++) {
+      if (p[k] < this->lower[k] || p[k] > this->upper[k]) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+/**
+ * Ball query region.
+ */
+template <std::size_t D> struct MortonBallRegion {
+  double center[D];
+  double radius;
+
+  RegionOverlap classify(const double *lo, const double *hi) const {
+    double nearest = 0;
+    double farthest = 0;
+    for (std::size_t k = 0; k < D; k++) {
+      const double below = this->center[k] - lo[k];
+      const double above = hi[k] - this->center[k];
+      const double gap = below < 0 ? -below : (above < 0 ? -above : 0);
+      const double reach = below > above ? below : above;
+      nearest += gap * gap;
+      farthest += reach * reach;
+    }
+
+    const double r2 = this->radius * this->radius;
+    if (nearest > r2) {
+      return REGION_OUTSIDE;
+    }
+    return farthest <= r2 ? REGION_INSIDE : REGION_PARTIAL;
+  }
+
+  bool contains(const double *p) const {
+    double dist = 0;
+    for (std::size_t k = 0; k < D; k++) {
+      dist += (p[k] - this->center[k]) * (p[k] - this->center[k]);
+    }
+    return dist <= this->radius * this->radius;
+  }
+};
+
+/**
+ * Intersection of half-spaces as a query region, with the normals stored
+ * one row per plane.
+ */
+template <std::size_t D> struct MortonHalfspaceRegion {
+  std::vector<double> normals;
+  std::vector<double> offsets;
+
+  RegionOverlap classify(const double *lo, const double *hi) const {
+    bool inside = true;
+    for (std::size_t i = 0; i < this->offsets.size(); i++) {
+      double most = this->offsets[i];
+      double least = this->offsets[i];
+      for (std::size_t k = 0; k < D; k++) {
+        const double n = this->normals[i * D + k];
+        most += n * (n > 0 ? hi[k] : lo[k]);
+        least += n * (n > 0 ? lo[k] : hi[k]);
+      }
+      if (most < 0) {
+        return REGION_OUTSIDE;
+      }
+      inside = inside && least >= 0;
+    }
+    return inside ? REGION_INSIDE : REGION_PARTIAL;
+  }
+
+  bool contains(const double *p) const {
+    for (std::size_t i = 0; i < this->offsets.size(); i++) {
+      double dist = this->offsets[i];
+      for (std::size_t k = 0; k < D; k++) {
+        dist += this->normals[i * D + k] * p[k];
+      }
+      if (dist < 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+} // namespace detail
+
+/**
+ * @brief Linear quadtree (2D) or octree (3D) of points with ids.
+ *
+ * @tparam V 2D or 3D point type.
+ */
+template <typename V> class MortonTree {
+public:
+  /**
+   * @brief Number of dimensions of the points.
+   */
+  static constexpr std::size_t dimensions = VectorTraits<V>::dimensions;
+
+  /**
+   * @brief Number of levels below the root, which is also the number of
+   * bits each coordinate is quantized to.
+   */
+  static constexpr std::size_t levels = 63 / dimensions;
+
+  /**
+   * @brief Creates an empty tree.
+   *
+   * @param leafSize Queries test the points of nodes with at most this many
+   * points one by one instead of descending further.
+   */
+  explicit MortonTree(const std::size_t leafSize = 16)
+      : m_leafSize(leafSize), m_size(1) {
+    static_assert(VectorTraits<V>::dimensions == 2 ||
+                      VectorTraits<V>::dimensions == 3,
+                  "MortonTree requires 2D or 3D vectors");
+
+    for (std::size_t k = 0; k < dimensions; k++) {
+      this->m_lower[k] = 0;
+    }
+  }
+
+  /**
+   * @brief Builds a tree of points, with their indices as ids.
+   *
+   * @param points The points.
+   * @param leafSize Queries test the points of nodes with at most this many
+   * points one by one instead of descending further.
+   */
+  explicit MortonTree(const std::vector<V> &points,
+                      const std::size_t leafSize = 16)
+      : MortonTree(leafSize) {
+    this->build(points);
+  }
+
+  /**
+   * @brief Replaces the points of the tree, with their indices as ids.
+   *
+   * The tree is fitted to the bounding box of the points.
+   *
+   * @param points The points.
+   */
+  void build(const std::vector<V> &points) {
+    std::vector<double> coords(points.size() * dimensions);
+    std::vector<std::size_t> ids(points.size());
+    for (std::size_t i = 0; i < points.size(); i++) {
+      for (std::size_t k = 0; k < dimensions; k++) {
+        coords[i * dimensions + k] = static_cast<double>(points[i][k]);
+      }
+      ids[i] = i;
+    }
+
+    this->rebuild(coords, ids);
+  }
+
+  /**
+   * @brief Adds a point.
+   *
+   * Points outside of the bounding box of the tree cause a rebuild with a
+   * larger box.
+   *
+   * @param point The point.
+   * @param id The id returned by queries for the point.
+   */
+  void insert(const V &point, const std::size_t id) {
+    double p[dimensions];
+    bool outside = this->m_ids.empty();
+    for (std::size_t k = 0; k < dimensions; k++) {
+      p[k] = static_cast<double>(point[k]);
+      outside = outside || p[k] < this->m_lower[k] ||
+                p[k] > this->m_lower[k] + this->m_size;
+    }
+
+    if (outside) {
+      std::vector<double> coords(this->m_coords);
+      std::vector<std::size_t> ids(this->m_ids);
+      coords.insert(coords.end(), p, p + dimensions);
+      ids.push_back(id);
+      this->rebuild(coords, ids);
+      return;
+    }
+
+    const std::uint64_t code = this->encode(p);
+    const std::size_t pos = static_cast<std::size_t>(
+        std::upper_bound(this->m_codes.begin(), this->m_codes.end(), code) -
+        this->m_codes.begin());
+    this->m_codes.insert(this->m_codes.begin() + pos, code);
+    this->m_ids.insert(this->m_ids.begin() + pos, id);
+    this->m_coords.insert(this->m_coords.begin() + pos * dimensions, p,
+                          p + dimensions);
+  }
+
+  /**
+   * @brief Removes a point.
+   *
+   * @param point The point, equal to the one it was added with.
+   * @param id The id of the point.
+   *
+   * @returns Whether the point was found.
+   */
+  bool erase(const V &point, const std::size_t id) {
+    double p[dimensions];
+    for (std::size_t k = 0; k < dimensions; k++) {
+      p[k] = static_cast<double>(point[k]);
+    }
+
+    const std::uint64_t code = this->encode(p);
+    const auto range =
+        std::equal_range(this->m_codes.begin(), this->m_codes.end(), code);
+    for (auto it = range.first; it != range.second; ++it) {
+      const std::size_t pos =
+          static_cast<std::size_t>(it - this->m_codes.begin());
+      if (this->m_ids[pos] != id) {
+        continue;
+      }
+
+      this->m_codes.erase(it);
+      this->m_ids.erase(this->m_ids.begin() + pos);
+      this->m_coords.erase(this->m_coords.begin() + pos * dimensions,
+                           this->m_coords.begin() + (pos + 1) * dimensions);
+      return true;
+    }
+
+    return false;
+  }
+
+  /**
+   * @brief Number of points.
+   *
+   * @returns The number of points.
+   */
+  std::size_t size() const { return this->m_ids.size(); }
+
+  /**
+   * @brief Id of a point.
+   *
+   * @param i The position of the point in Morton order.
+   *
+   * @returns The id of the point.
+   */
+  std::size_t id(const std::size_t i) const { return this->m_ids[i]; }
+
+  /**
+   * @brief A point.
+   *
+   * @param i The position of the point in Morton order.
+   *
+   * @returns The point.
+   */
+  V point(const std::size_t i) const {
+    V result;
+    for (std::size_t k = 0; k < dimensions; k++) {
+      result[k] = static_cast<typename VectorTraits<V>::value_type>(
+          this->m_coords[i * dimensions + k]);
+    }
+    return result;
+  }
+
+  /**
+   * @brief Morton code of a point at the deepest level.
+   *
+   * @param i The position of the point in Morton order.
+   *
+   * @returns The code.
+   */
+  std::uint64_t code(const std::size_t i) const { return this->m_codes[i]; }
+
+  /**
+   * @brief Finds the points in an axis-aligned box.
+   *
+   * @param lower The corner of the box with the smallest coordinates.
+   * @param upper The corner of the box with the largest coordinates.
+   * @param out The vector to append the ids of the points to.
+   */
+  void boxQuery(const V &lower, const V &upper,
+                std::vector<std::size_t> &out) const {
+    detail::MortonBoxRegion<dimensions> region;
+    for (std::size_t k = 0; k < dimensions; k++) {
+      region.lower[k] = static_cast<double>(lower[k]);
+      region.upper[k] = static_cast<double>(upper[k]);
+    }
+    this->query(region, out);
+  }
+
+  /**
+   * @brief Finds the points within a distance of a center.
+   *
+   * @param center The center.
+   * @param radius The distance.
+   * @param out The vector to append the ids of the points to.
+   */
+  void radiusQuery(const V &center, const double radius,
+                   std::vector<std::size_t> &out) const {
+    detail::MortonBallRegion<dimensions> region;
+    for (std::size_t k = 0; k < dimensions; k++) {
+      region.center[k] = static_cast<double>(center[k]);
+    }
+    region.radius = radius;
+    this->query(region, out);
+  }
+
+  /**
+   * @brief Finds the points in all of a set of half-spaces, such as the six
+   * half-spaces of a view frustum.
+   *
+   * @param halfspaces The half-spaces.
+   * @param out The vector to append the ids of the points to.
+   */
+  void halfspaceQuery(const std::vector<Halfspace<V>> &halfspaces,
+                      std::vector<std::size_t> &out) const {
+    detail::MortonHalfspaceRegion<dimensions> region;
+    for (const Halfspace<V> &halfspace : halfspaces) {
+      for (std::size_t k = 0; k < dimensions; k++) {
+        region.normals.push_back(static_cast<double>(halfspace.normal[k]));
+      }
+      region.offsets.push_back(halfspace.offset);
+    }
+    this->query(region, out);
+  }
+
+  /**
+   * @brief The occupied cells at a level, for example to draw one
+   * representative point per cell as a level of detail.
+   *
+   * @param level The level, where 0 is the root and the cells at level l
+   * have an edge length of the root's divided by 2 to the power of l.
+   *
+   * @returns The cells in Morton order.
+   */
+  std::vector<MortonCell> cells(const std::size_t level) const {
+    const std::size_t shift =
+        dimensions * (levels - (level < levels ? level : levels));
+    std::vector<MortonCell> result;
+    for (std::size_t i = 0; i < this->m_codes.size(); i++) {
+      const std::uint64_t code = this->m_codes[i] >> shift;
+      if (result.empty() || result.back().code != code) {
+        result.push_back(MortonCell{code, i, i});
+      }
+      result.back().end = i + 1;
+    }
+    return result;
+  }
+
+private:
+  std::size_t m_leafSize;             //!< Largest node tested point by point.
+  double m_lower[dimensions];         //!< Lower corner of the root cell.
+  double m_size;                      //!< Edge length of the root cell.
+  std::vector<std::uint64_t> m_codes; //!< Sorted Morton codes.
+  std::vector<std::size_t> m_ids;     //!< Ids in Morton order.
+  std::vector<double> m_coords;       //!< Coordinates, one row per point.
+
+  /**
+   * @brief Morton code of a point in the root cell.
+   */
+  std::uint64_t encode(const double *p) const {
+    const double cells = std::ldexp(1.0, static_cast<int>(levels));
+    const double scale = cells / this->m_size;
+    std::uint64_t code = 0;
+    for (std::size_t k = 0; k < dimensions; k++) {
+      double q = std::floor((p[k] - this->m_lower[k]) * scale);
+      q = q < 0 ? 0 : (q > cells - 1 ? cells - 1 : q);
+      code |= detail::mortonSpread(static_cast<std::uint64_t>(q), dimensions)
+              << k;
+    }
+    return code;
+  }
+
+  /**
+   * @brief Fits the root cell to points and sorts them.
+   */
+  void rebuild(const std::vector<double> &coords,
+               const std::vector<std::size_t> &ids) {
+    const std::size_t n = ids.size();
+    double upper[dimensions];
+    for (std::size_t k = 0; k < dimensions; k++) {
+      this->m_lower[k] = n > 0 ? coords[k] : 0;
+      upper[k] = this->m_lower[k];
+    }
+    for (std::size_t i = 0; i < n; i++) {
+      for (std::size_t k = 0; k < dimensions; k++) {
+        const double c = coords[i * dimensions + k];
+        this->m_lower[k] = c < this->m_lower[k] ? c : this->m_lower[k];
+        upper[k] = c > upper[k] ? c : upper[k];
+      }
+    }
+
+    this->m_size = 0;
+    for (std::size_t k = 0; k < dimensions; k++) {
+      const double extent = upper[k] - this->m_lower[k];
+      this->m_size = extent > this->m_size ? extent : this->m_size;
+    }
+    this->m_size = this->m_size > 0 ? this->m_size : 1;
+
+    std::vector<std::pair<std::uint64_t, std::size_t>> order(n);
+    for (std::size_t i = 0; i < n; i++) {
+      order[i] = std::make_pair(this->encode(&coords[i * dimensions]), i);
+    }
+    std::sort(order.begin(), order.end());
+
+    this->m_codes.resize(n);
+    this->m_ids.resize(n);
+    this->m_coords.resize(n * dimensions);
+    for (std::size_t i = 0; i < n; i++) {
+      const std::size_t from = order[i].second;
+      this->m_codes[i] = order[i].first;
+      this->m_ids[i] = ids[from];
+      for (std::size_t k = 0; k < dimensions; k++) {
+        this->m_coords[i * dimensions + k] = coords[from * dimensions + k];
+      }
+    }
+  }
+
+  /**
+   * @brief Appends the ids of the points in a region.
+   */
+  template <typename R>
+  void query(const R &region, std::vector<std::size_t> &out) const {
+    if (this->m_codes.empty()) {
+      return;
+    }
+
+    std::uint64_t cell[dimensions];
+    for (std::size_t k = 0; k < dimensions; k++) {
+      cell[k] = 0;
+    }
+    this->visit(region, 0, cell, 0, 0, this->m_codes.size(), out);
+  }
+
+  /**
+   * @brief Visits a node given by its level, cell coordinates and code
+   * prefix, covering the sorted positions begin to end.
+   */
+  template <typename R>
+  void visit(const R &region, const std::size_t level,
+             const std::uint64_t *cell, const std::uint64_t prefix,
+             const std::size_t begin, const std::size_t end,
+             std::vector<std::size_t> &out) const {
+    // widen the cell a little so rounding never leaves a point outside it
+    const double size = std::ldexp(this->m_size, -static_cast<int>(level));
+    const double margin = this->m_size * 1e-12;
+    double lo[dimensions];
+    double hi[dimensions];
+    for (std::size_t k = 0; k < dimensions; k++) {
+      lo[k] = this->m_lower[k] + static_cast<double>(cell[k]) * size - margin;
+      hi[k] = lo[k] + size + 2 * margin;
+    }
+
+    const detail::RegionOverlap overlap = region.classify(lo, hi);
+    if (overlap == detail::REGION_OUTSIDE) {
+      return;
+    }
+    if (overlap == detail::REGION_INSIDE) {
+      out.insert(out.end(), this->m_ids.begin() + begin,
+                 this->m_ids.begin() + end);
+      return;
+    }
+    if (end - begin <= this->m_leafSize || level == levels) {
+      for (std::size_t i = begin; i < end; i++) {
+        if (region.contains(&this->m_coords[i * dimensions])) {
+          out.push_back(this->m_ids[i]);
+        }
+      }
+      return;
+    }
+
+    // the children split the range at the codes where their prefixes start
+    const std::size_t children = std::size_t{1} << dimensions;
+    const std::size_t shift = dimensions * (levels - level - 1);
+    std::size_t childBegin = begin;
+    for (std::size_t child = 0; child < children; child++) {
+      const std::uint64_t childPrefix = (prefix << dimensions) | child;
+      const std::size_t childEnd =
+          child + 1 == children
+              ? end
+              : static_cast<std::size_t>(
+                    std::lower_bound(this->m_codes.begin() + childBegin,
+                                     this->m_codes.begin() + end,
+                                     (childPrefix + 1) << shift) -
+                    this->m_codes.begin());
+      if (childEnd > childBegin) {
+        std::uint64_t childCell[dimensions];
+        for (std::size_t k = 0; k < dimensions; k++) {
+          childCell[k] = 2 * cell[k] + ((child >> k) & 1);
+        }
+        this->visit(region, level + 1, childCell, childPrefix, childBegin,
+                    childEnd, out);
+      }
+      childBegin = childEnd;
+    }
+  }
+};
+
+template <typename V> constexpr std::size_t MortonTree<V>::dimensions;
+template <typename V> constexpr std::size_t MortonTree<V>::levels;
+
+typedef MortonTree<Vector2D> Quadtree; //!< Quadtree of svector::Vector2D.
+typedef MortonTree<Vector3D> Octree;   //!< Octree of svector::Vector3D.
+} // namespace svector
+
+#endif
@@ -50,6 +50,7 @@ FILE_BEGIN = """/**
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <initializer_list>
 #include <string>
 #include <type_traits>
@@ -82,6 +83,9 @@ def combine():
     output_str = (
         FILE_BEGIN
         + get_sandwiched(os.path.join("include", "simplevectors", "core", "units.hpp"))
+        + get_sandwiched(
+            os.path.join("include", "simplevectors", "core", "mathpolicy.hpp")
+        )
         + get_sandwiched(os.path.join("include", "simplevectors", "core", "vector.hpp"))
         + get_sandwiched(
             os.path.join("include", "simplevectors", "core", "vector2d.hpp")
@@ -0,0 +1,133 @@
+#include "simplevectors/math/angles.hpp"
+#include "simplevectors/vectors.hpp"
+
+#include <gtest/gtest.h>
+
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <random>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+double round3(const double num) { return std::round(num * 1000) / 1000; }
+} // namespace
+
+TEST(AnglesTest, DirectionCosines) {
+  const svector::Vector3D vector(-3, 2, -6);
+  const svector::Vector3D cosines = vector.directionCosines();
+  EXPECT_EQ(round3(cosines.x()), round3(-3 / 7.0));
+  EXPECT_EQ(round3(cosines.y()), round3(2 / 7.0));
+  EXPECT_EQ(round3(cosines.z()), round3(-6 / 7.0));
+  EXPECT_EQ(std::acos(cosines.x()), vector.angle<svector::ALPHA>());
+  EXPECT_EQ(std::acos(cosines.z()), vector.angle<svector::GAMMA>());
+}
+
+TEST(AnglesTest, Scalar) {
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<double> dist(-2, 2);
+  for (int i = 0; i < 10000; i++) {
+    const double x = dist(gen);
+    const double y = dist(gen);
+    const double c = x / 2;
+    const double angle = std::atan2(y, x);
+    ASSERT_EQ(svector::arctan2(y, x), angle);
+    ASSERT_LT(std::abs(svector::arctan2<svector::ANGLE_PRECISE>(y, x) - angle),
+              1e-15);
+    ASSERT_LT(std::abs(svector::arctan2<svector::ANGLE_FAST>(y, x) - angle),
+              1e-4);
+    ASSERT_LT(std::abs(svector::arccos<svector::ANGLE_PRECISE>(c) -
+                       std::acos(c)),
+              1e-15);
+    ASSERT_LT(std::abs(svector::arccos<svector::ANGLE_FAST>(c) - std::acos(c)),
+              1e-4);
+  }
+
+  // axes and signed zeros behave like std::atan2
+  const double ys[8] = {0, 0, 1, -1, 0, -0.0, 1, -1};
+  const double xs[8] = {1, -1, 0, 0, 0, -1, 1, -1};
+  for (int i = 0; i < 8; i++) {
+    EXPECT_EQ(round3(svector::arctan2<svector::ANGLE_PRECISE>(ys[i], xs[i])),
+              round3(std::atan2(ys[i], xs[i])));
+    EXPECT_EQ(round3(svector::arctan2<svector::ANGLE_FAST>(ys[i], xs[i])),
+              round3(std::atan2(ys[i], xs[i])));
+  }
+
+  // cosines rounded past ±1
+  EXPECT_EQ(svector::arccos<svector::ANGLE_PRECISE>(1 + 1e-16), 0);
+  EXPECT_EQ(round3(svector::arccos<svector::ANGLE_FAST>(-1 - 1e-16)),
+            round3(M_PI));
+}
+
+TEST(AnglesTest, Batch2D) {
+  std::vector<svector::Vector2D> vectors;
+  std::vector<double> xs;
+  std::vector<double> ys;
+  std::mt19937 gen(2);
+  std::uniform_real_distribution<double> dist(-1, 1);
+  for (int i = 0; i < 101; i++) {
+    vectors.push_back(svector::Vector2D(dist(gen), dist(gen)));
+    xs.push_back(vectors.back().x());
+    ys.push_back(vectors.back().y());
+  }
+
+  std::vector<double> exact(101);
+  std::vector<double> fromVectors(101);
+  std::vector<double> fast(101);
+  svector::angles(xs.data(), ys.data(), exact.data(), 101);
+  svector::angles(vectors.data(), fromVectors.data(), 101);
+  svector::angles<svector::ANGLE_FAST>(vectors.data(), fast.data(), 101);
+  for (std::size_t i = 0; i < 101; i++) {
+    EXPECT_EQ(exact[i], vectors[i].angle());
+    EXPECT_EQ(fromVectors[i], vectors[i].angle());
+    EXPECT_LT(std::abs(fast[i] - vectors[i].angle()), 1e-4);
+  }
+}
+
+TEST(AnglesTest, Batch3D) {
+  std::vector<svector::Vector3D> vectors;
+  std::vector<double> xs;
+  std::vector<double> ys;
+  std::vector<double> zs;
+  std::mt19937 gen(3);
+  std::uniform_real_distribution<double> dist(-1, 1);
+  for (int i = 0; i < 101; i++) {
+    vectors.push_back(svector::Vector3D(dist(gen), dist(gen), dist(gen)));
+    xs.push_back(vectors.back().x());
+    ys.push_back(vectors.back().y());
+    zs.push_back(vectors.back().z());
+  }
+
+  std::vector<double> alphas(101);
+  std::vector<double> betas(101);
+  std::vector<double> gammas(101);
+  svector::angles(vectors.data(), alphas.data(), betas.data(), gammas.data(),
+                  101);
+  for (std::size_t i = 0; i < 101; i++) {
+    EXPECT_EQ(alphas[i], vectors[i].angle<svector::ALPHA>());
+    EXPECT_EQ(betas[i], vectors[i].angle<svector::BETA>());
+    EXPECT_EQ(gammas[i], vectors[i].angle<svector::GAMMA>());
+  }
+
+  svector::angles<svector::ANGLE_PRECISE>(xs.data(), ys.data(), zs.data(),
+                                          alphas.data(), betas.data(),
+                                          gammas.data(), 101);
+  for (std::size_t i = 0; i < 101; i++) {
+    EXPECT_LT(std::abs(alphas[i] - vectors[i].angle<svector::ALPHA>()),
+              1e-14);
+    EXPECT_LT(std::abs(betas[i] - vectors[i].angle<svector::BETA>()), 1e-14);
+    EXPECT_LT(std::abs(gammas[i] - vectors[i].angle<svector::GAMMA>()),
+              1e-14);
+  }
+
+  svector::angles<svector::ANGLE_FAST>(xs.data(), ys.data(), zs.data(),
+                                       alphas.data(), betas.data(),
+                                       gammas.data(), 101);
+  for (std::size_t i = 0; i < 101; i++) {
+    EXPECT_LT(std::abs(alphas[i] - vectors[i].angle<svector::ALPHA>()), 1e-4);
+    EXPECT_LT(std::abs(gammas[i] - vectors[i].angle<svector::GAMMA>()), 1e-4);
+  }
+}
@@ -208,3 +208,18 @@ TEST(IsZeroTestV, IsZeroTestZeroDimensionVector) {
   svector::Vector<0> v;
   EXPECT_TRUE(v.isZero());
 }
+
+TEST(MagnitudeTestV, SquaredMagnitudeAndDistance) {
+  svector::Vector<4> v{1, 2, 2, 4};
+  EXPECT_EQ(v.magnSquared(), 25);
+  EXPECT_EQ(v.magn(), 5);
+
+  svector::Vector<4> w{1, 5, 6, 4};
+  EXPECT_EQ(v.distanceSquared(w), 25);
+  EXPECT_EQ(v.distance(w), 5);
+  EXPECT_EQ(w.distance(v), 5);
+
+  svector::Vector<2, int> i{3, 4};
+  EXPECT_EQ(i.magnSquared(), 25);
+  EXPECT_EQ(i.distanceSquared(svector::Vector<2, int>{0, 0}), 25);
+}
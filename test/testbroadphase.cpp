@@ -0,0 +1,127 @@
+#include "simplevectors/collision/broadphase.hpp"
+#include "simplevectors/vectors.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace {
+typedef std::vector<std::pair<std::size_t, std::size_t>> Pairs;
+
+template <typename V>
+Pairs bruteForce(const std::vector<V> &lowers, const std::vector<V> &uppers) {
+  Pairs result;
+  for (std::size_t i = 0; i < lowers.size(); i++) {
+    for (std::size_t j = i + 1; j < lowers.size(); j++) {
+      bool overlap = true;
+      for (std::size_t k = 0; k < lowers[i].numDimensions(); k++) {
+        overlap = overlap && lowers[i][k] <= uppers[j][k] &&
+                  lowers[j][k] <= uppers[i][k];
+      }
+      if (overlap) {
+        result.push_back(std::make_pair(i, j));
+      }
+    }
+  }
+  return result;
+}
+} // namespace
+
+TEST(BroadphaseTest, Simple) {
+  std::vector<svector::Vector3D> lowers{svector::Vector3D(0, 0, 0),
+                                        svector::Vector3D(1, 1, 1),
+                                        svector::Vector3D(2, 0, 0),
+                                        svector::Vector3D(5, 5, 5)};
+  std::vector<svector::Vector3D> uppers{svector::Vector3D(1, 1, 1),
+                                        svector::Vector3D(3, 2, 2),
+                                        svector::Vector3D(3, 1, 1),
+                                        svector::Vector3D(6, 6, 6)};
+
+  // boxes 0 and 1 touch at a corner
+  Pairs res{{0, 1}, {1, 2}};
+  EXPECT_EQ(svector::overlappingBoxes(lowers, uppers), res);
+
+  svector::SweepAndPrune<svector::Vector3D> sap;
+  for (std::size_t i = 0; i < lowers.size(); i++) {
+    EXPECT_EQ(sap.insert(lowers[i], uppers[i]), i);
+  }
+  EXPECT_EQ(Pairs(sap.update().begin(), sap.update().end()), res);
+
+  // move box 3 onto box 0 and remove box 1
+  sap.move(3, svector::Vector3D(0.5, 0.5, 0.5),
+           svector::Vector3D(1.5, 1.5, 1.5));
+  sap.erase(1);
+  sap.update();
+  Pairs moved{{0, 3}};
+  EXPECT_EQ(Pairs(sap.pairs().begin(), sap.pairs().end()), moved);
+
+  // the id of the removed box is reused
+  EXPECT_EQ(sap.insert(svector::Vector3D(2.5, 0, 0),
+                       svector::Vector3D(4, 1, 1)),
+            1u);
+  sap.update();
+  Pairs added{{0, 3}, {1, 2}};
+  EXPECT_EQ(Pairs(sap.pairs().begin(), sap.pairs().end()), added);
+}
+
+TEST(BroadphaseTest, MovingBoxes) {
+  std::mt19937 gen(6);
+  std::uniform_real_distribution<double> pos(0, 20);
+  std::uniform_real_distribution<double> size(0.2, 2);
+  std::uniform_real_distribution<double> step(-0.3, 0.3);
+
+  const std::size_t n = 300;
+  std::vector<svector::Vector3D> lowers;
+  std::vector<svector::Vector3D> sizes;
+  std::vector<svector::Vector3D> uppers;
+  svector::SweepAndPrune<svector::Vector3D> sap;
+  for (std::size_t i = 0; i < n; i++) {
+    lowers.push_back(svector::Vector3D(pos(gen), pos(gen), pos(gen)));
+    sizes.push_back(svector::Vector3D(size(gen), size(gen), size(gen)));
+    uppers.push_back(lowers[i] + sizes[i]);
+    sap.insert(lowers[i], uppers[i]);
+  }
+
+  for (int frame = 0; frame < 30; frame++) {
+    for (std::size_t i = 0; i < n; i++) {
+      lowers[i] += svector::Vector3D(step(gen), step(gen), step(gen));
+      uppers[i] = lowers[i] + sizes[i];
+      sap.move(i, lowers[i], uppers[i]);
+    }
+
+    Pairs res = bruteForce(lowers, uppers);
+    sap.update();
+    EXPECT_EQ(Pairs(sap.pairs().begin(), sap.pairs().end()), res);
+    EXPECT_EQ(svector::overlappingBoxes(lowers, uppers), res);
+  }
+}
+
+TEST(BroadphaseTest, SweepRanges) {
+  std::mt19937 gen(2);
+  std::uniform_real_distribution<double> pos(0, 10);
+  std::uniform_real_distribution<double> size(0, 1);
+
+  // 2D boxes on integer coordinates, so many of them touch
+  std::vector<svector::Vector2D> lowers;
+  std::vector<svector::Vector2D> uppers;
+  for (int i = 0; i < 500; i++) {
+    const svector::Vector2D lower(std::floor(pos(gen)), std::floor(pos(gen)));
+    lowers.push_back(lower);
+    uppers.push_back(lower + svector::Vector2D(std::round(size(gen)), 0.5));
+  }
+
+  svector::BoxSweep<svector::Vector2D> sweep(lowers, uppers);
+  Pairs chunked;
+  for (std::size_t begin = 0; begin < sweep.size(); begin += 64) {
+    sweep.pairs(begin, std::min(begin + 64, sweep.size()), chunked);
+  }
+  std::sort(chunked.begin(), chunked.end());
+
+  Pairs res = bruteForce(lowers, uppers);
+  EXPECT_EQ(chunked, res);
+  EXPECT_EQ(sweep.pairs(), res);
+}
@@ -0,0 +1,139 @@
+#include "simplevectors/physics/cloth.hpp"
+#include "simplevectors/vectors.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <set>
+#include <vector>
+
+namespace {
+double round3(const double num) { return std::round(num * 1000) / 1000; }
+
+double distance(const svector::Cloth &cloth, const std::size_t a,
+                const std::size_t b) {
+  const svector::Vector3D pa = cloth.position(a);
+  const svector::Vector3D pb = cloth.position(b);
+  return svector::Vector3D(pb.x() - pa.x(), pb.y() - pa.y(), pb.z() - pa.z())
+      .magn();
+}
+} // namespace
+
+TEST(ClothTest, Grid) {
+  svector::Cloth cloth = svector::clothGrid(
+      svector::Vector3D(0, 0, 0), svector::Vector3D(1, 0, 0),
+      svector::Vector3D(0, 0, 1), 3, 3, 9);
+  EXPECT_EQ(cloth.size(), 9u);
+  EXPECT_EQ(cloth.inverseMass(4), 1);
+  EXPECT_EQ(cloth.position(5).x(), 2);
+  EXPECT_EQ(cloth.position(5).z(), 1);
+
+  // 6 rows and columns, 8 diagonals, 6 bending constraints
+  EXPECT_EQ(cloth.constraints(), 26u);
+}
+
+TEST(ClothTest, Coloring) {
+  svector::Cloth cloth = svector::clothGrid(
+      svector::Vector3D(0, 0, 0), svector::Vector3D(1, 0, 0),
+      svector::Vector3D(0, 0, 1), 20, 15, 1);
+  cloth.step(0.01);
+
+  // every constraint has exactly one color, and the constraints of a color
+  // share no particles
+  std::size_t total = 0;
+  for (std::size_t c = 0; c < cloth.colors(); c++) {
+    EXPECT_GT(cloth.colorSize(c), 0u);
+    std::set<std::size_t> particles;
+    for (std::size_t k = 0; k < cloth.colorSize(c); k++) {
+      const std::pair<std::size_t, std::size_t> ends = cloth.constraint(c, k);
+      EXPECT_TRUE(particles.insert(ends.first).second);
+      EXPECT_TRUE(particles.insert(ends.second).second);
+    }
+    total += cloth.colorSize(c);
+  }
+  EXPECT_EQ(total, cloth.constraints());
+
+  // a particle in the middle has 12 constraints
+  EXPECT_GE(cloth.colors(), 12u);
+  EXPECT_LE(cloth.colors(), 16u);
+}
+
+TEST(ClothTest, FreeFall) {
+  svector::Cloth cloth = svector::clothGrid(
+      svector::Vector3D(0, 10, 0), svector::Vector3D(0.1, 0, 0),
+      svector::Vector3D(0, 0, 0.1), 5, 5, 1);
+  for (int i = 0; i < 60; i++) {
+    cloth.step(1.0 / 60);
+  }
+
+  // the constraints do not change how the cloth falls as a whole
+  for (std::size_t i = 0; i < cloth.size(); i++) {
+    EXPECT_EQ(round3(cloth.velocity(i).y()), -9.81);
+    EXPECT_EQ(round3(cloth.velocity(i).x()), 0);
+  }
+  EXPECT_EQ(round3(distance(cloth, 0, 24)), round3(std::sqrt(0.32)));
+}
+
+TEST(ClothTest, Pendulum) {
+  svector::Cloth cloth;
+  const std::size_t pivot = cloth.add(svector::Vector3D(0, 0, 0), 0);
+  const std::size_t bob = cloth.add(svector::Vector3D(1, 0, 0), 1);
+  cloth.addDistance(pivot, bob);
+
+  double lowest = 0;
+  for (int i = 0; i < 120; i++) {
+    cloth.step(1.0 / 60);
+    EXPECT_EQ(round3(distance(cloth, pivot, bob)), 1);
+    lowest = cloth.position(bob).y() < lowest ? cloth.position(bob).y()
+                                              : lowest;
+  }
+
+  EXPECT_EQ(cloth.position(pivot).magn(), 0);
+  EXPECT_LT(lowest, -0.99);
+}
+
+TEST(ClothTest, Spring) {
+  // a mass of 2 hanging from a constraint with compliance 0.01 stretches it
+  // by 2 * 9.81 * 0.01, like a spring with stiffness 100
+  svector::Cloth cloth;
+  const std::size_t top = cloth.add(svector::Vector3D(0, 0, 0), 0);
+  const std::size_t bottom = cloth.add(svector::Vector3D(0, -1, 0), 0.5);
+  cloth.addDistance(top, bottom, 0.01);
+  cloth.damping(5);
+
+  for (int i = 0; i < 600; i++) {
+    cloth.step(1.0 / 60);
+  }
+  EXPECT_EQ(round3(cloth.position(bottom).y()), round3(-1 - 0.1962));
+}
+
+TEST(ClothTest, Hanging) {
+  const std::size_t columns = 30;
+  const std::size_t rows = 20;
+  svector::Cloth cloth = svector::clothGrid(
+      svector::Vector3D(0, 0, 0), svector::Vector3D(0.05, 0, 0),
+      svector::Vector3D(0, 0, 0.05), columns, rows, 0.5);
+  for (std::size_t c = 0; c < columns; c++) {
+    cloth.inverseMass(c, 0);
+  }
+  cloth.damping(3);
+
+  for (int i = 0; i < 300; i++) {
+    cloth.step(1.0 / 60);
+  }
+
+  // the cloth hangs down from the pinned row without stretching much
+  for (std::size_t c = 0; c < columns; c++) {
+    EXPECT_EQ(cloth.position(c).y(), 0);
+    EXPECT_EQ(cloth.position(c).z(), 0);
+  }
+  for (std::size_t r = 0; r + 1 < rows; r++) {
+    for (std::size_t c = 0; c + 1 < columns; c++) {
+      const std::size_t i = r * columns + c;
+      EXPECT_LT(std::abs(distance(cloth, i, i + 1) - 0.05), 0.005);
+      EXPECT_LT(std::abs(distance(cloth, i, i + columns) - 0.05), 0.005);
+    }
+  }
+  EXPECT_LT(cloth.position((rows - 1) * columns).y(), -0.9);
+  EXPECT_LT(cloth.velocity((rows - 1) * columns).magn(), 0.1);
+}
@@ -0,0 +1,169 @@
+#include "simplevectors/math/coordinates.hpp"
+#include "simplevectors/vectors.hpp"
+
+#include <gtest/gtest.h>
+
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <random>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+double round3(const double num) { return std::round(num * 1000) / 1000; }
+} // namespace
+
+TEST(CoordinatesTest, SinCos) {
+  for (double ang = -1000; ang < 1000; ang += 0.37) {
+    double sine;
+    double cosine;
+    svector::sinCos<svector::ANGLE_PRECISE>(ang, sine, cosine);
+    ASSERT_LT(std::abs(sine - std::sin(ang)), 1e-15);
+    ASSERT_LT(std::abs(cosine - std::cos(ang)), 1e-15);
+
+    svector::sinCos<svector::ANGLE_FAST>(ang, sine, cosine);
+    ASSERT_LT(std::abs(sine - std::sin(ang)), 2e-7);
+    ASSERT_LT(std::abs(cosine - std::cos(ang)), 2e-7);
+
+    svector::sinCos(ang, sine, cosine);
+    ASSERT_EQ(sine, std::sin(ang));
+  }
+
+  // the quadrants
+  double sine;
+  double cosine;
+  svector::sinCos<svector::ANGLE_PRECISE>(M_PI, sine, cosine);
+  EXPECT_LT(std::abs(sine), 1e-15);
+  EXPECT_EQ(cosine, -1);
+  svector::sinCos<svector::ANGLE_PRECISE>(-M_PI / 2, sine, cosine);
+  EXPECT_EQ(sine, -1);
+  EXPECT_LT(std::abs(cosine), 1e-15);
+
+  // large angles, past the range of an int
+  for (double ang = 1e5; std::abs(ang) < 1e16; ang *= -3.7) {
+    svector::sinCos<svector::ANGLE_PRECISE>(ang, sine, cosine);
+    ASSERT_LT(std::abs(sine - std::sin(ang)), 1e-10);
+    ASSERT_LT(std::abs(cosine - std::cos(ang)), 1e-10);
+  }
+}
+
+TEST(CoordinatesTest, Polar) {
+  const std::vector<svector::Vector2D> points{
+      svector::Vector2D(3, 4), svector::Vector2D(-1, 1),
+      svector::Vector2D(0, -2), svector::Vector2D(0, 0)};
+  std::vector<double> radii(4);
+  std::vector<double> angles(4);
+  svector::toPolar(points.data(), radii.data(), angles.data(), 4);
+  EXPECT_EQ(radii[0], 5);
+  EXPECT_EQ(round3(angles[1]), round3(3 * M_PI / 4));
+  EXPECT_EQ(radii[2], 2);
+  EXPECT_EQ(round3(angles[2]), round3(-M_PI / 2));
+  EXPECT_EQ(radii[3], 0);
+  EXPECT_EQ(angles[3], 0);
+
+  std::vector<svector::Vector2D> back(4);
+  svector::fromPolar(radii.data(), angles.data(), back.data(), 4);
+  for (std::size_t i = 0; i < 4; i++) {
+    EXPECT_LT((back[i] - points[i]).magn(), 1e-15);
+  }
+}
+
+TEST(CoordinatesTest, Spherical) {
+  const std::vector<svector::Vector3D> points{
+      svector::Vector3D(1, 0, 0), svector::Vector3D(0, 2, 0),
+      svector::Vector3D(0, 0, -3), svector::Vector3D(1, 1, std::sqrt(2))};
+  std::vector<double> ranges(4);
+  std::vector<double> azimuths(4);
+  std::vector<double> elevations(4);
+  svector::toSpherical(points.data(), ranges.data(), azimuths.data(),
+                       elevations.data(), 4);
+  EXPECT_EQ(ranges[0], 1);
+  EXPECT_EQ(azimuths[0], 0);
+  EXPECT_EQ(elevations[0], 0);
+  EXPECT_EQ(round3(azimuths[1]), round3(M_PI / 2));
+  EXPECT_EQ(ranges[2], 3);
+  EXPECT_EQ(round3(elevations[2]), round3(-M_PI / 2));
+  EXPECT_EQ(round3(ranges[3]), 2);
+  EXPECT_EQ(round3(azimuths[3]), round3(M_PI / 4));
+  EXPECT_EQ(round3(elevations[3]), round3(M_PI / 4));
+
+  std::vector<svector::Vector3D> back(4);
+  svector::fromSpherical(ranges.data(), azimuths.data(), elevations.data(),
+                         back.data(), 4);
+  for (std::size_t i = 0; i < 4; i++) {
+    EXPECT_LT((back[i] - points[i]).magn(), 1e-15);
+  }
+}
+
+TEST(CoordinatesTest, Cylindrical) {
+  const std::vector<svector::Vector3D> points{svector::Vector3D(3, 4, 7),
+                                              svector::Vector3D(-2, 0, -1)};
+  std::vector<double> radii(2);
+  std::vector<double> angles(2);
+  std::vector<double> heights(2);
+  svector::toCylindrical(points.data(), radii.data(), angles.data(),
+                         heights.data(), 2);
+  EXPECT_EQ(radii[0], 5);
+  EXPECT_EQ(heights[0], 7);
+  EXPECT_EQ(round3(angles[1]), round3(M_PI));
+
+  std::vector<svector::Vector3D> back(2);
+  svector::fromCylindrical(radii.data(), angles.data(), heights.data(),
+                           back.data(), 2);
+  for (std::size_t i = 0; i < 2; i++) {
+    EXPECT_LT((back[i] - points[i]).magn(), 1e-15);
+  }
+}
+
+TEST(CoordinatesTest, Batch) {
+  // a scan of many returns round trips with every accuracy
+  std::mt19937 gen(5);
+  std::uniform_real_distribution<double> dist(-50, 50);
+  const std::size_t n = 1000;
+  std::vector<double> xs(n), ys(n), zs(n);
+  for (std::size_t i = 0; i < n; i++) {
+    xs[i] = dist(gen);
+    ys[i] = dist(gen);
+    zs[i] = dist(gen);
+  }
+
+  std::vector<double> ranges(n), azimuths(n), elevations(n);
+  std::vector<double> bx(n), by(n), bz(n);
+  svector::toSpherical<svector::ANGLE_PRECISE>(
+      xs.data(), ys.data(), zs.data(), ranges.data(), azimuths.data(),
+      elevations.data(), n);
+  svector::fromSpherical<svector::ANGLE_PRECISE>(
+      ranges.data(), azimuths.data(), elevations.data(), bx.data(), by.data(),
+      bz.data(), n);
+  for (std::size_t i = 0; i < n; i++) {
+    ASSERT_LT(std::abs(bx[i] - xs[i]), 1e-13);
+    ASSERT_LT(std::abs(by[i] - ys[i]), 1e-13);
+    ASSERT_LT(std::abs(bz[i] - zs[i]), 1e-13);
+  }
+
+  svector::toSpherical<svector::ANGLE_FAST>(xs.data(), ys.data(), zs.data(),
+                                            ranges.data(), azimuths.data(),
+                                            elevations.data(), n);
+  svector::fromSpherical<svector::ANGLE_FAST>(
+      ranges.data(), azimuths.data(), elevations.data(), bx.data(), by.data(),
+      bz.data(), n);
+  for (std::size_t i = 0; i < n; i++) {
+    // the angles are within about 1e-4 radians
+    ASSERT_LT(std::abs(bx[i] - xs[i]), 2e-4 * ranges[i]);
+    ASSERT_LT(std::abs(bz[i] - zs[i]), 2e-4 * ranges[i]);
+  }
+
+  std::vector<double> radii(n), angles(n);
+  svector::toCylindrical<svector::ANGLE_PRECISE>(xs.data(), ys.data(),
+                                                 radii.data(), angles.data(),
+                                                 n);
+  svector::fromCylindrical<svector::ANGLE_PRECISE>(
+      radii.data(), angles.data(), bx.data(), by.data(), n);
+  for (std::size_t i = 0; i < n; i++) {
+    ASSERT_LT(std::abs(bx[i] - xs[i]), 1e-13);
+    ASSERT_LT(std::abs(by[i] - ys[i]), 1e-13);
+  }
+}
@@ -0,0 +1,117 @@
+#include "simplevectors/spatial/culling.hpp"
+#include "simplevectors/vectors.hpp"
+
+#include <gtest/gtest.h>
+
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <random>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+double round3(const double num) { return std::round(num * 1000) / 1000; }
+} // namespace
+
+TEST(CullingTest, ViewFrustum) {
+  // looking down -z with a 90 degree field of view
+  std::vector<svector::Halfspace<svector::Vector3D>> planes =
+      svector::viewFrustum(svector::Vector3D(0, 0, 0),
+                           svector::Vector3D(0, 0, -1),
+                           svector::Vector3D(0, 1, 0), M_PI / 2, 2, 1, 10);
+  ASSERT_EQ(planes.size(), 6u);
+
+  const auto inside = [&planes](const svector::Vector3D &p) {
+    for (const auto &plane : planes) {
+      if (svector::signedDistance(plane, p) < 0) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  EXPECT_TRUE(inside(svector::Vector3D(0, 0, -5)));
+  EXPECT_FALSE(inside(svector::Vector3D(0, 0, -0.5)));
+  EXPECT_FALSE(inside(svector::Vector3D(0, 0, -11)));
+  EXPECT_FALSE(inside(svector::Vector3D(0, 0, 5)));
+
+  // the view is twice as wide as it is high
+  EXPECT_TRUE(inside(svector::Vector3D(9, 0, -5)));
+  EXPECT_FALSE(inside(svector::Vector3D(11, 0, -5)));
+  EXPECT_TRUE(inside(svector::Vector3D(0, 4, -5)));
+  EXPECT_FALSE(inside(svector::Vector3D(0, 6, -5)));
+
+  EXPECT_EQ(round3(svector::signedDistance(planes[0],
+                                           svector::Vector3D(0, 0, -3))),
+            2);
+}
+
+TEST(CullingTest, SpheresAndBoxes) {
+  std::vector<svector::Halfspace<svector::Vector3D>> planes =
+      svector::viewFrustum(svector::Vector3D(0, 0, 0),
+                           svector::Vector3D(0, 0, -1),
+                           svector::Vector3D(0, 1, 0), M_PI / 2, 1, 1, 10);
+  svector::CullRegion region(planes);
+
+  svector::SphereSet spheres;
+  spheres.add(svector::Vector3D(0, 0, -5), 1);   // inside
+  spheres.add(svector::Vector3D(0, 0, 5), 1);    // behind
+  spheres.add(svector::Vector3D(0, 0, -0.5), 1); // crosses the near plane
+  spheres.add(svector::Vector3D(7, 0, -5), 1);   // right of the view
+  spheres.add(svector::Vector3D(5.5, 0, -5), 1); // crosses the right plane
+  std::vector<std::size_t> res{0, 2, 4};
+  EXPECT_EQ(region.cull(spheres), res);
+
+  svector::BoxSet boxes;
+  boxes.add(svector::Vector3D(-1, -1, -6), svector::Vector3D(1, 1, -4));
+  boxes.add(svector::Vector3D(-1, -1, 4), svector::Vector3D(1, 1, 6));
+  boxes.add(svector::Vector3D(5.5, -1, -6), svector::Vector3D(6.5, 1, -4));
+  boxes.add(svector::Vector3D(6.5, -1, -6), svector::Vector3D(7.5, 1, -4));
+  std::vector<std::size_t> boxRes{0, 2};
+  EXPECT_EQ(region.cull(boxes), boxRes);
+}
+
+TEST(CullingTest, ChunksMatchSingle) {
+  std::mt19937 gen(12);
+  std::uniform_real_distribution<double> pos(-20, 20);
+  std::uniform_real_distribution<double> size(0, 2);
+
+  std::vector<svector::Halfspace<svector::Vector3D>> planes =
+      svector::viewFrustum(svector::Vector3D(1, 2, 3),
+                           svector::Vector3D(1, -0.5, -1),
+                           svector::Vector3D(0, 1, 0), 1.0, 1.5, 0.5, 25);
+  svector::CullRegion region(planes);
+
+  svector::SphereSet spheres;
+  for (int i = 0; i < 2000; i++) {
+    spheres.add(svector::Vector3D(pos(gen), pos(gen), pos(gen)), size(gen));
+  }
+
+  std::vector<std::size_t> expected;
+  for (std::size_t i = 0; i < spheres.size(); i++) {
+    const svector::Vector3D c(spheres.x[i], spheres.y[i], spheres.z[i]);
+    bool visible = true;
+    for (const auto &plane : planes) {
+      visible = visible &&
+                svector::signedDistance(plane, c) >= -spheres.radius[i];
+    }
+    if (visible) {
+      expected.push_back(i);
+    }
+  }
+  EXPECT_FALSE(expected.empty());
+  EXPECT_EQ(region.cull(spheres), expected);
+
+  // ranges that do not line up with the chunks
+  std::vector<std::size_t> joined;
+  std::vector<std::size_t> buffer(spheres.size());
+  for (std::size_t begin = 0; begin < spheres.size(); begin += 300) {
+    const std::size_t end = std::min(begin + 300, spheres.size());
+    const std::size_t count = region.cull(spheres, begin, end, buffer.data());
+    joined.insert(joined.end(), buffer.begin(), buffer.begin() + count);
+  }
+  EXPECT_EQ(joined, expected);
+}
@@ -0,0 +1,197 @@
+#include "simplevectors/interp/curves.hpp"
+#include "simplevectors/vectors.hpp"
+
+#include <gtest/gtest.h>
+
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+double round3(const double num) { return std::round(num * 1000) / 1000; }
+} // namespace
+
+TEST(LerpTest, SingleAndBatch) {
+  svector::Vector<3> a{0, 2, 4};
+  svector::Vector<3> b{4, 2, 0};
+  svector::Vector<3> res{1, 2, 3};
+  EXPECT_EQ(svector::lerp(a, b, 0.25), res);
+
+  std::vector<svector::Vector<3>> as{a, b};
+  std::vector<svector::Vector<3>> bs{b, a};
+  std::vector<svector::Vector<3>> out(2);
+  svector::lerp(as.data(), bs.data(), 2, 0.25, out.data());
+  EXPECT_EQ(out[0], res);
+  svector::Vector<3> res2{3, 2, 1};
+  EXPECT_EQ(out[1], res2);
+}
+
+TEST(LerpTest, NlerpIsUnit) {
+  svector::Vector<2> a{1, 0};
+  svector::Vector<2> b{0, 1};
+  svector::Vector<2> mid = svector::nlerp(a, b, 0.5);
+  EXPECT_EQ(round3(mid.magn()), 1);
+  EXPECT_EQ(round3(mid[0]), round3(mid[1]));
+
+  std::vector<svector::Vector<2>> out(1);
+  svector::nlerp(&a, &b, 1, 0.3, out.data());
+  EXPECT_EQ(round3(out[0].magn()), 1);
+}
+
+TEST(LerpTest, SlerpConstantAngle) {
+  svector::Vector<3> a{1, 0, 0};
+  svector::Vector<3> b{0, 0, 1};
+
+  for (double t = 0; t <= 1; t += 0.125) {
+    svector::Vector<3> v = svector::slerp(a, b, t);
+    EXPECT_EQ(round3(v[0]), round3(std::cos(t * M_PI / 2)));
+    EXPECT_EQ(round3(v[2]), round3(std::sin(t * M_PI / 2)));
+  }
+
+  std::vector<svector::Vector<3>> out(1);
+  svector::slerp(&a, &b, 1, 0.5, out.data());
+  EXPECT_EQ(round3(out[0][0]), round3(std::cos(M_PI / 4)));
+
+  // parallel vectors
+  svector::Vector<3> same = svector::slerp(a, a, 0.5);
+  EXPECT_EQ(same, a);
+}
+
+TEST(LerpTest, BatchVectorClasses) {
+  // the batch kernels index arrays of the vector classes directly
+  const std::vector<svector::Vector3D> as{svector::Vector3D(1, 0, 0),
+                                          svector::Vector3D(0, 2, 0),
+                                          svector::Vector3D(0, 0, 3)};
+  const std::vector<svector::Vector3D> bs{svector::Vector3D(0, 1, 0),
+                                          svector::Vector3D(0, 0, 2),
+                                          svector::Vector3D(3, 0, 0)};
+  std::vector<svector::Vector3D> out(3);
+
+  svector::lerp(as.data(), bs.data(), 3, 0.25, out.data());
+  for (std::size_t k = 0; k < 3; k++) {
+    EXPECT_EQ(out[k], svector::lerp(as[k], bs[k], 0.25));
+  }
+
+  svector::nlerp(as.data(), bs.data(), 3, 0.25, out.data());
+  for (std::size_t k = 0; k < 3; k++) {
+    EXPECT_EQ(out[k], svector::nlerp(as[k], bs[k], 0.25));
+  }
+
+  const std::vector<svector::Vector3D> units{svector::Vector3D(1, 0, 0),
+                                             svector::Vector3D(0, 1, 0),
+                                             svector::Vector3D(0, 0, 1)};
+  svector::slerp(units.data(), units.data() + 1, 2, 0.5, out.data());
+  EXPECT_EQ(round3(out[0].x()), round3(std::cos(M_PI / 4)));
+  EXPECT_EQ(round3(out[1].z()), round3(std::sin(M_PI / 4)));
+  EXPECT_EQ(round3(out[1].x()), 0);
+
+  std::vector<svector::Vector3D> ctrl;
+  for (int i = 0; i < 8; i++) {
+    ctrl.push_back(svector::Vector3D(1.0 * i, 1.0 * i * i, 3.0 - i));
+  }
+  svector::cubic<svector::B_SPLINE>(ctrl.data(), 2, 0.3, out.data());
+  for (std::size_t k = 0; k < 2; k++) {
+    EXPECT_EQ(out[k], svector::cubic<svector::B_SPLINE>(
+                          ctrl[4 * k], ctrl[4 * k + 1], ctrl[4 * k + 2],
+                          ctrl[4 * k + 3], 0.3));
+  }
+}
+
+TEST(CubicTest, EndPoints) {
+  svector::Vector<2> p0{0, 0};
+  svector::Vector<2> p1{1, 2};
+  svector::Vector<2> p2{3, 2};
+  svector::Vector<2> p3{4, 0};
+
+  EXPECT_EQ(svector::cubic<svector::BEZIER>(p0, p1, p2, p3, 0.0), p0);
+  EXPECT_EQ(svector::cubic<svector::BEZIER>(p0, p1, p2, p3, 1.0), p3);
+  EXPECT_EQ(svector::cubic<svector::CATMULL_ROM>(p0, p1, p2, p3, 0.0), p1);
+  EXPECT_EQ(svector::cubic<svector::CATMULL_ROM>(p0, p1, p2, p3, 1.0), p2);
+
+  // B-spline starts at (p0 + 4 p1 + p2) / 6
+  svector::Vector<2> bs =
+      svector::cubic<svector::B_SPLINE>(p0, p1, p2, p3, 0.0);
+  EXPECT_EQ(round3(bs[0]), round3(7.0 / 6));
+  EXPECT_EQ(round3(bs[1]), round3(10.0 / 6));
+
+  // symmetric control polygon gives the middle at t = 0.5
+  svector::Vector<2> mid = svector::cubic<svector::BEZIER>(p0, p1, p2, p3, 0.5);
+  EXPECT_EQ(round3(mid[0]), 2);
+  EXPECT_EQ(round3(mid[1]), 1.5);
+}
+
+TEST(CubicTest, BatchMatchesSingle) {
+  std::vector<svector::Vector<3>> ctrl;
+  for (int i = 0; i < 12; i++) {
+    ctrl.push_back(svector::Vector<3>{1.0 * i, 1.0 * i * i, 3.0 - i});
+  }
+
+  std::vector<svector::Vector<3>> out(3);
+  svector::cubic<svector::CATMULL_ROM>(ctrl.data(), 3, 0.3, out.data());
+  for (std::size_t k = 0; k < 3; k++) {
+    svector::Vector<3> single = svector::cubic<svector::CATMULL_ROM>(
+        ctrl[4 * k], ctrl[4 * k + 1], ctrl[4 * k + 2], ctrl[4 * k + 3], 0.3);
+    EXPECT_EQ(out[k], single);
+  }
+}
+
+TEST(CubicTest, ForwardDifferencingMatchesDirect) {
+  svector::Vector<3> p0{0, 1, 2};
+  svector::Vector<3> p1{3, -1, 5};
+  svector::Vector<3> p2{-2, 4, 1};
+  svector::Vector<3> p3{6, 0, -3};
+
+  const std::size_t n = 17;
+  std::vector<svector::Vector<3>> out(n);
+  svector::sampleCubic<svector::B_SPLINE>(p0, p1, p2, p3, n, out.data());
+
+  for (std::size_t k = 0; k < n; k++) {
+    svector::Vector<3> direct = svector::cubic<svector::B_SPLINE>(
+        p0, p1, p2, p3, static_cast<double>(k) / (n - 1));
+    for (std::size_t i = 0; i < 3; i++) {
+      EXPECT_EQ(round3(out[k][i]), round3(direct[i]));
+    }
+  }
+}
+
+TEST(CubicTest, SamplePath) {
+  std::vector<svector::Vector<2>> ctrl{
+      {0, 0}, {1, 1}, {2, 0}, {3, 1}, {4, 0}, {5, 1}, {6, 0}};
+
+  // Catmull-Rom passes through the inner control points
+  std::vector<svector::Vector<2>> path =
+      svector::samplePath<svector::CATMULL_ROM>(ctrl, 5);
+  ASSERT_EQ(path.size(), 4 * 4 + 1);
+  for (std::size_t s = 0; s <= 4; s++) {
+    EXPECT_EQ(round3(path[s * 4][0]), round3(ctrl[s + 1][0]));
+    EXPECT_EQ(round3(path[s * 4][1]), round3(ctrl[s + 1][1]));
+  }
+
+  // Bézier segments share end points
+  std::vector<svector::Vector<2>> bez =
+      svector::samplePath<svector::BEZIER>(ctrl, 3);
+  ASSERT_EQ(bez.size(), 2 * 2 + 1);
+  EXPECT_EQ(round3(bez[2][0]), 3);
+  EXPECT_EQ(round3(bez[4][0]), 6);
+
+  EXPECT_TRUE(svector::samplePath<svector::BEZIER>(
+                  std::vector<svector::Vector<2>>(3), 4)
+                  .empty());
+
+  // the vector classes work too
+  std::vector<svector::Vector3D> ctrl3{
+      svector::Vector3D(0, 0, 1), svector::Vector3D(1, 1, 2),
+      svector::Vector3D(2, 0, 3), svector::Vector3D(3, 1, 4),
+      svector::Vector3D(4, 0, 5)};
+  std::vector<svector::Vector3D> path3 =
+      svector::samplePath<svector::CATMULL_ROM>(ctrl3, 5);
+  ASSERT_EQ(path3.size(), 2 * 4 + 1);
+  for (std::size_t s = 0; s <= 2; s++) {
+    EXPECT_EQ(round3(path3[s * 4].x()), round3(ctrl3[s + 1].x()));
+    EXPECT_EQ(round3(path3[s * 4].z()), round3(ctrl3[s + 1].z()));
+  }
+}
@@ -0,0 +1,118 @@
+#include "simplevectors/geometry/delaunay.hpp"
+#include "simplevectors/vectors.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+// checks that half-edges are consistent, triangles are counterclockwise and
+// no point is inside a circumcircle
+void checkDelaunay(const std::vector<svector::Vector2D> &points,
+                   const svector::Triangulation &tri) {
+  ASSERT_EQ(tri.triangles.size() % 3, 0);
+  ASSERT_EQ(tri.halfedges.size(), tri.triangles.size());
+
+  std::size_t hullEdges = 0;
+  for (std::size_t e = 0; e < tri.halfedges.size(); e++) {
+    const std::size_t opposite = tri.halfedges[e];
+    if (opposite == svector::NO_EDGE) {
+      hullEdges++;
+      continue;
+    }
+
+    EXPECT_EQ(tri.halfedges[opposite], e);
+    EXPECT_EQ(tri.triangles[e],
+              tri.triangles[svector::nextHalfedge(opposite)]);
+  }
+  EXPECT_EQ(hullEdges, tri.hull.size());
+
+  for (std::size_t t = 0; t < tri.triangles.size(); t += 3) {
+    const svector::Vector2D &a = points[tri.triangles[t]];
+    const svector::Vector2D &b = points[tri.triangles[t + 1]];
+    const svector::Vector2D &c = points[tri.triangles[t + 2]];
+    EXPECT_GT(svector::orient2d(a, b, c), 0);
+    for (const auto &p : points) {
+      EXPECT_LE(svector::incircle(a, b, c, p), 0);
+    }
+  }
+}
+} // namespace
+
+TEST(DelaunayTest, SquareWithCenter) {
+  std::vector<svector::Vector2D> points{
+      {0, 0}, {2, 0}, {2, 2}, {0, 2}, {1, 1}};
+
+  svector::Triangulation tri = svector::delaunay(points);
+  EXPECT_EQ(tri.triangles.size(), 4 * 3);
+  checkDelaunay(points, tri);
+
+  std::vector<std::size_t> hull = tri.hull;
+  std::rotate(hull.begin(), std::min_element(hull.begin(), hull.end()),
+              hull.end());
+  std::vector<std::size_t> res{0, 1, 2, 3};
+  EXPECT_EQ(hull, res);
+}
+
+TEST(DelaunayTest, Navigation) {
+  EXPECT_EQ(svector::nextHalfedge(0), 1);
+  EXPECT_EQ(svector::nextHalfedge(2), 0);
+  EXPECT_EQ(svector::nextHalfedge(5), 3);
+  EXPECT_EQ(svector::prevHalfedge(3), 5);
+  EXPECT_EQ(svector::prevHalfedge(4), 3);
+}
+
+TEST(DelaunayTest, Random) {
+  std::mt19937 gen(11);
+  std::uniform_real_distribution<double> dist(-10, 10);
+  std::vector<svector::Vector2D> points;
+  for (int i = 0; i < 300; i++) {
+    points.push_back(svector::Vector2D(dist(gen), dist(gen)));
+  }
+
+  svector::Triangulation tri = svector::delaunay(points);
+  checkDelaunay(points, tri);
+
+  // Euler's formula for a triangulation of n points with h on the hull
+  EXPECT_EQ(tri.triangles.size() / 3, 2 * points.size() - 2 - tri.hull.size());
+}
+
+TEST(DelaunayTest, GridAndDuplicates) {
+  // grids have many cocircular and collinear points
+  std::vector<svector::Vector2D> points;
+  for (int i = 0; i < 10; i++) {
+    for (int j = 0; j < 10; j++) {
+      points.push_back(svector::Vector2D(i, j));
+    }
+  }
+  points.push_back(svector::Vector2D(3, 4));
+  points.push_back(svector::Vector2D(0, 0));
+
+  svector::Triangulation tri = svector::delaunay(points);
+  checkDelaunay(points, tri);
+
+  // 100 distinct points, 36 of them on the boundary of the grid
+  EXPECT_EQ(tri.triangles.size() / 3, 2 * 100 - 2 - 36);
+
+  std::vector<bool> used(points.size(), false);
+  for (const std::size_t i : tri.triangles) {
+    used[i] = true;
+  }
+  EXPECT_EQ(std::count(used.begin(), used.end(), true), 100);
+}
+
+TEST(DelaunayTest, Degenerate) {
+  std::vector<svector::Vector2D> line{{2, 2}, {0, 0}, {1, 1}, {1, 1}};
+  svector::Triangulation tri = svector::delaunay(line);
+  EXPECT_TRUE(tri.triangles.empty());
+  std::vector<std::size_t> res{1, 2, 0};
+  EXPECT_EQ(tri.hull, res);
+
+  std::vector<svector::Vector2D> two{{0, 0}, {1, 0}};
+  EXPECT_TRUE(svector::delaunay(two).triangles.empty());
+
+  std::vector<svector::Vector2D> empty;
+  EXPECT_TRUE(svector::delaunay(empty).hull.empty());
+}
@@ -704,3 +704,17 @@ TEST(EmbedIsZeroTest, IsZeroTestNonZeroDimensionVector) {
   svector::Vec3D v2{0, 0, 0};
   EXPECT_TRUE(isZero(v2));
 }
+
+TEST(EmbedDistanceTest, SquaredMagnitudeAndDistance) {
+  Vec2D a(1, 1);
+  Vec2D b(4, 5);
+  EXPECT_EQ(magnSquared(b), 41);
+  EXPECT_EQ(distanceSquared(a, b), 25);
+  EXPECT_EQ(distance(a, b), 5);
+
+  Vec3D c(1, 2, 2);
+  Vec3D d(4, 6, 2);
+  EXPECT_EQ(magnSquared(c), 9);
+  EXPECT_EQ(distanceSquared(c, d), 25);
+  EXPECT_EQ(distance(d, c), 5);
+}
@@ -674,3 +674,17 @@ TEST(Embed2IsZeroTest, IsZeroTestNonZeroDimensionVector) {
   svector::EmbVec3D v2{0, 0, 0};
   EXPECT_TRUE(isZero(v2));
 }
+
+TEST(Embed2DistanceTest, SquaredMagnitudeAndDistance) {
+  EmbVec2D a(1, 1);
+  EmbVec2D b(4, 5);
+  EXPECT_EQ(magnSquared(b), 41);
+  EXPECT_EQ(distanceSquared(a, b), 25);
+  EXPECT_EQ(distance(a, b), 5);
+
+  EmbVec3D c(1, 2, 2);
+  EmbVec3D d(4, 6, 2);
+  EXPECT_EQ(magnSquared(c), 9);
+  EXPECT_EQ(distanceSquared(c, d), 25);
+  EXPECT_EQ(distance(d, c), 5);
+}
@@ -0,0 +1,182 @@
+#include "simplevectors/physics/flocking.hpp"
+#include "simplevectors/vectors.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+double round3(const double num) { return std::round(num * 1000) / 1000; }
+
+// the velocities after one step, computed over all pairs
+std::vector<svector::Vector2D> bruteForce(const svector::Flock &flock,
+                                          const svector::FlockSettings &s,
+                                          const double width,
+                                          const double height,
+                                          const double dt) {
+  std::vector<svector::Vector2D> result;
+  for (std::size_t i = 0; i < flock.size(); i++) {
+    double count = 0;
+    double vx = 0;
+    double vy = 0;
+    double cx = 0;
+    double cy = 0;
+    double ax = 0;
+    double ay = 0;
+    for (std::size_t j = 0; j < flock.size(); j++) {
+      double dx = flock.position(j).x() - flock.position(i).x();
+      double dy = flock.position(j).y() - flock.position(i).y();
+      dx -= width * std::round(dx / width);
+      dy -= height * std::round(dy / height);
+      const double d2 = dx * dx + dy * dy;
+      if (j == i || d2 >= s.radius * s.radius) {
+        continue;
+      }
+
+      count++;
+      vx += flock.velocity(j).x();
+      vy += flock.velocity(j).y();
+      cx += dx;
+      cy += dy;
+      if (d2 < s.separationRadius * s.separationRadius) {
+        ax -= dx / d2;
+        ay -= dy / d2;
+      }
+    }
+
+    ax *= s.separation;
+    ay *= s.separation;
+    if (count > 0) {
+      ax += s.alignment * (vx / count - flock.velocity(i).x()) +
+            s.cohesion * cx / count;
+      ay += s.alignment * (vy / count - flock.velocity(i).y()) +
+            s.cohesion * cy / count;
+    }
+    const double force = std::sqrt(ax * ax + ay * ay);
+    if (force > s.maxForce) {
+      ax *= s.maxForce / force;
+      ay *= s.maxForce / force;
+    }
+
+    svector::Vector2D v(flock.velocity(i).x() + dt * ax,
+                        flock.velocity(i).y() + dt * ay);
+    if (v.magn() > s.maxSpeed) {
+      v = svector::Vector2D(v.x() * s.maxSpeed / v.magn(),
+                            v.y() * s.maxSpeed / v.magn());
+    }
+    result.push_back(v);
+  }
+  return result;
+}
+} // namespace
+
+TEST(FlockingTest, Rules) {
+  svector::FlockSettings settings;
+  settings.separation = 0;
+  settings.cohesion = 0;
+
+  // alignment: two agents turn towards their average heading
+  svector::Flock aligned(settings, 10, 10);
+  aligned.add(svector::Vector2D(5, 5), svector::Vector2D(1, 0));
+  aligned.add(svector::Vector2D(5.5, 5), svector::Vector2D(0, 1));
+  aligned.step(0.1);
+  EXPECT_EQ(round3(aligned.velocity(0).x()), 0.9);
+  EXPECT_EQ(round3(aligned.velocity(0).y()), 0.1);
+  EXPECT_EQ(round3(aligned.position(0).x()), 5.09);
+
+  // cohesion: two resting agents move towards each other
+  settings.alignment = 0;
+  settings.cohesion = 1;
+  svector::Flock cohesive(settings, 10, 10);
+  cohesive.add(svector::Vector2D(5, 5), svector::Vector2D(0, 0));
+  cohesive.add(svector::Vector2D(5.8, 5), svector::Vector2D(0, 0));
+  cohesive.step(0.1);
+  EXPECT_EQ(round3(cohesive.velocity(0).x()), 0.08);
+  EXPECT_EQ(round3(cohesive.velocity(1).x()), -0.08);
+
+  // separation: close agents move apart, and agents out of sight are not
+  // affected
+  settings.cohesion = 0;
+  settings.separation = 1;
+  svector::Flock separated(settings, 10, 10);
+  separated.add(svector::Vector2D(5, 5), svector::Vector2D(0, 0));
+  separated.add(svector::Vector2D(5, 5.2), svector::Vector2D(0, 0));
+  separated.add(svector::Vector2D(1, 1), svector::Vector2D(0, 0));
+  separated.step(0.1);
+  EXPECT_EQ(round3(separated.velocity(0).y()), -0.5);
+  EXPECT_EQ(round3(separated.velocity(1).y()), 0.5);
+  EXPECT_EQ(separated.velocity(2).magn(), 0);
+}
+
+TEST(FlockingTest, Wrap) {
+  svector::FlockSettings settings;
+  settings.separation = 0;
+  settings.alignment = 0;
+  svector::Flock flock(settings, 10, 10);
+
+  // neighbors across the edge of the world pull towards each other
+  flock.add(svector::Vector2D(0.1, 5), svector::Vector2D(-1, 0));
+  flock.add(svector::Vector2D(9.7, 5), svector::Vector2D(0, 0));
+  flock.step(0.1);
+  EXPECT_EQ(round3(flock.velocity(0).x()), -1.04);
+  EXPECT_EQ(round3(flock.velocity(1).x()), 0.04);
+
+  // the first agent crossed the edge
+  EXPECT_GT(flock.position(0).x(), 9.5);
+  EXPECT_LT(flock.position(0).x(), 10);
+}
+
+TEST(FlockingTest, MatchesBruteForce) {
+  svector::FlockSettings settings;
+  const double width = 12;
+  const double height = 8;
+  svector::Flock flock(settings, width, height);
+  std::mt19937 gen(3);
+  std::uniform_real_distribution<double> dist(0, 1);
+  for (int i = 0; i < 500; i++) {
+    flock.add(svector::Vector2D(width * dist(gen), height * dist(gen)),
+              svector::Vector2D(dist(gen) - 0.5, dist(gen) - 0.5));
+  }
+
+  for (int step = 0; step < 5; step++) {
+    const std::vector<svector::Vector2D> expected =
+        bruteForce(flock, settings, width, height, 0.05);
+    flock.step(0.05);
+    for (std::size_t i = 0; i < flock.size(); i++) {
+      ASSERT_LT(std::abs(flock.velocity(i).x() - expected[i].x()), 1e-9);
+      ASSERT_LT(std::abs(flock.velocity(i).y() - expected[i].y()), 1e-9);
+      ASSERT_GE(flock.position(i).x(), 0);
+      ASSERT_LT(flock.position(i).x(), width);
+    }
+  }
+}
+
+TEST(FlockingTest, Ranges) {
+  // steering in ranges gives the same result as one step, since the ranges
+  // only read the last state
+  svector::FlockSettings settings;
+  svector::Flock whole(settings, 20, 20);
+  svector::Flock split(settings, 20, 20);
+  std::mt19937 gen(5);
+  std::uniform_real_distribution<double> dist(0, 1);
+  for (int i = 0; i < 1000; i++) {
+    const svector::Vector2D p(20 * dist(gen), 20 * dist(gen));
+    const svector::Vector2D v(dist(gen) - 0.5, dist(gen) - 0.5);
+    whole.add(p, v);
+    split.add(p, v);
+  }
+
+  for (int step = 0; step < 10; step++) {
+    whole.step(0.05);
+    split.buildGrid();
+    split.steer(700, 1000, 0.05);
+    split.steer(0, 300, 0.05);
+    split.steer(300, 700, 0.05);
+    split.swap();
+  }
+
+  EXPECT_EQ(whole.x(), split.x());
+  EXPECT_EQ(whole.y(), split.y());
+}
@@ -116,6 +116,17 @@ TEST(XYMagnitudeTestUtil, TestMagnitudeGivenXYZ) {
   EXPECT_EQ(magn_r, 6.230);
 }
 
+TEST(XYMagnitudeTestUtil, TestSquaredMagnitudeAndDistance) {
+  svector::Vector3D lhs(1, 2, 2);
+  svector::Vector3D rhs(4, 6, 2);
+
+  EXPECT_EQ(svector::magnSquared(lhs), 9);
+  EXPECT_EQ(svector::distanceSquared(lhs, rhs), 25);
+  EXPECT_EQ(svector::distance(lhs, rhs), 5);
+  EXPECT_EQ(svector::distance(rhs, lhs), 5);
+  EXPECT_TRUE(svector::isZero(svector::Vector3D(0, 0, 0)));
+}
+
 TEST(NormalizeTestUtil, TestNormalize2D) {
   svector::Vector2D vector(3, 4);
   vector = svector::normalize(vector);
@@ -0,0 +1,160 @@
+#include "simplevectors/math/geodetic.hpp"
+#include "simplevectors/vectors.hpp"
+
+#include <gtest/gtest.h>
+
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <random>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+double round3(const double num) { return std::round(num * 1000) / 1000; }
+
+std::vector<svector::Vector3D> makeFixes(const std::size_t n) {
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<double> latitude(-M_PI / 2, M_PI / 2);
+  std::uniform_real_distribution<double> longitude(-M_PI, M_PI);
+  std::uniform_real_distribution<double> altitude(-1e4, 4e7);
+  std::vector<svector::Vector3D> result;
+  for (std::size_t i = 0; i < n; i++) {
+    result.push_back(
+        svector::Vector3D(latitude(gen), longitude(gen), altitude(gen)));
+  }
+  return result;
+}
+} // namespace
+
+TEST(GeodeticTest, LlaToEcef) {
+  svector::Vector3D ecef = svector::llaToEcef(svector::Vector3D(0, 0, 0));
+  EXPECT_EQ(ecef.x(), 6378137);
+  EXPECT_EQ(ecef.y(), 0);
+  EXPECT_EQ(ecef.z(), 0);
+
+  ecef = svector::llaToEcef(svector::Vector3D(0, M_PI / 2, 100));
+  EXPECT_LT(std::abs(ecef.x()), 1e-8);
+  EXPECT_EQ(ecef.y(), 6378237);
+
+  // the semi-minor axis
+  ecef = svector::llaToEcef(svector::Vector3D(M_PI / 2, 0, 0));
+  EXPECT_LT(std::abs(ecef.x()), 1e-8);
+  EXPECT_EQ(round3(ecef.z()), 6356752.314);
+}
+
+TEST(GeodeticTest, EcefToLla) {
+  svector::Vector3D lla = svector::ecefToLla(svector::Vector3D(6378137, 0, 0));
+  EXPECT_EQ(lla.x(), 0);
+  EXPECT_EQ(lla.y(), 0);
+  EXPECT_LT(std::abs(lla.z()), 1e-8);
+
+  // the poles
+  lla = svector::ecefToLla(svector::Vector3D(0, 0, -6356852.314245179));
+  EXPECT_EQ(lla.x(), -M_PI / 2);
+  EXPECT_LT(std::abs(lla.z() - 100), 1e-8);
+
+  const std::vector<svector::Vector3D> fixes = makeFixes(1000);
+  for (const svector::Vector3D &fix : fixes) {
+    const svector::Vector3D back = svector::ecefToLla(svector::llaToEcef(fix));
+    ASSERT_LT(std::abs(back.x() - fix.x()), 1e-14);
+    ASSERT_LT(std::abs(back.y() - fix.y()), 1e-14);
+    ASSERT_LT(std::abs(back.z() - fix.z()), 1e-7);
+  }
+}
+
+TEST(GeodeticTest, Batch) {
+  const std::size_t n = 1000;
+  const std::vector<svector::Vector3D> fixes = makeFixes(n);
+  std::vector<double> latitudes(n), longitudes(n), altitudes(n);
+  for (std::size_t i = 0; i < n; i++) {
+    latitudes[i] = fixes[i].x();
+    longitudes[i] = fixes[i].y();
+    altitudes[i] = fixes[i].z();
+  }
+
+  std::vector<svector::Vector3D> ecef(n);
+  svector::llaToEcef(fixes.data(), ecef.data(), n);
+
+  std::vector<double> xs(n), ys(n), zs(n);
+  svector::llaToEcef<svector::ANGLE_PRECISE>(
+      latitudes.data(), longitudes.data(), altitudes.data(), xs.data(),
+      ys.data(), zs.data(), n);
+  for (std::size_t i = 0; i < n; i++) {
+    ASSERT_LT(std::abs(xs[i] - ecef[i].x()), 1e-7);
+    ASSERT_LT(std::abs(ys[i] - ecef[i].y()), 1e-7);
+    ASSERT_LT(std::abs(zs[i] - ecef[i].z()), 1e-7);
+  }
+
+  std::vector<double> bl(n), bm(n), ba(n);
+  svector::ecefToLla<svector::ANGLE_PRECISE>(xs.data(), ys.data(), zs.data(),
+                                             bl.data(), bm.data(), ba.data(),
+                                             n);
+  std::vector<svector::Vector3D> back(n);
+  svector::ecefToLla(ecef.data(), back.data(), n);
+  for (std::size_t i = 0; i < n; i++) {
+    ASSERT_LT(std::abs(bl[i] - latitudes[i]), 1e-14);
+    ASSERT_LT(std::abs(bm[i] - longitudes[i]), 1e-14);
+    ASSERT_LT(std::abs(ba[i] - altitudes[i]), 1e-7);
+    ASSERT_LT(std::abs(back[i].z() - altitudes[i]), 1e-7);
+  }
+}
+
+TEST(GeodeticTest, EnuFrame) {
+  const svector::EnuFrame frame(svector::Vector3D(0, 0, 0));
+  EXPECT_EQ(frame.originEcef(), svector::Vector3D(6378137, 0, 0));
+  EXPECT_EQ(frame.up(), svector::Vector3D(1, 0, 0));
+
+  // east at the origin is +y and north is +z
+  svector::Vector3D enu = frame.ecefToEnu(svector::Vector3D(6378137, 5, 0));
+  EXPECT_EQ(enu, svector::Vector3D(5, 0, 0));
+  enu = frame.ecefToEnu(svector::Vector3D(6378137, 0, 7));
+  EXPECT_EQ(enu, svector::Vector3D(0, 7, 0));
+  EXPECT_EQ(frame.llaToEnu(svector::Vector3D(0, 0, 20)),
+            svector::Vector3D(0, 0, 20));
+
+  // straight up from any origin
+  const svector::Vector3D origin(0.7, -1.2, 150);
+  const svector::EnuFrame tilted(origin);
+  enu = tilted.llaToEnu(svector::Vector3D(0.7, -1.2, 1150));
+  EXPECT_LT(std::abs(enu.x()), 1e-8);
+  EXPECT_LT(std::abs(enu.y()), 1e-8);
+  EXPECT_LT(std::abs(enu.z() - 1000), 1e-8);
+  EXPECT_LT(tilted.ecefToEnu(tilted.originEcef()).magn(), 1e-15);
+
+  const svector::Vector3D lla = tilted.enuToLla(svector::Vector3D(30, 40, 50));
+  EXPECT_LT((tilted.llaToEnu(lla) - svector::Vector3D(30, 40, 50)).magn(),
+            1e-8);
+
+  // the batch conversions match the single ones
+  const std::vector<svector::Vector3D> fixes = makeFixes(100);
+  std::vector<svector::Vector3D> ecef(100), enus(100), back(100);
+  svector::llaToEcef(fixes.data(), ecef.data(), 100);
+  tilted.ecefToEnu(ecef.data(), enus.data(), 100);
+  tilted.enuToEcef(enus.data(), back.data(), 100);
+
+  std::vector<double> xs, ys, zs;
+  for (const svector::Vector3D &p : ecef) {
+    xs.push_back(p.x());
+    ys.push_back(p.y());
+    zs.push_back(p.z());
+  }
+  std::vector<double> es(100), ns(100), us(100);
+  tilted.ecefToEnu(xs.data(), ys.data(), zs.data(), es.data(), ns.data(),
+                   us.data(), 100);
+  std::vector<double> bx(100), by(100), bz(100);
+  tilted.enuToEcef(es.data(), ns.data(), us.data(), bx.data(), by.data(),
+                   bz.data(), 100);
+  for (std::size_t i = 0; i < 100; i++) {
+    ASSERT_EQ(enus[i], tilted.ecefToEnu(ecef[i]));
+    ASSERT_LT(std::abs(es[i] - enus[i].x()), 1e-6);
+    ASSERT_LT(std::abs(ns[i] - enus[i].y()), 1e-6);
+    ASSERT_LT(std::abs(us[i] - enus[i].z()), 1e-6);
+    ASSERT_LT((back[i] - ecef[i]).magn(), 1e-6);
+    ASSERT_LT(std::abs(bx[i] - ecef[i].x()), 1e-6);
+    ASSERT_LT(std::abs(by[i] - ecef[i].y()), 1e-6);
+    ASSERT_LT(std::abs(bz[i] - ecef[i].z()), 1e-6);
+  }
+}
@@ -0,0 +1,166 @@
+#include "simplevectors/collision/gjk.hpp"
+#include "simplevectors/vectors.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+double round3(const double num) { return std::round(num * 1000) / 1000; }
+
+std::vector<svector::Vector3D> cube(const svector::Vector3D &center,
+                                    const double half) {
+  std::vector<svector::Vector3D> points;
+  for (int i = 0; i < 8; i++) {
+    points.push_back(center + svector::Vector3D(i & 1 ? half : -half,
+                                                i & 2 ? half : -half,
+                                                i & 4 ? half : -half));
+  }
+  return points;
+}
+} // namespace
+
+TEST(GJKTest, Spheres) {
+  svector::SphereShape a(svector::Vector3D(0, 0, 0), 1);
+  svector::SphereShape b(svector::Vector3D(5, 0, 0), 2);
+
+  svector::GJKResult res = svector::gjkDistance(a, b);
+  EXPECT_FALSE(res.overlap);
+  EXPECT_EQ(round3(res.distance), 2);
+  EXPECT_EQ(round3(res.pointA.x()), 1);
+  EXPECT_EQ(round3(res.pointB.x()), 3);
+
+  svector::SphereShape c(svector::Vector3D(0, 2.5, 0), 2);
+  EXPECT_TRUE(svector::gjkOverlap(a, c));
+
+  svector::Penetration pen = svector::epaPenetration(a, c);
+  EXPECT_TRUE(pen.overlap);
+  EXPECT_NEAR(pen.depth, 0.5, 1e-2);
+  EXPECT_NEAR(pen.normal.y(), 1, 1e-2);
+}
+
+TEST(GJKTest, Boxes) {
+  std::vector<svector::Vector3D> boxA = cube(svector::Vector3D(0, 0, 0), 1);
+  std::vector<svector::Vector3D> boxB = cube(svector::Vector3D(3, 0.5, 0), 1);
+  svector::ConvexPointsShape<svector::Vector3D> a(boxA);
+  svector::ConvexPointsShape<svector::Vector3D> b(boxB);
+
+  svector::GJKResult res = svector::gjkDistance(a, b);
+  EXPECT_FALSE(res.overlap);
+  EXPECT_EQ(round3(res.distance), 1);
+
+  // overlapping by 0.25 along x
+  std::vector<svector::Vector3D> boxC =
+      cube(svector::Vector3D(1.75, 0.5, 0.2), 1);
+  svector::ConvexPointsShape<svector::Vector3D> c(boxC);
+  svector::Penetration pen = svector::epaPenetration(a, c);
+  EXPECT_TRUE(pen.overlap);
+  EXPECT_EQ(round3(pen.depth), 0.25);
+  EXPECT_EQ(round3(pen.normal.x()), 1);
+  EXPECT_EQ(round3(pen.pointA.x() - pen.pointB.x()), 0.25);
+
+  // touching faces overlap with no depth
+  std::vector<svector::Vector3D> boxD = cube(svector::Vector3D(2, 0, 0), 1);
+  svector::ConvexPointsShape<svector::Vector3D> d(boxD);
+  EXPECT_TRUE(svector::gjkOverlap(a, d));
+  EXPECT_EQ(round3(svector::epaPenetration(a, d).depth), 0);
+}
+
+TEST(GJKTest, Flat) {
+  // two triangles in the same plane
+  std::vector<svector::Vector3D> triA{svector::Vector3D(0, 0, 0),
+                                      svector::Vector3D(2, 0, 0),
+                                      svector::Vector3D(0, 2, 0)};
+  std::vector<svector::Vector3D> triB{svector::Vector3D(0.5, 0.5, 0),
+                                      svector::Vector3D(3, 0.5, 0),
+                                      svector::Vector3D(0.5, 3, 0)};
+  svector::ConvexPointsShape<svector::Vector3D> a(triA);
+  svector::ConvexPointsShape<svector::Vector3D> b(triB);
+  EXPECT_TRUE(svector::gjkOverlap(a, b));
+
+  std::vector<svector::Vector3D> triC{svector::Vector3D(0, 0, 1),
+                                      svector::Vector3D(2, 0, 1),
+                                      svector::Vector3D(0, 2, 1)};
+  svector::ConvexPointsShape<svector::Vector3D> c(triC);
+  EXPECT_EQ(round3(svector::gjkDistance(a, c).distance), 1);
+}
+
+TEST(GJKTest, RandomSpheres) {
+  // spheres have a known answer for both distance and depth
+  std::mt19937 gen(11);
+  std::uniform_real_distribution<double> pos(-3, 3);
+  std::uniform_real_distribution<double> radius(0.2, 2);
+  for (int i = 0; i < 200; i++) {
+    const svector::Vector3D ca(pos(gen), pos(gen), pos(gen));
+    const svector::Vector3D cb(pos(gen), pos(gen), pos(gen));
+    const double ra = radius(gen);
+    const double rb = radius(gen);
+    svector::SphereShape a(ca, ra);
+    svector::SphereShape b(cb, rb);
+
+    const double gap = (cb - ca).magn() - ra - rb;
+    if (gap > 1e-3) {
+      svector::GJKResult res = svector::gjkDistance(a, b);
+      EXPECT_FALSE(res.overlap);
+      EXPECT_NEAR(res.distance, gap, 1e-3);
+    } else if (gap < -1e-3) {
+      svector::Penetration pen = svector::epaPenetration(a, b);
+      EXPECT_TRUE(pen.overlap);
+      EXPECT_NEAR(pen.depth, -gap, 1e-2);
+    }
+  }
+}
+
+TEST(GJKTest, DeepSpheres) {
+  // deep overlaps take many EPA iterations and may stop at the limit, where
+  // the depth is a lower bound that must still be close
+  std::mt19937 gen(5);
+  std::uniform_real_distribution<double> pos(-0.5, 0.5);
+  std::uniform_real_distribution<double> radius(1, 3);
+  for (int i = 0; i < 20; i++) {
+    const svector::Vector3D ca(pos(gen), pos(gen), pos(gen));
+    const svector::Vector3D cb(pos(gen), pos(gen), pos(gen));
+    const double ra = radius(gen);
+    const double rb = radius(gen);
+    const double depth = ra + rb - (cb - ca).magn();
+
+    svector::Penetration pen = svector::epaPenetration(
+        svector::SphereShape(ca, ra), svector::SphereShape(cb, rb));
+    EXPECT_TRUE(pen.overlap);
+    EXPECT_LE(pen.depth, depth * (1 + 1e-9));
+    EXPECT_NEAR(pen.depth, depth, depth * 1e-2);
+  }
+}
+
+TEST(GJKTest, WarmStart) {
+  std::vector<svector::Vector3D> boxA = cube(svector::Vector3D(0, 0, 0), 1);
+  svector::ConvexPointsShape<svector::Vector3D> a(boxA);
+
+  svector::GJKSimplex cache;
+  std::size_t warm = 0;
+  std::size_t cold = 0;
+  for (int frame = 0; frame < 100; frame++) {
+    // a box orbiting the first one, sometimes overlapping it
+    const double t = frame * 0.05;
+    const svector::Vector3D center(2.5 * std::cos(t), 2.5 * std::sin(t),
+                                   0.3 * std::sin(3 * t));
+    auto b = [&center](const svector::Vector3D &direction) {
+      return svector::Vector3D(direction.x() >= 0 ? 1 : -1,
+                               direction.y() >= 0 ? 1 : -1,
+                               direction.z() >= 0 ? 1 : -1) *
+                 0.8 +
+             center;
+    };
+
+    svector::GJKResult warmRes = svector::gjkDistance(a, b, cache);
+    svector::GJKResult coldRes = svector::gjkDistance(a, b);
+    EXPECT_EQ(warmRes.overlap, coldRes.overlap);
+    EXPECT_NEAR(warmRes.distance, coldRes.distance, 1e-9);
+    warm += warmRes.iterations;
+    cold += coldRes.iterations;
+  }
+
+  EXPECT_LT(warm, cold);
+}
@@ -0,0 +1,176 @@
+#include "simplevectors/geometry/hull.hpp"
+#include "simplevectors/vectors.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+TEST(HullTest, Hull2DSquare) {
+  std::vector<svector::Vector2D> points{{0, 0}, {1, 1}, {2, 0}, {2, 2},
+                                        {0, 2}, {1, 0}, {1, 2}, {0.5, 1.5}};
+
+  std::vector<std::size_t> hull = svector::convexHull2D(points);
+  std::vector<std::size_t> res{0, 2, 3, 4};
+  EXPECT_EQ(hull, res);
+}
+
+TEST(HullTest, Hull2DDegenerate) {
+  std::vector<svector::Vector2D> line{{0, 0}, {2, 2}, {1, 1}, {3, 3}};
+  std::vector<std::size_t> hull = svector::convexHull2D(line);
+  std::vector<std::size_t> res{0, 3};
+  EXPECT_EQ(hull, res);
+
+  std::vector<svector::Vector2D> same{{1, 1}, {1, 1}, {1, 1}};
+  EXPECT_EQ(svector::convexHull2D(same).size(), 1);
+
+  std::vector<svector::Vector2D> empty;
+  EXPECT_TRUE(svector::convexHull2D(empty).empty());
+}
+
+TEST(HullTest, Hull2DChunksMatchWhole) {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> dist(-100, 100);
+  std::vector<svector::Vector2D> points;
+  for (int i = 0; i < 2000; i++) {
+    points.push_back(svector::Vector2D(dist(gen), dist(gen)));
+  }
+
+  std::vector<std::size_t> whole = svector::convexHull2D(points);
+
+  std::vector<std::size_t> merged;
+  for (std::size_t chunk = 0; chunk < 4; chunk++) {
+    std::vector<std::size_t> indices;
+    for (std::size_t i = chunk * 500; i < (chunk + 1) * 500; i++) {
+      indices.push_back(i);
+    }
+
+    std::vector<std::size_t> part = svector::convexHull2D(points, indices);
+    merged.insert(merged.end(), part.begin(), part.end());
+  }
+
+  EXPECT_EQ(svector::convexHull2D(points, merged), whole);
+
+  // every point is on the inner side of every hull edge
+  for (std::size_t i = 0; i < whole.size(); i++) {
+    const svector::Vector2D &a = points[whole[i]];
+    const svector::Vector2D &b = points[whole[(i + 1) % whole.size()]];
+    for (const auto &p : points) {
+      EXPECT_GE(svector::orient2d(a, b, p), 0);
+    }
+  }
+}
+
+TEST(HullTest, Hull3DCube) {
+  std::vector<svector::Vector3D> points;
+  for (int i = 0; i < 8; i++) {
+    points.push_back(svector::Vector3D(i & 1, (i >> 1) & 1, (i >> 2) & 1));
+  }
+  points.push_back(svector::Vector3D(0.5, 0.5, 0.5));
+  points.push_back(svector::Vector3D(0.2, 0.7, 0.1));
+
+  std::vector<std::array<std::size_t, 3>> hull = svector::convexHull3D(points);
+
+  // cube faces split into two triangles each
+  EXPECT_EQ(hull.size(), 12);
+  std::vector<std::size_t> vertices = svector::hullVertices(hull);
+  std::vector<std::size_t> res{0, 1, 2, 3, 4, 5, 6, 7};
+  EXPECT_EQ(vertices, res);
+
+  for (const auto &tri : hull) {
+    for (const auto &p : points) {
+      EXPECT_GE(svector::orient3d(points[tri[0]], points[tri[1]],
+                                  points[tri[2]], p),
+                0);
+    }
+  }
+}
+
+TEST(HullTest, Hull3DRandomClosedAndConvex) {
+  std::mt19937 gen(7);
+  std::normal_distribution<double> dist(0, 1);
+  std::vector<svector::Vector3D> points;
+  for (int i = 0; i < 1000; i++) {
+    points.push_back(svector::Vector3D(dist(gen), dist(gen), dist(gen)));
+  }
+
+  std::vector<std::array<std::size_t, 3>> hull = svector::convexHull3D(points);
+  ASSERT_FALSE(hull.empty());
+
+  // closed: every directed edge has its reverse exactly once
+  std::vector<std::pair<std::size_t, std::size_t>> edges;
+  for (const auto &tri : hull) {
+    for (std::size_t e = 0; e < 3; e++) {
+      edges.push_back(std::make_pair(tri[e], tri[(e + 1) % 3]));
+    }
+  }
+  std::sort(edges.begin(), edges.end());
+  for (const auto &edge : edges) {
+    EXPECT_EQ(std::count(edges.begin(), edges.end(),
+                         std::make_pair(edge.second, edge.first)),
+              1);
+  }
+
+  // Euler's formula for a triangulated sphere
+  const std::size_t v = svector::hullVertices(hull).size();
+  EXPECT_EQ(hull.size(), 2 * v - 4);
+
+  for (const auto &tri : hull) {
+    for (const auto &p : points) {
+      EXPECT_GE(svector::orient3d(points[tri[0]], points[tri[1]],
+                                  points[tri[2]], p),
+                0);
+    }
+  }
+
+  // merging the hulls of two halves gives the same vertices
+  std::vector<std::size_t> first;
+  std::vector<std::size_t> second;
+  for (std::size_t i = 0; i < points.size(); i++) {
+    (i < 500 ? first : second).push_back(i);
+  }
+  std::vector<std::size_t> merged =
+      svector::hullVertices(svector::convexHull3D(points, first));
+  std::vector<std::size_t> merged2 =
+      svector::hullVertices(svector::convexHull3D(points, second));
+  merged.insert(merged.end(), merged2.begin(), merged2.end());
+  EXPECT_EQ(svector::hullVertices(svector::convexHull3D(points, merged)),
+            svector::hullVertices(hull));
+}
+
+TEST(HullTest, Hull3DCoplanar) {
+  std::vector<svector::Vector3D> points{
+      {0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {1, 1, 0}, {0.5, 0.5, 0}};
+  EXPECT_TRUE(svector::convexHull3D(points).empty());
+}
+
+TEST(HullTest, Hull3DSphere) {
+  // every point is on the hull, which is the worst case for the number of
+  // faces each point can see
+  std::mt19937 gen(9);
+  std::normal_distribution<double> dist(0, 1);
+  std::vector<svector::Vector3D> points;
+  for (int i = 0; i < 5000; i++) {
+    const svector::Vector3D p(dist(gen), dist(gen), dist(gen));
+    points.push_back(p / p.magn());
+  }
+
+  std::vector<std::array<std::size_t, 3>> hull = svector::convexHull3D(points);
+  EXPECT_EQ(svector::hullVertices(hull).size(), points.size());
+  EXPECT_EQ(hull.size(), 2 * points.size() - 4);
+
+  // every edge of the hull joins two faces
+  std::vector<std::pair<std::size_t, std::size_t>> edges;
+  for (const auto &tri : hull) {
+    for (std::size_t e = 0; e < 3; e++) {
+      edges.push_back(std::make_pair(tri[e], tri[(e + 1) % 3]));
+    }
+  }
+  std::sort(edges.begin(), edges.end());
+  for (const auto &edge : edges) {
+    ASSERT_TRUE(std::binary_search(edges.begin(), edges.end(),
+                                   std::make_pair(edge.second, edge.first)));
+  }
+}
@@ -0,0 +1,151 @@
+#include "simplevectors/geometry/intersections.hpp"
+#include "simplevectors/vectors.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+typedef std::vector<std::pair<svector::Vector2D, svector::Vector2D>> Segments;
+typedef std::vector<std::pair<std::size_t, std::size_t>> Pairs;
+
+Pairs bruteForce(const Segments &segments) {
+  Pairs result;
+  for (std::size_t i = 0; i < segments.size(); i++) {
+    for (std::size_t j = i + 1; j < segments.size(); j++) {
+      if (svector::segmentsIntersect(segments[i].first, segments[i].second,
+                                     segments[j].first, segments[j].second)) {
+        result.push_back(std::make_pair(i, j));
+      }
+    }
+  }
+
+  return result;
+}
+
+std::pair<svector::Vector2D, svector::Vector2D>
+seg(const double ax, const double ay, const double bx, const double by) {
+  return std::make_pair(svector::Vector2D(ax, ay), svector::Vector2D(bx, by));
+}
+} // namespace
+
+TEST(IntersectionTest, SegmentsIntersect) {
+  svector::Vector2D a(0, 0);
+  svector::Vector2D b(2, 2);
+  EXPECT_TRUE(svector::segmentsIntersect(a, b, svector::Vector2D(0, 2),
+                                         svector::Vector2D(2, 0)));
+  EXPECT_FALSE(svector::segmentsIntersect(a, b, svector::Vector2D(1, 0),
+                                          svector::Vector2D(3, 2)));
+
+  // touching, shared end points and overlaps all count
+  EXPECT_TRUE(svector::segmentsIntersect(a, b, svector::Vector2D(1, 1),
+                                         svector::Vector2D(3, 0)));
+  EXPECT_TRUE(svector::segmentsIntersect(a, b, b, svector::Vector2D(5, 0)));
+  EXPECT_TRUE(svector::segmentsIntersect(a, b, svector::Vector2D(1, 1),
+                                         svector::Vector2D(3, 3)));
+  EXPECT_FALSE(svector::segmentsIntersect(a, b, svector::Vector2D(3, 3),
+                                          svector::Vector2D(4, 4)));
+}
+
+TEST(IntersectionTest, Simple) {
+  Segments segments{seg(0, 0, 4, 4), seg(0, 4, 4, 0), seg(5, 0, 5, 4),
+                    seg(3, 2, 6, 2)};
+
+  Pairs res{{0, 1}, {2, 3}};
+  EXPECT_EQ(svector::segmentIntersections(segments), res);
+  EXPECT_EQ(svector::segmentIntersectionsGrid(segments), res);
+}
+
+TEST(IntersectionTest, Degenerate) {
+  // vertical segments, shared end points, overlaps, a point segment and
+  // several segments through one point
+  Segments segments{seg(1, 0, 1, 2),     seg(0, 1, 2, 1), seg(0, 0, 2, 2),
+                    seg(0, 2, 2, 0),     seg(2, 2, 3, 2), seg(1, 1, 1, 1),
+                    seg(2, 2, 2.5, 2.5), seg(1, 1, 3, 3), seg(3, 0, 3, 1)};
+
+  Pairs res = bruteForce(segments);
+  EXPECT_EQ(svector::segmentIntersections(segments), res);
+  EXPECT_EQ(svector::segmentIntersectionsGrid(segments), res);
+}
+
+TEST(IntersectionTest, RandomSmallGrid) {
+  // integer end points in a small range produce many degeneracies
+  std::mt19937 gen(5);
+  std::uniform_int_distribution<int> dist(0, 4);
+  for (int trial = 0; trial < 200; trial++) {
+    Segments segments;
+    for (int i = 0; i < 12; i++) {
+      segments.push_back(seg(dist(gen), dist(gen), dist(gen), dist(gen)));
+    }
+
+    Pairs res = bruteForce(segments);
+    EXPECT_EQ(svector::segmentIntersections(segments), res);
+    EXPECT_EQ(svector::segmentIntersectionsGrid(segments), res);
+  }
+}
+
+TEST(IntersectionTest, RandomShortSegments) {
+  std::mt19937 gen(8);
+  std::uniform_real_distribution<double> pos(0, 1);
+  std::uniform_real_distribution<double> offset(-0.05, 0.05);
+  Segments segments;
+  for (int i = 0; i < 500; i++) {
+    const double x = pos(gen);
+    const double y = pos(gen);
+    segments.push_back(seg(x, y, x + offset(gen), y + offset(gen)));
+  }
+
+  Pairs res = bruteForce(segments);
+  EXPECT_FALSE(res.empty());
+  EXPECT_EQ(svector::segmentIntersections(segments), res);
+  EXPECT_EQ(svector::segmentIntersectionsGrid(segments), res);
+  EXPECT_EQ(svector::segmentIntersectionsGrid(segments, 0.01), res);
+}
+
+TEST(IntersectionTest, RandomDegenerate) {
+  // nearly vertical segments, vertical segments, exactly collinear segments
+  // on a line through representable points, and nearly collinear segments
+  // that cross at tiny angles
+  std::mt19937 gen(13);
+  std::uniform_real_distribution<double> pos(0, 1);
+  std::uniform_real_distribution<double> length(-0.5, 0.5);
+  std::uniform_real_distribution<double> tilt(-1e-9, 1e-9);
+  std::uniform_int_distribution<int> kind(0, 4);
+  std::uniform_int_distribution<int> step(0, 16);
+  for (int trial = 0; trial < 300; trial++) {
+    Segments segments;
+    for (int i = 0; i < 30; i++) {
+      const double x = pos(gen);
+      const double y = pos(gen);
+      switch (kind(gen)) {
+      case 0:
+        segments.push_back(seg(x, y, x + tilt(gen), y + length(gen)));
+        break;
+      case 1:
+        segments.push_back(seg(x, y, x, y + length(gen)));
+        break;
+      case 2: {
+        const double s = step(gen) / 16.0;
+        const double t = step(gen) / 16.0;
+        segments.push_back(seg(s, 1 - 0.5 * s, t, 1 - 0.5 * t));
+        break;
+      }
+      case 3: {
+        const double s = length(gen);
+        const double t = length(gen);
+        segments.push_back(
+            seg(0.5 + s, 0.5 + 0.3 * s, 0.5 + t, 0.5 + 0.3 * t));
+        break;
+      }
+      default:
+        segments.push_back(seg(x, y, x + length(gen), y + length(gen)));
+      }
+    }
+
+    Pairs res = bruteForce(segments);
+    ASSERT_EQ(svector::segmentIntersections(segments), res);
+    ASSERT_EQ(svector::segmentIntersectionsGrid(segments), res);
+  }
+}
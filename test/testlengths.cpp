@@ -0,0 +1,115 @@
+#include "simplevectors/math/lengths.hpp"
+#include "simplevectors/vectors.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+namespace {
+std::vector<svector::Vector3D> makePoints(const std::size_t n) {
+  std::mt19937 gen(11);
+  std::uniform_real_distribution<double> dist(-10, 10);
+  std::vector<svector::Vector3D> result;
+  for (std::size_t i = 0; i < n; i++) {
+    result.push_back(svector::Vector3D(dist(gen), dist(gen), dist(gen)));
+  }
+  return result;
+}
+} // namespace
+
+TEST(LengthsTest, MagnitudesSquared) {
+  const std::vector<svector::Vector3D> points = makePoints(100);
+  std::vector<double> xs, ys, zs;
+  for (const svector::Vector3D &p : points) {
+    xs.push_back(p.x());
+    ys.push_back(p.y());
+    zs.push_back(p.z());
+  }
+
+  std::vector<double> fromVectors(100);
+  std::vector<double> fromComponents(100);
+  std::vector<double> flat(100);
+  svector::magnitudesSquared(points.data(), fromVectors.data(), 100);
+  svector::magnitudesSquared(xs.data(), ys.data(), zs.data(),
+                             fromComponents.data(), 100);
+  svector::magnitudesSquared(xs.data(), ys.data(), flat.data(), 100);
+  for (std::size_t i = 0; i < 100; i++) {
+    EXPECT_EQ(fromVectors[i], points[i].magnSquared());
+    EXPECT_EQ(fromComponents[i], points[i].magnSquared());
+    EXPECT_EQ(flat[i], xs[i] * xs[i] + ys[i] * ys[i]);
+  }
+}
+
+TEST(LengthsTest, WithinRadius) {
+  // more points than one chunk
+  const std::vector<svector::Vector3D> points = makePoints(1000);
+  std::vector<double> xs, ys, zs;
+  for (const svector::Vector3D &p : points) {
+    xs.push_back(p.x());
+    ys.push_back(p.y());
+    zs.push_back(p.z());
+  }
+  const svector::Vector3D center(1, -2, 3);
+
+  std::vector<std::size_t> expected;
+  std::vector<std::size_t> expected2D;
+  for (std::size_t i = 100; i < 900; i++) {
+    if ((points[i] - center).magn() <= 6) {
+      expected.push_back(i);
+    }
+    const double dx = xs[i] - 1;
+    const double dy = ys[i] + 2;
+    if (dx * dx + dy * dy <= 36) {
+      expected2D.push_back(i);
+    }
+  }
+  ASSERT_GT(expected.size(), 0u);
+
+  std::vector<std::size_t> out(800);
+  std::size_t count =
+      svector::withinRadius(points.data(), 100, 900, center, 6, out.data());
+  EXPECT_EQ(std::vector<std::size_t>(out.begin(), out.begin() + count),
+            expected);
+
+  count = svector::withinRadius(xs.data(), ys.data(), zs.data(), 100, 900, 1,
+                                -2, 3, 6, out.data());
+  EXPECT_EQ(std::vector<std::size_t>(out.begin(), out.begin() + count),
+            expected);
+
+  count = svector::withinRadius(xs.data(), ys.data(), 100, 900, 1, -2, 6,
+                                out.data());
+  EXPECT_EQ(std::vector<std::size_t>(out.begin(), out.begin() + count),
+            expected2D);
+
+  // points at the radius are inside
+  const svector::Vector2D edge[] = {svector::Vector2D(3, 4),
+                                    svector::Vector2D(3, 4.001)};
+  count = svector::withinRadius(edge, 0, 2, svector::Vector2D(0, 0), 5,
+                                out.data());
+  EXPECT_EQ(count, 1u);
+  EXPECT_EQ(out[0], 0u);
+}
+
+TEST(LengthsTest, SortByLength) {
+  std::vector<svector::Vector2D> vectors{
+      svector::Vector2D(3, 4), svector::Vector2D(1, 0),
+      svector::Vector2D(0, -5), svector::Vector2D(-2, 2),
+      svector::Vector2D(0, 1)};
+
+  std::vector<std::size_t> order(5);
+  svector::sortByLength(vectors.data(), 5, order.data());
+  // equal lengths keep their order
+  EXPECT_EQ(order, (std::vector<std::size_t>{1, 4, 3, 0, 2}));
+
+  svector::sortByLength(vectors.data(), 5);
+  EXPECT_EQ(vectors[0], svector::Vector2D(1, 0));
+  EXPECT_EQ(vectors[2], svector::Vector2D(-2, 2));
+  EXPECT_EQ(vectors[4], svector::Vector2D(0, -5));
+
+  std::vector<svector::Vector3D> points = makePoints(500);
+  svector::sortByLength(points.data(), points.size());
+  for (std::size_t i = 1; i < points.size(); i++) {
+    ASSERT_LE(points[i - 1].magn(), points[i].magn());
+  }
+}
@@ -0,0 +1,112 @@
+#include "simplevectors/vectors.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+
+namespace {
+std::vector<svector::Vector3D> makeVectors(const std::size_t n) {
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<double> dist(-100, 100);
+  std::vector<svector::Vector3D> result;
+  for (std::size_t i = 0; i < n; i++) {
+    result.push_back(svector::Vector3D(dist(gen), dist(gen), dist(gen)));
+  }
+  return result;
+}
+} // namespace
+
+TEST(MathPolicyTest, Exact) {
+  // the default policy gives the results of the standard library
+  for (const svector::Vector3D &v : makeVectors(100)) {
+    const double magnitude =
+        std::sqrt(v.x() * v.x() + v.y() * v.y() + v.z() * v.z());
+    EXPECT_EQ(v.magn(), magnitude);
+    EXPECT_EQ(svector::magn(v), magnitude);
+    EXPECT_EQ(v.normalize()[1], v.y() / magnitude);
+    EXPECT_EQ(svector::normalize(v)[2], v.z() / magnitude);
+    EXPECT_EQ(v.angle<svector::BETA>(), std::acos(v.y() / magnitude));
+    EXPECT_EQ(svector::gamma(v), std::acos(v.z() / magnitude));
+
+    const svector::Vector2D flat(v.x(), v.y());
+    EXPECT_EQ(flat.angle(), std::atan2(v.y(), v.x()));
+    EXPECT_EQ(svector::angle(flat), std::atan2(v.y(), v.x()));
+    EXPECT_EQ(flat.rotate(v.z()).x(),
+              v.x() * std::cos(v.z()) - v.y() * std::sin(v.z()));
+    EXPECT_EQ(svector::rotateBeta(v, 0.3).z(),
+              -v.x() * std::sin(0.3) + v.z() * std::cos(0.3));
+  }
+}
+
+TEST(MathPolicyTest, Fast) {
+  for (const svector::Vector3D &v : makeVectors(1000)) {
+    const double magnitude = v.magn();
+    const svector::Vector3D unit = v.normalize<svector::FastMath>();
+    ASSERT_LT(std::abs(unit.x() - v.x() / magnitude), 4.5e-16);
+    ASSERT_LT(std::abs(unit.magn() - 1), 1e-15);
+
+    const svector::Vector<3> fromFunction =
+        svector::normalize<double, 3, svector::FastMath>(v);
+    ASSERT_EQ(fromFunction[0], unit.x());
+
+    // the arccosine magnifies the last place of cosines near ±1
+    ASSERT_LT(std::abs(v.angle<svector::ALPHA, svector::FastMath>() -
+                       v.angle<svector::ALPHA>()),
+              4e-15);
+    ASSERT_LT(std::abs(svector::Vector2D(v.x(), v.y())
+                           .angle<svector::FastMath>() -
+                       std::atan2(v.y(), v.x())),
+              1e-15);
+  }
+}
+
+TEST(MathPolicyTest, FastRsqrt) {
+  // within one unit in the last place of the correctly rounded result
+  for (double x = 1e-300; x < 1e300; x *= 1.37) {
+    const long double exact = 1 / std::sqrt(static_cast<long double>(x));
+    const double rounded = static_cast<double>(exact);
+    const double ulp = std::nextafter(rounded, 2 * rounded) - rounded;
+    ASSERT_LE(std::abs(svector::FastMath::rsqrt(x) - rounded), ulp);
+  }
+  for (float x = 1e-30F; x < 1e30F; x *= 1.37F) {
+    const float rounded =
+        static_cast<float>(1 / std::sqrt(static_cast<double>(x)));
+    const float ulp = std::nextafter(rounded, 2 * rounded) - rounded;
+    ASSERT_LE(std::abs(svector::FastMath::rsqrt(x) - rounded), ulp);
+  }
+}
+
+TEST(MathPolicyTest, Approx) {
+  // reciprocal square roots over many orders of magnitude
+  for (double x = 1e-300; x < 1e300; x *= 1.37) {
+    ASSERT_LT(std::abs(svector::ApproxMath::rsqrt(x) * std::sqrt(x) - 1),
+              5e-6);
+    ASSERT_LT(std::abs(svector::ApproxMath::sqrt(x) / std::sqrt(x) - 1),
+              5e-6);
+  }
+  for (float x = 1e-30F; x < 1e30F; x *= 1.37F) {
+    ASSERT_LT(std::abs(svector::ApproxMath::rsqrt(x) * std::sqrt(x) - 1),
+              1e-5);
+  }
+  EXPECT_EQ(svector::ApproxMath::sqrt(0.0), 0);
+
+  // sines and cosines, also outside of [-π, π]
+  for (double ang = -50; ang < 50; ang += 0.01) {
+    ASSERT_LT(std::abs(svector::ApproxMath::sin(ang) - std::sin(ang)), 2e-7);
+    ASSERT_LT(std::abs(svector::ApproxMath::cos(ang) - std::cos(ang)), 2e-7);
+  }
+
+  for (const svector::Vector3D &v : makeVectors(1000)) {
+    ASSERT_LT(std::abs(v.normalize<svector::ApproxMath>().magn() - 1), 1e-5);
+    ASSERT_LT(std::abs(v.magn<svector::ApproxMath>() / v.magn() - 1), 5e-6);
+    ASSERT_LT(std::abs(svector::beta<svector::ApproxMath>(v) -
+                       svector::beta(v)),
+              1e-4);
+
+    const svector::Vector3D rotated =
+        v.rotate<svector::GAMMA, svector::ApproxMath>(v.x());
+    const svector::Vector3D exact = v.rotate<svector::GAMMA>(v.x());
+    ASSERT_LT((rotated - exact).magn(), 1e-6 * v.magn());
+  }
+}
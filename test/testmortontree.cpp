@@ -0,0 +1,122 @@
+#include "simplevectors/spatial/mortontree.hpp"
+#include "simplevectors/vectors.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+TEST(MortonTreeTest, Codes) {
+  // the four quadrants of a quadtree come in z order
+  std::vector<svector::Vector2D> points{{0, 0}, {1, 0}, {0, 1}, {1, 1}};
+  svector::Quadtree tree(points);
+  ASSERT_EQ(tree.size(), 4u);
+  for (std::size_t i = 0; i < 4; i++) {
+    EXPECT_EQ(tree.id(i), i);
+    EXPECT_EQ(tree.point(i), points[i]);
+  }
+
+  std::vector<svector::MortonCell> cells = tree.cells(1);
+  ASSERT_EQ(cells.size(), 4u);
+  for (std::size_t i = 0; i < 4; i++) {
+    EXPECT_EQ(cells[i].code, i);
+    EXPECT_EQ(cells[i].end - cells[i].begin, 1u);
+  }
+  EXPECT_EQ(tree.cells(0).size(), 1u);
+}
+
+TEST(MortonTreeTest, Queries) {
+  std::mt19937 gen(9);
+  std::uniform_real_distribution<double> dist(-10, 10);
+  std::vector<svector::Vector3D> points;
+  for (int i = 0; i < 3000; i++) {
+    points.push_back(svector::Vector3D(dist(gen), dist(gen), dist(gen)));
+  }
+  svector::Octree tree(points, 8);
+
+  for (int trial = 0; trial < 20; trial++) {
+    const svector::Vector3D a(dist(gen), dist(gen), dist(gen));
+    const svector::Vector3D b(dist(gen), dist(gen), dist(gen));
+    const svector::Vector3D lower(std::min(a.x(), b.x()),
+                                  std::min(a.y(), b.y()),
+                                  std::min(a.z(), b.z()));
+    const svector::Vector3D upper(std::max(a.x(), b.x()),
+                                  std::max(a.y(), b.y()),
+                                  std::max(a.z(), b.z()));
+    const double radius = std::abs(dist(gen)) / 2;
+
+    // a wedge of two half-spaces
+    std::vector<svector::Halfspace<svector::Vector3D>> wedge{
+        svector::makeHalfspace(svector::Vector3D(1, 1, 0), a),
+        svector::makeHalfspace(svector::Vector3D(0, -1, 1), a)};
+
+    std::vector<std::size_t> inBox;
+    std::vector<std::size_t> inBall;
+    std::vector<std::size_t> inWedge;
+    for (std::size_t i = 0; i < points.size(); i++) {
+      const svector::Vector3D &p = points[i];
+      if (p.x() >= lower.x() && p.x() <= upper.x() && p.y() >= lower.y() &&
+          p.y() <= upper.y() && p.z() >= lower.z() && p.z() <= upper.z()) {
+        inBox.push_back(i);
+      }
+      if ((p - a).magn() <= radius) {
+        inBall.push_back(i);
+      }
+      if (svector::signedDistance(wedge[0], p) >= 0 &&
+          svector::signedDistance(wedge[1], p) >= 0) {
+        inWedge.push_back(i);
+      }
+    }
+
+    std::vector<std::size_t> res;
+    tree.boxQuery(lower, upper, res);
+    std::sort(res.begin(), res.end());
+    EXPECT_EQ(res, inBox);
+
+    res.clear();
+    tree.radiusQuery(a, radius, res);
+    std::sort(res.begin(), res.end());
+    EXPECT_EQ(res, inBall);
+
+    res.clear();
+    tree.halfspaceQuery(wedge, res);
+    std::sort(res.begin(), res.end());
+    EXPECT_EQ(res, inWedge);
+  }
+}
+
+TEST(MortonTreeTest, InsertErase) {
+  svector::Quadtree tree;
+  std::vector<std::size_t> res;
+  tree.radiusQuery(svector::Vector2D(0, 0), 1, res);
+  EXPECT_TRUE(res.empty());
+
+  // the second and third points grow the root cell
+  tree.insert(svector::Vector2D(0, 0), 10);
+  tree.insert(svector::Vector2D(4, 4), 11);
+  tree.insert(svector::Vector2D(-4, 2), 12);
+  tree.insert(svector::Vector2D(1, 1), 13);
+  tree.insert(svector::Vector2D(1, 1), 14);
+  EXPECT_EQ(tree.size(), 5u);
+
+  tree.radiusQuery(svector::Vector2D(0.5, 0.5), 1, res);
+  std::sort(res.begin(), res.end());
+  std::vector<std::size_t> near{10, 13, 14};
+  EXPECT_EQ(res, near);
+
+  EXPECT_TRUE(tree.erase(svector::Vector2D(1, 1), 13));
+  EXPECT_FALSE(tree.erase(svector::Vector2D(1, 1), 13));
+  EXPECT_FALSE(tree.erase(svector::Vector2D(4, 4), 14));
+
+  res.clear();
+  tree.boxQuery(svector::Vector2D(-5, -5), svector::Vector2D(5, 5), res);
+  std::sort(res.begin(), res.end());
+  std::vector<std::size_t> all{10, 11, 12, 14};
+  EXPECT_EQ(res, all);
+
+  // codes stay sorted
+  for (std::size_t i = 1; i < tree.size(); i++) {
+    EXPECT_LE(tree.code(i - 1), tree.code(i));
+  }
+}
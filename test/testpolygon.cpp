@@ -0,0 +1,104 @@
+#include "simplevectors/geometry/polygon.hpp"
+#include "simplevectors/vectors.hpp"
+
+#include <gtest/gtest.h>
+
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <random>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+double round3(const double num) { return std::round(num * 1000) / 1000; }
+} // namespace
+
+TEST(PolygonTest, AreaPerimeterCentroid) {
+  std::vector<svector::Vector2D> square{{1, 1}, {3, 1}, {3, 3}, {1, 3}};
+  EXPECT_EQ(svector::polygonArea(square), 4);
+  EXPECT_EQ(svector::polygonPerimeter(square), 8);
+  EXPECT_EQ(svector::polygonCentroid(square), svector::Vector2D(2, 2));
+
+  // clockwise order gives a negative area but the same centroid
+  std::vector<svector::Vector2D> clockwise(square.rbegin(), square.rend());
+  EXPECT_EQ(svector::polygonArea(clockwise), -4);
+  EXPECT_EQ(svector::polygonCentroid(clockwise), svector::Vector2D(2, 2));
+
+  // L shape made of a 2x1 and a 1x1 square
+  std::vector<svector::Vector2D> ell{{0, 0}, {2, 0}, {2, 1},
+                                     {1, 1}, {1, 2}, {0, 2}};
+  EXPECT_EQ(svector::polygonArea(ell), 3);
+  svector::Vector2D c = svector::polygonCentroid(ell);
+  EXPECT_EQ(round3(c.x()), round3(5.0 / 6));
+  EXPECT_EQ(round3(c.y()), round3(5.0 / 6));
+
+  std::vector<svector::Vector2D> line{{0, 0}, {2, 2}};
+  EXPECT_EQ(svector::polygonArea(line), 0);
+  EXPECT_EQ(svector::polygonCentroid(line), svector::Vector2D(1, 1));
+}
+
+TEST(PolygonTest, Winding) {
+  std::vector<svector::Vector2D> square{{0, 0}, {2, 0}, {2, 2}, {0, 2}};
+  EXPECT_EQ(svector::windingNumber(square, svector::Vector2D(1, 1)), 1);
+  EXPECT_EQ(svector::windingNumber(square, svector::Vector2D(3, 1)), 0);
+
+  std::vector<svector::Vector2D> clockwise(square.rbegin(), square.rend());
+  EXPECT_EQ(svector::windingNumber(clockwise, svector::Vector2D(1, 1)), -1);
+
+  // a star whose middle is wound around twice
+  std::vector<svector::Vector2D> star;
+  for (int i = 0; i < 5; i++) {
+    const double angle = 2 * M_PI * (2 * i) / 5;
+    star.push_back(svector::Vector2D(std::cos(angle), std::sin(angle)));
+  }
+  EXPECT_EQ(svector::windingNumber(star, svector::Vector2D(0, 0)), 2);
+  EXPECT_EQ(svector::windingNumber(star, svector::Vector2D(0.8, 0.03)), 1);
+}
+
+TEST(PolygonTest, BatchAndSlabsMatchSingle) {
+  std::vector<svector::Vector2D> ring;
+  for (int i = 0; i < 200; i++) {
+    const double angle = 2 * M_PI * i / 200;
+    const double r = 1 + 0.3 * std::sin(7 * angle);
+    ring.push_back(svector::Vector2D(r * std::cos(angle), r * std::sin(angle)));
+  }
+
+  std::mt19937 gen(4);
+  std::uniform_real_distribution<double> dist(-1.5, 1.5);
+  std::vector<svector::Vector2D> points;
+  for (int i = 0; i < 1000; i++) {
+    points.push_back(svector::Vector2D(dist(gen), dist(gen)));
+  }
+
+  std::vector<int> batch = svector::windingNumbers(ring, points);
+  svector::PolygonSlabs slabs(ring);
+  svector::PolygonSlabs fewSlabs(ring, 3);
+  std::vector<int> slabbed(points.size());
+  slabs.winding(points.data(), points.size(), slabbed.data());
+
+  int inside = 0;
+  for (std::size_t i = 0; i < points.size(); i++) {
+    const int single = svector::windingNumber(ring, points[i]);
+    EXPECT_EQ(batch[i], single);
+    EXPECT_EQ(slabbed[i], single);
+    EXPECT_EQ(fewSlabs.winding(points[i]), single);
+    EXPECT_EQ(slabs.contains(points[i]), single != 0);
+    inside += single != 0;
+  }
+
+  EXPECT_GT(inside, 0);
+  EXPECT_LT(inside, 1000);
+}
+
+TEST(PolygonTest, SlabsDegenerate) {
+  std::vector<svector::Vector2D> flat{{0, 0}, {1, 0}, {2, 0}};
+  svector::PolygonSlabs slabs(flat);
+  EXPECT_EQ(slabs.winding(svector::Vector2D(1, 0)), 0);
+
+  std::vector<svector::Vector2D> empty;
+  svector::PolygonSlabs none(empty);
+  EXPECT_FALSE(none.contains(svector::Vector2D(0, 0)));
+}
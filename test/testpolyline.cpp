@@ -0,0 +1,125 @@
+#include "simplevectors/geometry/polyline.hpp"
+#include "simplevectors/vectors.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+namespace {
+double round3(const double num) { return std::round(num * 1000) / 1000; }
+} // namespace
+
+TEST(VectorTraitsTest, DerivedClasses) {
+  EXPECT_EQ(svector::VectorTraits<svector::Vector2D>::dimensions, 2);
+  EXPECT_EQ(svector::VectorTraits<svector::Vector3D>::dimensions, 3);
+  EXPECT_EQ((svector::VectorTraits<svector::Vector<5, float>>::dimensions), 5);
+
+  bool isFloat = std::is_same<
+      svector::VectorTraits<svector::Vector<5, float>>::value_type,
+      float>::value;
+  EXPECT_TRUE(isFloat);
+}
+
+TEST(PolylineTest, DouglasPeuckerStraightLine) {
+  std::vector<svector::Vector2D> line;
+  for (int i = 0; i <= 10; i++) {
+    line.push_back(svector::Vector2D(i, 2 * i));
+  }
+
+  std::vector<std::size_t> kept = svector::douglasPeucker(line, 0.01);
+  std::vector<std::size_t> res{0, 10};
+  EXPECT_EQ(kept, res);
+}
+
+TEST(PolylineTest, DouglasPeuckerKeepsCorners) {
+  std::vector<svector::Vector2D> line{{0, 0}, {1, 0.01}, {2, 0},
+                                      {3, 0}, {3, 1},    {3.01, 2},
+                                      {3, 3}, {4, 3}};
+
+  std::vector<std::size_t> kept = svector::douglasPeucker(line, 0.1);
+  std::vector<std::size_t> res{0, 3, 6, 7};
+  EXPECT_EQ(kept, res);
+
+  // zero tolerance keeps every point that isn't exactly collinear
+  std::vector<std::size_t> all = svector::douglasPeucker(line, 0.0);
+  std::vector<std::size_t> res2{0, 1, 2, 3, 4, 5, 6, 7};
+  EXPECT_EQ(all, res2);
+
+  std::vector<svector::Vector2D> simple = svector::selectPoints(line, kept);
+  ASSERT_EQ(simple.size(), 4);
+  EXPECT_EQ(simple[2], svector::Vector2D(3, 3));
+}
+
+TEST(PolylineTest, DouglasPeucker3D) {
+  std::vector<svector::Vector3D> line{
+      {0, 0, 0}, {1, 0, 0.01}, {2, 0, 0}, {2, 1, 0}, {2, 2, 0.01}};
+  std::vector<std::size_t> kept = svector::douglasPeucker(line, 0.1);
+  std::vector<std::size_t> res{0, 2, 4};
+  EXPECT_EQ(kept, res);
+}
+
+TEST(PolylineTest, DouglasPeuckerSmallInputs) {
+  std::vector<svector::Vector2D> empty;
+  EXPECT_TRUE(svector::douglasPeucker(empty, 1.0).empty());
+
+  std::vector<svector::Vector2D> two{{0, 0}, {1, 1}};
+  EXPECT_EQ(svector::douglasPeucker(two, 1.0).size(), 2);
+}
+
+TEST(PolylineTest, VisvalingamWhyatt) {
+  // a spike in the middle of a flat line with some small noise
+  std::vector<svector::Vector2D> line{{0, 0}, {1, 0.01}, {2, 0},
+                                      {3, 5}, {4, 0},    {5, -0.01},
+                                      {6, 0}};
+
+  std::vector<std::size_t> kept = svector::visvalingamWhyatt(line, 0.5);
+  std::vector<std::size_t> res{0, 2, 3, 4, 6};
+  EXPECT_EQ(kept, res);
+
+  // huge threshold leaves the ends only
+  std::vector<std::size_t> ends = svector::visvalingamWhyatt(line, 1000.0);
+  std::vector<std::size_t> res2{0, 6};
+  EXPECT_EQ(ends, res2);
+
+  // tiny threshold removes only collinear points
+  std::vector<svector::Vector2D> straight{{0, 0}, {1, 1}, {2, 2}, {3, 0}};
+  std::vector<std::size_t> res3{0, 2, 3};
+  EXPECT_EQ(svector::visvalingamWhyatt(straight, 1e-9), res3);
+}
+
+TEST(PolylineTest, Length) {
+  std::vector<svector::Vector3D> line{{0, 0, 0}, {3, 4, 0}, {3, 4, 2}};
+  EXPECT_EQ(svector::polylineLength(line), 7);
+}
+
+TEST(PolylineTest, ResampleUniform) {
+  std::vector<svector::Vector2D> line{{0, 0}, {4, 0}, {4, 2}};
+
+  std::vector<svector::Vector2D> res = svector::resample(line, 7);
+  ASSERT_EQ(res.size(), 7);
+  EXPECT_EQ(res[0], svector::Vector2D(0, 0));
+  EXPECT_EQ(res[2], svector::Vector2D(2, 0));
+  EXPECT_EQ(res[4], svector::Vector2D(4, 0));
+  EXPECT_EQ(round3(res[5].x()), 4);
+  EXPECT_EQ(round3(res[5].y()), 1);
+  EXPECT_EQ(res[6], svector::Vector2D(4, 2));
+
+  // spacing between consecutive points is constant along the path
+  std::vector<svector::Vector2D> coarse{{0, 0}, {10, 0}};
+  std::vector<svector::Vector2D> fine = svector::resample(coarse, 11);
+  for (std::size_t i = 0; i < fine.size(); i++) {
+    EXPECT_EQ(round3(fine[i].x()), i);
+  }
+}
+
+TEST(PolylineTest, ResampleDegenerate) {
+  std::vector<svector::Vector2D> one{{1, 2}};
+  std::vector<svector::Vector2D> res = svector::resample(one, 3);
+  ASSERT_EQ(res.size(), 3);
+  EXPECT_EQ(res[2], svector::Vector2D(1, 2));
+
+  std::vector<svector::Vector2D> empty;
+  EXPECT_TRUE(svector::resample(empty, 3).empty());
+}
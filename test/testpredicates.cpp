@@ -0,0 +1,179 @@
+#include "simplevectors/geometry/predicates.hpp"
+#include "simplevectors/vectors.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <utility>
+
+TEST(PredicateTest, Orient2D) {
+  svector::Vector2D a(0, 0);
+  svector::Vector2D b(1, 0);
+  svector::Vector2D c(0, 1);
+  EXPECT_GT(svector::orient2d(a, b, c), 0);
+  EXPECT_LT(svector::orient2d(a, c, b), 0);
+  EXPECT_EQ(svector::orient2d(a, b, svector::Vector2D(5, 0)), 0);
+}
+
+TEST(PredicateTest, Orient2DNearlyCollinear) {
+  // points on the line y = x, perturbed by one ulp at a time; the sign must
+  // agree with the side of the line the point is actually on
+  svector::Vector2D q(12, 12);
+  svector::Vector2D r(24, 24);
+  const double ulp = 1.1102230246251565e-16;
+  for (int i = 0; i < 64; i++) {
+    for (int j = 0; j < 64; j++) {
+      svector::Vector2D p(0.5 + i * ulp, 0.5 + j * ulp);
+      const double o = svector::orient2d(p, q, r);
+      if (p.x() == p.y()) {
+        EXPECT_EQ(o, 0);
+      } else if (p.y() > p.x()) {
+        EXPECT_GT(o, 0);
+      } else {
+        EXPECT_LT(o, 0);
+      }
+    }
+  }
+}
+
+TEST(PredicateTest, Orient3D) {
+  svector::Vector3D a(0, 0, 0);
+  svector::Vector3D b(1, 0, 0);
+  svector::Vector3D c(0, 1, 0);
+  EXPECT_GT(svector::orient3d(a, b, c, svector::Vector3D(0, 0, -1)), 0);
+  EXPECT_LT(svector::orient3d(a, b, c, svector::Vector3D(0, 0, 1)), 0);
+  EXPECT_EQ(svector::orient3d(a, b, c, svector::Vector3D(3, 7, 0)), 0);
+
+  // repeated point is always coplanar, even with inexact coordinates
+  svector::Vector3D p(0.1, 0.2, 0.3);
+  svector::Vector3D q(0.7, 0.1, 0.9);
+  svector::Vector3D s(5, 5, 5);
+  EXPECT_EQ(svector::orient3d(p, q, p, s), 0);
+  EXPECT_NE(svector::orient3d(p, q, s, svector::Vector3D(1, 0, 0)), 0);
+}
+
+TEST(PredicateTest, Orient3DNearlyCoplanar) {
+  // a point close to the plane z = x through nearby inexact points; the
+  // differences are exact, so the cheaper exact stage is exercised
+  svector::Vector3D a(0.5, 0, 0.5);
+  svector::Vector3D b(0.75, 1, 0.75);
+  svector::Vector3D c(1.25, 0, 1.25);
+  const double above = svector::orient3d(a, b, c, svector::Vector3D(1, 0.5, 2));
+  ASSERT_NE(above, 0);
+  EXPECT_EQ(svector::orient3d(a, b, c, svector::Vector3D(1, 0.5, 1)), 0);
+
+  double up = 1;
+  double down = 1;
+  for (int i = 0; i < 8; i++) {
+    up = std::nextafter(up, 2.0);
+    down = std::nextafter(down, 0.0);
+    const double o1 = svector::orient3d(a, b, c, svector::Vector3D(1, 0.5, up));
+    const double o2 =
+        svector::orient3d(a, b, c, svector::Vector3D(1, 0.5, down));
+    EXPECT_EQ(o1 > 0, above > 0);
+    EXPECT_NE(o1, 0);
+    EXPECT_EQ(o2 > 0, above < 0);
+    EXPECT_NE(o2, 0);
+  }
+
+  // far apart coordinates do not subtract exactly
+  svector::Vector3D p(1e20, 0, 0);
+  svector::Vector3D q(0, 1e-20, 0);
+  svector::Vector3D r(0, 0, 1);
+  EXPECT_EQ(svector::orient3d(p, q, r, p), 0);
+}
+
+TEST(PredicateTest, Incircle) {
+  svector::Vector2D a(1, 0);
+  svector::Vector2D b(0, 1);
+  svector::Vector2D c(-1, 0);
+  EXPECT_GT(svector::incircle(a, b, c, svector::Vector2D(0, 0)), 0);
+  EXPECT_LT(svector::incircle(a, b, c, svector::Vector2D(2, 2)), 0);
+  EXPECT_EQ(svector::incircle(a, b, c, svector::Vector2D(0, -1)), 0);
+
+  // clockwise order flips the sign
+  EXPECT_LT(svector::incircle(a, c, b, svector::Vector2D(0, 0)), 0);
+}
+
+TEST(PredicateTest, IncircleNearlyCocircular) {
+  // four corners of a square are cocircular; moving the last one by single
+  // ulps must give signs consistent with moving it inwards or outwards
+  const double base = 0.1;
+  svector::Vector2D a(base, base);
+  svector::Vector2D b(base + 1, base);
+  svector::Vector2D c(base + 1, base + 1);
+  EXPECT_EQ(svector::incircle(a, b, c, svector::Vector2D(base, base + 1)), 0);
+
+  double inward = base + 1;
+  double outward = base + 1;
+  for (int i = 0; i < 16; i++) {
+    inward = std::nextafter(inward, 0.0);
+    outward = std::nextafter(outward, 2.0);
+    EXPECT_GT(svector::incircle(a, b, c, svector::Vector2D(base, inward)), 0);
+    EXPECT_LT(svector::incircle(a, b, c, svector::Vector2D(base, outward)),
+              0);
+  }
+}
+
+TEST(PredicateTest, Insphere) {
+  svector::Vector3D a(1, 0, 0);
+  svector::Vector3D b(0, 1, 0);
+  svector::Vector3D c(-1, 0, 0);
+  svector::Vector3D d(0, 0, 1);
+  if (svector::orient3d(a, b, c, d) < 0) {
+    std::swap(a, b);
+  }
+  ASSERT_GT(svector::orient3d(a, b, c, d), 0);
+
+  EXPECT_GT(svector::insphere(a, b, c, d, svector::Vector3D(0, 0, 0)), 0);
+  EXPECT_LT(svector::insphere(a, b, c, d, svector::Vector3D(0, 0, 2)), 0);
+  EXPECT_EQ(svector::insphere(a, b, c, d, svector::Vector3D(0, -1, 0)), 0);
+  EXPECT_EQ(svector::insphere(a, b, c, d, svector::Vector3D(0, 0, -1)), 0);
+
+  // cospherical corners of a cube with inexact coordinates
+  const double base = 0.3;
+  svector::Vector3D p(base, base, base);
+  svector::Vector3D q(base + 1, base, base);
+  svector::Vector3D r(base, base + 1, base);
+  svector::Vector3D s(base, base, base + 1);
+  if (svector::orient3d(p, q, r, s) < 0) {
+    std::swap(p, q);
+  }
+
+  const double far = base + 1;
+  EXPECT_EQ(svector::insphere(p, q, r, s, svector::Vector3D(far, far, far)),
+            0);
+  const double in = std::nextafter(far, 0.0);
+  const double out = std::nextafter(far, 2.0);
+  EXPECT_GT(svector::insphere(p, q, r, s, svector::Vector3D(far, far, in)), 0);
+  EXPECT_LT(svector::insphere(p, q, r, s, svector::Vector3D(far, far, out)),
+            0);
+}
+
+TEST(PredicateTest, RandomAgreesWithFilter) {
+  // well-separated random points are decided by the floating-point filter,
+  // so the sign must match the naive evaluation
+  std::mt19937 gen(3);
+  std::uniform_real_distribution<double> dist(-1, 1);
+  for (int i = 0; i < 1000; i++) {
+    svector::Vector2D a(dist(gen), dist(gen));
+    svector::Vector2D b(dist(gen), dist(gen));
+    svector::Vector2D c(dist(gen), dist(gen));
+    svector::Vector2D d(dist(gen), dist(gen));
+
+    const double adx = a.x() - d.x();
+    const double ady = a.y() - d.y();
+    const double bdx = b.x() - d.x();
+    const double bdy = b.y() - d.y();
+    const double cdx = c.x() - d.x();
+    const double cdy = c.y() - d.y();
+    const double naive =
+        (adx * adx + ady * ady) * (bdx * cdy - cdx * bdy) +
+        (bdx * bdx + bdy * bdy) * (cdx * ady - adx * cdy) +
+        (cdx * cdx + cdy * cdy) * (adx * bdy - bdx * ady);
+    if (std::abs(naive) > 1e-6) {
+      EXPECT_EQ(svector::incircle(a, b, c, d) > 0, naive > 0);
+    }
+  }
+}
@@ -0,0 +1,136 @@
+#include "simplevectors/geometry/rays.hpp"
+#include "simplevectors/vectors.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+
+namespace {
+double round3(const double num) { return std::round(num * 1000) / 1000; }
+} // namespace
+
+TEST(RayTest, Sphere) {
+  svector::RayPacket4 rays;
+  rays.set(0, svector::Vector3D(0, 0, -5), svector::Vector3D(0, 0, 1));
+  rays.set(1, svector::Vector3D(0, 0, 0), svector::Vector3D(0, 0, 2));
+  rays.set(2, svector::Vector3D(0, 3, -5), svector::Vector3D(0, 0, 1));
+  rays.set(3, svector::Vector3D(0, 0, 5), svector::Vector3D(0, 0, 1));
+
+  svector::HitPacket4 hits;
+  hits.reset();
+  svector::intersectSphere(rays, svector::Vector3D(0, 0, 0), 2, 7, hits);
+
+  EXPECT_EQ(round3(hits.t[0]), 3);
+  EXPECT_EQ(hits.nz[0], -1);
+  EXPECT_EQ(hits.id[0], 7u);
+
+  // starting inside hits the far side, measured in direction lengths
+  EXPECT_EQ(round3(hits.t[1]), 1);
+  EXPECT_EQ(hits.nz[1], 1);
+
+  EXPECT_FALSE(hits.hit(2));
+  EXPECT_FALSE(hits.hit(3));
+}
+
+TEST(RayTest, Plane) {
+  svector::RayPacket4 rays;
+  svector::Vector3D origins[] = {svector::Vector3D(0, 0, 3),
+                                 svector::Vector3D(1, 1, 3),
+                                 svector::Vector3D(0, 0, 3)};
+  svector::Vector3D dirs[] = {svector::Vector3D(0, 0, -1),
+                              svector::Vector3D(1, 0, 0),
+                              svector::Vector3D(0, 0, 1)};
+  rays.load(origins, dirs, 3);
+
+  svector::HitPacket4 hits;
+  hits.reset();
+  svector::intersectPlane(rays, svector::Vector3D(0, 0, 1),
+                          svector::Vector3D(0, 0, 4), 1, hits);
+
+  EXPECT_EQ(hits.t[0], 2);
+  EXPECT_EQ(hits.nz[0], 1);
+  EXPECT_FALSE(hits.hit(1)); // parallel
+  EXPECT_FALSE(hits.hit(2)); // pointing away
+  EXPECT_FALSE(hits.hit(3)); // padding
+}
+
+TEST(RayTest, Box) {
+  svector::RayPacket4 rays;
+  rays.set(0, svector::Vector3D(-5, 0.5, 0.5), svector::Vector3D(1, 0, 0));
+  rays.set(1, svector::Vector3D(0.5, 5, 0.5), svector::Vector3D(0, -1, 0));
+  rays.set(2, svector::Vector3D(0.5, 0.5, 0.5), svector::Vector3D(0, 0, 1));
+  rays.set(3, svector::Vector3D(-5, 5, 0.5), svector::Vector3D(1, 0, 0));
+
+  svector::HitPacket4 hits;
+  hits.reset();
+  svector::intersectBox(rays, svector::Vector3D(0, 0, 0),
+                        svector::Vector3D(1, 1, 1), 3, hits);
+
+  EXPECT_EQ(hits.t[0], 5);
+  EXPECT_EQ(hits.nx[0], -1);
+  EXPECT_EQ(hits.ny[0], 0);
+  EXPECT_EQ(hits.t[1], 4);
+  EXPECT_EQ(hits.ny[1], 1);
+
+  // from the inside, the exit face is hit
+  EXPECT_EQ(hits.t[2], 0.5);
+  EXPECT_EQ(hits.nz[2], 1);
+
+  EXPECT_FALSE(hits.hit(3));
+}
+
+TEST(RayTest, Triangle) {
+  svector::RayPacket4 rays;
+  rays.set(0, svector::Vector3D(0.2, 0.2, 1), svector::Vector3D(0, 0, -1));
+  rays.set(1, svector::Vector3D(0.2, 0.2, -1), svector::Vector3D(0, 0, 1));
+  rays.set(2, svector::Vector3D(0.8, 0.8, 1), svector::Vector3D(0, 0, -1));
+  rays.set(3, svector::Vector3D(0, 0, 1), svector::Vector3D(1, 0, 0));
+
+  svector::HitPacket4 hits;
+  hits.reset();
+  svector::intersectTriangle(rays, svector::Vector3D(0, 0, 0),
+                             svector::Vector3D(1, 0, 0),
+                             svector::Vector3D(0, 1, 0), 2, hits);
+
+  EXPECT_EQ(hits.t[0], 1);
+  EXPECT_EQ(hits.nz[0], 1);
+  EXPECT_EQ(hits.t[1], 1);
+  EXPECT_EQ(hits.nz[1], 1);
+  EXPECT_FALSE(hits.hit(2));
+  EXPECT_FALSE(hits.hit(3));
+}
+
+TEST(RayTest, ClosestHit) {
+  // a wall of two triangles behind a sphere
+  std::mt19937 gen(3);
+  std::uniform_real_distribution<double> dist(-1, 1);
+
+  svector::RayPacket8 rays;
+  for (std::size_t i = 0; i < 8; i++) {
+    rays.set(i, svector::Vector3D(dist(gen), dist(gen), -5),
+             svector::Vector3D(0, 0, 1));
+  }
+
+  svector::HitPacket8 hits;
+  hits.reset(100);
+  svector::intersectTriangle(rays, svector::Vector3D(-2, -2, 3),
+                             svector::Vector3D(2, -2, 3),
+                             svector::Vector3D(2, 2, 3), 0, hits);
+  svector::intersectTriangle(rays, svector::Vector3D(-2, -2, 3),
+                             svector::Vector3D(2, 2, 3),
+                             svector::Vector3D(-2, 2, 3), 1, hits);
+  svector::intersectSphere(rays, svector::Vector3D(0, 0, 0), 0.5, 2, hits);
+
+  for (std::size_t i = 0; i < 8; i++) {
+    const double r2 = rays.ox[i] * rays.ox[i] + rays.oy[i] * rays.oy[i];
+    EXPECT_TRUE(hits.hit(i, 100));
+    if (r2 < 0.25) {
+      EXPECT_EQ(hits.id[i], 2u);
+      EXPECT_EQ(round3(hits.t[i]), round3(5 - std::sqrt(0.25 - r2)));
+    } else {
+      EXPECT_LT(hits.id[i], 2u);
+      EXPECT_EQ(round3(hits.t[i]), 8);
+    }
+  }
+}
@@ -0,0 +1,307 @@
+#include "simplevectors/physics/rigidbody.hpp"
+#include "simplevectors/vectors.hpp"
+
+#include <gtest/gtest.h>
+
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+double round3(const double num) { return std::round(num * 1000) / 1000; }
+
+// contacts of spheres with each other and with the ground plane y = 0,
+// where the ground is body 0
+std::vector<svector::Contact>
+sphereContacts(const svector::RigidBodyWorld &world, const double radius) {
+  std::vector<svector::Contact> contacts;
+  for (std::size_t i = 1; i < world.size(); i++) {
+    const svector::Vector3D p = world.position(i);
+    if (p.y() < radius) {
+      contacts.push_back(svector::Contact(
+          0, i, svector::Vector3D(p.x(), 0, p.z()),
+          svector::Vector3D(0, 1, 0), radius - p.y()));
+    }
+
+    for (std::size_t j = i + 1; j < world.size(); j++) {
+      const svector::Vector3D q = world.position(j);
+      const svector::Vector3D d(q.x() - p.x(), q.y() - p.y(), q.z() - p.z());
+      const double distance = d.magn();
+      if (distance < 2 * radius) {
+        contacts.push_back(svector::Contact(
+            i, j,
+            svector::Vector3D((p.x() + q.x()) / 2, (p.y() + q.y()) / 2,
+                              (p.z() + q.z()) / 2),
+            svector::Vector3D(d.x() / distance, d.y() / distance,
+                              d.z() / distance),
+            2 * radius - distance));
+      }
+    }
+  }
+  return contacts;
+}
+} // namespace
+
+TEST(RigidBodyTest, Quaternion) {
+  const svector::Quaternion q =
+      svector::axisAngle(svector::Vector3D(0, 0, 2), M_PI / 2);
+  const svector::Vector3D v = q.rotate(svector::Vector3D(1, 0, 0));
+  EXPECT_EQ(round3(v.x()), 0);
+  EXPECT_EQ(round3(v.y()), 1);
+  EXPECT_EQ(round3(v.z()), 0);
+
+  const svector::Vector3D back = q.conjugate().rotate(v);
+  EXPECT_EQ(round3(back.x()), 1);
+  EXPECT_EQ(round3(back.y()), 0);
+
+  // two quarter turns make a half turn
+  const svector::Vector3D twice = (q * q).rotate(svector::Vector3D(1, 0, 0));
+  EXPECT_EQ(round3(twice.x()), -1);
+  EXPECT_EQ(round3(twice.y()), 0);
+
+  const svector::Quaternion n = svector::Quaternion(2, 0, 0, 0).normalized();
+  EXPECT_EQ(n.w, 1);
+}
+
+TEST(RigidBodyTest, MassProperties) {
+  const svector::MassProperties sphere = svector::sphereMass(1, 1);
+  EXPECT_EQ(round3(sphere.mass), round3(4 * M_PI / 3));
+  EXPECT_EQ(round3(sphere.inertia.xx), round3(0.4 * sphere.mass));
+
+  // 2 x 4 x 6 box with density 1
+  const svector::MassProperties box =
+      svector::boxMass(1, svector::Vector3D(1, 2, 3));
+  EXPECT_EQ(box.mass, 48);
+  EXPECT_EQ(box.inertia.xx, 48.0 / 12 * (16 + 36));
+  EXPECT_EQ(box.inertia.yy, 48.0 / 12 * (4 + 36));
+  EXPECT_EQ(box.inertia.zz, 48.0 / 12 * (4 + 16));
+
+  // two unit cubes side by side make a 2 x 1 x 1 box
+  const svector::MassProperties cube =
+      svector::boxMass(1, svector::Vector3D(0.5, 0.5, 0.5));
+  const svector::MassProperties both = svector::combineMass(
+      svector::translateMass(cube, svector::Vector3D(1.5, 0, 0)),
+      svector::translateMass(cube, svector::Vector3D(2.5, 0, 0)));
+  const svector::MassProperties wide =
+      svector::boxMass(1, svector::Vector3D(1, 0.5, 0.5));
+  EXPECT_EQ(both.mass, 2);
+  EXPECT_EQ(both.center.x(), 2);
+  EXPECT_EQ(round3(both.inertia.xx), round3(wide.inertia.xx));
+  EXPECT_EQ(round3(both.inertia.yy), round3(wide.inertia.yy));
+  EXPECT_EQ(round3(both.inertia.zz), round3(wide.inertia.zz));
+  EXPECT_EQ(both.inertia.xy, 0);
+}
+
+TEST(RigidBodyTest, InertiaTensor) {
+  svector::InertiaTensor tensor(2, 3, 4);
+  tensor.xy = 0.5;
+  tensor.yz = -0.25;
+
+  const svector::InertiaTensor inverse = tensor.inverse();
+  const svector::Vector3D v(1, -2, 3);
+  const svector::Vector3D back = inverse.apply(tensor.apply(v));
+  EXPECT_EQ(round3(back.x()), 1);
+  EXPECT_EQ(round3(back.y()), -2);
+  EXPECT_EQ(round3(back.z()), 3);
+
+  EXPECT_EQ(svector::InertiaTensor(1, 0, 1).inverse().xx, 0);
+
+  // a quarter turn about z swaps the x and y moments
+  const svector::InertiaTensor rotated =
+      svector::InertiaTensor(1, 2, 3).rotated(
+          svector::axisAngle(svector::Vector3D(0, 0, 1), M_PI / 2));
+  EXPECT_EQ(round3(rotated.xx), 2);
+  EXPECT_EQ(round3(rotated.yy), 1);
+  EXPECT_EQ(round3(rotated.zz), 3);
+  EXPECT_EQ(round3(rotated.xy), 0);
+}
+
+TEST(RigidBodyTest, FreeFall) {
+  svector::RigidBodyWorld world;
+  const std::size_t body = world.add(svector::sphereMass(1, 1),
+                                     svector::Vector3D(0, 100, 0));
+  const std::size_t ground = world.addStatic(svector::Vector3D(0, 0, 0));
+  EXPECT_FALSE(world.isStatic(body));
+  EXPECT_TRUE(world.isStatic(ground));
+
+  world.angularVelocity(body, svector::Vector3D(0, M_PI, 0));
+  std::vector<svector::Contact> contacts;
+  for (int i = 0; i < 60; i++) {
+    world.step(contacts, 1.0 / 60);
+  }
+
+  EXPECT_EQ(round3(world.velocity(body).y()), -9.81);
+  EXPECT_EQ(round3(world.position(body).y()),
+            round3(100 - 9.81 * 61 / 120));
+  EXPECT_EQ(world.position(ground).y(), 0);
+
+  // half a turn about y
+  const svector::Vector3D x =
+      world.orientation(body).rotate(svector::Vector3D(1, 0, 0));
+  EXPECT_LT(std::abs(x.x() + 1), 0.01);
+  EXPECT_LT(std::abs(x.z()), 0.05);
+}
+
+TEST(RigidBodyTest, Forces) {
+  svector::RigidBodyWorld world;
+  world.gravity(svector::Vector3D(0, 0, 0));
+  const std::size_t body = world.add(
+      svector::boxMass(1, svector::Vector3D(0.5, 0.5, 0.5)),
+      svector::Vector3D(0, 0, 0));
+
+  // a force at the center only pushes
+  world.applyForce(body, svector::Vector3D(2, 0, 0),
+                   svector::Vector3D(0, 0, 0));
+  world.integrateVelocities(0.5);
+  EXPECT_EQ(world.velocity(body).x(), 1);
+  EXPECT_EQ(world.angularVelocity(body).magn(), 0);
+
+  // forces are cleared after a step
+  world.integrateVelocities(0.5);
+  EXPECT_EQ(world.velocity(body).x(), 1);
+
+  // an impulse off the center also spins the body about z
+  world.applyImpulse(body, svector::Vector3D(0, 1, 0),
+                     svector::Vector3D(0.5, 0, 0));
+  EXPECT_EQ(world.velocity(body).y(), 1);
+  EXPECT_EQ(round3(world.angularVelocity(body).z()), 3);
+}
+
+TEST(RigidBodyTest, Islands) {
+  svector::RigidBodyWorld world;
+  const svector::MassProperties mass = svector::sphereMass(1, 0.5);
+  const std::size_t ground = world.addStatic(svector::Vector3D(0, 0, 0));
+  for (int i = 0; i < 6; i++) {
+    world.add(mass, svector::Vector3D(i, 1, 0));
+  }
+
+  const svector::Vector3D up(0, 1, 0);
+  const svector::Vector3D origin(0, 0, 0);
+  std::vector<svector::Contact> contacts;
+  contacts.push_back(svector::Contact(ground, 1, origin, up, 0));
+  contacts.push_back(svector::Contact(ground, 2, origin, up, 0));
+  contacts.push_back(svector::Contact(4, 3, origin, up, 0));
+  contacts.push_back(svector::Contact(1, 5, origin, up, 0));
+  contacts.push_back(svector::Contact(ground, 4, origin, up, 0));
+
+  // the ground does not connect bodies, body 6 touches nothing
+  const svector::ContactIslands islands = world.islands(contacts);
+  ASSERT_EQ(islands.size(), 3u);
+
+  const std::vector<std::size_t> bodies = {1, 5, 2, 3, 4};
+  const std::vector<std::size_t> bodyOffsets = {0, 2, 3, 5};
+  const std::vector<std::size_t> contactIndices = {0, 3, 1, 2, 4};
+  const std::vector<std::size_t> contactOffsets = {0, 2, 3, 5};
+  EXPECT_EQ(islands.bodies, bodies);
+  EXPECT_EQ(islands.bodyOffsets, bodyOffsets);
+  EXPECT_EQ(islands.contacts, contactIndices);
+  EXPECT_EQ(islands.contactOffsets, contactOffsets);
+}
+
+TEST(RigidBodyTest, InelasticCollision) {
+  svector::RigidBodyWorld world;
+  world.gravity(svector::Vector3D(0, 0, 0));
+  const svector::MassProperties mass = svector::sphereMass(1, 0.5);
+  const std::size_t a = world.add(mass, svector::Vector3D(-0.5, 0, 0));
+  const std::size_t b = world.add(
+      svector::sphereMass(3, 0.5), svector::Vector3D(0.5, 0, 0));
+  world.velocity(a, svector::Vector3D(4, 0, 0));
+
+  std::vector<svector::Contact> contacts;
+  contacts.push_back(svector::Contact(a, b, svector::Vector3D(0, 0, 0),
+                                      svector::Vector3D(1, 0, 0), 0));
+  world.step(contacts, 1.0 / 60);
+
+  // momentum is kept and the spheres move together
+  EXPECT_EQ(round3(world.velocity(a).x()), 1);
+  EXPECT_EQ(round3(world.velocity(b).x()), 1);
+  EXPECT_EQ(round3(world.angularVelocity(a).magn()), 0);
+  EXPECT_GT(contacts[0].normalImpulse, 0);
+}
+
+TEST(RigidBodyTest, Bounce) {
+  svector::RigidBodyWorld world;
+  world.gravity(svector::Vector3D(0, 0, 0));
+  const std::size_t ground = world.addStatic(svector::Vector3D(0, 0, 0));
+  const std::size_t ball = world.add(svector::sphereMass(1, 0.5),
+                                     svector::Vector3D(0, 0.5, 0));
+  world.velocity(ball, svector::Vector3D(0, -5, 0));
+
+  std::vector<svector::Contact> contacts;
+  contacts.push_back(svector::Contact(ground, ball,
+                                      svector::Vector3D(0, 0, 0),
+                                      svector::Vector3D(0, 1, 0), 0, 0, 0.5));
+  world.step(contacts, 1.0 / 60);
+  EXPECT_EQ(round3(world.velocity(ball).y()), 2.5);
+}
+
+TEST(RigidBodyTest, Friction) {
+  svector::RigidBodyWorld world;
+  const std::size_t ground = world.addStatic(svector::Vector3D(0, 0, 0));
+  const std::size_t box = world.add(
+      svector::boxMass(1, svector::Vector3D(0.5, 0.5, 0.5)),
+      svector::Vector3D(0, 0.5, 0));
+  world.velocity(box, svector::Vector3D(2, 0, 0));
+
+  // four corners on the ground, kept between steps
+  std::vector<svector::Contact> contacts;
+  const double dt = 1.0 / 60;
+  for (int step = 0; step < 40; step++) {
+    if (step == 20) {
+      // sliding slows down by friction * g = 4.905 per second
+      EXPECT_LT(std::abs(world.velocity(box).x() - (2 - 4.905 * 20 * dt)),
+                0.01);
+    }
+
+    const svector::Vector3D p = world.position(box);
+    contacts.clear();
+    for (int corner = 0; corner < 4; corner++) {
+      contacts.push_back(svector::Contact(
+          ground, box,
+          svector::Vector3D(p.x() + (corner % 2 ? 0.5 : -0.5), 0,
+                            p.z() + (corner / 2 ? 0.5 : -0.5)),
+          svector::Vector3D(0, 1, 0), 0.5 - p.y(), 0.5));
+    }
+    world.step(contacts, dt);
+  }
+
+  // and then stops
+  EXPECT_LT(std::abs(world.velocity(box).x()), 0.01);
+  EXPECT_LT(std::abs(world.position(box).y() - 0.5), 0.01);
+  EXPECT_LT(world.angularVelocity(box).magn(), 0.05);
+}
+
+TEST(RigidBodyTest, Pile) {
+  // spheres dropped on the ground come to rest without sinking into it or
+  // into each other
+  const double radius = 0.5;
+  svector::RigidBodyWorld world;
+  world.addStatic(svector::Vector3D(0, 0, 0));
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 5; j++) {
+      for (int k = 0; k < 4; k++) {
+        world.add(svector::sphereMass(1, radius),
+                  svector::Vector3D(i * 1.1, 0.6 + k * 1.1 + 0.05 * (i + j),
+                                    j * 1.1));
+      }
+    }
+  }
+
+  for (int step = 0; step < 400; step++) {
+    std::vector<svector::Contact> contacts = sphereContacts(world, radius);
+    world.step(contacts, 1.0 / 60);
+  }
+
+  for (std::size_t i = 1; i < world.size(); i++) {
+    EXPECT_GT(world.position(i).y(), radius - 0.02);
+    EXPECT_LT(world.velocity(i).magn(), 0.1);
+  }
+
+  for (const svector::Contact &contact : sphereContacts(world, radius)) {
+    EXPECT_LT(contact.depth, 0.02);
+  }
+}
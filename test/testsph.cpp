@@ -0,0 +1,247 @@
+#include "simplevectors/physics/sph.hpp"
+#include "simplevectors/vectors.hpp"
+
+#include <gtest/gtest.h>
+
+#define _USE_MATH_DEFINES
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+double round3(const double num) { return std::round(num * 1000) / 1000; }
+
+// integral of a radial function over the ball of radius h
+template <typename F> double integrate(const F &f, const double h) {
+  const int steps = 10000;
+  double sum = 0;
+  for (int i = 0; i < steps; i++) {
+    const double r = (i + 0.5) * h / steps;
+    sum += 4 * M_PI * r * r * f(r) * h / steps;
+  }
+  return sum;
+}
+
+// a block of particles 0.02 apart with its lower corner at the origin
+void addBlock(svector::SPHFluid &fluid, const int nx, const int ny,
+              const int nz) {
+  for (int x = 0; x < nx; x++) {
+    for (int y = 0; y < ny; y++) {
+      for (int z = 0; z < nz; z++) {
+        fluid.add(svector::Vector3D(0.01 + 0.02 * x, 0.01 + 0.02 * y,
+                                    0.01 + 0.02 * z));
+      }
+    }
+  }
+}
+} // namespace
+
+TEST(SPHTest, Kernels) {
+  const svector::SPHKernel kernel(0.5);
+  EXPECT_EQ(kernel.h(), 0.5);
+
+  // the kernels integrate to one
+  EXPECT_EQ(round3(integrate(
+                [&kernel](const double r) { return kernel.poly6(r * r); },
+                0.5)),
+            1);
+
+  // the spiky kernel 15 / (pi h^6) (h - r)^3 has the gradient
+  // -45 / (pi h^6) (h - r)^2
+  const double r = 0.2;
+  EXPECT_EQ(round3(kernel.spikyGradient(r * r) * r),
+            round3(-45 / (M_PI * std::pow(0.5, 6)) * 0.09));
+  EXPECT_EQ(kernel.spikyGradient(0), 0);
+  EXPECT_EQ(kernel.poly6(0.25), 0);
+  EXPECT_EQ(kernel.spikyGradient(0.3), 0);
+  EXPECT_EQ(kernel.viscosityLaplacian(0.3), 0);
+  EXPECT_EQ(round3(kernel.viscosityLaplacian(r * r)),
+            round3(45 / (M_PI * std::pow(0.5, 6)) * 0.3));
+
+  // batches give the same values
+  const std::vector<double> r2 = {0, 0.01, 0.1, 0.2, 0.3};
+  std::vector<double> poly6(r2.size());
+  std::vector<double> gradient(r2.size());
+  std::vector<double> laplacian(r2.size());
+  kernel.poly6(r2.data(), poly6.data(), r2.size());
+  kernel.spikyGradient(r2.data(), gradient.data(), r2.size());
+  kernel.viscosityLaplacian(r2.data(), laplacian.data(), r2.size());
+  for (std::size_t i = 0; i < r2.size(); i++) {
+    EXPECT_EQ(poly6[i], kernel.poly6(r2[i]));
+    EXPECT_EQ(gradient[i], kernel.spikyGradient(r2[i]));
+    EXPECT_EQ(laplacian[i], kernel.viscosityLaplacian(r2[i]));
+  }
+}
+
+TEST(SPHTest, Neighbors) {
+  svector::SPHSettings settings;
+  svector::SPHFluid fluid(settings, svector::Vector3D(0, 0, 0),
+                          svector::Vector3D(0.5, 0.3, 0.4));
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<double> dist(0, 1);
+  for (int i = 0; i < 2000; i++) {
+    fluid.add(svector::Vector3D(0.5 * dist(gen), 0.3 * dist(gen),
+                                0.4 * dist(gen)));
+  }
+  EXPECT_TRUE(fluid.updateNeighbors());
+  EXPECT_FALSE(fluid.updateNeighbors());
+
+  const double radius = settings.h + settings.skin;
+  for (std::size_t i = 0; i < fluid.size(); i++) {
+    std::vector<std::size_t> expected;
+    for (std::size_t j = 0; j < fluid.size(); j++) {
+      const svector::Vector3D d(fluid.position(j).x() - fluid.position(i).x(),
+                                fluid.position(j).y() - fluid.position(i).y(),
+                                fluid.position(j).z() - fluid.position(i).z());
+      if (j != i && d.magn() < radius) {
+        expected.push_back(j);
+      }
+    }
+
+    std::vector<std::size_t> actual;
+    for (std::size_t k = 0; k < fluid.neighborCount(i); k++) {
+      actual.push_back(fluid.neighbor(i, k));
+    }
+    std::sort(actual.begin(), actual.end());
+    ASSERT_EQ(actual, expected);
+  }
+}
+
+TEST(SPHTest, Skin) {
+  // particles falling freely keep their lists until one has moved by half
+  // of the skin, which is 0.005
+  svector::SPHSettings settings;
+  svector::SPHFluid fluid(settings, svector::Vector3D(0, -10, 0),
+                          svector::Vector3D(1, 1, 1));
+  addBlock(fluid, 2, 2, 2);
+  EXPECT_TRUE(fluid.updateNeighbors());
+
+  std::size_t rebuilds = 0;
+  double lastRebuild = 0;
+  for (int step = 1; step <= 100; step++) {
+    fluid.computeDensity(0, fluid.size());
+    fluid.computeForces(0, fluid.size());
+    fluid.integrate(0, fluid.size(), 0.001);
+    if (fluid.updateNeighbors()) {
+      rebuilds++;
+      const double fallen = 0.01 - fluid.position(0).y();
+      EXPECT_GT(fallen - lastRebuild, 0.005);
+      lastRebuild = fallen;
+    }
+  }
+
+  // 0.049 fallen in 100 steps
+  EXPECT_GE(rebuilds, 5u);
+  EXPECT_LE(rebuilds, 9u);
+}
+
+TEST(SPHTest, Density) {
+  // particles on a lattice with spacing s and mass rho0 * s^3 have about the
+  // rest density away from the surface
+  svector::SPHSettings settings;
+  svector::SPHFluid fluid(settings, svector::Vector3D(0, 0, 0),
+                          svector::Vector3D(0.2, 0.2, 0.2));
+  addBlock(fluid, 9, 9, 9);
+  fluid.updateNeighbors();
+  fluid.computeDensity(0, fluid.size());
+
+  const std::size_t center = (4 * 9 + 4) * 9 + 4;
+  EXPECT_LT(std::abs(fluid.density(center) - 1000), 100);
+  EXPECT_LT(fluid.density(0), fluid.density(center));
+  EXPECT_EQ(fluid.pressure(0), 0);
+
+  // ranges give the same result as the whole
+  std::vector<double> whole;
+  for (std::size_t i = 0; i < fluid.size(); i++) {
+    whole.push_back(fluid.density(i));
+  }
+  fluid.computeDensity(0, 100);
+  fluid.computeDensity(100, fluid.size());
+  for (std::size_t i = 0; i < fluid.size(); i++) {
+    EXPECT_EQ(fluid.density(i), whole[i]);
+  }
+}
+
+TEST(SPHTest, Forces) {
+  // two particles pushed together repel each other with equal and opposite
+  // forces
+  svector::SPHSettings settings;
+  settings.gravity[1] = 0;
+  settings.restDensity = 100;
+  settings.viscosity = 0;
+  svector::SPHFluid fluid(settings, svector::Vector3D(-1, -1, -1),
+                          svector::Vector3D(1, 1, 1));
+  fluid.add(svector::Vector3D(0, 0, 0));
+  fluid.add(svector::Vector3D(0.01, 0, 0));
+  fluid.updateNeighbors();
+  fluid.computeDensity(0, 2);
+  fluid.computeForces(0, 2);
+  EXPECT_GT(fluid.pressure(0), 0);
+  EXPECT_LT(fluid.acceleration(0).x(), 0);
+  EXPECT_GT(fluid.acceleration(1).x(), 0);
+  EXPECT_EQ(fluid.acceleration(0).y(), 0);
+  EXPECT_EQ(round3(fluid.acceleration(0).x() + fluid.acceleration(1).x()),
+            0);
+
+  // without pressure, viscosity drags the resting particle along
+  settings.stiffness = 0;
+  settings.viscosity = 1;
+  svector::SPHFluid viscous(settings, svector::Vector3D(-1, -1, -1),
+                            svector::Vector3D(1, 1, 1));
+  viscous.add(svector::Vector3D(0, 0, 0));
+  viscous.add(svector::Vector3D(0.01, 0, 0), svector::Vector3D(0, 1, 0));
+  viscous.step(0.001);
+  EXPECT_EQ(viscous.pressure(0), 0);
+  EXPECT_GT(viscous.acceleration(0).y(), 0);
+  EXPECT_LT(viscous.acceleration(1).y(), 0);
+  EXPECT_EQ(viscous.acceleration(0).x(), 0);
+}
+
+TEST(SPHTest, Settle) {
+  // a block of fluid falls to the floor of the box and spreads out
+  svector::SPHSettings settings;
+  settings.viscosity = 2;
+  svector::SPHFluid fluid(settings, svector::Vector3D(0, 0, 0),
+                          svector::Vector3D(0.2, 0.4, 0.2));
+  for (int x = 0; x < 6; x++) {
+    for (int y = 0; y < 8; y++) {
+      for (int z = 0; z < 6; z++) {
+        fluid.add(svector::Vector3D(0.01 + 0.02 * x, 0.1 + 0.02 * y,
+                                    0.01 + 0.02 * z));
+      }
+    }
+  }
+
+  for (int step = 0; step < 1500; step++) {
+    fluid.step(0.001);
+  }
+
+  double highest = 0;
+  double fastest = 0;
+  double density = 0;
+  for (std::size_t i = 0; i < fluid.size(); i++) {
+    const svector::Vector3D p = fluid.position(i);
+    EXPECT_GE(p.x(), 0);
+    EXPECT_LE(p.x(), 0.2);
+    EXPECT_GE(p.y(), 0);
+    EXPECT_GE(p.z(), 0);
+    EXPECT_LE(p.z(), 0.2);
+    highest = p.y() > highest ? p.y() : highest;
+    density += fluid.density(i) / static_cast<double>(fluid.size());
+    fastest = fluid.velocity(i).magn() > fastest ? fluid.velocity(i).magn()
+                                                 : fastest;
+  }
+
+  // the fluid covers the floor with two or three layers of particles, at
+  // about the rest density
+  EXPECT_LT(highest, 0.07);
+  EXPECT_GT(highest, 0.02);
+  EXPECT_GT(density, 850);
+  EXPECT_LT(density, 1050);
+  EXPECT_LT(fastest, 0.5);
+}
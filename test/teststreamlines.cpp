@@ -0,0 +1,204 @@
+#include "simplevectors/fields/streamlines.hpp"
+#include "simplevectors/fields/vectorfield.hpp"
+#include "simplevectors/vectors.hpp"
+
+#include <gtest/gtest.h>
+
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+double round3(const double num) { return std::round(num * 1000) / 1000; }
+
+// rotation around the z axis
+svector::Vector3D circular(const svector::Vector3D &p) {
+  return svector::Vector3D(-p.y(), p.x(), 0);
+}
+
+svector::Vector3D uniform(const svector::Vector3D &) {
+  return svector::Vector3D(1, 0, 0);
+}
+} // namespace
+
+TEST(StreamlinesTest, Circle) {
+  svector::StreamlineSettings settings;
+  settings.maxLength = 2 * M_PI;
+  std::vector<svector::Vector3D> points(1000);
+  const svector::StreamlineResult result =
+      svector::traceStreamline(circular, svector::Vector3D(1, 0, 0), settings,
+                               points.data(), points.size());
+
+  EXPECT_EQ(result.stop, svector::STREAMLINE_LENGTH);
+  EXPECT_EQ(result.count, 630u);
+  EXPECT_EQ(round3(result.length), round3(2 * M_PI));
+  for (std::size_t i = 0; i < result.count; i++) {
+    ASSERT_LT(std::abs(points[i].magn() - 1), 1e-9);
+  }
+
+  // one turn returns to the seed
+  EXPECT_EQ(round3(points[result.count - 1].x()), 1);
+  EXPECT_EQ(round3(points[result.count - 1].y()), 0);
+
+  // backward tracing turns the other way
+  settings.backward = true;
+  settings.maxLength = M_PI / 2;
+  const svector::StreamlineResult quarter =
+      svector::traceStreamline(circular, svector::Vector3D(1, 0, 0), settings,
+                               points.data(), points.size());
+  EXPECT_EQ(round3(points[quarter.count - 1].x()), 0);
+  EXPECT_EQ(round3(points[quarter.count - 1].y()), -1);
+}
+
+TEST(StreamlinesTest, Adaptive) {
+  svector::StreamlineSettings settings;
+  settings.method = svector::STREAMLINE_RK45;
+  settings.tolerance = 1e-10;
+  settings.maxLength = 2 * M_PI;
+  std::vector<svector::Vector3D> points(1000);
+  const svector::StreamlineResult result =
+      svector::traceStreamline(circular, svector::Vector3D(2, 0, 0), settings,
+                               points.data(), points.size());
+
+  // the step grows from 0.01 and far fewer points are needed
+  EXPECT_EQ(result.stop, svector::STREAMLINE_LENGTH);
+  EXPECT_LT(result.count, 100u);
+  for (std::size_t i = 0; i < result.count; i++) {
+    ASSERT_LT(std::abs(points[i].magn() - 2), 1e-7);
+  }
+  EXPECT_GT((points[result.count - 2] - points[result.count - 3]).magn(),
+            (points[1] - points[0]).magn());
+
+  // the step shrinks where the field turns quickly: a circle of radius 0.1
+  // needs smaller steps than one of radius 2
+  const svector::StreamlineResult small =
+      svector::traceStreamline(circular, svector::Vector3D(0.1, 0, 0),
+                               settings, points.data(), points.size());
+  EXPECT_LT((points[small.count - 2] - points[small.count - 3]).magn(), 0.1);
+  for (std::size_t i = 0; i < small.count; i++) {
+    ASSERT_LT(std::abs(points[i].magn() - 0.1), 1e-7);
+  }
+
+  // a straight line takes the largest steps
+  settings.maxStep = 0.5;
+  settings.maxLength = 10;
+  const svector::StreamlineResult straight =
+      svector::traceStreamline(uniform, svector::Vector3D(0, 0, 0), settings,
+                               points.data(), points.size());
+  EXPECT_EQ(round3(points[straight.count - 1].x()), 10);
+  EXPECT_LT(straight.count, 30u);
+}
+
+TEST(StreamlinesTest, ParticlePath) {
+  // x' = x, so x grows exponentially with time
+  svector::StreamlineSettings settings;
+  settings.normalize = false;
+  settings.step = 0.1;
+  const auto growth = [](const svector::Vector3D &p) {
+    return svector::Vector3D(p.x(), 0, 0);
+  };
+  std::vector<svector::Vector3D> points(11);
+  const svector::StreamlineResult result = svector::traceStreamline(
+      growth, svector::Vector3D(1, 0, 0), settings, points.data(), 11);
+  EXPECT_EQ(result.stop, svector::STREAMLINE_CAPACITY);
+  EXPECT_EQ(result.count, 11u);
+  EXPECT_LT(std::abs(points[10].x() - std::exp(1)), 1e-5);
+  EXPECT_EQ(round3(result.length), round3(std::exp(1) - 1));
+}
+
+TEST(StreamlinesTest, Stops) {
+  svector::StreamlineSettings settings;
+  settings.step = 0.25;
+  std::vector<svector::Vector3D> points(100);
+
+  // leaving the bounds
+  settings.upper = svector::Vector3D(1, 1, 1);
+  svector::StreamlineResult result = svector::traceStreamline(
+      uniform, svector::Vector3D(0, 0, 0), settings, points.data(), 100);
+  EXPECT_EQ(result.stop, svector::STREAMLINE_BOUNDS);
+  EXPECT_EQ(result.count, 5u);
+  EXPECT_EQ(points[4].x(), 1);
+
+  result = svector::traceStreamline(uniform, svector::Vector3D(2, 0, 0),
+                                    settings, points.data(), 100);
+  EXPECT_EQ(result.stop, svector::STREAMLINE_BOUNDS);
+  EXPECT_EQ(result.count, 0u);
+
+  // reaching the maximum length exactly
+  settings.maxLength = 0.5;
+  result = svector::traceStreamline(uniform, svector::Vector3D(0, 0, 0),
+                                    settings, points.data(), 100);
+  EXPECT_EQ(result.stop, svector::STREAMLINE_LENGTH);
+  EXPECT_EQ(result.count, 3u);
+  EXPECT_EQ(result.length, 0.5);
+
+  // a field that vanishes for x < 0.5
+  settings.maxLength = 10;
+  settings.upper = svector::Vector3D(10, 10, 10);
+  const auto sink = [](const svector::Vector3D &p) {
+    return svector::Vector3D(p.x() >= 0.5 ? -1 : 0, 0, 0);
+  };
+  result = svector::traceStreamline(sink, svector::Vector3D(2, 0, 0),
+                                    settings, points.data(), 100);
+  EXPECT_EQ(result.stop, svector::STREAMLINE_STAGNATION);
+  EXPECT_GE(points[result.count - 1].x(), 0.5);
+  EXPECT_LT(points[result.count - 1].x(), 1);
+
+  settings.method = svector::STREAMLINE_RK45;
+  result = svector::traceStreamline(sink, svector::Vector3D(2, 0, 0),
+                                    settings, points.data(), 100);
+  EXPECT_EQ(result.stop, svector::STREAMLINE_STAGNATION);
+  EXPECT_GE(points[result.count - 1].x(), 0.5);
+  EXPECT_LT(points[result.count - 1].x(), 0.51);
+}
+
+TEST(StreamlinesTest, Seeds) {
+  // a rotation sampled on a grid
+  svector::VectorField3D<> field(svector::Vector<3, std::size_t>{21, 21, 3},
+                                 svector::Vector3D(-2, -2, -1),
+                                 svector::Vector3D(0.2, 0.2, 1));
+  for (std::size_t i = 0; i < field.size(); i++) {
+    const svector::Vector<3> p = field.grid().position(i);
+    field.value(i, svector::Vector<3>{-p[1], p[0], 0});
+  }
+  const auto sampled = [&field](const svector::Vector3D &p) {
+    return field.sample(p);
+  };
+
+  std::vector<svector::Vector3D> seeds;
+  for (int i = 1; i <= 8; i++) {
+    seeds.push_back(svector::Vector3D(0.2 * i, 0, 0));
+  }
+
+  svector::StreamlineSettings settings;
+  settings.method = svector::STREAMLINE_RK45;
+  settings.maxLength = 3;
+  const std::size_t capacity = 200;
+  std::vector<svector::Vector3D> whole(seeds.size() * capacity);
+  std::vector<svector::Vector3D> split(seeds.size() * capacity);
+  std::vector<svector::StreamlineResult> wholeResults(seeds.size());
+  std::vector<svector::StreamlineResult> splitResults(seeds.size());
+  svector::traceStreamlines(sampled, seeds.data(), 0, seeds.size(), settings,
+                            whole.data(), capacity, wholeResults.data());
+  svector::traceStreamlines(sampled, seeds.data(), 5, seeds.size(), settings,
+                            split.data(), capacity, splitResults.data());
+  svector::traceStreamlines(sampled, seeds.data(), 0, 5, settings,
+                            split.data(), capacity, splitResults.data());
+
+  for (std::size_t s = 0; s < seeds.size(); s++) {
+    ASSERT_EQ(wholeResults[s].count, splitResults[s].count);
+    EXPECT_EQ(wholeResults[s].stop, svector::STREAMLINE_LENGTH);
+    EXPECT_EQ(whole[s * capacity].x(), seeds[s].x());
+
+    // the interpolated rotation keeps streamlines close to their circle
+    for (std::size_t i = 0; i < wholeResults[s].count; i++) {
+      const svector::Vector3D &p = whole[s * capacity + i];
+      EXPECT_EQ(p.x(), split[s * capacity + i].x());
+      EXPECT_LT(std::abs(p.magn() - seeds[s].x()), 0.02);
+    }
+  }
+}
@@ -0,0 +1,147 @@
+#include "simplevectors/interp/trajectory.hpp"
+#include "simplevectors/vectors.hpp"
+
+#include <gtest/gtest.h>
+
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+double round3(const double num) { return std::round(num * 1000) / 1000; }
+} // namespace
+
+TEST(TrajectoryTest, EmptyAndSize) {
+  svector::Trajectory3D traj;
+  EXPECT_TRUE(traj.empty());
+
+  traj.push_back(0, svector::Vector3D(1, 2, 3));
+  traj.push_back(1, svector::Vector3D(4, 5, 6));
+  EXPECT_FALSE(traj.empty());
+  EXPECT_EQ(traj.size(), 2);
+  EXPECT_EQ(traj.time(1), 1);
+  EXPECT_EQ(svector::Vector3D(traj.point(1)), svector::Vector3D(4, 5, 6));
+
+  traj.clear();
+  EXPECT_TRUE(traj.empty());
+}
+
+TEST(TrajectoryTest, SingleSample) {
+  svector::Trajectory3D traj;
+  traj.push_back(2, svector::Vector3D(1, 2, 3));
+
+  svector::Vector3D res = traj.at<svector::LINEAR>(5);
+  EXPECT_EQ(res, svector::Vector3D(1, 2, 3));
+}
+
+TEST(TrajectoryTest, LinearInterpolation) {
+  svector::Trajectory3D traj;
+  traj.push_back(0, svector::Vector3D(0, 0, 0));
+  traj.push_back(1, svector::Vector3D(2, 4, 6));
+  traj.push_back(3, svector::Vector3D(4, 4, 6));
+
+  EXPECT_EQ(svector::Vector3D(traj.at<svector::LINEAR>(0.5)),
+            svector::Vector3D(1, 2, 3));
+  EXPECT_EQ(svector::Vector3D(traj.at<svector::LINEAR>(2)),
+            svector::Vector3D(3, 4, 6));
+
+  // clamps to ends
+  EXPECT_EQ(svector::Vector3D(traj.at<svector::LINEAR>(-1)),
+            svector::Vector3D(0, 0, 0));
+  EXPECT_EQ(svector::Vector3D(traj.at<svector::LINEAR>(10)),
+            svector::Vector3D(4, 4, 6));
+}
+
+TEST(TrajectoryTest, SegmentLookup) {
+  svector::Trajectory<1> traj;
+  std::vector<double> times{0, 0.1, 0.5, 0.6, 2, 7, 7.5, 10};
+  for (const auto &t : times) {
+    traj.push_back(t, svector::Vector<1>{t});
+  }
+
+  // every hint should give the same segment as a linear scan
+  for (double t = -1; t < 11; t += 0.05) {
+    std::size_t expected = 0;
+    for (std::size_t i = 0; i + 1 < times.size() - 1; i++) {
+      if (times[i + 1] < t) {
+        expected = i + 1;
+      }
+    }
+
+    for (std::size_t hint = 0; hint < times.size() + 2; hint++) {
+      std::size_t h = hint;
+      std::size_t seg = traj.segment(t, h);
+      EXPECT_EQ(seg, expected);
+      EXPECT_EQ(h, seg);
+      EXPECT_TRUE(seg == 0 || times[seg] <= t);
+    }
+  }
+
+  // NaN and infinite times
+  std::size_t h = 3;
+  EXPECT_EQ(traj.segment(std::nan(""), h), 0u);
+  EXPECT_EQ(h, 0u);
+  h = 3;
+  EXPECT_EQ(traj.segment(-INFINITY, h), 0u);
+  EXPECT_EQ(traj.segment(INFINITY, h), times.size() - 2);
+}
+
+TEST(TrajectoryTest, HermitePassesThroughSamples) {
+  svector::Trajectory2D traj;
+  for (int i = 0; i <= 10; i++) {
+    const double t = i * 0.1;
+    traj.push_back(t, svector::Vector2D(std::cos(t), std::sin(t)));
+  }
+
+  for (int i = 0; i <= 10; i++) {
+    svector::Vector2D res = traj.at<svector::HERMITE>(i * 0.1);
+    EXPECT_EQ(round3(res.x()), round3(std::cos(i * 0.1)));
+    EXPECT_EQ(round3(res.y()), round3(std::sin(i * 0.1)));
+  }
+
+  // smooth curve is close to the circle between samples
+  svector::Vector2D mid = traj.at<svector::HERMITE>(0.55);
+  EXPECT_EQ(round3(mid.x()), round3(std::cos(0.55)));
+  EXPECT_EQ(round3(mid.y()), round3(std::sin(0.55)));
+}
+
+TEST(TrajectoryTest, SlerpKeepsMagnitude) {
+  svector::Trajectory3D traj;
+  traj.push_back(0, svector::Vector3D(1, 0, 0));
+  traj.push_back(1, svector::Vector3D(0, 1, 0));
+
+  svector::Vector3D mid = traj.at<svector::SLERP>(0.5);
+  EXPECT_EQ(round3(mid.magn()), 1);
+  EXPECT_EQ(round3(mid.x()), round3(std::cos(M_PI / 4)));
+  EXPECT_EQ(round3(mid.y()), round3(std::sin(M_PI / 4)));
+
+  svector::Vector3D third = traj.at<svector::SLERP>(1.0 / 3);
+  EXPECT_EQ(round3(third.x()), round3(std::cos(M_PI / 6)));
+
+  // parallel vectors fall back to linear interpolation
+  svector::Trajectory3D parallel;
+  parallel.push_back(0, svector::Vector3D(1, 0, 0));
+  parallel.push_back(1, svector::Vector3D(3, 0, 0));
+  EXPECT_EQ(svector::Vector3D(parallel.at<svector::SLERP>(0.5)),
+            svector::Vector3D(2, 0, 0));
+}
+
+TEST(TrajectoryTest, SampleMany) {
+  svector::Trajectory3D traj;
+  traj.reserve(100);
+  for (int i = 0; i < 100; i++) {
+    traj.push_back(i, svector::Vector3D(i, 2 * i, 0));
+  }
+
+  std::vector<double> times{0.5, 10.25, 3, 98.5};
+  std::vector<svector::Vector<3>> res = traj.sample<svector::LINEAR>(times);
+  ASSERT_EQ(res.size(), times.size());
+  for (std::size_t i = 0; i < times.size(); i++) {
+    EXPECT_EQ(res[i][0], times[i]);
+    EXPECT_EQ(res[i][1], 2 * times[i]);
+  }
+}
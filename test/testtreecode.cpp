@@ -0,0 +1,176 @@
+#include "simplevectors/physics/treecode.hpp"
+#include "simplevectors/vectors.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+struct Charges {
+  std::vector<svector::Vector3D> positions;
+  std::vector<double> charges;
+};
+
+// charges in the unit cube with both signs
+Charges makeCharges(const std::size_t n, const unsigned seed) {
+  Charges result;
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> dist(0, 1);
+  for (std::size_t i = 0; i < n; i++) {
+    result.positions.push_back(
+        svector::Vector3D(dist(gen), dist(gen), dist(gen)));
+    result.charges.push_back(dist(gen) - 0.3);
+  }
+  return result;
+}
+
+// the potential and field summed over all charges
+void direct(const Charges &charges, const svector::Vector3D &point,
+            const double softening, double &potential,
+            svector::Vector3D &field) {
+  potential = 0;
+  field = svector::Vector3D(0, 0, 0);
+  for (std::size_t j = 0; j < charges.charges.size(); j++) {
+    const svector::Vector3D d = point - charges.positions[j];
+    const double r2 = d.dot(d) + softening * softening;
+    if (r2 == 0) {
+      continue;
+    }
+    const double r = std::sqrt(r2);
+    potential += charges.charges[j] / r;
+    field += d * (charges.charges[j] / (r2 * r));
+  }
+}
+
+// the largest relative error of the treecode at some charges and points
+// outside of the cube
+double largestError(const Charges &charges, const svector::Treecode &tree,
+                    const double softening) {
+  std::vector<svector::Vector3D> points(charges.positions.begin(),
+                                        charges.positions.begin() + 50);
+  points.push_back(svector::Vector3D(3, 0.5, 0.5));
+  points.push_back(svector::Vector3D(-1, -1, 2));
+
+  std::vector<double> potentials(points.size());
+  std::vector<svector::Vector3D> fields(points.size());
+  tree.evaluate(points.data(), 0, points.size(), potentials.data(),
+                fields.data());
+
+  double largest = 0;
+  for (std::size_t i = 0; i < points.size(); i++) {
+    double potential;
+    svector::Vector3D field;
+    direct(charges, points[i], softening, potential, field);
+    const double potentialError =
+        std::abs(potentials[i] - potential) / std::abs(potential);
+    const double fieldError = (fields[i] - field).magn() / field.magn();
+    largest = potentialError > largest ? potentialError : largest;
+    largest = fieldError > largest ? fieldError : largest;
+  }
+  return largest;
+}
+} // namespace
+
+TEST(TreecodeTest, Tree) {
+  const Charges charges = makeCharges(1000, 1);
+  svector::Treecode tree;
+  tree.build(charges.positions.data(), charges.charges.data(), 1000);
+  EXPECT_EQ(tree.size(), 1000u);
+  EXPECT_GT(tree.nodes(), 1000u / 32);
+  EXPECT_EQ(tree.moments(), 35u);
+
+  // an empty tree
+  svector::Treecode empty;
+  empty.build(nullptr, nullptr, 0);
+  EXPECT_EQ(empty.nodes(), 0u);
+  EXPECT_EQ(empty.potential(svector::Vector3D(1, 2, 3)), 0);
+
+  // charges at the same position are never split
+  const std::vector<svector::Vector3D> same(100, svector::Vector3D(1, 1, 1));
+  const std::vector<double> ones(100, 1);
+  svector::Treecode stacked;
+  stacked.build(same.data(), ones.data(), 100);
+  EXPECT_EQ(stacked.nodes(), 1u);
+  EXPECT_EQ(std::round(stacked.potential(svector::Vector3D(1, 1, 3)) * 1000),
+            50000);
+
+  // charges an ulp apart are not split forever either
+  std::vector<svector::Vector3D> close;
+  const double next = std::nextafter(1.0, 2.0);
+  for (std::size_t i = 0; i < 40; i++) {
+    close.push_back(svector::Vector3D(
+        i % 2 == 0 ? next : std::nextafter(next, 2.0), 0, 0));
+  }
+  const std::vector<double> more(40, 1);
+  svector::Treecode nearby;
+  nearby.build(close.data(), more.data(), 40);
+  EXPECT_EQ(nearby.nodes(), 1u);
+  EXPECT_EQ(std::round(nearby.potential(svector::Vector3D(1, 2, 0)) * 1000),
+            20000);
+}
+
+TEST(TreecodeTest, Order) {
+  // the error shrinks with the order of the expansion
+  const Charges charges = makeCharges(4000, 2);
+  double last = 1;
+  for (std::size_t order = 0; order <= 8; order += 2) {
+    svector::TreecodeSettings settings;
+    settings.order = order;
+    settings.leafSize = 8;
+    svector::Treecode tree(settings);
+    tree.build(charges.positions.data(), charges.charges.data(), 4000);
+    const double error = largestError(charges, tree, 0);
+    EXPECT_LT(error, last);
+    last = error;
+  }
+  EXPECT_LT(last, 1e-4);
+
+  // and with the opening angle
+  svector::TreecodeSettings settings;
+  settings.theta = 0.8;
+  svector::Treecode wide(settings);
+  wide.build(charges.positions.data(), charges.charges.data(), 4000);
+  settings.theta = 0.3;
+  svector::Treecode narrow(settings);
+  narrow.build(charges.positions.data(), charges.charges.data(), 4000);
+  EXPECT_LT(largestError(charges, narrow, 0),
+            largestError(charges, wide, 0));
+  EXPECT_LT(largestError(charges, narrow, 0), 2e-4);
+}
+
+TEST(TreecodeTest, Softening) {
+  const Charges charges = makeCharges(2000, 3);
+  svector::TreecodeSettings settings;
+  settings.order = 8;
+  settings.softening = 0.05;
+  svector::Treecode tree(settings);
+  tree.build(charges.positions.data(), charges.charges.data(), 2000);
+  EXPECT_LT(largestError(charges, tree, 0.05), 1e-4);
+}
+
+TEST(TreecodeTest, Ranges) {
+  // moments and points computed in ranges give the same result
+  const Charges charges = makeCharges(3000, 4);
+  svector::Treecode whole;
+  whole.build(charges.positions.data(), charges.charges.data(), 3000);
+  svector::Treecode split;
+  split.buildTree(charges.positions.data(), charges.charges.data(), 3000);
+  const std::size_t half = split.nodes() / 2;
+  split.computeMoments(half, split.nodes());
+  split.computeMoments(0, half);
+
+  std::vector<double> potentials(100);
+  std::vector<svector::Vector3D> fields(100);
+  split.evaluate(charges.positions.data(), 40, 100, potentials.data(),
+                 nullptr);
+  split.evaluate(charges.positions.data(), 0, 40, potentials.data(),
+                 nullptr);
+  split.evaluate(charges.positions.data(), 0, 100, nullptr, fields.data());
+  for (std::size_t i = 0; i < 100; i++) {
+    EXPECT_EQ(potentials[i], whole.potential(charges.positions[i]));
+    EXPECT_EQ(fields[i].x(), whole.field(charges.positions[i]).x());
+    EXPECT_EQ(fields[i].z(), whole.field(charges.positions[i]).z());
+  }
+}
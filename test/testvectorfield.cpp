@@ -0,0 +1,209 @@
+#include "simplevectors/fields/vectorfield.hpp"
+#include "simplevectors/vectors.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+double round3(const double num) { return std::round(num * 1000) / 1000; }
+
+// a 5 x 4 x 3 grid from (1, 2, 3) with spacing (0.5, 1, 2)
+svector::VectorField3D<> makeField() {
+  return svector::VectorField3D<>(svector::Vector<3, std::size_t>{5, 4, 3},
+                                  svector::Vector3D(1, 2, 3),
+                                  svector::Vector3D(0.5, 1, 2));
+}
+
+// fills a field from a function of the node position
+template <typename Field, typename F> void fill(Field &field, const F &f) {
+  for (std::size_t i = 0; i < field.size(); i++) {
+    field.value(i, f(field.grid().position(i)));
+  }
+}
+} // namespace
+
+TEST(VectorFieldTest, Grid) {
+  const svector::VectorField3D<> field = makeField();
+  const svector::FieldGrid<3> &grid = field.grid();
+  EXPECT_EQ(grid.size(), 60u);
+  EXPECT_EQ(field.size(), 60u);
+  EXPECT_EQ(grid.stride(0), 1u);
+  EXPECT_EQ(grid.stride(1), 5u);
+  EXPECT_EQ(grid.stride(2), 20u);
+  EXPECT_EQ(grid.index(svector::Vector<3, std::size_t>{2, 1, 2}), 47u);
+
+  const svector::Vector<3> p = grid.position(47);
+  EXPECT_EQ(p[0], 2);
+  EXPECT_EQ(p[1], 3);
+  EXPECT_EQ(p[2], 7);
+}
+
+TEST(VectorFieldTest, Trilinear) {
+  // multilinear interpolation reproduces linear fields exactly
+  svector::VectorField3D<> field = makeField();
+  const auto linear = [](const svector::Vector<3> &p) {
+    return svector::Vector<3>{1 + 2 * p[0] - p[1] + 3 * p[2],
+                              p[0] * 0.5 - 4, p[2] - p[1]};
+  };
+  fill(field, linear);
+
+  std::mt19937 gen(11);
+  std::uniform_real_distribution<double> dist(0, 1);
+  std::vector<double> xs;
+  std::vector<double> ys;
+  std::vector<double> zs;
+  for (int i = 0; i < 100; i++) {
+    const svector::Vector<3> p{1 + 2 * dist(gen), 2 + 3 * dist(gen),
+                               3 + 4 * dist(gen)};
+    const svector::Vector<3> sampled = field.sample(p);
+    const svector::Vector<3> expected = linear(p);
+    for (std::size_t d = 0; d < 3; d++) {
+      EXPECT_EQ(round3(sampled[d]), round3(expected[d]));
+    }
+    xs.push_back(p[0]);
+    ys.push_back(p[1]);
+    zs.push_back(p[2]);
+  }
+
+  // the batch gives the same results
+  std::vector<double> outX(xs.size());
+  std::vector<double> outY(xs.size());
+  std::vector<double> outZ(xs.size());
+  const double *coordinates[3] = {xs.data(), ys.data(), zs.data()};
+  double *out[3] = {outX.data(), outY.data(), outZ.data()};
+  field.sample(coordinates, out, xs.size());
+  for (std::size_t i = 0; i < xs.size(); i++) {
+    const svector::Vector<3> sampled =
+        field.sample(svector::Vector<3>{xs[i], ys[i], zs[i]});
+    EXPECT_EQ(outX[i], sampled[0]);
+    EXPECT_EQ(outY[i], sampled[1]);
+    EXPECT_EQ(outZ[i], sampled[2]);
+  }
+
+  // nodes, the upper corner and points outside the grid
+  EXPECT_EQ(field.sample(field.grid().position(47))[0], field.value(47)[0]);
+  EXPECT_EQ(round3(field.sample(svector::Vector3D(3, 5, 7))[0]),
+            round3(linear(svector::Vector3D(3, 5, 7))[0]));
+  EXPECT_EQ(round3(field.sample(svector::Vector3D(10, 5, 7))[0]),
+            round3(linear(svector::Vector3D(3, 5, 7))[0]));
+  EXPECT_EQ(round3(field.sample(svector::Vector3D(-10, 2, 3))[0]),
+            round3(linear(svector::Vector3D(1, 2, 3))[0]));
+}
+
+TEST(VectorFieldTest, Bilinear) {
+  svector::ScalarField2D<> field(svector::Vector<2, std::size_t>{3, 3},
+                                 svector::Vector2D(0, 0),
+                                 svector::Vector2D(1, 1));
+  fill(field, [](const svector::Vector<2> &p) { return p[0] * p[1]; });
+
+  // bilinear interpolation is exact for xy as well
+  EXPECT_EQ(round3(field.sample(svector::Vector2D(0.5, 1.5))), 0.75);
+  EXPECT_EQ(round3(field.sample(svector::Vector2D(1.25, 0.5))), 0.625);
+
+  const double xs[2] = {0.5, 2};
+  const double ys[2] = {1.5, 2};
+  const double *coordinates[2] = {xs, ys};
+  double out[2];
+  field.sample(coordinates, out, 2);
+  EXPECT_EQ(round3(out[0]), 0.75);
+  EXPECT_EQ(round3(out[1]), 4);
+
+  // a single node along an axis
+  svector::ScalarField2D<> line(svector::Vector<2, std::size_t>{4, 1},
+                                svector::Vector2D(0, 0),
+                                svector::Vector2D(1, 1));
+  fill(line, [](const svector::Vector<2> &p) { return p[0]; });
+  EXPECT_EQ(line.sample(svector::Vector2D(2.5, 3)), 2.5);
+}
+
+TEST(VectorFieldTest, Gradient) {
+  svector::ScalarField3D<> field(svector::Vector<3, std::size_t>{5, 4, 3},
+                                 svector::Vector3D(1, 2, 3),
+                                 svector::Vector3D(0.5, 1, 2));
+  fill(field, [](const svector::Vector<3> &p) {
+    return 1 + 2 * p[0] - p[1] + 3 * p[2];
+  });
+
+  const svector::VectorField3D<> grad = svector::gradient(field);
+  for (std::size_t i = 0; i < grad.size(); i++) {
+    EXPECT_EQ(round3(grad.value(i)[0]), 2);
+    EXPECT_EQ(round3(grad.value(i)[1]), -1);
+    EXPECT_EQ(round3(grad.value(i)[2]), 3);
+  }
+}
+
+TEST(VectorFieldTest, DivergenceCurl) {
+  svector::VectorField3D<> field = makeField();
+  fill(field, [](const svector::Vector<3> &p) {
+    return svector::Vector<3>{-p[1] + p[0], p[0] + 2 * p[1], 3 * p[2]};
+  });
+
+  const svector::ScalarField3D<> div = svector::divergence(field);
+  const svector::VectorField3D<> rot = svector::curl(field);
+  for (std::size_t i = 0; i < field.size(); i++) {
+    EXPECT_EQ(round3(div.value(i)), 6);
+    EXPECT_EQ(round3(rot.value(i)[0]), 0);
+    EXPECT_EQ(round3(rot.value(i)[1]), 0);
+    EXPECT_EQ(round3(rot.value(i)[2]), 2);
+  }
+
+  // the curl of a gradient vanishes inside the grid
+  svector::ScalarField3D<> potential(svector::Vector<3, std::size_t>{6, 6, 6},
+                                     svector::Vector3D(0, 0, 0),
+                                     svector::Vector3D(0.2, 0.2, 0.2));
+  fill(potential, [](const svector::Vector<3> &p) {
+    return p[0] * p[1] + p[2] * p[2] * p[0];
+  });
+  const svector::VectorField3D<> none =
+      svector::curl(svector::gradient(potential));
+  const std::size_t center =
+      potential.grid().index(svector::Vector<3, std::size_t>{2, 3, 2});
+  EXPECT_EQ(round3(none.value(center)[0]), 0);
+  EXPECT_EQ(round3(none.value(center)[1]), 0);
+  EXPECT_EQ(round3(none.value(center)[2]), 0);
+
+  // 2D
+  svector::VectorField2D<> flat(svector::Vector<2, std::size_t>{4, 5},
+                                svector::Vector2D(0, 0),
+                                svector::Vector2D(1, 0.5));
+  fill(flat, [](const svector::Vector<2> &p) {
+    return svector::Vector<2>{-p[1], p[0] + p[1]};
+  });
+  const svector::ScalarField2D<> flatCurl = svector::curl(flat);
+  const svector::ScalarField2D<> flatDiv = svector::divergence(flat);
+  for (std::size_t i = 0; i < flat.size(); i++) {
+    EXPECT_EQ(round3(flatCurl.value(i)), 2);
+    EXPECT_EQ(round3(flatDiv.value(i)), 1);
+  }
+}
+
+TEST(VectorFieldTest, Slices) {
+  // slices computed separately give the same result as the whole field
+  svector::VectorField3D<> field = makeField();
+  fill(field, [](const svector::Vector<3> &p) {
+    return svector::Vector<3>{p[0] * p[1], std::sin(p[2]), p[0] * p[2]};
+  });
+
+  const svector::ScalarField3D<> whole = svector::divergence(field);
+  svector::ScalarField3D<> split(field.grid().shape, field.grid().origin,
+                                 field.grid().spacing);
+  svector::divergence(field, split, 2, 3);
+  svector::divergence(field, split, 0, 2);
+  for (std::size_t i = 0; i < field.size(); i++) {
+    EXPECT_EQ(split.value(i), whole.value(i));
+  }
+}
+
+TEST(VectorFieldTest, Float) {
+  svector::VectorField3D<float> field(svector::Vector<3, std::size_t>{2, 2, 2},
+                                      svector::Vector<3, float>{0, 0, 0},
+                                      svector::Vector<3, float>{1, 1, 1});
+  field.value(7, svector::Vector<3, float>{8, 0, 0});
+  const svector::Vector<3, float> center =
+      field.sample(svector::Vector<3, float>{0.5f, 0.5f, 0.5f});
+  EXPECT_EQ(center[0], 1);
+  EXPECT_EQ(field.component(0)[7], 8);
+}